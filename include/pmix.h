@@ -212,6 +212,36 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const pmix_key_t
                                       const pmix_info_t info[], size_t ninfo,
                                       pmix_value_cbfunc_t cbfunc, void *cbdata);
 
+/* Release a value obtained from PMIx_Get with the PMIX_GET_POINTER_VALUES
+ * attribute. Values that were returned as views into the shared-memory
+ * store are freed without touching the data they point to, while any
+ * that had to be copied are released as usual. Views must be released
+ * before the library is finalized. */
+PMIX_EXPORT void PMIx_Value_release_view(pmix_value_t *val);
+
+/* Retrieve the values of a set of keys for a set of processes in a single
+ * call. Data already present in the local shared store is collected in one
+ * pass, and the data of all processes still missing a key is requested
+ * from the local server in a single message before the call blocks until
+ * all of it has arrived. The info array is used as described above for the
+ * blocking form of PMIx_Get and applies to every entry.
+ *
+ * Results are returned in the vals and status arrays, each holding
+ * nprocs * nkeys elements ordered by process and then by key - i.e., the
+ * value of keys[k] for procs[p] is at index p*nkeys + k. If *vals is NULL,
+ * the array will be allocated by the library and must be released by the
+ * caller with PMIX_VALUE_FREE(*vals, nprocs * nkeys) - otherwise it must
+ * point to an array of that size provided by the caller, whose contents
+ * must then be destructed with PMIX_VALUE_DESTRUCT. Entries whose status
+ * is not PMIX_SUCCESS are left empty.
+ *
+ * Returns PMIX_SUCCESS if every value was retrieved, or the status of the
+ * first entry that failed */
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], size_t nprocs,
+                                         const pmix_key_t keys[], size_t nkeys,
+                                         const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t **vals, pmix_status_t status[]);
+
 
 /* Publish the data in the info array for lookup. By default,
  * the data will be published into the PMIX_SESSION range and
@@ -0,0 +1,105 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "src/class/pmix_arena.h"
+
+/* every allocation starts on this boundary */
+#define PMIX_ARENA_ALIGN    16
+#define PMIX_ARENA_ROUND(s) (((s) + PMIX_ARENA_ALIGN - 1) & ~((size_t)PMIX_ARENA_ALIGN - 1))
+
+typedef struct pmix_arena_block_t {
+    struct pmix_arena_block_t *next;
+    size_t size;
+    size_t used;
+} pmix_arena_block_t;
+
+/* the data region follows the header */
+#define PMIX_ARENA_HDR_SIZE PMIX_ARENA_ROUND(sizeof(pmix_arena_block_t))
+
+static void acon(pmix_arena_t *p)
+{
+    p->blocks = NULL;
+    p->block_size = 0;
+    p->nbytes = 0;
+}
+static void ades(pmix_arena_t *p)
+{
+    pmix_arena_block_t *blk, *next;
+
+    for (blk = p->blocks; NULL != blk; blk = next) {
+        next = blk->next;
+        free(blk);
+    }
+}
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_arena_t,
+                                       pmix_object_t,
+                                       acon, ades);
+
+void* pmix_arena_alloc(pmix_arena_t *arena, size_t size)
+{
+    pmix_arena_block_t *blk = arena->blocks;
+    size_t bsize;
+    char *ptr;
+
+    /* refuse sizes that would wrap once rounded up or given a
+     * block header of their own */
+    if (SIZE_MAX - PMIX_ARENA_HDR_SIZE - PMIX_ARENA_ALIGN < size) {
+        return NULL;
+    }
+    size = PMIX_ARENA_ROUND(size);
+    if (NULL == blk || blk->size - blk->used < size) {
+        /* grow geometrically so that large messages need only a
+         * handful of blocks */
+        if (0 == arena->block_size) {
+            bsize = PMIX_ARENA_BLOCK_SIZE;
+        } else if (arena->block_size < PMIX_ARENA_BLOCK_MAX) {
+            bsize = 2 * arena->block_size;
+        } else {
+            bsize = arena->block_size;
+        }
+        if (bsize < size) {
+            /* oversized request - give it a block of its own and
+             * keep carving from the current one */
+            blk = (pmix_arena_block_t*)malloc(PMIX_ARENA_HDR_SIZE + size);
+            if (NULL == blk) {
+                return NULL;
+            }
+            blk->size = size;
+            blk->used = size;
+            if (NULL == arena->blocks) {
+                blk->next = NULL;
+                arena->blocks = blk;
+            } else {
+                blk->next = arena->blocks->next;
+                arena->blocks->next = blk;
+            }
+            arena->nbytes += size;
+            return (char*)blk + PMIX_ARENA_HDR_SIZE;
+        }
+        blk = (pmix_arena_block_t*)malloc(PMIX_ARENA_HDR_SIZE + bsize);
+        if (NULL == blk) {
+            return NULL;
+        }
+        blk->size = bsize;
+        blk->used = 0;
+        blk->next = arena->blocks;
+        arena->blocks = blk;
+        arena->block_size = bsize;
+    }
+    ptr = (char*)blk + PMIX_ARENA_HDR_SIZE + blk->used;
+    blk->used += size;
+    arena->nbytes += size;
+    return ptr;
+}
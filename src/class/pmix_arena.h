@@ -0,0 +1,77 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/** @file
+ *
+ * A bump allocator for data whose pieces all share one lifetime.
+ * Allocations are carved sequentially out of a chain of blocks and
+ * are never freed individually - releasing the arena object returns
+ * all of them at once.
+ */
+
+#ifndef PMIX_ARENA_H
+#define PMIX_ARENA_H
+
+#include <src/include/pmix_config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "src/class/pmix_object.h"
+
+BEGIN_C_DECLS
+
+/* size of the first block - later blocks double up to the max */
+#define PMIX_ARENA_BLOCK_SIZE       4096
+#define PMIX_ARENA_BLOCK_MAX        (1024 * 1024)
+
+struct pmix_arena_block_t;
+
+struct pmix_arena_t {
+    /** base class */
+    pmix_object_t super;
+    /** block currently being carved - older blocks are chained
+     * behind it */
+    struct pmix_arena_block_t *blocks;
+    /** size of the most recently allocated block */
+    size_t block_size;
+    /** total bytes handed out */
+    size_t nbytes;
+};
+typedef struct pmix_arena_t pmix_arena_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_arena_t);
+
+/**
+ * Allocate size bytes from the arena, suitably aligned for any type.
+ * The memory is not initialized. Returns NULL if no memory is
+ * available or size is too large to be allocated at all.
+ */
+PMIX_EXPORT void* pmix_arena_alloc(pmix_arena_t *arena, size_t size);
+
+/**
+ * Allocate zeroed storage for an array of n elements of the given
+ * size. Returns NULL if no memory is available or n * size does
+ * not fit in a size_t.
+ */
+static inline void* pmix_arena_calloc(pmix_arena_t *arena, size_t n, size_t size)
+{
+    void *ptr;
+
+    if (0 != size && SIZE_MAX / size < n) {
+        return NULL;
+    }
+    if (NULL != (ptr = pmix_arena_alloc(arena, n * size))) {
+        memset(ptr, 0, n * size);
+    }
+    return ptr;
+}
+
+END_C_DECLS
+
+#endif /* PMIX_ARENA_H */
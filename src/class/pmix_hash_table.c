@@ -11,7 +11,7 @@
  *                         All rights reserved.
  * Copyright (c) 2014-2015 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
- * Copyright (c) 2014-2015 Intel, Inc. All rights reserved
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -85,6 +85,8 @@ pmix_hash_table_construct(pmix_hash_table_t* ht)
   ht->ht_density_numer = ht->ht_density_denom = 0;
   ht->ht_growth_numer = ht->ht_growth_denom = 0;
   ht->ht_type_methods = NULL;
+  ht->ht_data_bytes = 0;
+  ht->ht_key_index = NULL;
 }
 
 static void
@@ -92,6 +94,9 @@ pmix_hash_table_destruct(pmix_hash_table_t* ht)
 {
     pmix_hash_table_remove_all(ht);
     free(ht->ht_table);
+    if (NULL != ht->ht_key_index) {
+        PMIX_RELEASE(ht->ht_key_index);
+    }
 }
 
 /*
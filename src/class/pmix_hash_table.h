@@ -9,7 +9,7 @@
  *                         University of Stuttgart.  All rights reserved.
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
- * Copyright (c) 2015-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015-2016 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * Copyright (c) 2016      Mellanox Technologies, Inc.
@@ -59,6 +59,8 @@ struct pmix_hash_table_t
     int                  ht_density_numer, ht_density_denom; /**< max allowed density of table */
     int                  ht_growth_numer, ht_growth_denom;   /**< growth factor when grown  */
     const struct pmix_hash_type_methods_t * ht_type_methods;
+    size_t               ht_data_bytes;  /**< approximate size of the key-values held via pmix_hash_store */
+    struct pmix_hash_table_t *ht_key_index; /**< keys stored via pmix_hash_store, mapped to the first rank holding them */
 };
 typedef struct pmix_hash_table_t pmix_hash_table_t;
 
@@ -9,7 +9,7 @@
  *                         University of Stuttgart.  All rights reserved.
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2016      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -30,6 +30,7 @@
 
 
 #include <stdio.h>
+#include <string.h>
 #include <pthread.h>
 
 #include "src/class/pmix_object.h"
@@ -48,7 +49,9 @@ PMIX_EXPORT pmix_class_t pmix_object_t_class = {
     0,                    /* class hierarchy depth */
     NULL,                 /* array of constructors */
     NULL,                 /* array of destructors */
-    sizeof(pmix_object_t) /* size of the pmix object */
+    sizeof(pmix_object_t), /* size of the pmix object */
+    0,                    /* not cached */
+    NULL                  /* free list */
 };
 
 int pmix_class_init_epoch = 1;
@@ -62,12 +65,66 @@ static int num_classes = 0;
 static int max_classes = 0;
 static const int increment = 10;
 
+int pmix_obj_cache_size = 256;
+int pmix_obj_cache_thread_size = 16;
+
+/* cached classes in use - only the first PMIX_OBJ_CACHE_MAX of
+ * them get a free list in each thread */
+#define PMIX_OBJ_CACHE_MAX  16
+
+/* released objects are chained through their first word */
+typedef struct pmix_obj_link_t {
+    struct pmix_obj_link_t *next;
+} pmix_obj_link_t;
+
+typedef struct pmix_obj_cache_t {
+    pmix_class_t *cls;
+    int index;
+    pthread_mutex_t lock;
+    pmix_obj_link_t *head;
+    size_t count;
+    size_t peak;
+    /* counters of the threads without a free list of their own */
+    uint64_t news;
+    uint64_t mallocs;
+    uint64_t frees;
+} pmix_obj_cache_t;
+
+typedef struct {
+    pmix_obj_link_t *head;
+    int count;
+    uint64_t news;
+    uint64_t mallocs;
+    uint64_t frees;
+} pmix_obj_tcache_t;
+
+/* one per thread and only ever touched by it, so it needs no lock -
+ * handed back to the shared lists when the thread exits */
+typedef struct pmix_obj_tblock_t {
+    struct pmix_obj_tblock_t *next;
+    pmix_obj_tcache_t caches[PMIX_OBJ_CACHE_MAX];
+} pmix_obj_tblock_t;
+
+static pmix_obj_cache_t *caches[PMIX_OBJ_CACHE_MAX];
+static int num_caches = 0;
+static pthread_mutex_t tblocks_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pmix_obj_tblock_t *tblocks = NULL;
+#if PMIX_HAVE_THREAD_LOCAL
+/* finalize frees the blocks of all threads - a thread only uses
+ * its block when it was created in the current class epoch */
+static pmix_thread_local pmix_obj_tblock_t *mytblock = NULL;
+static pmix_thread_local int mytblock_epoch = 0;
+static pthread_key_t tblock_key;
+static bool tblock_key_set = false;
+#endif
+
 
 /*
  * Local functions
  */
 static void save_class(pmix_class_t *cls);
 static void expand_array(void);
+static void create_cache(pmix_class_t *cls);
 
 
 /*
@@ -157,6 +214,10 @@ void pmix_class_initialize(pmix_class_t *cls)
     }
     *cls_destruct_array = NULL;  /* end marker for the destructors */
 
+    if (cls->cls_cached) {
+        create_cache(cls);
+    }
+
     cls->cls_initialized = pmix_class_init_epoch;
     save_class(cls);
 
@@ -171,13 +232,49 @@ void pmix_class_initialize(pmix_class_t *cls)
  */
 int pmix_class_finalize(void)
 {
+    pmix_obj_tblock_t *blk;
+    pmix_obj_link_t *obj;
     int i;
 
+    /* free the recycled objects and the thread blocks holding
+     * some of them - bumping the epoch below keeps their threads
+     * from using them again. Threads exiting meanwhile wait for us
+     * on the tblocks mutex */
+    pthread_mutex_lock(&tblocks_mutex);
+    while (NULL != (blk = tblocks)) {
+        tblocks = blk->next;
+        for (i = 0; i < PMIX_OBJ_CACHE_MAX; i++) {
+            while (NULL != (obj = blk->caches[i].head)) {
+                blk->caches[i].head = obj->next;
+                free(obj);
+            }
+        }
+        free(blk);
+    }
+#if PMIX_HAVE_THREAD_LOCAL
+    if (tblock_key_set) {
+        pthread_key_delete(tblock_key);
+        tblock_key_set = false;
+    }
+#endif
+    for (i = 0; i < num_caches; i++) {
+        while (NULL != (obj = caches[i]->head)) {
+            caches[i]->head = obj->next;
+            free(obj);
+        }
+        caches[i]->cls->cls_cache = NULL;
+        pthread_mutex_destroy(&caches[i]->lock);
+        free(caches[i]);
+        caches[i] = NULL;
+    }
+    num_caches = 0;
+
     if (INT_MAX == pmix_class_init_epoch) {
         pmix_class_init_epoch = 1;
     } else {
         pmix_class_init_epoch++;
     }
+    pthread_mutex_unlock(&tblocks_mutex);
 
     if (NULL != classes) {
         for (i = 0; i < num_classes; ++i) {
@@ -195,6 +292,267 @@ int pmix_class_finalize(void)
 }
 
 
+/* called with the class mutex held */
+static void create_cache(pmix_class_t *cls)
+{
+    pmix_obj_cache_t *c;
+
+    if (NULL != cls->cls_cache || PMIX_OBJ_CACHE_MAX <= num_caches) {
+        return;
+    }
+    if (NULL == (c = (pmix_obj_cache_t*)calloc(1, sizeof(pmix_obj_cache_t)))) {
+        return;
+    }
+    c->cls = cls;
+    c->index = num_caches;
+    pthread_mutex_init(&c->lock, NULL);
+    caches[num_caches++] = c;
+    cls->cls_cache = c;
+}
+
+#if PMIX_HAVE_THREAD_LOCAL
+/* called when a thread exits - move its objects and counters to the
+ * shared lists and drop its block */
+static void release_tblock(void *arg)
+{
+    pmix_obj_tblock_t *blk = (pmix_obj_tblock_t*)arg, **prev;
+    pmix_obj_tcache_t *tc;
+    pmix_obj_cache_t *c;
+    pmix_obj_link_t *obj, *spill = NULL;
+    int i;
+
+    /* destructors of other keys may still create objects */
+    mytblock = NULL;
+    pthread_mutex_lock(&tblocks_mutex);
+    for (prev = &tblocks; NULL != *prev && blk != *prev; prev = &(*prev)->next);
+    if (NULL == *prev) {
+        /* finalize got here first and freed it */
+        pthread_mutex_unlock(&tblocks_mutex);
+        return;
+    }
+    *prev = blk->next;
+    for (i = 0; i < num_caches; i++) {
+        c = caches[i];
+        tc = &blk->caches[i];
+        pthread_mutex_lock(&c->lock);
+        while (NULL != (obj = tc->head)) {
+            tc->head = obj->next;
+            if (c->count < (size_t)pmix_obj_cache_size) {
+                obj->next = c->head;
+                c->head = obj;
+                c->count++;
+            } else {
+                obj->next = spill;
+                spill = obj;
+                tc->frees++;
+            }
+        }
+        if (c->count > c->peak) {
+            c->peak = c->count;
+        }
+        c->news += tc->news;
+        c->mallocs += tc->mallocs;
+        c->frees += tc->frees;
+        pthread_mutex_unlock(&c->lock);
+    }
+    pthread_mutex_unlock(&tblocks_mutex);
+
+    while (NULL != (obj = spill)) {
+        spill = obj->next;
+        free(obj);
+    }
+    free(blk);
+}
+#endif
+
+/* returns the block of the calling thread */
+static pmix_obj_tblock_t *get_tblock(void)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pmix_obj_tblock_t *blk;
+
+    if (0 >= pmix_obj_cache_thread_size) {
+        return NULL;
+    }
+    if (NULL != (blk = mytblock) && pmix_class_init_epoch == mytblock_epoch) {
+        return blk;
+    }
+    /* none yet, or finalize freed it */
+    mytblock = NULL;
+    if (NULL == (blk = (pmix_obj_tblock_t*)calloc(1, sizeof(pmix_obj_tblock_t)))) {
+        return NULL;
+    }
+    pthread_mutex_lock(&tblocks_mutex);
+    if (!tblock_key_set) {
+        tblock_key_set = (0 == pthread_key_create(&tblock_key, release_tblock));
+    }
+    if (!tblock_key_set || 0 != pthread_setspecific(tblock_key, blk)) {
+        pthread_mutex_unlock(&tblocks_mutex);
+        free(blk);
+        return NULL;
+    }
+    blk->next = tblocks;
+    tblocks = blk;
+    mytblock = blk;
+    mytblock_epoch = pmix_class_init_epoch;
+    pthread_mutex_unlock(&tblocks_mutex);
+    return blk;
+#else
+    return NULL;
+#endif
+}
+
+pmix_object_t *pmix_obj_cache_get(pmix_class_t *cls)
+{
+    pmix_obj_cache_t *c = cls->cls_cache;
+    pmix_obj_tblock_t *blk;
+    pmix_obj_tcache_t *tc;
+    pmix_obj_link_t *obj = NULL;
+    int n;
+
+    if (NULL != (blk = get_tblock())) {
+        tc = &blk->caches[c->index];
+        tc->news++;
+        if (0 < pmix_obj_cache_size && NULL == tc->head && NULL != c->head) {
+            /* refill half of our list from the shared one */
+            pthread_mutex_lock(&c->lock);
+            for (n = 0; NULL != c->head && n < (pmix_obj_cache_thread_size + 1) / 2; n++) {
+                obj = c->head;
+                c->head = obj->next;
+                c->count--;
+                obj->next = tc->head;
+                tc->head = obj;
+                tc->count++;
+            }
+            pthread_mutex_unlock(&c->lock);
+        }
+        if (NULL != (obj = tc->head)) {
+            tc->head = obj->next;
+            tc->count--;
+        } else {
+            tc->mallocs++;
+        }
+        if (NULL == obj) {
+            return (pmix_object_t *) malloc(cls->cls_sizeof);
+        }
+        return (pmix_object_t *) obj;
+    }
+
+    pthread_mutex_lock(&c->lock);
+    c->news++;
+    if (0 < pmix_obj_cache_size && NULL != (obj = c->head)) {
+        c->head = obj->next;
+        c->count--;
+    } else {
+        c->mallocs++;
+    }
+    pthread_mutex_unlock(&c->lock);
+    if (NULL == obj) {
+        return (pmix_object_t *) malloc(cls->cls_sizeof);
+    }
+    return (pmix_object_t *) obj;
+}
+
+void pmix_obj_cache_put(pmix_object_t *object)
+{
+    pmix_obj_cache_t *c = object->obj_class->cls_cache;
+    pmix_obj_tblock_t *blk;
+    pmix_obj_tcache_t *tc;
+    pmix_obj_link_t *obj = (pmix_obj_link_t *) object, *spill = NULL;
+    int n;
+
+    if (NULL != (blk = get_tblock())) {
+        tc = &blk->caches[c->index];
+        if (0 >= pmix_obj_cache_size) {
+            tc->frees++;
+            free(object);
+            return;
+        }
+        if (tc->count >= pmix_obj_cache_thread_size) {
+            /* move half of our list to the shared one and free
+             * whatever goes beyond its high-water mark */
+            pthread_mutex_lock(&c->lock);
+            for (n = 0; NULL != tc->head && n < (pmix_obj_cache_thread_size + 1) / 2; n++) {
+                obj = tc->head;
+                tc->head = obj->next;
+                tc->count--;
+                if (c->count < (size_t)pmix_obj_cache_size) {
+                    obj->next = c->head;
+                    c->head = obj;
+                    c->count++;
+                } else {
+                    obj->next = spill;
+                    spill = obj;
+                    tc->frees++;
+                }
+            }
+            if (c->count > c->peak) {
+                c->peak = c->count;
+            }
+            pthread_mutex_unlock(&c->lock);
+            obj = (pmix_obj_link_t *) object;
+        }
+        obj->next = tc->head;
+        tc->head = obj;
+        tc->count++;
+        while (NULL != (obj = spill)) {
+            spill = obj->next;
+            free(obj);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&c->lock);
+    if (0 < pmix_obj_cache_size && c->count < (size_t)pmix_obj_cache_size) {
+        obj->next = c->head;
+        c->head = obj;
+        c->count++;
+        if (c->count > c->peak) {
+            c->peak = c->count;
+        }
+        obj = NULL;
+    } else {
+        c->frees++;
+    }
+    pthread_mutex_unlock(&c->lock);
+    if (NULL != obj) {
+        free(obj);
+    }
+}
+
+int pmix_obj_cache_stats(int idx, pmix_obj_cache_stats_t *stats)
+{
+    pmix_obj_cache_t *c;
+    pmix_obj_tblock_t *blk;
+    pmix_obj_tcache_t *tc;
+
+    pthread_mutex_lock(&class_mutex);
+    if (idx < 0 || num_caches <= idx) {
+        pthread_mutex_unlock(&class_mutex);
+        return PMIX_ERR_NOT_FOUND;
+    }
+    c = caches[idx];
+    pthread_mutex_lock(&c->lock);
+    stats->name = c->cls->cls_name;
+    stats->news = c->news;
+    stats->mallocs = c->mallocs;
+    stats->frees = c->frees;
+    stats->cached = c->count;
+    stats->peak = c->peak;
+    pthread_mutex_unlock(&c->lock);
+    pthread_mutex_lock(&tblocks_mutex);
+    for (blk = tblocks; NULL != blk; blk = blk->next) {
+        tc = &blk->caches[c->index];
+        stats->news += tc->news;
+        stats->mallocs += tc->mallocs;
+        stats->frees += tc->frees;
+        stats->cached += tc->count;
+    }
+    pthread_mutex_unlock(&tblocks_mutex);
+    pthread_mutex_unlock(&class_mutex);
+    return PMIX_SUCCESS;
+}
+
 static void save_class(pmix_class_t *cls)
 {
     if (num_classes >= max_classes) {
@@ -11,7 +11,7 @@
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
  * Copyright (c) 2007      Cisco Systems, Inc.  All rights reserved.
- * Copyright (c) 2013-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2013-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2016      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -64,7 +64,8 @@
  *     sally_construct,
  *     sally_destruct,
  *     0, 0, NULL, NULL,
- *     sizeof ("sally_t")
+ *     sizeof ("sally_t"),
+ *     0, NULL
  *   };
  * @endcode
  * This variable should be declared in the interface (.h) file using
@@ -96,6 +97,13 @@
  * When the reference count reaches zero, the class's destructor, and
  * those of its parents, are run and the memory is freed.
  *
+ * Classes whose objects are created and released at a high rate can
+ * be instantiated with PMIX_CLASS_INSTANCE_CACHED instead. Released
+ * objects of such a class are kept on a free list - a small one per
+ * thread backed by one shared by all threads - and handed out again
+ * by PMIX_NEW. The objects are still individually malloc'd, so they
+ * may be freed with free() like any other object.
+ *
  * N.B. There is no explicit free/delete method for dynamic objects in
  * this model.
  *
@@ -165,8 +173,29 @@ struct pmix_class_t {
     pmix_destruct_t *cls_destruct_array;
                                     /**< array of parent class destructors */
     size_t cls_sizeof;              /**< size of an object instance */
+    int cls_cached;                 /**< recycle released objects */
+    struct pmix_obj_cache_t *cls_cache;
+                                    /**< free list of released objects */
 };
 
+/**
+ * Allocation counters of a cached class
+ */
+typedef struct {
+    const char *name;               /**< class name */
+    uint64_t news;                  /**< objects created */
+    uint64_t mallocs;               /**< objects that had to be allocated */
+    uint64_t frees;                 /**< released objects that were freed */
+    size_t cached;                  /**< objects currently held for reuse */
+    size_t peak;                    /**< most objects held by the shared list */
+} pmix_obj_cache_stats_t;
+
+/* number of objects of each class kept on the shared free list, 0
+ * disables recycling altogether */
+PMIX_EXPORT extern int pmix_obj_cache_size;
+/* number of objects of each class kept by every thread */
+PMIX_EXPORT extern int pmix_obj_cache_thread_size;
+
 PMIX_EXPORT extern int pmix_class_init_epoch;
 
 /**
@@ -228,7 +257,24 @@ struct pmix_object_t {
         (pmix_construct_t) CONSTRUCTOR,                                 \
         (pmix_destruct_t) DESTRUCTOR,                                   \
         0, 0, NULL, NULL,                                               \
-        sizeof(NAME)                                                    \
+        sizeof(NAME),                                                   \
+        0, NULL                                                         \
+    }
+
+/**
+ * Static initializer for the descriptor of a class whose released
+ * objects are recycled - takes the same arguments as
+ * PMIX_CLASS_INSTANCE
+ */
+#define PMIX_CLASS_INSTANCE_CACHED(NAME, PARENT, CONSTRUCTOR, DESTRUCTOR) \
+    pmix_class_t NAME ## _class = {                                     \
+        # NAME,                                                         \
+        PMIX_CLASS(PARENT),                                              \
+        (pmix_construct_t) CONSTRUCTOR,                                 \
+        (pmix_destruct_t) DESTRUCTOR,                                   \
+        0, 0, NULL, NULL,                                               \
+        sizeof(NAME),                                                   \
+        1, NULL                                                         \
     }
 
 
@@ -322,7 +368,7 @@ static inline pmix_object_t *pmix_obj_new_debug(pmix_class_t* type, const char*
             PMIX_SET_MAGIC_ID((object), 0);                              \
             pmix_obj_run_destructors((pmix_object_t *) (object));       \
             PMIX_REMEMBER_FILE_AND_LINENO( object, __FILE__, __LINE__ ); \
-            free(object);                                               \
+            pmix_obj_free((pmix_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -331,7 +377,7 @@ static inline pmix_object_t *pmix_obj_new_debug(pmix_class_t* type, const char*
     do {                                                                \
         if (0 == pmix_obj_update((pmix_object_t *) (object), -1)) {     \
             pmix_obj_run_destructors((pmix_object_t *) (object));       \
-            free(object);                                               \
+            pmix_obj_free((pmix_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -409,6 +455,32 @@ PMIX_EXPORT void pmix_class_initialize(pmix_class_t *);
  */
 PMIX_EXPORT int pmix_class_finalize(void);
 
+/**
+ * Take an object of a cached class from its free lists, allocating
+ * it if they are empty.
+ *
+ * Do not use this function directly: use PMIX_NEW() instead.
+ */
+PMIX_EXPORT pmix_object_t *pmix_obj_cache_get(pmix_class_t *cls);
+
+/**
+ * Put a destructed object of a cached class on its free lists,
+ * freeing it if they are full.
+ *
+ * Do not use this function directly: use PMIX_RELEASE() instead.
+ */
+PMIX_EXPORT void pmix_obj_cache_put(pmix_object_t *object);
+
+/**
+ * Return the allocation counters of the idx-th cached class in
+ * use. The counters kept by each thread are read while that thread
+ * may still be updating them, so the result is a snapshot, not an
+ * atomic one.
+ *
+ * @return PMIX_SUCCESS, or PMIX_ERR_NOT_FOUND past the last class
+ */
+PMIX_EXPORT int pmix_obj_cache_stats(int idx, pmix_obj_cache_stats_t *stats);
+
 /**
  * Run the hierarchy of class constructors for this object, in a
  * parent-first order.
@@ -472,10 +544,14 @@ static inline pmix_object_t *pmix_obj_new(pmix_class_t * cls)
     pmix_object_t *object;
     assert(cls->cls_sizeof >= sizeof(pmix_object_t));
 
-    object = (pmix_object_t *) malloc(cls->cls_sizeof);
     if (pmix_class_init_epoch != cls->cls_initialized) {
         pmix_class_initialize(cls);
     }
+    if (NULL != cls->cls_cache) {
+        object = pmix_obj_cache_get(cls);
+    } else {
+        object = (pmix_object_t *) malloc(cls->cls_sizeof);
+    }
     if (NULL != object) {
         object->obj_class = cls;
         object->obj_reference_count = 1;
@@ -485,6 +561,23 @@ static inline pmix_object_t *pmix_obj_new(pmix_class_t * cls)
 }
 
 
+/**
+ * Release the storage of a destructed object.
+ *
+ * Do not use this function directly: use PMIX_RELEASE() instead.
+ *
+ * @param object        Pointer to the object
+ */
+static inline void pmix_obj_free(pmix_object_t *object)
+{
+    if (NULL != object->obj_class->cls_cache) {
+        pmix_obj_cache_put(object);
+    } else {
+        free(object);
+    }
+}
+
+
 /**
  * Atomically update the object's reference count by some increment.
  *
@@ -44,6 +44,7 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#include <sys/mman.h>
 
 #include PMIX_EVENT_HEADER
 #ifdef PMIX_EVENT2_THREAD_HEADER
@@ -59,6 +60,7 @@ static pmix_status_t pmix_init_result = PMIX_ERR_INIT;
 #include "src/util/error.h"
 #include "src/util/hash.h"
 #include "src/util/name_fns.h"
+#include "src/util/opstats.h"
 #include "src/util/output.h"
 #include "src/runtime/pmix_progress_threads.h"
 #include "src/runtime/pmix_rte.h"
@@ -852,6 +854,13 @@ PMIX_EXPORT pmix_status_t PMIx_Finalize(const pmix_info_t info[], size_t ninfo)
     }
     PMIX_DESTRUCT(&pmix_client_globals.peers);
 
+    /* release the heartbeat counter shared with our server */
+    if (NULL != pmix_client_globals.hbeat_base) {
+        pmix_client_globals.hbeat = NULL;
+        munmap(pmix_client_globals.hbeat_base, pmix_client_globals.hbeat_size);
+        pmix_client_globals.hbeat_base = NULL;
+    }
+
     if (0 <= pmix_client_globals.myserver->sd) {
         CLOSE_THE_SOCKET(pmix_client_globals.myserver->sd);
     }
@@ -1033,6 +1042,7 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
 {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    uint64_t ts;
 
     pmix_output_verbose(2, pmix_client_globals.base_output,
                         "pmix: executing put for key %s type %d",
@@ -1044,6 +1054,7 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
         return PMIX_ERR_INIT;
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
+    PMIX_OPSTATS_START(ts);
 
     /* create a callback object */
     cb = PMIX_NEW(pmix_cb_t);
@@ -1058,6 +1069,7 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
     PMIX_WAIT_THREAD(&cb->lock);
     rc = cb->pstatus;
     PMIX_RELEASE(cb);
+    PMIX_OPSTATS_STOP(PMIX_OPSTATS_CLIENT_PUT, ts);
 
     return rc;
 }
@@ -1194,6 +1206,7 @@ static void _commitfn(int sd, short args, void *cbdata)
  {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    uint64_t ts;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
     if (pmix_globals.init_cntr <= 0) {
@@ -1211,6 +1224,7 @@ static void _commitfn(int sd, short args, void *cbdata)
         return PMIX_ERR_UNREACH;
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
+    PMIX_OPSTATS_START(ts);
 
     /* create a callback object */
     cb = PMIX_NEW(pmix_cb_t);
@@ -1221,6 +1235,7 @@ static void _commitfn(int sd, short args, void *cbdata)
     PMIX_WAIT_THREAD(&cb->lock);
     rc = cb->pstatus;
     PMIX_RELEASE(cb);
+    PMIX_OPSTATS_STOP(PMIX_OPSTATS_CLIENT_COMMIT, ts);
 
     return rc;
 }
@@ -50,6 +50,7 @@
 #include "src/mca/bfrops/bfrops.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
+#include "src/util/opstats.h"
 #include "src/util/output.h"
 #include "src/threads/threads.h"
 #include "src/mca/gds/gds.h"
@@ -68,6 +69,7 @@ PMIX_EXPORT pmix_status_t PMIx_Connect(const pmix_proc_t procs[], size_t nprocs,
 {
     pmix_status_t rc;
     pmix_cb_t *cb;
+    uint64_t ts;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -85,6 +87,7 @@ PMIX_EXPORT pmix_status_t PMIx_Connect(const pmix_proc_t procs[], size_t nprocs,
         return PMIX_ERR_UNREACH;
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
+    PMIX_OPSTATS_START(ts);
 
     /* create a callback object as we need to pass it to the
      * recv routine so we know which callback to use when
@@ -101,6 +104,7 @@ PMIX_EXPORT pmix_status_t PMIx_Connect(const pmix_proc_t procs[], size_t nprocs,
     PMIX_WAIT_THREAD(&cb->lock);
     rc = cb->status;
     PMIX_RELEASE(cb);
+    PMIX_OPSTATS_STOP(PMIX_OPSTATS_CLIENT_CONNECT, ts);
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix: connect completed");
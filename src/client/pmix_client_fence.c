@@ -50,6 +50,7 @@
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/hash.h"
+#include "src/util/opstats.h"
 #include "src/util/output.h"
 #include "src/mca/ptl/ptl.h"
 
@@ -69,6 +70,7 @@ PMIX_EXPORT pmix_status_t PMIx_Fence(const pmix_proc_t procs[], size_t nprocs,
 {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    uint64_t ts;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -86,6 +88,7 @@ PMIX_EXPORT pmix_status_t PMIx_Fence(const pmix_proc_t procs[], size_t nprocs,
         return PMIX_ERR_UNREACH;
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
+    PMIX_OPSTATS_START(ts);
 
     /* create a callback object as we need to pass it to the
      * recv routine so we know which callback to use when
@@ -104,6 +107,7 @@ PMIX_EXPORT pmix_status_t PMIx_Fence(const pmix_proc_t procs[], size_t nprocs,
     PMIX_WAIT_THREAD(&cb->lock);
     rc = cb->status;
     PMIX_RELEASE(cb);
+    PMIX_OPSTATS_STOP(PMIX_OPSTATS_CLIENT_FENCE, ts);
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix: fence released");
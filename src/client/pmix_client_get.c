@@ -53,8 +53,10 @@
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/hash.h"
+#include "src/util/opstats.h"
 #include "src/util/output.h"
 #include "src/mca/gds/gds.h"
+#include "src/mca/gds/base/base.h"
 #include "src/mca/ptl/ptl.h"
 
 #include "pmix_client_ops.h"
@@ -77,6 +79,9 @@ static pmix_status_t _getfn_fastpath(const pmix_proc_t *proc, const pmix_key_t k
 
 static pmix_status_t process_values(pmix_value_t **v, pmix_cb_t *cb);
 
+static pmix_status_t _getfn_view(const pmix_proc_t *proc, const pmix_key_t key,
+                                 const pmix_info_t info[], size_t ninfo,
+                                 pmix_value_t **val);
 
 PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
                                    const pmix_key_t key,
@@ -85,6 +90,7 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
 {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    uint64_t ts;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -93,6 +99,7 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
         return PMIX_ERR_INIT;
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
+    PMIX_OPSTATS_START(ts);
 
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix:client get for %s:%d key %s",
@@ -100,6 +107,11 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
                         (NULL == proc) ? PMIX_RANK_UNDEF : proc->rank,
                         (NULL == key) ? "NULL" : key);
 
+    /* if requested, see if the value can be shared with the store */
+    if (PMIX_SUCCESS == (rc = _getfn_view(proc, key, info, ninfo, val))) {
+        goto done;
+    }
+
     /* try to get data directly, without threadshift */
     if (PMIX_SUCCESS == (rc = _getfn_fastpath(proc, key, info, ninfo, val))) {
         goto done;
@@ -124,6 +136,7 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
     PMIX_RELEASE(cb);
 
   done:
+    PMIX_OPSTATS_STOP(PMIX_OPSTATS_CLIENT_GET, ts);
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix:client get completed");
 
@@ -206,6 +219,482 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const pmix_key_t
     return PMIX_SUCCESS;
 }
 
+/* define a tracking object for multi-get operations */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_lock_t lock;
+    const pmix_proc_t *procs;
+    pmix_proc_t *myprocs;           // copy of procs with empty nspaces filled in
+    size_t nprocs;
+    const pmix_key_t *keys;
+    size_t nkeys;
+    pmix_info_t *info;
+    size_t ninfo;
+    pmix_value_t *vals;
+    pmix_status_t *status;
+    bool fetched;
+    size_t *missing;                // procs still missing a key
+    size_t nmissing;
+    size_t nreqs;
+    struct pmix_get_multi_req_t *reqs;
+} pmix_get_multi_tracker_t;
+
+/* each entry that has to be requested from the server
+ * needs to point back at its slot in the tracker */
+typedef struct pmix_get_multi_req_t {
+    pmix_get_multi_tracker_t *trk;
+    size_t idx;
+} pmix_get_multi_req_t;
+
+static void gmcon(pmix_get_multi_tracker_t *p)
+{
+    PMIX_CONSTRUCT_LOCK(&p->lock);
+    p->procs = NULL;
+    p->myprocs = NULL;
+    p->nprocs = 0;
+    p->keys = NULL;
+    p->nkeys = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->vals = NULL;
+    p->status = NULL;
+    p->fetched = false;
+    p->missing = NULL;
+    p->nmissing = 0;
+    p->nreqs = 0;
+    p->reqs = NULL;
+}
+static void gmdes(pmix_get_multi_tracker_t *p)
+{
+    PMIX_DESTRUCT_LOCK(&p->lock);
+    if (NULL != p->myprocs) {
+        free(p->myprocs);
+    }
+    if (NULL != p->missing) {
+        free(p->missing);
+    }
+    if (NULL != p->reqs) {
+        free(p->reqs);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_multi_tracker_t,
+                           pmix_object_t,
+                           gmcon, gmdes);
+
+static void _getmulti_complete(pmix_get_multi_tracker_t *trk)
+{
+    trk->nreqs--;
+    if (0 == trk->nreqs) {
+        PMIX_POST_OBJECT(trk);
+        PMIX_WAKEUP_THREAD(&trk->lock);
+    }
+}
+
+static void _getmulti_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+{
+    pmix_get_multi_req_t *req = (pmix_get_multi_req_t*)cbdata;
+    pmix_get_multi_tracker_t *trk = req->trk;
+    pmix_status_t rc;
+
+    trk->status[req->idx] = status;
+    if (PMIX_SUCCESS == status && NULL != kv) {
+        if (PMIX_SUCCESS != (rc = pmix_value_xfer(&trk->vals[req->idx], kv))) {
+            PMIX_ERROR_LOG(rc);
+            trk->status[req->idx] = rc;
+        }
+    }
+    _getmulti_complete(trk);
+}
+
+/* servers that can't take a multi-get are asked for each
+ * proc on its own - requests for the same proc are coalesced
+ * into a single message to the server */
+static void _getmulti_singles(pmix_get_multi_tracker_t *trk)
+{
+    pmix_cb_t *cb;
+    size_t n, p, k;
+
+    trk->reqs = (pmix_get_multi_req_t*)calloc(trk->nprocs * trk->nkeys,
+                                              sizeof(pmix_get_multi_req_t));
+    if (NULL == trk->reqs) {
+        PMIX_POST_OBJECT(trk);
+        PMIX_WAKEUP_THREAD(&trk->lock);
+        return;
+    }
+    /* hold a reference of our own so the tracker can't complete
+     * while we are still issuing requests */
+    trk->nreqs = 1;
+    for (n=0; n < trk->nprocs * trk->nkeys; n++) {
+        if (PMIX_SUCCESS == trk->status[n]) {
+            continue;
+        }
+        p = n / trk->nkeys;
+        k = n % trk->nkeys;
+        trk->reqs[n].trk = trk;
+        trk->reqs[n].idx = n;
+        cb = PMIX_NEW(pmix_cb_t);
+        cb->pname.nspace = strdup(trk->procs[p].nspace);
+        cb->pname.rank = trk->procs[p].rank;
+        cb->key = (char*)trk->keys[k];
+        cb->info = trk->info;
+        cb->ninfo = trk->ninfo;
+        cb->cbfunc.valuefn = _getmulti_cbfunc;
+        cb->cbdata = &trk->reqs[n];
+        trk->nreqs++;
+        /* we are already in the progress thread */
+        _getnbfn(0, 0, cb);
+    }
+    _getmulti_complete(trk);
+}
+
+/* pick up the keys of a proc whose data the server returned */
+static void _getmulti_fill(pmix_get_multi_tracker_t *trk, size_t p, pmix_status_t ret)
+{
+    pmix_cb_t cb;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    size_t k, n;
+
+    for (k=0; k < trk->nkeys; k++) {
+        n = p * trk->nkeys + k;
+        if (PMIX_SUCCESS == trk->status[n]) {
+            continue;
+        }
+        if (PMIX_SUCCESS != ret) {
+            trk->status[n] = ret;
+            continue;
+        }
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        cb.proc = (pmix_proc_t*)&trk->procs[p];
+        cb.key = (char*)trk->keys[k];
+        cb.scope = PMIX_SCOPE_UNDEF;
+        cb.copy = true;
+        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
+        if (PMIX_SUCCESS == rc) {
+            if (1 != pmix_list_get_size(&cb.kvs)) {
+                rc = PMIX_ERR_INVALID_VAL;
+            } else {
+                kv = (pmix_kval_t*)pmix_list_get_first(&cb.kvs);
+                rc = pmix_value_xfer(&trk->vals[n], kv->value);
+            }
+        }
+        trk->status[n] = rc;
+        PMIX_DESTRUCT(&cb);
+    }
+}
+
+/* this callback is coming from the ptl recv, and thus
+ * is occurring inside of our progress thread */
+static void _getmulti_recv(struct pmix_peer_t *pr,
+                           pmix_ptl_hdr_t *hdr,
+                           pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_get_multi_tracker_t *trk = (pmix_get_multi_tracker_t*)cbdata;
+    pmix_byte_object_t bo;
+    pmix_buffer_t pbkt;
+    pmix_status_t rc, ret;
+    int32_t cnt;
+    size_t m;
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix: get multi callback recvd");
+
+    /* a zero-byte buffer indicates that this recv is being
+     * completed due to a lost connection */
+    if (PMIX_BUFFER_IS_EMPTY(buf)) {
+        ret = PMIX_ERR_UNREACH;
+        m = 0;
+        goto done;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver,
+                       buf, &ret, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = rc;
+    }
+    if (PMIX_ERR_NOT_SUPPORTED == ret) {
+        _getmulti_singles(trk);
+        return;
+    }
+
+    /* each proc's data comes back as the blob a single get returns */
+    for (m=0; PMIX_SUCCESS == ret && m < trk->nmissing; m++) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver,
+                           buf, &ret, &cnt, PMIX_STATUS);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver,
+                               buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = rc;
+            break;
+        }
+        if (PMIX_SUCCESS == ret && 0 < bo.size) {
+            PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+            PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &pbkt, bo.bytes, bo.size);
+            /* as with a single get, whatever made it into the
+             * store is picked up below */
+            PMIX_GDS_ACCEPT_KVS_RESP(rc, pmix_client_globals.myserver, &pbkt);
+            PMIX_DESTRUCT(&pbkt);
+        } else {
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        }
+        _getmulti_fill(trk, trk->missing[m], ret);
+        ret = PMIX_SUCCESS;
+    }
+
+  done:
+    /* anything we didn't get an answer for fails with the error */
+    for (; m < trk->nmissing; m++) {
+        _getmulti_fill(trk, trk->missing[m], ret);
+    }
+    PMIX_POST_OBJECT(trk);
+    PMIX_WAKEUP_THREAD(&trk->lock);
+}
+
+/* ask the server for the data of all procs still missing a key
+ * in a single request */
+static pmix_status_t _getmulti_request(pmix_get_multi_tracker_t *trk)
+{
+    pmix_cmd_t cmd = PMIX_GETNB_MULTI_CMD;
+    pmix_buffer_t *msg;
+    pmix_proc_t *procs;
+    pmix_status_t rc;
+    size_t n, p, k;
+
+    trk->missing = (size_t*)malloc(trk->nprocs * sizeof(size_t));
+    if (NULL == trk->missing) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (p=0; p < trk->nprocs; p++) {
+        for (k=0; k < trk->nkeys; k++) {
+            if (PMIX_SUCCESS != trk->status[p * trk->nkeys + k]) {
+                trk->missing[trk->nmissing++] = p;
+                break;
+            }
+        }
+    }
+    if (0 == trk->nmissing) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    PMIX_PROC_CREATE(procs, trk->nmissing);
+    if (NULL == procs) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n=0; n < trk->nmissing; n++) {
+        memcpy(&procs[n], &trk->procs[trk->missing[n]], sizeof(pmix_proc_t));
+    }
+
+    msg = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                     msg, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         msg, &trk->nmissing, 1, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         msg, procs, trk->nmissing, PMIX_PROC);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         msg, &trk->ninfo, 1, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS == rc && 0 < trk->ninfo) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         msg, trk->info, trk->ninfo, PMIX_INFO);
+    }
+    PMIX_PROC_FREE(procs, trk->nmissing);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+        return rc;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "%s:%d REQUESTING DATA FROM SERVER FOR %lu PROCS",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        (unsigned long)trk->nmissing);
+    PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, _getmulti_recv, (void*)trk);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(msg);
+    }
+    return rc;
+}
+
+static void _getmultifn(int fd, short flags, void *cbdata)
+{
+    pmix_get_multi_tracker_t *trk = (pmix_get_multi_tracker_t*)cbdata;
+    pmix_status_t rc;
+    size_t n;
+
+    PMIX_ACQUIRE_OBJECT(trk);
+
+    /* if the store couldn't be read from the caller's thread,
+     * then take the single pass over it from here */
+    if (!trk->fetched) {
+        PMIX_GDS_FETCH_MULTI(rc, pmix_client_globals.myserver,
+                             trk->procs, trk->nprocs, trk->keys, trk->nkeys,
+                             trk->vals, trk->status);
+        if (PMIX_SUCCESS == rc) {
+            goto done;
+        }
+    }
+
+    /* only a connected client can ask its server, and the caller
+     * may not want us to */
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) || !pmix_globals.connected) {
+        goto done;
+    }
+    for (n=0; n < trk->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&trk->info[n], PMIX_OPTIONAL) &&
+            PMIX_INFO_TRUE(&trk->info[n])) {
+            goto done;
+        }
+    }
+    if (PMIX_SUCCESS == _getmulti_request(trk)) {
+        return;
+    }
+
+  done:
+    PMIX_POST_OBJECT(trk);
+    PMIX_WAKEUP_THREAD(&trk->lock);
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], size_t nprocs,
+                                         const pmix_key_t keys[], size_t nkeys,
+                                         const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t **vals, pmix_status_t status[])
+{
+    pmix_get_multi_tracker_t *trk;
+    pmix_status_t rc;
+    size_t n;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == procs || 0 == nprocs || NULL == keys || 0 == nkeys ||
+        NULL == vals || NULL == status) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get multi for %lu procs %lu keys",
+                        (unsigned long)nprocs, (unsigned long)nkeys);
+
+    if (NULL == *vals) {
+        PMIX_VALUE_CREATE(*vals, nprocs * nkeys);
+        if (NULL == *vals) {
+            return PMIX_ERR_NOMEM;
+        }
+    } else {
+        for (n=0; n < nprocs * nkeys; n++) {
+            PMIX_VALUE_CONSTRUCT(&(*vals)[n]);
+        }
+    }
+    for (n=0; n < nprocs * nkeys; n++) {
+        status[n] = PMIX_ERR_NOT_FOUND;
+    }
+
+    trk = PMIX_NEW(pmix_get_multi_tracker_t);
+    trk->procs = procs;
+    trk->nprocs = nprocs;
+    /* as with PMIx_Get, an empty nspace refers to our own - fill
+     * it in so the store can be searched for those procs too */
+    for (n=0; n < nprocs; n++) {
+        if (0 == strlen(procs[n].nspace)) {
+            break;
+        }
+    }
+    if (n < nprocs) {
+        trk->myprocs = (pmix_proc_t*)malloc(nprocs * sizeof(pmix_proc_t));
+        if (NULL == trk->myprocs) {
+            PMIX_RELEASE(trk);
+            return PMIX_ERR_NOMEM;
+        }
+        memcpy(trk->myprocs, procs, nprocs * sizeof(pmix_proc_t));
+        for (; n < nprocs; n++) {
+            if (0 == strlen(trk->myprocs[n].nspace)) {
+                PMIX_LOAD_NSPACE(trk->myprocs[n].nspace, pmix_globals.myid.nspace);
+            }
+        }
+        trk->procs = trk->myprocs;
+    }
+    trk->keys = keys;
+    trk->nkeys = nkeys;
+    trk->info = (pmix_info_t*)info;
+    trk->ninfo = ninfo;
+    trk->vals = *vals;
+    trk->status = status;
+
+    /* take whatever is already in the shared store in a single
+     * pass, without threadshift, if the module allows it */
+    PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_client_globals.myserver);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_GDS_FETCH_MULTI(rc, pmix_client_globals.myserver,
+                             trk->procs, nprocs, keys, nkeys, *vals, status);
+        if (PMIX_SUCCESS == rc) {
+            goto done;
+        }
+        trk->fetched = true;
+    }
+
+    /* threadshift to pick up the rest */
+    PMIX_THREADSHIFT(trk, _getmultifn);
+    PMIX_WAIT_THREAD(&trk->lock);
+
+  done:
+    PMIX_RELEASE(trk);
+    rc = PMIX_SUCCESS;
+    for (n=0; n < nprocs * nkeys; n++) {
+        /* the values live in the caller's array, so uncompress
+         * any strings in place */
+        if (PMIX_SUCCESS == status[n] &&
+            PMIX_COMPRESSED_STRING == (*vals)[n].type) {
+            char *tmp;
+            pmix_compress.decompress_string(&tmp, (uint8_t*)(*vals)[n].data.bo.bytes,
+                                            (*vals)[n].data.bo.size);
+            if (NULL == tmp) {
+                PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+                status[n] = PMIX_ERR_NOMEM;
+            } else {
+                PMIX_VALUE_DESTRUCT(&(*vals)[n]);
+                (*vals)[n].data.string = tmp;
+                (*vals)[n].type = PMIX_STRING;
+            }
+        }
+        if (PMIX_SUCCESS != status[n] && PMIX_SUCCESS == rc) {
+            rc = status[n];
+        }
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get multi completed");
+
+    return rc;
+}
+
+PMIX_EXPORT void PMIx_Value_release_view(pmix_value_t *val)
+{
+    if (NULL == val) {
+        return;
+    }
+    /* values that couldn't be returned as views are our own copies */
+    if (!pmix_gds_base_view_release(val)) {
+        PMIX_VALUE_RELEASE(val);
+    }
+}
+
 static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
@@ -532,6 +1021,72 @@ static pmix_status_t _getfn_fastpath(const pmix_proc_t *proc, const pmix_key_t k
     return rc;
 }
 
+static void _getviewfn(int fd, short flags, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(cb);
+    PMIX_GDS_FETCH_VIEW(cb->status, pmix_client_globals.myserver,
+                        cb->proc, cb->key, &cb->value);
+    PMIX_POST_OBJECT(cb);
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+static pmix_status_t _getfn_view(const pmix_proc_t *proc, const pmix_key_t key,
+                                 const pmix_info_t info[], size_t ninfo,
+                                 pmix_value_t **val)
+{
+    pmix_cb_t *cb;
+    pmix_proc_t p;
+    pmix_status_t rc;
+    bool pntrs = false;
+    size_t n;
+
+    if (NULL != info) {
+        for (n=0; n < ninfo; n++) {
+            if (0 == strncmp(info[n].key, PMIX_GET_POINTER_VALUES, PMIX_MAX_KEYLEN)) {
+                pntrs = PMIX_INFO_TRUE(&info[n]);
+                break;
+            }
+        }
+    }
+    /* views are only available to clients of a server, and our own
+     * data lives in our local store anyway */
+    if (!pntrs || NULL == proc || NULL == key || NULL == val ||
+        !PMIX_PROC_IS_CLIENT(pmix_globals.mypeer) ||
+        PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    if (0 == strlen(proc->nspace)) {
+        pmix_strncpy(p.nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN);
+    } else {
+        pmix_strncpy(p.nspace, proc->nspace, PMIX_MAX_NSLEN);
+    }
+    p.rank = proc->rank;
+    if (PMIX_CHECK_NSPACE(p.nspace, pmix_globals.myid.nspace) &&
+        p.rank == pmix_globals.myid.rank) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_client_globals.myserver);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_GDS_FETCH_VIEW(rc, pmix_client_globals.myserver, &p, key, val);
+        return rc;
+    }
+
+    /* the store has to be accessed from the progress thread */
+    cb = PMIX_NEW(pmix_cb_t);
+    cb->proc = &p;
+    cb->key = (char*)key;
+    PMIX_THREADSHIFT(cb, _getviewfn);
+    PMIX_WAIT_THREAD(&cb->lock);
+    rc = cb->status;
+    *val = cb->value;
+    cb->value = NULL;
+    PMIX_RELEASE(cb);
+    return rc;
+}
+
 static void _getnbfn(int fd, short flags, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
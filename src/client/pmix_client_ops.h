@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -13,6 +13,7 @@
 #include <src/include/pmix_config.h>
 
 
+#include "src/atomics/sys/atomic.h"
 #include "src/threads/threads.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_pointer_array.h"
@@ -52,6 +53,10 @@ typedef struct {
     /* IOF output sinks */
     pmix_iof_sink_t iof_stdout;
     pmix_iof_sink_t iof_stderr;
+    /* heartbeat counter in the page shared with our server */
+    unsigned char *hbeat_base;
+    size_t hbeat_size;
+    pmix_atomic_int64_t *hbeat;
 } pmix_client_globals_t;
 
 PMIX_EXPORT extern pmix_client_globals_t pmix_client_globals;
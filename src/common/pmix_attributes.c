@@ -459,6 +459,7 @@ static pmix_regattr_input_t server_attributes[] = {
         {.name = ""},
     // query
         {.name = "PMIX_QUERY_REFRESH_CACHE", .string = PMIX_QUERY_REFRESH_CACHE, .type = PMIX_BOOL, .description = (char *[]){"True,False", NULL}},
+        {.name = "PMIX_QUERY_CACHE_TTL", .string = PMIX_QUERY_CACHE_TTL, .type = PMIX_UINT32, .description = (char *[]){"UNSIGNED INT32", NULL}},
         {.name = "PMIX_PROCID", .string = PMIX_PROCID, .type = PMIX_PROC, .description = (char *[]){"pmix_proc_t*", NULL}},
         {.name = "PMIX_NSPACE", .string = PMIX_NSPACE, .type = PMIX_STRING, .description = (char *[]){"UNRESTRICTED", NULL}},
         {.name = "PMIX_RANK", .string = PMIX_RANK, .type = PMIX_PROC_RANK, .description = (char *[]){"UNSIGNED INT32", NULL}},
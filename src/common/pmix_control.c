@@ -1,6 +1,6 @@
 /* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
 /*
- * Copyright (c) 2014-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2016      Mellanox Technologies, Inc.
  *                         All rights reserved.
  * Copyright (c) 2016      IBM Corporation.  All rights reserved.
@@ -22,6 +22,13 @@
 #include <pmix_server.h>
 #include <pmix_rename.h>
 
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <sys/mman.h>
+
+#include "src/atomics/sys/atomic.h"
 #include "src/threads/threads.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
@@ -46,6 +53,49 @@ static void relcbfunc(void *cbdata)
     }
     PMIX_RELEASE(cd);
 }
+/* map the heartbeat counter our server assigned to us */
+static void heartbeat_attach(pmix_info_t *info, size_t ninfo)
+{
+#if PMIX_HAVE_ATOMIC_MATH_64
+    char *path = NULL;
+    uint32_t slot = UINT32_MAX;
+    size_t n, size;
+    void *base;
+    int fd;
+
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_HEARTBEAT_SEGMENT)) {
+            path = info[n].value.data.string;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_HEARTBEAT_SLOT)) {
+            slot = info[n].value.data.uint32;
+        }
+    }
+    /* the slot belongs to our connection, so once we have
+     * it there is nothing more to do */
+    if (NULL == path || UINT32_MAX == slot ||
+        NULL != pmix_client_globals.hbeat_base) {
+        return;
+    }
+    if (0 > (fd = open(path, O_RDWR))) {
+        pmix_output_verbose(2, pmix_client_globals.base_output,
+                            "pmix:monitor cannot open heartbeat page %s - sending beats",
+                            path);
+        return;
+    }
+    size = ((size_t)slot + 1) * PMIX_HEARTBEAT_SLOT_SIZE;
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        return;
+    }
+    pmix_client_globals.hbeat_base = (unsigned char*)base;
+    pmix_client_globals.hbeat_size = size;
+    pmix_atomic_wmb();
+    pmix_client_globals.hbeat = (pmix_atomic_int64_t*)(pmix_client_globals.hbeat_base +
+                                                       (size_t)slot * PMIX_HEARTBEAT_SLOT_SIZE);
+#endif
+}
+
 static void query_cbfunc(struct pmix_peer_t *peer,
                          pmix_ptl_hdr_t *hdr,
                          pmix_buffer_t *buf, void *cbdata)
@@ -98,6 +148,8 @@ static void query_cbfunc(struct pmix_peer_t *peer,
             PMIX_ERROR_LOG(rc);
             goto complete;
         }
+        /* a heartbeat monitor may have given us a counter to use */
+        heartbeat_attach(results->info, results->ninfo);
     }
 
   complete:
@@ -366,6 +418,13 @@ PMIX_EXPORT pmix_status_t PMIx_Process_monitor_nb(const pmix_info_t *monitor, pm
 
     /* if the monitor is PMIX_SEND_HEARTBEAT, then send it */
     if (0 == strncmp(monitor->key, PMIX_SEND_HEARTBEAT, PMIX_MAX_KEYLEN)) {
+#if PMIX_HAVE_ATOMIC_MATH_64
+        /* if our server gave us a counter, then just bump it */
+        if (NULL != pmix_client_globals.hbeat) {
+            (void)pmix_atomic_fetch_add_64(pmix_client_globals.hbeat, 1);
+            return PMIX_SUCCESS;
+        }
+#endif
         msg = PMIX_NEW(pmix_buffer_t);
         if (NULL == msg) {
             return PMIX_ERR_NOMEM;
@@ -22,19 +22,358 @@
 #include <pmix_server.h>
 #include <pmix_rename.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/threads/threads.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/name_fns.h"
+#include "src/util/opstats.h"
 #include "src/util/output.h"
 #include "src/mca/bfrops/bfrops.h"
+#include "src/mca/psec/base/base.h"
 #include "src/mca/ptl/ptl.h"
 #include "src/common/pmix_attributes.h"
+#include "src/common/pmix_query.h"
 
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/include/pmix_globals.h"
 
+/* an answer held in the query cache */
+typedef struct {
+    pmix_list_item_t super;
+    char *key;
+    time_t expires;
+    pmix_info_t *info;
+    size_t ninfo;
+} pmix_query_cache_t;
+static void qccon(pmix_query_cache_t *p)
+{
+    p->key = NULL;
+    p->expires = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+}
+static void qcdes(pmix_query_cache_t *p)
+{
+    if (NULL != p->key) {
+        free(p->key);
+    }
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_query_cache_t,
+                           pmix_list_item_t,
+                           qccon, qcdes);
+
+/* the cache is used from the caller's thread as well as our
+ * progress thread, so it has to be protected */
+static pmix_mutex_t qcache_lock = PMIX_MUTEX_STATIC_INIT;
+static bool qcache_init = false;
+static pmix_hash_table_t qcache_index;
+/* entries in the order they were stored, oldest first */
+static pmix_list_t qcache_entries;
+
+/* keys whose answers change from one moment to the next, or
+ * depend on who is asking */
+static const char *uncacheable_keys[] = {
+    PMIX_QUERY_OP_STATS,
+    PMIX_QUERY_ALLOC_STATS,
+    PMIX_QUERY_SERVER_STATS,
+    PMIX_QUERY_PSEC_CACHE_STATS,
+    PMIX_QUERY_MEMORY_USAGE,
+    PMIX_QUERY_AUTHORIZATIONS,
+    PMIX_TIME_REMAINING,
+    NULL
+};
+
+/* keys whose answers change as nspaces come and go - only a server
+ * sees that happen and drops its cache, so nobody else caches them */
+static const char *nspace_keys[] = {
+    PMIX_QUERY_NAMESPACES,
+    PMIX_QUERY_NAMESPACE_INFO,
+    PMIX_QUERY_PROC_TABLE,
+    PMIX_QUERY_LOCAL_PROC_TABLE,
+    NULL
+};
+
+static int sort_strings(const void *a, const void *b)
+{
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/* print a qualifier in a form that identifies its value,
+ * returning NULL if it is of a type we don't handle */
+static char* qualifier_string(const pmix_info_t *info)
+{
+    const pmix_value_t *val = &info->value;
+    char *str = NULL;
+    int rc;
+
+    switch (val->type) {
+        case PMIX_BOOL:
+            rc = asprintf(&str, "%s=b:%d", info->key, val->data.flag ? 1 : 0);
+            break;
+        case PMIX_STRING:
+            rc = asprintf(&str, "%s=s:%s", info->key,
+                          (NULL == val->data.string) ? "" : val->data.string);
+            break;
+        case PMIX_INT:
+            rc = asprintf(&str, "%s=i:%d", info->key, val->data.integer);
+            break;
+        case PMIX_INT32:
+            rc = asprintf(&str, "%s=i:%d", info->key, (int)val->data.int32);
+            break;
+        case PMIX_STATUS:
+            rc = asprintf(&str, "%s=i:%d", info->key, (int)val->data.status);
+            break;
+        case PMIX_UINT32:
+            rc = asprintf(&str, "%s=u:%u", info->key, (unsigned)val->data.uint32);
+            break;
+        case PMIX_SIZE:
+            rc = asprintf(&str, "%s=u:%lu", info->key, (unsigned long)val->data.size);
+            break;
+        case PMIX_PID:
+            rc = asprintf(&str, "%s=u:%lu", info->key, (unsigned long)val->data.pid);
+            break;
+        case PMIX_PROC_RANK:
+            rc = asprintf(&str, "%s=r:%u", info->key, (unsigned)val->data.rank);
+            break;
+        case PMIX_PROC:
+            if (NULL == val->data.proc) {
+                return NULL;
+            }
+            rc = asprintf(&str, "%s=p:%s.%u", info->key, val->data.proc->nspace,
+                          (unsigned)val->data.proc->rank);
+            break;
+        default:
+            return NULL;
+    }
+    return (0 > rc) ? NULL : str;
+}
+
+char* pmix_query_cache_key(const pmix_query_t queries[], size_t nqueries,
+                           const char *nspace, uint32_t uid,
+                           uint32_t *ttl, bool *refresh)
+{
+    char **qstrs = NULL, **parts = NULL, *str, *key = NULL;
+    uint32_t qttl, minttl = UINT32_MAX;
+    size_t n, p, k;
+    bool server = PMIX_PROC_IS_SERVER(pmix_globals.mypeer);
+
+    *refresh = false;
+    for (n=0; n < nqueries; n++) {
+        parts = NULL;
+        qttl = (0 < pmix_globals.query_cache_ttl) ? (uint32_t)pmix_globals.query_cache_ttl : 0;
+        for (p=0; NULL != queries[n].keys && NULL != queries[n].keys[p]; p++) {
+            for (k=0; NULL != uncacheable_keys[k]; k++) {
+                if (0 == strcmp(queries[n].keys[p], uncacheable_keys[k])) {
+                    goto nocache;
+                }
+            }
+            for (k=0; !server && NULL != nspace_keys[k]; k++) {
+                if (0 == strcmp(queries[n].keys[p], nspace_keys[k])) {
+                    goto nocache;
+                }
+            }
+            pmix_argv_append_nosize(&parts, queries[n].keys[p]);
+        }
+        if (NULL == parts) {
+            goto nocache;
+        }
+        /* the keys are answered together, so their order
+         * doesn't matter */
+        qsort(parts, pmix_argv_count(parts), sizeof(char*), sort_strings);
+        k = pmix_argv_count(parts);
+        for (p=0; p < queries[n].nqual; p++) {
+            if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_QUERY_CACHE_TTL)) {
+                if (PMIX_UINT32 != queries[n].qualifiers[p].value.type) {
+                    goto nocache;
+                }
+                qttl = queries[n].qualifiers[p].value.data.uint32;
+                continue;
+            }
+            if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_QUERY_REFRESH_CACHE)) {
+                *refresh = *refresh || PMIX_INFO_TRUE(&queries[n].qualifiers[p]);
+                continue;
+            }
+            if (NULL == (str = qualifier_string(&queries[n].qualifiers[p]))) {
+                goto nocache;
+            }
+            pmix_argv_append_nosize(&parts, str);
+            free(str);
+        }
+        qsort(parts + k, pmix_argv_count(parts) - k, sizeof(char*), sort_strings);
+        if (0 == qttl) {
+            /* this query didn't ask to be cached */
+            goto nocache;
+        }
+        if (qttl < minttl) {
+            minttl = qttl;
+        }
+        str = pmix_argv_join(parts, '|');
+        pmix_argv_free(parts);
+        pmix_argv_append_nosize(&qstrs, str);
+        free(str);
+    }
+    if (NULL == qstrs) {
+        return NULL;
+    }
+    /* the answers to all the queries come back as one
+     * array, so their order doesn't matter either */
+    qsort(qstrs, pmix_argv_count(qstrs), sizeof(char*), sort_strings);
+    str = pmix_argv_join(qstrs, ';');
+    pmix_argv_free(qstrs);
+    /* answers such as the job size depend on who asked, so
+     * only share them with the same nspace and user */
+    if (0 > asprintf(&key, "%s:%u#%s", nspace, (unsigned)uid, str)) {
+        key = NULL;
+    }
+    free(str);
+    *ttl = minttl;
+    return key;
+
+  nocache:
+    pmix_argv_free(parts);
+    pmix_argv_free(qstrs);
+    return NULL;
+}
+
+static void cache_remove(pmix_query_cache_t *qc)
+{
+    pmix_hash_table_remove_value_ptr(&qcache_index, qc->key, strlen(qc->key));
+    pmix_list_remove_item(&qcache_entries, &qc->super);
+    PMIX_RELEASE(qc);
+}
+
+pmix_status_t pmix_query_cache_fetch(const char *key,
+                                     pmix_info_t **info, size_t *ninfo)
+{
+    pmix_query_cache_t *qc;
+    pmix_status_t rc = PMIX_ERR_NOT_FOUND;
+    void *ptr;
+    size_t n;
+
+    pmix_mutex_lock(&qcache_lock);
+    if (!qcache_init ||
+        PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&qcache_index, key, strlen(key), &ptr)) {
+        goto done;
+    }
+    qc = (pmix_query_cache_t*)ptr;
+    if (qc->expires <= time(NULL)) {
+        cache_remove(qc);
+        goto done;
+    }
+    *info = NULL;
+    *ninfo = qc->ninfo;
+    if (0 < qc->ninfo) {
+        PMIX_INFO_CREATE(*info, qc->ninfo);
+        if (NULL == *info) {
+            rc = PMIX_ERR_NOMEM;
+            goto done;
+        }
+        for (n=0; n < qc->ninfo; n++) {
+            PMIX_INFO_XFER(&(*info)[n], &qc->info[n]);
+        }
+    }
+    rc = PMIX_SUCCESS;
+
+  done:
+    pmix_mutex_unlock(&qcache_lock);
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:query cache %s for %s",
+                        (PMIX_SUCCESS == rc) ? "hit" : "miss", key);
+    return rc;
+}
+
+void pmix_query_cache_store(const char *key, uint32_t ttl,
+                            const pmix_info_t *info, size_t ninfo)
+{
+    pmix_query_cache_t *qc;
+    void *ptr;
+    size_t n;
+
+    if (0 >= pmix_globals.query_cache_size) {
+        return;
+    }
+    qc = PMIX_NEW(pmix_query_cache_t);
+    qc->key = strdup(key);
+    qc->expires = time(NULL) + ttl;
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(qc->info, ninfo);
+        if (NULL == qc->info) {
+            PMIX_RELEASE(qc);
+            return;
+        }
+        qc->ninfo = ninfo;
+        for (n=0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&qc->info[n], (pmix_info_t*)&info[n]);
+        }
+    }
+
+    pmix_mutex_lock(&qcache_lock);
+    if (!qcache_init) {
+        PMIX_CONSTRUCT(&qcache_index, pmix_hash_table_t);
+        pmix_hash_table_init(&qcache_index, 64);
+        PMIX_CONSTRUCT(&qcache_entries, pmix_list_t);
+        qcache_init = true;
+    }
+    /* replace any answer we already have */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&qcache_index, key, strlen(key), &ptr)) {
+        cache_remove((pmix_query_cache_t*)ptr);
+    }
+    /* make room by dropping the oldest */
+    while ((int)pmix_list_get_size(&qcache_entries) >= pmix_globals.query_cache_size) {
+        cache_remove((pmix_query_cache_t*)pmix_list_get_first(&qcache_entries));
+    }
+    pmix_hash_table_set_value_ptr(&qcache_index, qc->key, strlen(qc->key), qc);
+    pmix_list_append(&qcache_entries, &qc->super);
+    pmix_mutex_unlock(&qcache_lock);
+}
+
+void pmix_query_cache_flush(void)
+{
+    pmix_query_cache_t *qc;
+
+    pmix_mutex_lock(&qcache_lock);
+    if (qcache_init) {
+        while (NULL != (qc = (pmix_query_cache_t*)pmix_list_remove_first(&qcache_entries))) {
+            PMIX_RELEASE(qc);
+        }
+        pmix_hash_table_remove_all(&qcache_index);
+    }
+    pmix_mutex_unlock(&qcache_lock);
+}
+
+void pmix_query_cache_event(pmix_status_t status)
+{
+    switch (status) {
+        case PMIX_ERR_JOB_TERMINATED:
+        case PMIX_PROC_TERMINATED:
+        case PMIX_ERR_PROC_ABORTED:
+        case PMIX_ERR_PROC_ABORTING:
+        case PMIX_NOTIFY_ALLOC_COMPLETE:
+        case PMIX_ERR_NODE_DOWN:
+        case PMIX_ERR_NODE_OFFLINE:
+            pmix_query_cache_flush();
+            break;
+        default:
+            break;
+    }
+}
+
+void pmix_query_cache_finalize(void)
+{
+    pmix_mutex_lock(&qcache_lock);
+    if (qcache_init) {
+        PMIX_LIST_DESTRUCT(&qcache_entries);
+        PMIX_DESTRUCT(&qcache_index);
+        qcache_init = false;
+    }
+    pmix_mutex_unlock(&qcache_lock);
+}
+
 static void relcbfunc(void *cbdata)
 {
     pmix_shift_caddy_t *cd = (pmix_shift_caddy_t*)cbdata;
@@ -42,7 +381,8 @@ static void relcbfunc(void *cbdata)
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix:query release callback");
 
-    if (NULL != cd->info) {
+    /* info held in an arena is released along with the caddy */
+    if (NULL != cd->info && NULL == cd->arena) {
         PMIX_INFO_FREE(cd->info, cd->ninfo);
     }
     PMIX_RELEASE(cd);
@@ -63,6 +403,15 @@ static void query_cbfunc(struct pmix_peer_t *peer,
 
     results = PMIX_NEW(pmix_shift_caddy_t);
 
+    /* the results are only lent to the caller until it calls
+     * relcbfunc, so unpack them into an arena that can be
+     * dropped in one shot */
+    PMIX_BFROPS_USE_ARENA(peer, buf);
+    if (NULL != buf->arena) {
+        results->arena = buf->arena;
+        PMIX_RETAIN(results->arena);
+    }
+
     /* unpack the status */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &results->status, &cnt, PMIX_STATUS);
@@ -84,7 +433,12 @@ static void query_cbfunc(struct pmix_peer_t *peer,
         goto complete;
     }
     if (0 < results->ninfo) {
-        PMIX_INFO_CREATE(results->info, results->ninfo);
+        PMIX_BFROPS_ALLOC(results->info, buf, results->ninfo, pmix_info_t);
+        if (NULL == results->info) {
+            results->status = PMIX_ERR_NOMEM;
+            results->ninfo = 0;
+            goto complete;
+        }
         cnt = results->ninfo;
         PMIX_BFROPS_UNPACK(rc, peer, buf, results->info, &cnt, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
@@ -106,6 +460,10 @@ static void query_cbfunc(struct pmix_peer_t *peer,
             PMIX_RELEASE(kv);  // maintain accounting
         }
     }
+    if (NULL != cd->cache_key) {
+        pmix_query_cache_store(cd->cache_key, cd->cache_ttl,
+                               results->info, results->ninfo);
+    }
 
   complete:
     pmix_output_verbose(2, pmix_globals.debug_output,
@@ -133,6 +491,51 @@ static void _local_cbfunc(int sd, short args, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+/* cache the host's answer to a server's own queries on the
+ * way back to the caller */
+static void cache_cbfunc(pmix_status_t status,
+                         pmix_info_t *info, size_t ninfo,
+                         void *cbdata,
+                         pmix_release_cbfunc_t release_fn,
+                         void *release_cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t*)cbdata;
+
+    if (PMIX_SUCCESS == status) {
+        pmix_query_cache_store(cd->cache_key, cd->cache_ttl, info, ninfo);
+    }
+    if (NULL != cd->cbfunc) {
+        cd->cbfunc(status, info, ninfo, cd->cbdata, release_fn, release_cbdata);
+    } else if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    PMIX_RELEASE(cd);
+}
+
+/* the last of the results has been left for the server's
+ * stats, which can only be read in the progress thread */
+static void _server_stats(int sd, short args, void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t*)cbdata;
+    pmix_kval_t *kv;
+
+    if (PMIX_SUCCESS != cd->status) {
+        /* nothing to add to */
+    } else if (NULL == (kv = pmix_server_stats_report())) {
+        cd->status = PMIX_ERR_NOMEM;
+    } else {
+        PMIX_LOAD_KEY(cd->info[cd->ninfo-1].key, kv->key);
+        cd->status = pmix_value_xfer(&cd->info[cd->ninfo-1].value, kv->value);
+        PMIX_RELEASE(kv);
+    }
+    if (PMIX_SUCCESS != cd->status && NULL != cd->info) {
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+        cd->info = NULL;
+        cd->ninfo = 0;
+    }
+    _local_cbfunc(sd, args, cd);
+}
+
 PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nqueries,
                                              pmix_info_cbfunc_t cbfunc, void *cbdata)
 
@@ -146,6 +549,9 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     pmix_list_t results;
     pmix_kval_t *kv, *kvnxt;
     pmix_proc_t proc;
+    bool local, refresh, stats = false;
+    char *cachekey;
+    uint32_t ttl = 0;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -207,8 +613,11 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
             PMIX_RELEASE_THREAD(&pmix_global_lock);
             return PMIX_SUCCESS;
         }
+        local = false;
         for (p=0; p < queries[n].nqual; p++) {
-            if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_QUERY_REFRESH_CACHE)) {
+            if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_QUERY_LOCAL_ONLY)) {
+                local = PMIX_INFO_TRUE(&queries[n].qualifiers[p]);
+            } else if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_QUERY_REFRESH_CACHE)) {
                 if (PMIX_INFO_TRUE(&queries[n].qualifiers[p])) {
                     PMIX_LIST_DESTRUCT(&results);
                     goto query;
@@ -250,6 +659,47 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
         }
         for (p=0; NULL != queries[n].keys[p]; p++) {
             cb.key = queries[n].keys[p];
+            if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
+                0 == strcmp(cb.key, PMIX_QUERY_PSEC_CACHE_STATS)) {
+                /* the cache lives in the server's security framework */
+                if (NULL != (kv = pmix_psec_base_cache_stats())) {
+                    pmix_list_append(&results, &kv->super);
+                    continue;
+                }
+            }
+            if ((PMIX_PROC_IS_SERVER(pmix_globals.mypeer) || local) &&
+                0 == strcmp(cb.key, PMIX_QUERY_OP_STATS)) {
+                /* servers report their own histograms - anyone
+                 * else only does so when asked for local data */
+                if (NULL != (kv = pmix_opstats_report())) {
+                    pmix_list_append(&results, &kv->super);
+                    continue;
+                }
+            }
+            if ((PMIX_PROC_IS_SERVER(pmix_globals.mypeer) || local) &&
+                0 == strcmp(cb.key, PMIX_QUERY_ALLOC_STATS)) {
+                if (NULL != (kv = pmix_opstats_alloc_report())) {
+                    pmix_list_append(&results, &kv->super);
+                    continue;
+                }
+            }
+            if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
+                !PMIX_PROC_IS_LAUNCHER(pmix_globals.mypeer) &&
+                0 == strcmp(cb.key, PMIX_QUERY_SERVER_STATS)) {
+                /* a server asking about its own queues - added
+                 * to the results once we are in the progress thread */
+                stats = true;
+                continue;
+            }
+            if (0 == strcmp(cb.key, PMIX_QUERY_OP_STATS) ||
+                0 == strcmp(cb.key, PMIX_QUERY_ALLOC_STATS) ||
+                0 == strcmp(cb.key, PMIX_QUERY_SERVER_STATS)) {
+                /* live values must not be answered from the
+                 * results cached by an earlier query */
+                PMIX_LIST_DESTRUCT(&results);
+                PMIX_DESTRUCT(&cb);
+                goto query;
+            }
             PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
             if (PMIX_SUCCESS != rc) {
                 /* needs to be passed to the host */
@@ -273,6 +723,10 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     cd->cbdata = cbdata;
     cd->status = PMIX_SUCCESS;
     cd->ninfo = pmix_list_get_size(&results);
+    if (stats) {
+        /* leave room for the stats */
+        ++cd->ninfo;
+    }
     PMIX_INFO_CREATE(cd->info, cd->ninfo);
     n = 0;
     PMIX_LIST_FOREACH_SAFE(kv, kvnxt, &results, pmix_kval_t) {
@@ -290,7 +744,11 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     /* we need to thread-shift as we are not allowed to
      * execute the callback function prior to returning
      * from the API */
-    PMIX_THREADSHIFT(cd, _local_cbfunc);
+    if (stats) {
+        PMIX_THREADSHIFT(cd, _server_stats);
+    } else {
+        PMIX_THREADSHIFT(cd, _local_cbfunc);
+    }
     /* regardless of the result of the query, we return
      * PMIX_SUCCESS here to indicate that the operation
      * was accepted for processing */
@@ -299,6 +757,23 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
 
 
   query:
+    /* see if we were given the answer recently enough */
+    cachekey = pmix_query_cache_key(queries, nqueries, pmix_globals.myid.nspace,
+                                    (uint32_t)pmix_globals.uid, &ttl, &refresh);
+    if (NULL != cachekey && !refresh) {
+        cd = PMIX_NEW(pmix_query_caddy_t);
+        if (PMIX_SUCCESS == pmix_query_cache_fetch(cachekey, &cd->info, &cd->ninfo)) {
+            free(cachekey);
+            cd->cbfunc = cbfunc;
+            cd->cbdata = cbdata;
+            cd->status = PMIX_SUCCESS;
+            PMIX_THREADSHIFT(cd, _local_cbfunc);
+            PMIX_RELEASE_THREAD(&pmix_global_lock);
+            return PMIX_SUCCESS;
+        }
+        PMIX_RELEASE(cd);
+    }
+
     /* if we are the server, then we just issue the query and
      * return the response */
     if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
@@ -306,19 +781,36 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
         PMIX_RELEASE_THREAD(&pmix_global_lock);
         if (NULL == pmix_host_server.query) {
             /* nothing we can do */
+            free(cachekey);
             return PMIX_ERR_NOT_SUPPORTED;
         }
         pmix_output_verbose(2, pmix_globals.debug_output,
                             "pmix:query handed to RM");
+        if (NULL == cachekey) {
+            rc = pmix_host_server.query(&pmix_globals.myid,
+                                        queries, nqueries,
+                                        cbfunc, cbdata);
+            return rc;
+        }
+        /* pass the answer through the cache */
+        cd = PMIX_NEW(pmix_query_caddy_t);
+        cd->cbfunc = cbfunc;
+        cd->cbdata = cbdata;
+        cd->cache_key = cachekey;
+        cd->cache_ttl = ttl;
         rc = pmix_host_server.query(&pmix_globals.myid,
                                     queries, nqueries,
-                                    cbfunc, cbdata);
+                                    cache_cbfunc, cd);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(cd);
+        }
         return rc;
     }
 
     /* if we aren't connected, don't attempt to send */
     if (!pmix_globals.connected) {
         PMIX_RELEASE_THREAD(&pmix_global_lock);
+        free(cachekey);
         return PMIX_ERR_UNREACH;
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
@@ -327,6 +819,9 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     cd = PMIX_NEW(pmix_query_caddy_t);
     cd->cbfunc = cbfunc;
     cd->cbdata = cbdata;
+    /* hold onto the answer when it comes back */
+    cd->cache_key = cachekey;
+    cd->cache_ttl = ttl;
     msg = PMIX_NEW(pmix_buffer_t);
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
                      msg, &cmd, 1, PMIX_COMMAND);
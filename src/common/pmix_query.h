@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Cache of query results
+ *
+ * Answers to queries are kept for the number of seconds given by
+ * the PMIX_QUERY_CACHE_TTL qualifier (or the pmix_query_cache_ttl
+ * param), keyed on the requestor's nspace and uid and on the
+ * queries with their keys and qualifiers put into a canonical
+ * order. The whole cache is dropped whenever an nspace comes or
+ * goes, or a job changes state. Only servers see nspaces come and
+ * go, so other processes don't cache answers that depend on them.
+ */
+
+#ifndef PMIX_QUERY_H
+#define PMIX_QUERY_H
+
+#include <src/include/pmix_config.h>
+
+#include <pmix_common.h>
+
+BEGIN_C_DECLS
+
+/* return the key the given queries from the given nspace and uid are
+ * cached under along with the number of seconds to keep their
+ * answer, or NULL if they cannot be cached. refresh is set if the
+ * caller asked for the cached answer to be replaced */
+PMIX_EXPORT char* pmix_query_cache_key(const pmix_query_t queries[], size_t nqueries,
+                                       const char *nspace, uint32_t uid,
+                                       uint32_t *ttl, bool *refresh);
+
+/* return a copy of the unexpired answer cached under key */
+PMIX_EXPORT pmix_status_t pmix_query_cache_fetch(const char *key,
+                                                 pmix_info_t **info, size_t *ninfo);
+
+/* cache a copy of the answer to the queries behind key */
+PMIX_EXPORT void pmix_query_cache_store(const char *key, uint32_t ttl,
+                                        const pmix_info_t *info, size_t ninfo);
+
+/* drop every cached answer */
+PMIX_EXPORT void pmix_query_cache_flush(void);
+
+/* drop the answers invalidated by the given event */
+PMIX_EXPORT void pmix_query_cache_event(pmix_status_t status);
+
+PMIX_EXPORT void pmix_query_cache_finalize(void);
+
+END_C_DECLS
+
+#endif /* PMIX_QUERY_H */
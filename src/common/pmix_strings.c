@@ -240,6 +240,8 @@ PMIX_EXPORT const char* pmix_command_string(pmix_cmd_t cmd)
             return "GROUP LEAVE";
         case PMIX_GROUP_DESTRUCT_CMD:
             return "GROUP DESTRUCT";
+        case PMIX_GETNB_MULTI_CMD:
+            return "GET MULTI";
         default:
             return "UNKNOWN";
     }
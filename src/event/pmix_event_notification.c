@@ -18,6 +18,7 @@
 #include <pmix_server.h>
 #include <pmix_rename.h>
 
+#include "src/common/pmix_query.h"
 #include "src/threads/threads.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
@@ -624,6 +625,9 @@ void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain)
                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         PMIx_Error_string(chain->status));
 
+    /* drop any cached query answers the event makes stale */
+    pmix_query_cache_event(chain->status);
+
     /* sanity check */
     if (NULL == chain->info) {
         /* should never happen as space must always be
@@ -935,7 +939,6 @@ static void _notify_client_event(int sd, short args, void *cbdata)
      * If it is, then we need to track the group */
     if (PMIX_GROUP_CONSTRUCT_COMPLETE == cd->status) {
         char *grpid = NULL;
-        pmix_group_t *grp;
         /* must include the group id */
         for (n=0; n < cd->ninfo; n++) {
             if (PMIX_CHECK_KEY(&cd->info[n], PMIX_GROUP_ID)) {
@@ -965,12 +968,17 @@ static void _notify_client_event(int sd, short args, void *cbdata)
             PMIX_RELEASE(chain);
             return;
         }
-        grp = PMIX_NEW(pmix_group_t);
-        grp->grpid = strdup(grpid);
-        grp->nmbrs = cd->ntargets;
-        PMIX_PROC_CREATE(grp->members, grp->nmbrs);
-        memcpy(grp->members, cd->targets, cd->ntargets * sizeof(pmix_proc_t));
-        pmix_list_append(&pmix_server_globals.groups, &grp->super);
+        rc = pmix_server_group_record(grpid, cd->targets, cd->ntargets);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            /* notify the caller */
+            if (NULL != cd->cbfunc) {
+                cd->cbfunc(rc, cd->cbdata);
+            }
+            PMIX_RELEASE(cd);
+            PMIX_RELEASE(chain);
+            return;
+        }
     }
 
     holdcd = false;
@@ -183,6 +183,7 @@ static void pcon(pmix_peer_t *p)
     p->recv_ev_active = false;
     PMIX_CONSTRUCT(&p->send_queue, pmix_list_t);
     p->send_msg = NULL;
+    p->send_qbytes = 0;
     p->recv_msg = NULL;
     p->commit_cnt = 0;
     PMIX_CONSTRUCT(&p->epilog.cleanup_dirs, pmix_list_t);
@@ -273,6 +274,7 @@ static void scon(pmix_shift_caddy_t *p)
     p->cbfunc.relfn = NULL;
     p->cbdata = NULL;
     p->ref = 0;
+    p->arena = NULL;
 }
 static void scdes(pmix_shift_caddy_t *p)
 {
@@ -283,10 +285,13 @@ static void scdes(pmix_shift_caddy_t *p)
     if (NULL != p->kv) {
         PMIX_RELEASE(p->kv);
     }
+    if (NULL != p->arena) {
+        PMIX_RELEASE(p->arena);
+    }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_shift_caddy_t,
-                                pmix_object_t,
-                                scon, scdes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_shift_caddy_t,
+                                       pmix_object_t,
+                                       scon, scdes);
 
 static void cbcon(pmix_cb_t *p)
 {
@@ -320,9 +325,9 @@ static void cbdes(pmix_cb_t *p)
     PMIX_DESTRUCT(&p->data);
     PMIX_LIST_DESTRUCT(&p->kvs);
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_cb_t,
-                                pmix_list_item_t,
-                                cbcon, cbdes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_cb_t,
+                                       pmix_list_item_t,
+                                       cbcon, cbdes);
 
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_info_caddy_t,
                                 pmix_list_item_t,
@@ -357,6 +362,9 @@ static void qcon(pmix_query_caddy_t *p)
     p->relcbfunc = NULL;
     p->credcbfunc = NULL;
     p->validcbfunc = NULL;
+    p->arena = NULL;
+    p->cache_key = NULL;
+    p->cache_ttl = 0;
 }
 static void qdes(pmix_query_caddy_t *p)
 {
@@ -365,6 +373,12 @@ static void qdes(pmix_query_caddy_t *p)
     PMIX_PROC_FREE(p->targets, p->ntargets);
     PMIX_INFO_FREE(p->info, p->ninfo);
     PMIX_LIST_DESTRUCT(&p->results);
+    if (NULL != p->arena) {
+        PMIX_RELEASE(p->arena);
+    }
+    if (NULL != p->cache_key) {
+        free(p->cache_key);
+    }
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_query_caddy_t,
                                 pmix_object_t,
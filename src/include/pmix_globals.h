@@ -61,6 +61,13 @@ BEGIN_C_DECLS
 #define PMIX_BFROPS_MODULE                  "pmix.bfrops.mod"       // (char*) name of bfrops plugin in-use by a given nspace
 #define PMIX_PNET_SETUP_APP                 "pmix.pnet.setapp"      // (pmix_byte_object_t) blob containing info to be given to
                                                                     //      pnet framework on remote nodes
+#define PMIX_HEARTBEAT_SEGMENT              "pmix.hbeat.seg"        // (char*) path of the page of heartbeat counters
+                                                                    //      shared by a server with its clients
+#define PMIX_HEARTBEAT_SLOT                 "pmix.hbeat.slot"       // (uint32_t) index of the requestor's counter in that page
+
+/* each heartbeat counter is an int64_t at the start of its own
+ * cache line so that clients beating at once don't contend */
+#define PMIX_HEARTBEAT_SLOT_SIZE    64
 
 #define PMIX_INFO_OP_COMPLETE    0x80000000
 #define PMIX_INFO_OP_COMPLETED(m)            \
@@ -117,6 +124,7 @@ typedef uint8_t pmix_cmd_t;
 #define PMIX_GROUP_INVITE_CMD       26
 #define PMIX_GROUP_LEAVE_CMD        27
 #define PMIX_GROUP_DESTRUCT_CMD     28
+#define PMIX_GETNB_MULTI_CMD        29
 
 /* provide a "pretty-print" function for cmds */
 const char* pmix_command_string(pmix_cmd_t cmd);
@@ -249,6 +257,7 @@ typedef struct pmix_peer_t {
     bool recv_ev_active;
     pmix_list_t send_queue;         /**< list of messages to send */
     pmix_ptl_send_t *send_msg;      /**< current send in progress */
+    size_t send_qbytes;             /**< payload bytes of send_msg plus the send_queue */
     pmix_ptl_recv_t *recv_msg;      /**< current recv in progress */
     int commit_cnt;
     pmix_epilog_t epilog;           /**< things to be performed upon
@@ -288,6 +297,12 @@ typedef struct {
     pmix_credential_cbfunc_t credcbfunc;
     pmix_validation_cbfunc_t validcbfunc;
     void *cbdata;
+    /* if not NULL, queries were unpacked into this arena and
+     * are released along with it */
+    pmix_arena_t *arena;
+    /* if not NULL, the answer is to be cached under this key */
+    char *cache_key;
+    uint32_t cache_ttl;
 } pmix_query_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_query_caddy_t);
 
@@ -368,6 +383,9 @@ PMIX_CLASS_DECLARATION(pmix_server_caddy_t);
     } cbfunc;
     void *cbdata;
     size_t ref;
+    /* if not NULL, info was unpacked into this arena and
+     * is released along with it */
+    pmix_arena_t *arena;
  } pmix_shift_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_shift_caddy_t);
 
@@ -408,8 +426,8 @@ PMIX_CLASS_DECLARATION(pmix_cb_t);
 
 #define PMIX_THREADSHIFT(r, c)                              \
  do {                                                       \
-    pmix_event_assign(&((r)->ev), pmix_globals.evbase,      \
-                      -1, EV_WRITE, (c), (r));              \
+    pmix_event_assign_shift(&((r)->ev), pmix_globals.evbase,\
+                            EV_WRITE, (c), (r));            \
     PMIX_POST_OBJECT((r));                                  \
     pmix_event_active(&((r)->ev), EV_WRITE, 1);             \
 } while (0)
@@ -483,6 +501,8 @@ typedef struct {
     pmix_list_t iof_requests;           // list of pmix_iof_req_t IOF requests
     int max_events;                     // size of the notifications hotel
     int event_eviction_time;            // max time to cache notifications
+    int query_cache_ttl;                // default secs to cache query answers
+    int query_cache_size;               // max number of query answers to cache
     pmix_hotel_t notifications;         // hotel of pending notifications
     /* processes also need a place where they can store
      * their own internal data - e.g., data provided by
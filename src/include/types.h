@@ -261,6 +261,12 @@ PMIX_EXPORT int pmix_event_assign(struct event *ev, pmix_event_base_t *evbase,
 
 #define pmix_event_set(b, x, fd, fg, cb, arg) pmix_event_assign((x), (b), (fd), (fg), (event_callback_fn) (cb), (arg))
 
+/* assign a one-shot event that hands an operation to the progress
+ * thread. When the progress thread watchdog is enabled, the callback
+ * is wrapped so that the time it takes can be attributed to it */
+PMIX_EXPORT int pmix_event_assign_shift(struct event *ev, pmix_event_base_t *evbase,
+                                        short arg, event_callback_fn cbfn, void *cbd);
+
 #if PMIX_HAVE_LIBEV
 PMIX_EXPORT int pmix_event_add(struct event *ev, struct timeval *tv);
 PMIX_EXPORT int pmix_event_del(struct event *ev);
@@ -15,7 +15,7 @@
  *                         reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
- * Copyright (c) 2016-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2016-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -71,6 +71,7 @@ PMIX_EXPORT extern char *pmix_mca_base_component_path;
 PMIX_EXPORT extern bool pmix_mca_base_component_show_load_errors;
 PMIX_EXPORT extern bool pmix_mca_base_component_track_load_errors;
 PMIX_EXPORT extern bool pmix_mca_base_component_disable_dlopen;
+PMIX_EXPORT extern bool pmix_mca_base_component_use_manifest;
 PMIX_EXPORT extern char *pmix_mca_base_system_default_path;
 PMIX_EXPORT extern char *pmix_mca_base_user_default_path;
 
@@ -15,7 +15,7 @@
  *                         reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
- * Copyright (c) 2016-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2016-2019 Intel, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -34,6 +34,11 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#include <fcntl.h>
+#include <errno.h>
 
 #include "src/class/pmix_list.h"
 #include "src/mca/mca.h"
@@ -176,6 +181,82 @@ static int process_repository_item (const char *filename, void *data)
     return PMIX_SUCCESS;
 }
 
+/*
+ * Populate the repository from the manifest written into the
+ * component directory at install time. This replaces a readdir
+ * and stat of every file in the directory with a single read.
+ * The manifest is ignored if anything has been added to or
+ * removed from the directory since it was written.
+ */
+static int load_manifest(const char *dir)
+{
+    char *path, *buf, *line, *ctx;
+    struct stat dst, mst;
+    size_t nread;
+    ssize_t n;
+    int fd, ret;
+
+    ret = asprintf(&path, "%s%s%s", dir, PMIX_PATH_SEP, PMIX_MCA_BASE_COMPONENT_MANIFEST);
+    if (0 > ret || NULL == path) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    fd = open(path, O_RDONLY);
+    free(path);
+    if (0 > fd) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (0 != fstat(fd, &mst) || 0 != stat(dir, &dst) ||
+        mst.st_mtime < dst.st_mtime) {
+        close(fd);
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    buf = (char*)malloc(mst.st_size + 1);
+    if (NULL == buf) {
+        close(fd);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    nread = 0;
+    while (nread < (size_t)mst.st_size) {
+        n = read(fd, buf + nread, mst.st_size - nread);
+        if (0 > n && EINTR == errno) {
+            continue;
+        }
+        if (0 >= n) {
+            break;
+        }
+        nread += n;
+    }
+    close(fd);
+    if (nread != (size_t)mst.st_size) {
+        free(buf);
+        return PMIX_ERR_NOT_FOUND;
+    }
+    buf[nread] = '\0';
+
+    pmix_output_verbose(PMIX_MCA_BASE_VERBOSE_COMPONENT, 0,
+                        "mca: base: component_repository: using manifest in %s", dir);
+
+    /* one component file per line, without its extension */
+    ret = PMIX_SUCCESS;
+    for (line = strtok_r(buf, "\n", &ctx); NULL != line; line = strtok_r(NULL, "\n", &ctx)) {
+        if ('#' == line[0]) {
+            continue;
+        }
+        if (0 > asprintf(&path, "%s%s%s", dir, PMIX_PATH_SEP, line)) {
+            ret = PMIX_ERR_OUT_OF_RESOURCE;
+            break;
+        }
+        ret = process_repository_item(path, NULL);
+        free(path);
+        if (PMIX_SUCCESS != ret) {
+            break;
+        }
+    }
+    free(buf);
+    return ret;
+}
+
 static int file_exists(const char *filename, const char *ext)
 {
     char *final;
@@ -220,6 +301,11 @@ int pmix_mca_base_component_repository_add (const char *path)
             dir = pmix_mca_base_system_default_path;
         }
 
+        if (pmix_mca_base_component_use_manifest &&
+            PMIX_SUCCESS == load_manifest(dir)) {
+            continue;
+        }
+
         if (0 != pmix_pdl_foreachfile(dir, process_repository_item, NULL)) {
             break;
         }
@@ -13,7 +13,7 @@
  * Copyright (c) 2015      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2015      Los Alamos National Security, LLC. All rights
  *                         reserved.
- * Copyright (c) 2016-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2016-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -43,6 +43,11 @@
 #include "src/mca/pdl/base/base.h"
 
 BEGIN_C_DECLS
+
+/* name of the file listing the dynamic components installed in
+ * a component directory - written by "make install" */
+#define PMIX_MCA_BASE_COMPONENT_MANIFEST "pmix-mca-manifest"
+
 struct pmix_mca_base_component_repository_item_t {
     pmix_list_item_t super;
 
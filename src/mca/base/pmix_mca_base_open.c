@@ -13,7 +13,7 @@
  * Copyright (c) 2011      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2015      Los Alamos National Security, LLC. All rights
  *                         reserved.
- * Copyright (c) 2016-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2016-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -51,6 +51,7 @@ char *pmix_mca_base_user_default_path = NULL;
 bool pmix_mca_base_component_show_load_errors = (bool) PMIX_SHOW_LOAD_ERRORS_DEFAULT;
 bool pmix_mca_base_component_track_load_errors = false;
 bool pmix_mca_base_component_disable_dlopen = false;
+bool pmix_mca_base_component_use_manifest = true;
 
 static char *pmix_mca_base_verbose = NULL;
 
@@ -138,6 +139,15 @@ int pmix_mca_base_open(void)
     (void) pmix_mca_base_var_register_synonym(var_id, "pmix", "mca", NULL, "component_disable_dlopen",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    pmix_mca_base_component_use_manifest = true;
+    var_id = pmix_mca_base_var_register("pmix", "mca", "base", "component_use_manifest",
+                                        "Whether to read the list of dynamic components from the manifest "
+                                        "generated at install time instead of scanning the component directories",
+                                        PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                        PMIX_INFO_LVL_9,
+                                        PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                        &pmix_mca_base_component_use_manifest);
+
     /* What verbosity level do we want for the default 0 stream? */
     pmix_mca_base_verbose = "stderr";
     var_id = pmix_mca_base_var_register("pmix", "mca", "base", "verbose",
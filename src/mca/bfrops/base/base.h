@@ -233,6 +233,25 @@ PMIX_EXPORT extern pmix_bfrops_globals_t pmix_bfrops_globals;
         free(tmpbuf);                                                       \
     } while (0)
 
+/* allocate storage for unpacked data - it comes from the buffer's
+ * arena if one is attached so that the storage for a message is
+ * never a mix of heap and arena memory */
+#define PMIX_BFROPS_UNPACK_MALLOC(b, s)                                     \
+    ((NULL != (b)->arena) ? pmix_arena_alloc((b)->arena, (s)) : malloc(s))
+
+#define PMIX_BFROPS_UNPACK_CALLOC(b, n, s)                                  \
+    ((NULL != (b)->arena) ? pmix_arena_calloc((b)->arena, (n), (s)) :       \
+                            calloc((n), (s)))
+
+/* release scratch storage obtained while unpacking - arena storage
+ * goes back with the arena */
+#define PMIX_BFROPS_UNPACK_FREE(b, p)                                       \
+    do {                                                                    \
+        if (NULL == (b)->arena) {                                           \
+            free(p);                                                        \
+        }                                                                   \
+    } while (0)
+
 /* for backwards compatibility */
 typedef struct pmix_info_array {
     size_t size;
@@ -11,7 +11,7 @@
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
  * Copyright (c) 2012-2013 Los Alamos National Security, Inc.  All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2015-2018 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -135,6 +135,7 @@ static void pmix_buffer_construct (pmix_buffer_t* buffer)
     /* Make everything NULL to begin with */
     buffer->base_ptr = buffer->pack_ptr = buffer->unpack_ptr = NULL;
     buffer->bytes_allocated = buffer->bytes_used = 0;
+    buffer->arena = NULL;
 }
 
 static void pmix_buffer_destruct (pmix_buffer_t* buffer)
@@ -142,12 +143,15 @@ static void pmix_buffer_destruct (pmix_buffer_t* buffer)
     if (NULL != buffer->base_ptr) {
         free (buffer->base_ptr);
     }
+    if (NULL != buffer->arena) {
+        PMIX_RELEASE(buffer->arena);
+    }
 }
 
-PMIX_CLASS_INSTANCE(pmix_buffer_t,
-                   pmix_object_t,
-                   pmix_buffer_construct,
-                   pmix_buffer_destruct);
+PMIX_CLASS_INSTANCE_CACHED(pmix_buffer_t,
+                          pmix_object_t,
+                          pmix_buffer_construct,
+                          pmix_buffer_destruct);
 
 
 static void pmix_bfrop_type_info_construct(pmix_bfrop_type_info_t *obj)
@@ -184,6 +188,6 @@ static void kvdes(pmix_kval_t *k)
         PMIX_VALUE_RELEASE(k->value);
     }
 }
-PMIX_CLASS_INSTANCE(pmix_kval_t,
-                   pmix_list_item_t,
-                   kvcon, kvdes);
+PMIX_CLASS_INSTANCE_CACHED(pmix_kval_t,
+                          pmix_list_item_t,
+                          kvcon, kvdes);
@@ -397,7 +397,7 @@ pmix_status_t pmix_bfrops_base_unpack_string(pmix_pointer_array_t *regtypes,
         if (0 ==  len) {   /* zero-length string - unpack the NULL */
             sdest[i] = NULL;
         } else {
-            sdest[i] = (char*)malloc(len);  // NULL terminator is included
+            sdest[i] = (char*)PMIX_BFROPS_UNPACK_MALLOC(buffer, len);  // NULL terminator is included
             if (NULL == sdest[i]) {
                 return PMIX_ERR_OUT_OF_RESOURCE;
             }
@@ -434,7 +434,7 @@ pmix_status_t pmix_bfrops_base_unpack_float(pmix_pointer_array_t *regtypes,
         if (NULL != convert) {
             tmp = strtof(convert, NULL);
             memcpy(&desttmp[i], &tmp, sizeof(tmp));
-            free(convert);
+            PMIX_BFROPS_UNPACK_FREE(buffer, convert);
         }
     }
     return PMIX_SUCCESS;
@@ -463,7 +463,7 @@ pmix_status_t pmix_bfrops_base_unpack_double(pmix_pointer_array_t *regtypes,
         if (NULL != convert) {
             tmp = strtod(convert, NULL);
             memcpy(&desttmp[i], &tmp, sizeof(tmp));
-            free(convert);
+            PMIX_BFROPS_UNPACK_FREE(buffer, convert);
         }
     }
     return PMIX_SUCCESS;
@@ -558,7 +558,7 @@ pmix_status_t pmix_bfrops_base_unpack_val(pmix_pointer_array_t *regtypes,
             break;
         case PMIX_PROC:
             /* this field is now a pointer, so we must allocate storage for it */
-            PMIX_PROC_CREATE(val->data.proc, m);
+            val->data.proc = (pmix_proc_t*)PMIX_BFROPS_UNPACK_CALLOC(buffer, 1, sizeof(pmix_proc_t));
             if (NULL == val->data.proc) {
                 return PMIX_ERR_NOMEM;
             }
@@ -566,7 +566,7 @@ pmix_status_t pmix_bfrops_base_unpack_val(pmix_pointer_array_t *regtypes,
             break;
         case PMIX_PROC_INFO:
             /* this is now a pointer, so allocate storage for it */
-            PMIX_PROC_INFO_CREATE(val->data.pinfo, 1);
+            val->data.pinfo = (pmix_proc_info_t*)PMIX_BFROPS_UNPACK_CALLOC(buffer, 1, sizeof(pmix_proc_info_t));
             if (NULL == val->data.pinfo) {
                 return PMIX_ERR_NOMEM;
             }
@@ -574,14 +574,14 @@ pmix_status_t pmix_bfrops_base_unpack_val(pmix_pointer_array_t *regtypes,
             break;
         case PMIX_DATA_ARRAY:
             /* this is now a pointer, so allocate storage for it */
-            val->data.darray = (pmix_data_array_t*)malloc(sizeof(pmix_data_array_t));
+            val->data.darray = (pmix_data_array_t*)PMIX_BFROPS_UNPACK_MALLOC(buffer, sizeof(pmix_data_array_t));
             if (NULL == val->data.darray) {
                 return PMIX_ERR_NOMEM;
             }
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, val->data.darray, &m, PMIX_DATA_ARRAY, regtypes);
             break;
         case PMIX_COORD:
-            val->data.coord = (pmix_coord_t*)malloc(sizeof(pmix_coord_t));
+            val->data.coord = (pmix_coord_t*)PMIX_BFROPS_UNPACK_MALLOC(buffer, sizeof(pmix_coord_t));
             if (NULL == val->data.coord) {
                 return PMIX_ERR_NOMEM;
             }
@@ -653,7 +653,7 @@ pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes,
             return PMIX_ERROR;
         }
         pmix_strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
+        PMIX_BFROPS_UNPACK_FREE(buffer, tmp);
         /* unpack the directives */
         m=1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].flags, &m, PMIX_INFO_DIRECTIVES, regtypes);
@@ -711,7 +711,7 @@ pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes,
             return PMIX_ERROR;
         }
         pmix_strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
+        PMIX_BFROPS_UNPACK_FREE(buffer, tmp);
         /* unpack value - since the value structure is statically-defined
          * instead of a pointer in this struct, we directly unpack it to
          * avoid the malloc */
@@ -759,7 +759,7 @@ pmix_status_t pmix_bfrops_base_unpack_buf(pmix_pointer_array_t *regtypes,
         m = nbytes;
         /* setup the buffer's data region */
         if (0 < nbytes) {
-            ptr[i].base_ptr = (char*)malloc(nbytes);
+            ptr[i].base_ptr = (char*)PMIX_BFROPS_UNPACK_MALLOC(buffer, nbytes);
             if (NULL == ptr[i].base_ptr) {
                 return PMIX_ERR_NOMEM;
             }
@@ -808,7 +808,7 @@ pmix_status_t pmix_bfrops_base_unpack_proc(pmix_pointer_array_t *regtypes,
             return PMIX_ERROR;
         }
         pmix_strncpy(ptr[i].nspace, tmp, PMIX_MAX_NSLEN);
-        free(tmp);
+        PMIX_BFROPS_UNPACK_FREE(buffer, tmp);
         /* unpack the rank */
         m=1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].rank, &m, PMIX_PROC_RANK, regtypes);
@@ -827,7 +827,6 @@ pmix_status_t pmix_bfrops_base_unpack_app(pmix_pointer_array_t *regtypes,
     int32_t i, k, n, m;
     pmix_status_t ret;
     int32_t nval;
-    char *tmp;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d apps", *num_vals);
@@ -851,18 +850,21 @@ pmix_status_t pmix_bfrops_base_unpack_app(pmix_pointer_array_t *regtypes,
             return ret;
         }
         /* unpack argv */
+        if (0 < nval) {
+            ptr[i].argv = (char**)PMIX_BFROPS_UNPACK_CALLOC(buffer, nval+1, sizeof(char*));
+            if (NULL == ptr[i].argv) {
+                return PMIX_ERR_NOMEM;
+            }
+        }
         for (k=0; k < nval; k++) {
             m=1;
-            tmp = NULL;
-            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tmp, &m, PMIX_STRING, regtypes);
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].argv[k], &m, PMIX_STRING, regtypes);
             if (PMIX_SUCCESS != ret) {
                 return ret;
             }
-            if (NULL == tmp) {
+            if (NULL == ptr[i].argv[k]) {
                 return PMIX_ERROR;
             }
-            pmix_argv_append_nosize(&ptr[i].argv, tmp);
-            free(tmp);
         }
         /* unpack env */
         m=1;
@@ -870,18 +872,21 @@ pmix_status_t pmix_bfrops_base_unpack_app(pmix_pointer_array_t *regtypes,
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
+        if (0 < nval) {
+            ptr[i].env = (char**)PMIX_BFROPS_UNPACK_CALLOC(buffer, nval+1, sizeof(char*));
+            if (NULL == ptr[i].env) {
+                return PMIX_ERR_NOMEM;
+            }
+        }
         for (k=0; k < nval; k++) {
             m=1;
-            tmp = NULL;
-            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tmp, &m, PMIX_STRING, regtypes);
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].env[k], &m, PMIX_STRING, regtypes);
             if (PMIX_SUCCESS != ret) {
                 return ret;
             }
-            if (NULL == tmp) {
+            if (NULL == ptr[i].env[k]) {
                 return PMIX_ERROR;
             }
-            pmix_argv_append_nosize(&ptr[i].env, tmp);
-            free(tmp);
         }
         /* unpack cwd */
         m=1;
@@ -902,9 +907,12 @@ pmix_status_t pmix_bfrops_base_unpack_app(pmix_pointer_array_t *regtypes,
             return ret;
         }
         if (0 < ptr[i].ninfo) {
-            PMIX_INFO_CREATE(ptr[i].info, ptr[i].ninfo);
+            ptr[i].info = (pmix_info_t*)PMIX_BFROPS_UNPACK_CALLOC(buffer, ptr[i].ninfo, sizeof(pmix_info_t));
+            if (NULL == ptr[i].info) {
+                return PMIX_ERR_NOMEM;
+            }
             m = ptr[i].ninfo;
-            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].info, &m, PMIX_INFO, regtypes);
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].info, &m, PMIX_INFO, regtypes);
             if (PMIX_SUCCESS != ret) {
                 return ret;
             }
@@ -936,7 +944,7 @@ pmix_status_t pmix_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes,
             return ret;
         }
         /* allocate the space */
-        ptr[i].value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+        ptr[i].value = (pmix_value_t*)PMIX_BFROPS_UNPACK_MALLOC(buffer, sizeof(pmix_value_t));
         /* unpack the value */
         m = 1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].value, &m, PMIX_VALUE, regtypes);
@@ -979,7 +987,7 @@ pmix_status_t pmix_bfrops_base_unpack_bo(pmix_pointer_array_t *regtypes,
             return ret;
         }
         if (0 < ptr[i].size) {
-            ptr[i].bytes = (char*)malloc(ptr[i].size * sizeof(char));
+            ptr[i].bytes = (char*)PMIX_BFROPS_UNPACK_MALLOC(buffer, ptr[i].size * sizeof(char));
             m=ptr[i].size;
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].bytes, &m, PMIX_BYTE, regtypes);
             if (PMIX_SUCCESS != ret) {
@@ -1100,6 +1108,83 @@ pmix_status_t pmix_bfrops_base_unpack_pinfo(pmix_pointer_array_t *regtypes,
     return PMIX_SUCCESS;
 }
 
+/* size of one element of a data array of the given type - this
+ * must track the allocations made by PMIX_DATA_ARRAY_CONSTRUCT.
+ * Unsupported types return zero, leaving the array unallocated */
+static size_t darray_elem_size(pmix_data_type_t t)
+{
+    switch (t) {
+        case PMIX_INFO:
+            return sizeof(pmix_info_t);
+        case PMIX_PROC:
+            return sizeof(pmix_proc_t);
+        case PMIX_PROC_INFO:
+            return sizeof(pmix_proc_info_t);
+        case PMIX_ENVAR:
+            return sizeof(pmix_envar_t);
+        case PMIX_VALUE:
+            return sizeof(pmix_value_t);
+        case PMIX_PDATA:
+            return sizeof(pmix_pdata_t);
+        case PMIX_QUERY:
+            return sizeof(pmix_query_t);
+        case PMIX_APP:
+            return sizeof(pmix_app_t);
+        case PMIX_BYTE_OBJECT:
+        case PMIX_COMPRESSED_STRING:
+            return sizeof(pmix_byte_object_t);
+        case PMIX_ALLOC_DIRECTIVE:
+        case PMIX_PROC_STATE:
+        case PMIX_PERSIST:
+        case PMIX_SCOPE:
+        case PMIX_DATA_RANGE:
+        case PMIX_BYTE:
+        case PMIX_INT8:
+        case PMIX_UINT8:
+        case PMIX_POINTER:
+            return sizeof(int8_t);
+        case PMIX_STRING:
+            return sizeof(char*);
+        case PMIX_SIZE:
+            return sizeof(size_t);
+        case PMIX_PID:
+            return sizeof(pid_t);
+        case PMIX_INT:
+        case PMIX_UINT:
+        case PMIX_STATUS:
+            return sizeof(int);
+        case PMIX_IOF_CHANNEL:
+        case PMIX_DATA_TYPE:
+        case PMIX_INT16:
+        case PMIX_UINT16:
+            return sizeof(int16_t);
+        case PMIX_PROC_RANK:
+        case PMIX_INFO_DIRECTIVES:
+        case PMIX_INT32:
+        case PMIX_UINT32:
+            return sizeof(int32_t);
+        case PMIX_INT64:
+        case PMIX_UINT64:
+            return sizeof(int64_t);
+        case PMIX_FLOAT:
+            return sizeof(float);
+        case PMIX_DOUBLE:
+            return sizeof(double);
+        case PMIX_TIMEVAL:
+            return sizeof(struct timeval);
+        case PMIX_TIME:
+            return sizeof(time_t);
+        case PMIX_REGATTR:
+            return sizeof(pmix_regattr_t);
+        case PMIX_BOOL:
+            return sizeof(bool);
+        case PMIX_COORD:
+            return sizeof(pmix_coord_t);
+        default:
+            return 0;
+    }
+}
+
 pmix_status_t pmix_bfrops_base_unpack_darray(pmix_pointer_array_t *regtypes,
                                              pmix_buffer_t *buffer, void *dest,
                                              int32_t *num_vals, pmix_data_type_t type)
@@ -1136,7 +1221,11 @@ pmix_status_t pmix_bfrops_base_unpack_darray(pmix_pointer_array_t *regtypes,
         m = ptr[i].size;
         t = ptr[i].type;
 
-        PMIX_DATA_ARRAY_CONSTRUCT(&ptr[i], m, t);
+        if (NULL == buffer->arena) {
+            PMIX_DATA_ARRAY_CONSTRUCT(&ptr[i], m, t);
+        } else {
+            ptr[i].array = pmix_arena_calloc(buffer->arena, m, darray_elem_size(t));
+        }
         if (NULL == ptr[i].array) {
             return PMIX_ERR_NOMEM;
         }
@@ -1182,7 +1271,7 @@ pmix_status_t pmix_bfrops_base_unpack_query(pmix_pointer_array_t *regtypes,
         }
         if (0 < nkeys) {
             /* unpack the keys */
-            if (NULL == (ptr[i].keys = (char**)calloc(nkeys+1, sizeof(char*)))) {
+            if (NULL == (ptr[i].keys = (char**)PMIX_BFROPS_UNPACK_CALLOC(buffer, nkeys+1, sizeof(char*)))) {
                 return PMIX_ERR_NOMEM;
             }
             /* unpack keys */
@@ -1200,7 +1289,10 @@ pmix_status_t pmix_bfrops_base_unpack_query(pmix_pointer_array_t *regtypes,
         }
         if (0 < ptr[i].nqual) {
             /* unpack the qualifiers */
-            PMIX_INFO_CREATE(ptr[i].qualifiers, ptr[i].nqual);
+            ptr[i].qualifiers = (pmix_info_t*)PMIX_BFROPS_UNPACK_CALLOC(buffer, ptr[i].nqual, sizeof(pmix_info_t));
+            if (NULL == ptr[i].qualifiers) {
+                return PMIX_ERR_NOMEM;
+            }
             m =  ptr[i].nqual;
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].qualifiers, &m, PMIX_INFO, regtypes);
             if (PMIX_SUCCESS != ret) {
@@ -1339,7 +1431,7 @@ pmix_status_t pmix_bfrops_base_unpack_regattr(pmix_pointer_array_t *regtypes,
             return PMIX_ERROR;
         }
         pmix_strncpy(ptr[i].string, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
+        PMIX_BFROPS_UNPACK_FREE(buffer, tmp);
         /* unpack the type */
         m=1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].type, &m, PMIX_DATA_TYPE, regtypes);
@@ -1356,7 +1448,10 @@ pmix_status_t pmix_bfrops_base_unpack_regattr(pmix_pointer_array_t *regtypes,
         }
         if (0 < ptr[i].ninfo) {
             /* unpack the info */
-            PMIX_INFO_CREATE(ptr[i].info, ptr[i].ninfo);
+            ptr[i].info = (pmix_info_t*)PMIX_BFROPS_UNPACK_CALLOC(buffer, ptr[i].ninfo, sizeof(pmix_info_t));
+            if (NULL == ptr[i].info) {
+                return PMIX_ERR_NOMEM;
+            }
             m =  ptr[i].ninfo;
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].info, &m, PMIX_INFO, regtypes);
             if (PMIX_SUCCESS != ret) {
@@ -1373,7 +1468,7 @@ pmix_status_t pmix_bfrops_base_unpack_regattr(pmix_pointer_array_t *regtypes,
         }
         if (0 < nd) {
             /* unpack the description */
-            if (NULL == (ptr[i].description = (char**)calloc(nd+1, sizeof(char*)))) {
+            if (NULL == (ptr[i].description = (char**)PMIX_BFROPS_UNPACK_CALLOC(buffer, nd+1, sizeof(char*)))) {
                 return PMIX_ERR_NOMEM;
             }
             m=nd;
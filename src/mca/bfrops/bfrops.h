@@ -11,7 +11,7 @@
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
  * Copyright (c) 2012      Los Alamos National Security, Inc. All rights reserved.
- * Copyright (c) 2013-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2013-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * Copyright (c) 2016      Mellanox Technologies, Inc.
@@ -378,6 +378,9 @@ typedef struct {
     pmix_bfrop_value_cmp_fn_t         value_cmp;
     pmix_bfrop_base_register_fn_t     register_type;
     pmix_bfrop_data_type_string_fn_t  data_type_string;
+    /* true if the module's unpack functions allocate from
+     * the buffer's arena when one is attached */
+    bool                              arena;
 } pmix_bfrops_module_t;
 
 
@@ -424,6 +427,32 @@ PMIX_EXPORT extern int pmix_bfrops_base_output;
         }                                                           \
     } while(0)
 
+/* Attach an arena to a buffer that is about to be unpacked so that
+ * all storage for the unpacked data comes from it, provided the
+ * peer's module supports arenas. Callers whose unpacked data does
+ * not outlive the request check (b)->arena afterwards - if it is
+ * set, they retain it and release it in place of freeing the data
+ * piece by piece. Top-level arrays the caller allocates itself can
+ * be taken from the arena with PMIX_BFROPS_ALLOC. */
+#define PMIX_BFROPS_USE_ARENA(p, b)                                 \
+    do {                                                            \
+        if (NULL == (b)->arena &&                                   \
+            (p)->nptr->compat.bfrops->arena) {                      \
+            (b)->arena = PMIX_NEW(pmix_arena_t);                    \
+        }                                                           \
+    } while(0)
+
+/* allocate zeroed storage for n elements of type t, from the
+ * buffer's arena if it has one */
+#define PMIX_BFROPS_ALLOC(d, b, n, t)                               \
+    do {                                                            \
+        if (NULL != (b)->arena) {                                   \
+            (d) = (t*)pmix_arena_calloc((b)->arena, (n), sizeof(t)); \
+        } else {                                                    \
+            (d) = (t*)calloc((n), sizeof(t));                       \
+        }                                                           \
+    } while(0)
+
 #define PMIX_BFROPS_COPY(r, p, d, s, t)             \
     (r) = (p)->nptr->compat.bfrops->copy(d, s, t)
 
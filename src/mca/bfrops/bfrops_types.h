@@ -12,7 +12,7 @@
  *                         All rights reserved.
  * Copyright (c) 2007-2011 Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2012-2013 Los Alamos National Security, Inc. All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -31,6 +31,7 @@
 #include <src/include/pmix_config.h>
 
 
+#include "src/class/pmix_arena.h"
 #include "src/class/pmix_object.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/class/pmix_list.h"
@@ -88,6 +89,9 @@ typedef struct {
     /** Number of bytes used by the buffer (i.e., amount of data --
         including overhead -- packed in the buffer) */
     size_t bytes_used;
+    /** If not NULL, unpacked data is allocated from this arena
+        instead of the heap - see PMIX_BFROPS_USE_ARENA */
+    pmix_arena_t *arena;
 } pmix_buffer_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_t);
 
@@ -13,7 +13,7 @@
  * Copyright (c) 2011-2014 Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2011-2013 Los Alamos National Security, LLC.  All rights
  *                         reserved.
- * Copyright (c) 2013-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2013-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2019      Mellanox Technologies, Inc.
  *                         All rights reserved.
  * $COPYRIGHT$
@@ -62,7 +62,8 @@ pmix_bfrops_module_t pmix_bfrops_pmix3_module = {
     .value_unload = pmix_bfrops_base_value_unload,
     .value_cmp = pmix_bfrops_base_value_cmp,
     .register_type = register_type,
-    .data_type_string = data_type_string
+    .data_type_string = data_type_string,
+    .arena = true
 };
 
 /* DEPRECATED data type values */
@@ -578,7 +579,7 @@ static pmix_status_t pmix3_bfrop_unpack_array(pmix_pointer_array_t *regtypes,
             return ret;
         }
         if (0 < ptr[i].size) {
-            ptr[i].array = (pmix_info_t*)malloc(ptr[i].size * sizeof(pmix_info_t));
+            ptr[i].array = (pmix_info_t*)PMIX_BFROPS_UNPACK_MALLOC(buffer, ptr[i].size * sizeof(pmix_info_t));
             m=ptr[i].size;
             if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_value(regtypes, buffer, ptr[i].array, &m, PMIX_INFO))) {
                 return ret;
@@ -610,7 +611,7 @@ static pmix_status_t pmix3_bfrop_unpack_modex(pmix_pointer_array_t *regtypes,
             return ret;
         }
         if (0 < ptr[i].size) {
-            ptr[i].blob = (uint8_t*)malloc(ptr[i].size * sizeof(uint8_t));
+            ptr[i].blob = (uint8_t*)PMIX_BFROPS_UNPACK_MALLOC(buffer, ptr[i].size * sizeof(uint8_t));
             m=ptr[i].size;
             if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_byte(regtypes, buffer, ptr[i].blob, &m, PMIX_UINT8))) {
                 return ret;
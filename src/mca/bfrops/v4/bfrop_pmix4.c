@@ -60,7 +60,8 @@ pmix_bfrops_module_t pmix_bfrops_pmix4_module = {
     .value_unload = pmix_bfrops_base_value_unload,
     .value_cmp = pmix_bfrops_base_value_cmp,
     .register_type = register_type,
-    .data_type_string = data_type_string
+    .data_type_string = data_type_string,
+    .arena = true
 };
 
 static pmix_status_t init(void)
@@ -48,6 +48,7 @@
 #include "src/util/pmix_environ.h"
 #include "src/util/hash.h"
 #include "src/mca/preg/preg.h"
+#include "src/atomics/sys/atomic.h"
 
 #include "src/mca/gds/base/base.h"
 #include "src/mca/pshmem/base/base.h"
@@ -61,6 +62,20 @@
 #define ESH_ENV_NS_META_SEG_SIZE    "NS_META_SEG_SIZE"
 #define ESH_ENV_NS_DATA_SEG_SIZE    "NS_DATA_SEG_SIZE"
 #define ESH_ENV_LINEAR              "SM_USE_LINEAR_SEARCH"
+#define ESH_ENV_NS_DATA_PER_PROC    "NS_DATA_SEG_BYTES_PER_PROC"
+
+/* the segments of a namespace may be sized for that namespace by the
+ * server, so their layout is derived from the first segment in the chain */
+#define _ESH_SEG_SIZE(segdesc) ((segdesc)->seg_info.seg_size)
+#define _ESH_SEG_MAX_META_ELEMS(segdesc) \
+    ((_ESH_SEG_SIZE(segdesc) - sizeof(size_t)) / sizeof(rank_meta_info))
+
+/* the generation counter of a session is kept in a header record in the
+ * first slot of its first initial segment, see dstore_base.h */
+#define ESH_SESSION_HDR_MARK        "PMIX_DSTORE_GEN"
+#define _ESH_SEG_NS_ELEM(segdesc, i)                                        \
+    ((ns_seg_info_t*)((uint8_t*)((segdesc)->seg_info.seg_base_addr) +      \
+                      sizeof(size_t) * 2 + (i) * sizeof(ns_seg_info_t)))
 
 #define ESH_INIT_SESSION_TBL_SIZE 2
 #define ESH_INIT_NS_MAP_TBL_SIZE  2
@@ -81,7 +96,22 @@ static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx,
                                            pmix_dstore_seg_desc_t *segdesc, size_t offset);
 static void _update_initial_segment_info(pmix_common_dstore_ctx_t *ds_ctx,
                                          const ns_map_data_t *ns_map);
+static void _esh_session_hdr_init(pmix_dstore_seg_desc_t *seg);
+static pmix_status_t _esh_view_hdr_init(pmix_common_dstore_ctx_t *ds_ctx);
+static bool _esh_value_view(pmix_common_dstore_ctx_t *ds_ctx, uint8_t *data_ptr,
+                            size_t data_size, pmix_value_t *val);
+static volatile size_t *_esh_session_gen(pmix_dstore_seg_desc_t *seg);
+static inline void _esh_session_gen_inc(pmix_common_dstore_ctx_t *ds_ctx, size_t tbl_idx);
+static ns_fetch_cache_t *_esh_fetch_cache_lookup(pmix_common_dstore_ctx_t *ds_ctx,
+                                                 const char *nspace);
+static void _esh_fetch_cache_update(pmix_common_dstore_ctx_t *ds_ctx,
+                                    const ns_map_data_t *ns_map, ns_track_elem_t *elem);
+static ns_key_index_t *_esh_key_index_get(pmix_common_dstore_ctx_t *ds_ctx,
+                                          const char *nspace, uint32_t nranks, bool create);
+static void _esh_key_index_del(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace);
 static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx);
+static void _get_ns_segment_sizes(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace,
+                                  size_t *meta_size, size_t *data_size);
 static inline ssize_t _get_univ_size(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace);
 
 static inline ns_map_data_t * _esh_session_map_search_server(pmix_common_dstore_ctx_t *ds_ctx,
@@ -531,12 +561,13 @@ static int _esh_session_init(pmix_common_dstore_ctx_t *ds_ctx, size_t idx, ns_ma
             }
         }
         seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_INITIAL_SEGMENT, ds_ctx->base_path,
-                                                   m->name, 0, ds_ctx->jobuid, ds_ctx->setjobuid);
+                                                   m->name, 0, 0, ds_ctx->jobuid, ds_ctx->setjobuid);
         if( NULL == seg ){
             rc = PMIX_ERR_OUT_OF_RESOURCE;
             PMIX_ERROR_LOG(rc);
             return rc;
         }
+        _esh_session_hdr_init(seg);
     }
     else {
         seg = pmix_common_dstor_attach_new_segment(PMIX_DSTORE_INITIAL_SEGMENT, ds_ctx->base_path, m->name, 0);
@@ -610,6 +641,9 @@ static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx)
             ds_ctx->direct_mode = 1;
         }
     }
+    if (NULL != (str = getenv(ESH_ENV_NS_DATA_PER_PROC))) {
+        ds_ctx->data_seg_bytes_per_proc = strtoul(str, NULL, 10);
+    }
 
     ds_ctx->lock_segment_size = page_size;
     ds_ctx->max_ns_num = (ds_ctx->initial_segment_size - sizeof(size_t) * 2) / sizeof(ns_seg_info_t);
@@ -620,6 +654,54 @@ static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx)
 
 }
 
+/* Pick the size of the first meta and data segments of a namespace so
+ * that the clients find all the data in a single segment instead of
+ * walking a chain of them. Only done if the expected amount of modex
+ * data per process was given - zero is returned otherwise and the
+ * default sizes are used. The sizes are never below the defaults. */
+static void _get_ns_segment_sizes(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace,
+                                  size_t *meta_size, size_t *data_size)
+{
+    pmix_namespace_t *ns, *nptr = NULL;
+    size_t page_size = pmix_common_dstor_getpagesize();
+    size_t size;
+
+    *meta_size = 0;
+    *data_size = 0;
+
+    if (0 == ds_ctx->data_seg_bytes_per_proc ||
+        !PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        return;
+    }
+    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
+        if (0 == strcmp(ns->nspace, nspace)) {
+            nptr = ns;
+            break;
+        }
+    }
+    if (NULL == nptr || 0 == nptr->nprocs) {
+        return;
+    }
+
+    /* one rank_meta_info per rank plus the one for the job-level info */
+    size = sizeof(size_t) + (nptr->nprocs + 1) * sizeof(rank_meta_info);
+    size = ((size + page_size - 1) / page_size) * page_size;
+    if (size > ds_ctx->meta_segment_size) {
+        *meta_size = size;
+    }
+    /* the job-level info is counted as one more process */
+    size = sizeof(size_t) + (nptr->nprocs + 1) * ds_ctx->data_seg_bytes_per_proc;
+    size = ((size + page_size - 1) / page_size) * page_size;
+    if (size > ds_ctx->data_segment_size) {
+        *data_size = size;
+    }
+
+    PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: nspace %s nprocs %lu: meta segment %lu data segment %lu",
+                         __FILE__, __LINE__, __func__, nspace, (unsigned long)nptr->nprocs,
+                         (unsigned long)*meta_size, (unsigned long)*data_size));
+}
+
 /* This function synchronizes the content of initial shared segment and the local track list. */
 static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_elem,
                            ns_seg_info_t *info)
@@ -627,6 +709,7 @@ static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns
     pmix_dstore_seg_desc_t *seg, *tmp = NULL;
     size_t i, offs;
     ns_map_data_t *ns_map = NULL;
+    size_t meta_size, data_size;
     pmix_status_t rc;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
@@ -646,11 +729,13 @@ static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns
         }
     }
 
+    _get_ns_segment_sizes(ds_ctx, info->ns_map.name, &meta_size, &data_size);
+
     /* synchronize number of meta segments for the target namespace. */
     for (i = ns_elem->num_meta_seg; i < info->num_meta_seg; i++) {
         if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
             seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_META_SEGMENT, ds_ctx->base_path,
-                                                       info->ns_map.name, i, ds_ctx->jobuid,
+                                                       info->ns_map.name, i, meta_size, ds_ctx->jobuid,
                                                        ds_ctx->setjobuid);
             if (NULL == seg) {
                 rc = PMIX_ERR_OUT_OF_RESOURCE;
@@ -685,7 +770,7 @@ static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns
     for (i = ns_elem->num_data_seg; i < info->num_data_seg; i++) {
         if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
             seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_DATA_SEGMENT, ds_ctx->base_path,
-                                                       info->ns_map.name, i, ds_ctx->jobuid,
+                                                       info->ns_map.name, i, data_size, ds_ctx->jobuid,
                                                        ds_ctx->setjobuid);
             if (NULL == seg) {
                 rc = PMIX_ERR_OUT_OF_RESOURCE;
@@ -755,6 +840,7 @@ static int _put_ns_info_to_initial_segment(pmix_common_dstore_ctx_t *ds_ctx,
     num_elems++;
     memcpy((uint8_t*)(_ESH_SESSION_sm_seg_last(ds_ctx->session_array, ns_map->tbl_idx)->seg_info.seg_base_addr),
            &num_elems, sizeof(size_t));
+    _esh_session_gen_inc(ds_ctx, ns_map->tbl_idx);
     return PMIX_SUCCESS;
 }
 
@@ -815,6 +901,164 @@ static ns_seg_info_t *_get_ns_info_from_initial_segment(pmix_common_dstore_ctx_t
     return elem;
 }
 
+/* server calls it on a new session: the first slot of the initial segment
+ * holds a header record that carries the generation counter. Its name
+ * starts with '\0', so it never matches a namespace lookup, and servers
+ * that don't maintain the counter never write such a record. */
+static void _esh_session_hdr_init(pmix_dstore_seg_desc_t *seg)
+{
+    ns_seg_info_t hdr;
+    size_t num_elems = 1;
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.ns_map.name + 1, ESH_SESSION_HDR_MARK, sizeof(ESH_SESSION_HDR_MARK));
+    hdr.num_meta_seg = 1;
+    memcpy(_ESH_SEG_NS_ELEM(seg, 0), &hdr, sizeof(hdr));
+    pmix_atomic_wmb();
+    memcpy(seg->seg_info.seg_base_addr, &num_elems, sizeof(size_t));
+}
+
+/* returns the generation counter of the session, or NULL if the server
+ * doesn't maintain one */
+static volatile size_t *_esh_session_gen(pmix_dstore_seg_desc_t *seg)
+{
+    ns_seg_info_t *hdr = _ESH_SEG_NS_ELEM(seg, 0);
+
+    if (0 == *((size_t*)(seg->seg_info.seg_base_addr)) ||
+        '\0' != hdr->ns_map.name[0] ||
+        0 != memcmp(hdr->ns_map.name + 1, ESH_SESSION_HDR_MARK, sizeof(ESH_SESSION_HDR_MARK))) {
+        return NULL;
+    }
+    return (volatile size_t*)&hdr->num_meta_seg;
+}
+
+/* server calls it (under the write lock) after adding a namespace to the
+ * initial segment or a segment to a namespace, so that the clients know
+ * they have to synchronize their local info again */
+static inline void _esh_session_gen_inc(pmix_common_dstore_ctx_t *ds_ctx, size_t tbl_idx)
+{
+    volatile size_t *gen = _esh_session_gen(_ESH_SESSION_sm_seg_first(ds_ctx->session_array,
+                                                                     tbl_idx));
+    if (NULL == gen) {
+        return;
+    }
+    /* the changes must be visible before the counter moves */
+    pmix_atomic_wmb();
+    (*gen)++;
+}
+
+static ns_fetch_cache_t *_esh_fetch_cache_lookup(pmix_common_dstore_ctx_t *ds_ctx,
+                                                 const char *nspace)
+{
+    ns_fetch_cache_t *fc = ds_ctx->fetch_cache;
+
+    pmix_atomic_rmb();
+    while (NULL != fc) {
+        if (0 == strcmp(fc->name, nspace)) {
+            return fc;
+        }
+        fc = fc->next;
+    }
+    return NULL;
+}
+
+/* clients call it with the ctx lock held once the segments of the
+ * namespace are synchronized with the initial segment */
+static void _esh_fetch_cache_update(pmix_common_dstore_ctx_t *ds_ctx,
+                                    const ns_map_data_t *ns_map, ns_track_elem_t *elem)
+{
+    volatile size_t *gen = _esh_session_gen(_ESH_SESSION_sm_seg_first(ds_ctx->session_array,
+                                                                     ns_map->tbl_idx));
+    ns_fetch_cache_t *fc;
+
+    if (NULL == gen) {
+        /* the server doesn't maintain the counter */
+        return;
+    }
+    fc = _esh_fetch_cache_lookup(ds_ctx, ns_map->name);
+    if (NULL != fc && 0 != fc->gen) {
+        fc->gen = *gen;
+        return;
+    }
+    /* invalidated entries stay in the list as someone may still be
+     * looking at them - just put the new one in front */
+    if (NULL == (fc = (ns_fetch_cache_t*)calloc(1, sizeof(ns_fetch_cache_t)))) {
+        return;
+    }
+    pmix_strncpy(fc->name, ns_map->name, PMIX_MAX_NSLEN);
+    fc->tbl_idx = ns_map->tbl_idx;
+    fc->session_gen = gen;
+    fc->gen = *gen;
+    fc->meta_seg = elem->meta_seg;
+    fc->data_seg = elem->data_seg;
+    fc->next = ds_ctx->fetch_cache;
+    pmix_atomic_wmb();
+    ds_ctx->fetch_cache = fc;
+}
+
+/* must be called with the key index lock held. The index may come
+ * back with fewer than nranks counts if they could not be grown */
+static ns_key_index_t *_esh_key_index_get(pmix_common_dstore_ctx_t *ds_ctx,
+                                          const char *nspace, uint32_t nranks, bool create)
+{
+    ns_key_index_t *ki;
+    size_t *counts;
+
+    for (ki = ds_ctx->key_index; NULL != ki; ki = ki->next) {
+        if (0 == strcmp(ki->name, nspace)) {
+            break;
+        }
+    }
+    if (NULL == ki) {
+        if (!create) {
+            return NULL;
+        }
+        if (NULL == (ki = (ns_key_index_t*)calloc(1, sizeof(ns_key_index_t)))) {
+            return NULL;
+        }
+        pmix_strncpy(ki->name, nspace, PMIX_MAX_NSLEN);
+        PMIX_CONSTRUCT(&ki->keys, pmix_hash_table_t);
+        pmix_hash_table_init(&ki->keys, 256);
+        ki->next = ds_ctx->key_index;
+        ds_ctx->key_index = ki;
+    }
+    if (nranks > ki->nranks) {
+        counts = (size_t*)realloc(ki->counts, nranks * sizeof(size_t));
+        if (NULL != counts) {
+            memset(counts + ki->nranks, 0, (nranks - ki->nranks) * sizeof(size_t));
+            ki->counts = counts;
+            ki->nranks = nranks;
+        }
+    }
+    return ki;
+}
+
+/* must be called with the key index lock held */
+static void _esh_key_index_del(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace)
+{
+    ns_key_index_t *ki, **prev = &ds_ctx->key_index;
+
+    for (ki = ds_ctx->key_index; NULL != ki; prev = &ki->next, ki = ki->next) {
+        if (0 == strcmp(ki->name, nspace)) {
+            *prev = ki->next;
+            PMIX_DESTRUCT(&ki->keys);
+            free(ki->counts);
+            free(ki);
+            return;
+        }
+    }
+}
+
+static inline void _esh_key_index_add(ns_key_index_t *ki, const char *kname, pmix_rank_t rank)
+{
+    size_t len = strnlen(kname, PMIX_MAX_KEYLEN+1);
+    void *ptr;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&ki->keys, kname, len, &ptr)) {
+        pmix_hash_table_set_value_ptr(&ki->keys, kname, len, (void*)(uintptr_t)rank);
+    }
+}
+
 static ns_track_elem_t *_get_track_elem_for_namespace(pmix_common_dstore_ctx_t *ds_ctx,
                                                       ns_map_data_t *ns_map)
 {
@@ -842,6 +1086,7 @@ static ns_track_elem_t *_get_track_elem_for_namespace(pmix_common_dstore_ctx_t *
     }
     PMIX_CONSTRUCT(new_elem, ns_track_elem_t);
     pmix_strncpy(new_elem->ns_map.name, ns_map->name, sizeof(new_elem->ns_map.name)-1);
+    new_elem->ns_map.tbl_idx = ns_map->tbl_idx;
     /* save latest track idx to info of nspace */
     ns_map->track_idx = size;
 
@@ -882,8 +1127,8 @@ static rank_meta_info *_get_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, pmi
     } else {
         /* directly compute index of meta segment (id) and relative offset (rel_offset)
          * inside this segment for fast lookup a rank_meta_info object for the requested rank. */
-        id = rcount/ds_ctx->max_meta_elems;
-        rel_offset = (rcount % ds_ctx->max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
+        id = rcount/_ESH_SEG_MAX_META_ELEMS(segdesc);
+        rel_offset = (rcount % _ESH_SEG_MAX_META_ELEMS(segdesc)) * sizeof(rank_meta_info) + sizeof(size_t);
         /* go through all existing meta segments for this namespace.
          * Stop at id number if it exists. */
         while (NULL != tmp->next && 0 != id) {
@@ -928,7 +1173,7 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
             tmp = tmp->next;
         }
         num_elems = *((size_t*)(tmp->seg_info.seg_base_addr));
-        if (ds_ctx->max_meta_elems <= num_elems) {
+        if (_ESH_SEG_MAX_META_ELEMS(ns_info->meta_seg) <= num_elems) {
             PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
                         "%s:%d:%s: extend meta segment for nspace %s",
                         __FILE__, __LINE__, __func__, ns_info->ns_map.name));
@@ -949,6 +1194,7 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
             }
             if (ns_info->num_meta_seg != elem->num_meta_seg) {
                 elem->num_meta_seg = ns_info->num_meta_seg;
+                _esh_session_gen_inc(ds_ctx, ns_info->ns_map.tbl_idx);
             }
             num_elems = 0;
         }
@@ -960,8 +1206,8 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
         /* directly compute index of meta segment (id) and relative offset (rel_offset)
          * inside this segment for fast lookup a rank_meta_info object for the requested rank. */
         size_t rcount = rinfo->rank == PMIX_RANK_WILDCARD ? 0 : rinfo->rank + 1;
-        id = rcount/ds_ctx->max_meta_elems;
-        rel_offset = (rcount % ds_ctx->max_meta_elems) * sizeof(rank_meta_info) + sizeof(size_t);
+        id = rcount/_ESH_SEG_MAX_META_ELEMS(ns_info->meta_seg);
+        rel_offset = (rcount % _ESH_SEG_MAX_META_ELEMS(ns_info->meta_seg)) * sizeof(rank_meta_info) + sizeof(size_t);
         count = id;
         /* go through all existing meta segments for this namespace.
          * Stop at id number if it exists. */
@@ -990,6 +1236,7 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
             }
             if (ns_info->num_meta_seg != elem->num_meta_seg) {
                 elem->num_meta_seg = ns_info->num_meta_seg;
+                _esh_session_gen_inc(ds_ctx, ns_info->ns_map.tbl_idx);
             }
         }
         /* store rank_meta_info object by rel_offset. */
@@ -1011,8 +1258,8 @@ static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx, pmi
 
     /* go through all existing data segments for this namespace */
     do {
-        if (rel_offset >= ds_ctx->data_segment_size) {
-            rel_offset -= ds_ctx->data_segment_size;
+        if (rel_offset >= _ESH_SEG_SIZE(segdesc)) {
+            rel_offset -= _ESH_SEG_SIZE(segdesc);
         } else {
             dataaddr = tmp->seg_info.seg_base_addr + rel_offset;
         }
@@ -1038,7 +1285,7 @@ static size_t get_free_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_
         /* this is the first created data segment, the first 8 bytes are used to place the free offset value itself */
         offset = sizeof(size_t);
     }
-    return (id * ds_ctx->data_segment_size + offset);
+    return (id * _ESH_SEG_SIZE(data_seg) + offset);
 }
 
 static int put_empty_ext_slot(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *dataseg)
@@ -1048,8 +1295,8 @@ static int put_empty_ext_slot(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_
     pmix_status_t rc;
 
     global_offset = get_free_offset(ds_ctx, dataseg);
-    rel_offset = global_offset % ds_ctx->data_segment_size;
-    if (rel_offset + PMIX_DS_SLOT_SIZE(ds_ctx) > ds_ctx->data_segment_size) {
+    rel_offset = global_offset % _ESH_SEG_SIZE(dataseg);
+    if (rel_offset + PMIX_DS_SLOT_SIZE(ds_ctx) > _ESH_SEG_SIZE(dataseg)) {
         PMIX_ERROR_LOG(PMIX_ERROR);
         return PMIX_ERROR;
     }
@@ -1085,12 +1332,12 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
         id++;
     }
     global_offset = get_free_offset(ds_ctx, dataseg);
-    offset = global_offset % ds_ctx->data_segment_size;
+    offset = global_offset % _ESH_SEG_SIZE(dataseg);
 
     /* We should provide additional space at the end of segment to
      * place EXTENSION_SLOT to have an ability to enlarge data for this rank.*/
     if ((sizeof(size_t) + PMIX_DS_KEY_SIZE(ds_ctx, key, size) + PMIX_DS_SLOT_SIZE(ds_ctx)) >
-            ds_ctx->data_segment_size) {
+            _ESH_SEG_SIZE(dataseg)) {
         /* this is an error case: segment is so small that cannot place evem a single key-value pair.
          * warn a user about it and fail. */
         offset = 0; /* offset cannot be 0 in normal case, so we use this value to indicate a problem. */
@@ -1108,7 +1355,7 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
      * so if offset is 0 here - we need to allocate the segment as well
      */
     if ( (0 == offset) || ( (offset + PMIX_DS_KEY_SIZE(ds_ctx, key, size) +
-                             PMIX_DS_SLOT_SIZE(ds_ctx)) > ds_ctx->data_segment_size) ) {
+                             PMIX_DS_SLOT_SIZE(ds_ctx)) > _ESH_SEG_SIZE(dataseg)) ) {
         id++;
         /* create a new data segment. */
         tmp = pmix_common_dstor_extend_segment(tmp, ds_ctx->base_path, ns_info->ns_map.name,
@@ -1127,9 +1374,10 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
             return offset;
         }
         elem->num_data_seg++;
+        _esh_session_gen_inc(ds_ctx, ns_info->ns_map.tbl_idx);
         offset = sizeof(size_t);
     }
-    global_offset = offset + id * ds_ctx->data_segment_size;
+    global_offset = offset + id * _ESH_SEG_SIZE(dataseg);
     addr = (uint8_t*)(tmp->seg_info.seg_base_addr)+offset;
     PMIX_DS_PUT_KEY(rc, ds_ctx, addr, key, buffer, size);
     if (rc != PMIX_SUCCESS) {
@@ -1146,7 +1394,7 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
                          __FILE__, __LINE__, __func__,
                          key, (unsigned long)offset,
                          (unsigned long)data_ended,
-                         (unsigned long)(id * ds_ctx->data_segment_size),
+                         (unsigned long)(id * _ESH_SEG_SIZE(dataseg)),
                          (unsigned long)size));
     return global_offset;
 }
@@ -1158,7 +1406,9 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
     pmix_buffer_t buffer;
     pmix_status_t rc;
     pmix_dstore_seg_desc_t *datadesc;
-    uint8_t *addr;
+    uint8_t *addr, *data_ptr;
+    size_t data_size;
+    pmix_value_t view;
 
     PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
                          "%s:%d:%s: for rank %u, replace flag %d",
@@ -1256,8 +1506,18 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                 PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                             "%s:%d:%s: for rank %u, replace flag %d found target key %s",
                             __FILE__, __LINE__, __func__, rank, data_exist, kval->key));
-                /* target key is found, compare value sizes */
-                if (PMIX_DS_DATA_SIZE(ds_ctx, addr, PMIX_DS_DATA_PTR(ds_ctx, addr)) != size) {
+                /* target key is found, compare value sizes. Byte objects and
+                 * strings may be viewed by the clients without the lock held
+                 * (see pmix_common_dstor_fetch_view), so a value is never
+                 * overwritten in place when either the stored or the new one
+                 * is of those types - the old value stays intact until the
+                 * namespace goes away. */
+                data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+                data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
+                if (data_size != size ||
+                    PMIX_BYTE_OBJECT == kval->value->type || PMIX_STRING == kval->value->type ||
+                    PMIX_SUCCESS != _esh_view_hdr_init(ds_ctx) ||
+                    _esh_value_view(ds_ctx, data_ptr, data_size, &view)) {
                 //if (1) { /* if we want to test replacing values for existing keys. */
                     /* invalidate current value and store another one at the end of data region. */
                     PMIX_DS_KEY_SET_INVALID(ds_ctx, addr);
@@ -1338,7 +1598,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                 }
 
                 /* Calculate the offset of the end of the extension slot */
-                offs_cur_segment = free_offset % ds_ctx->data_segment_size;
+                offs_cur_segment = free_offset % _ESH_SEG_SIZE(datadesc);
                 segstart = ldesc->seg_info.seg_base_addr;
                 offs_past_extslot = (addr + PMIX_DS_KV_SIZE(ds_ctx, addr)) - segstart;
 
@@ -1557,6 +1817,7 @@ pmix_common_dstore_ctx_t *pmix_common_dstor_init(const char *ds_name, pmix_info_
         return NULL;
     }
     memset(ds_ctx, 0, sizeof(*ds_ctx));
+    pthread_mutex_init(&ds_ctx->key_index_lock, NULL);
 
     /* assign lock callbacks */
     ds_ctx->lock_cbs = lock_cb;
@@ -1580,7 +1841,7 @@ pmix_common_dstore_ctx_t *pmix_common_dstor_init(const char *ds_name, pmix_info_
         goto err_exit;
     }
 
-    rc = pmix_pshmem.init();
+    rc = pmix_pshmem.init(info, ninfo);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto err_exit;
@@ -1750,10 +2011,19 @@ PMIX_EXPORT void pmix_common_dstor_finalize(pmix_common_dstore_ctx_t *ds_ctx)
 {
     struct stat st = {0};
     pmix_status_t rc = PMIX_SUCCESS;
+    ns_fetch_cache_t *fc;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                          "%s:%d:%s", __FILE__, __LINE__, __func__));
 
+    while (NULL != (fc = ds_ctx->fetch_cache)) {
+        ds_ctx->fetch_cache = fc->next;
+        free(fc);
+    }
+    while (NULL != ds_ctx->key_index) {
+        _esh_key_index_del(ds_ctx, ds_ctx->key_index->name);
+    }
+    pthread_mutex_destroy(&ds_ctx->key_index_lock);
     _esh_sessions_cleanup(ds_ctx);
     _esh_ns_map_cleanup(ds_ctx);
     _esh_ns_track_cleanup(ds_ctx);
@@ -1834,8 +2104,8 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
         }
 
         /* zero created shared memory segments for this namespace */
-        memset(elem->meta_seg->seg_info.seg_base_addr, 0, ds_ctx->meta_segment_size);
-        memset(elem->data_seg->seg_info.seg_base_addr, 0, ds_ctx->data_segment_size);
+        memset(elem->meta_seg->seg_info.seg_base_addr, 0, _ESH_SEG_SIZE(elem->meta_seg));
+        memset(elem->data_seg->seg_info.seg_base_addr, 0, _ESH_SEG_SIZE(elem->data_seg));
 
         /* put ns's shared segments info to the global meta segment. */
         rc = _put_ns_info_to_initial_segment(ds_ctx, ns_map, &elem->meta_seg->seg_info, &elem->data_seg->seg_info);
@@ -1925,48 +2195,44 @@ exit:
     return rc;
 }
 
-static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
-                                   const char *nspace, pmix_rank_t rank,
-                                   const char *key, pmix_value_t **kvs)
+/* Make sure the local info about the segments of the namespace is in sync
+ * with the initial segment. On success, return with the shared lock of the
+ * session held along with the heads of the meta and data segment chains. */
+static pmix_status_t _esh_fetch_prepare(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace,
+                                        size_t *tbl_idx, pmix_dstore_seg_desc_t **meta_seg,
+                                        pmix_dstore_seg_desc_t **data_seg)
 {
     ns_seg_info_t *ns_info = NULL;
-    pmix_status_t rc = PMIX_ERROR, lock_rc;
+    pmix_status_t rc, lock_rc;
     ns_track_elem_t *elem;
-    rank_meta_info *rinfo = NULL;
-    size_t kval_cnt = 0;
-    pmix_dstore_seg_desc_t *meta_seg, *data_seg;
-    uint8_t *addr;
-    pmix_buffer_t buffer;
-    pmix_value_t val, *kval = NULL;
-    uint32_t nprocs;
-    pmix_rank_t cur_rank;
     ns_map_data_t *ns_map = NULL;
-    bool all_ranks_found = true;
-    bool key_found = false;
-    pmix_info_t *info = NULL;
-    size_t ninfo;
-    size_t keyhash = 0;
+    ns_fetch_cache_t *fcache;
     bool lock_is_set = false;
 
-    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                         "%s:%d:%s: for %s:%u look for key %s",
-                         __FILE__, __LINE__, __func__, nspace, rank, key));
-
-    if ((PMIX_RANK_UNDEF == rank) && (NULL == key)) {
-        PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
-                             "dstore: Does not support passed parameters"));
-        rc = PMIX_ERR_BAD_PARAM;
-        goto error;
+    /* If the generation of the session didn't move since we synchronized
+     * the segments of this namespace, nothing was added to the initial
+     * segment or to the segment chains - skip the synchronization below
+     * and the ctx lock it requires. */
+    if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
+        NULL != (fcache = _esh_fetch_cache_lookup(ds_ctx, nspace))) {
+        lock_rc = _ESH_LOCK(ds_ctx, fcache->tbl_idx, rd_lock);
+        if (PMIX_SUCCESS != lock_rc) {
+            return lock_rc;
+        }
+        if (fcache->gen == *fcache->session_gen) {
+            pmix_atomic_rmb();
+            *tbl_idx = fcache->tbl_idx;
+            *meta_seg = fcache->meta_seg;
+            *data_seg = fcache->data_seg;
+            return PMIX_SUCCESS;
+        }
+        _ESH_LOCK(ds_ctx, fcache->tbl_idx, rd_unlock);
     }
 
-    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
-                         "%s:%d:%s: for %s:%u look for key %s",
-                         __FILE__, __LINE__, __func__, nspace, rank, key));
-
     /* protect info of dstore segments before it will be updated */
     if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
         if (0 != (rc = pthread_mutex_lock(&ds_ctx->lock))) {
-            goto error;
+            return PMIX_ERROR;
         }
         lock_is_set = true;
     }
@@ -1979,23 +2245,6 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
         goto error;
     }
 
-    if (NULL == kvs) {
-        rc = PMIX_ERR_FATAL;
-        goto error;
-    }
-
-    if (PMIX_RANK_UNDEF == rank) {
-        ssize_t _nprocs = _get_univ_size(ds_ctx, ns_map->name);
-        if( 0 > _nprocs ){
-            goto error;
-        }
-        nprocs = (size_t) _nprocs;
-        cur_rank = 0;
-    } else {
-        nprocs = 1;
-        cur_rank = rank;
-    }
-
     /* grab shared lock */
     lock_rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, rd_lock);
     if (PMIX_SUCCESS != lock_rc) {
@@ -2026,7 +2275,7 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                     "%s:%d:%s:  no data for ns %s is found in the shared memory.",
                     __FILE__, __LINE__, __func__, ns_map->name));
         rc = PMIX_ERR_PROC_ENTRY_NOT_FOUND;
-        goto done;
+        goto unlock;
     }
 
     /* get ns_track_elem_t object for the target namespace from the local track list. */
@@ -2035,7 +2284,7 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
         /* Shouldn't happen! */
         rc = PMIX_ERR_FATAL;
         PMIX_ERROR_LOG(rc);
-        goto done;
+        goto unlock;
     }
 
     /* need to update tracker:
@@ -2044,23 +2293,122 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
     rc = _update_ns_elem(ds_ctx, elem, ns_info);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto done;
+        goto unlock;
     }
 
     /* Now we have the data from meta segment for this namespace. */
-    meta_seg = elem->meta_seg;
-    data_seg = elem->data_seg;
+    *tbl_idx = ns_map->tbl_idx;
+    *meta_seg = elem->meta_seg;
+    *data_seg = elem->data_seg;
 
-    if( NULL != key ) {
-        keyhash = PMIX_DS_KEY_HASH(ds_ctx, key);
+    /* all segment data updated, ctx lock may released */
+    if (lock_is_set) {
+        _esh_fetch_cache_update(ds_ctx, ns_map, elem);
+        pthread_mutex_unlock(&ds_ctx->lock);
     }
+    return PMIX_SUCCESS;
 
-    /* all segment data updated, ctx lock may released */
+unlock:
+    lock_rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, rd_unlock);
+    if (PMIX_SUCCESS != lock_rc) {
+        PMIX_ERROR_LOG(lock_rc);
+    }
+error:
     if (lock_is_set) {
-        lock_is_set = false;
-        if (0 != (rc = pthread_mutex_unlock(&ds_ctx->lock))) {
+        pthread_mutex_unlock(&ds_ctx->lock);
+    }
+    return rc;
+}
+
+static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
+                                   const char *nspace, pmix_rank_t rank,
+                                   const char *key, pmix_value_t **kvs)
+{
+    pmix_status_t rc = PMIX_ERROR, lock_rc;
+    rank_meta_info *rinfo = NULL;
+    size_t kval_cnt = 0;
+    pmix_dstore_seg_desc_t *meta_seg, *data_seg;
+    uint8_t *addr;
+    pmix_buffer_t buffer;
+    pmix_value_t val, *kval = NULL;
+    uint32_t nprocs;
+    pmix_rank_t cur_rank;
+    bool all_ranks_found = true;
+    bool key_found = false;
+    pmix_info_t *info = NULL;
+    size_t ninfo;
+    size_t keyhash = 0;
+    size_t tbl_idx;
+    ns_key_index_t *kidx = NULL;
+    bool have_owner = false;
+    pmix_rank_t owner;
+    void *ptr;
+
+    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: for %s:%u look for key %s",
+                         __FILE__, __LINE__, __func__, nspace, rank, key));
+
+    if ((PMIX_RANK_UNDEF == rank) && (NULL == key)) {
+        PMIX_OUTPUT_VERBOSE((7, pmix_gds_base_framework.framework_output,
+                             "dstore: Does not support passed parameters"));
+        rc = PMIX_ERR_BAD_PARAM;
+        goto error;
+    }
+
+    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: for %s:%u look for key %s",
+                         __FILE__, __LINE__, __func__, nspace, rank, key));
+
+    if (NULL == kvs) {
+        rc = PMIX_ERR_FATAL;
+        goto error;
+    }
+
+    if (PMIX_RANK_UNDEF == rank) {
+        /* this is a fetch by itself, so do it before taking any lock */
+        ssize_t _nprocs = _get_univ_size(ds_ctx, nspace);
+        if( 0 > _nprocs ){
             goto error;
         }
+        nprocs = (size_t) _nprocs;
+        cur_rank = 0;
+        /* go straight to the rank the key was seen at */
+        pthread_mutex_lock(&ds_ctx->key_index_lock);
+        kidx = _esh_key_index_get(ds_ctx, nspace, 0, false);
+        if (NULL != kidx &&
+            PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&kidx->keys, key, strlen(key), &ptr)) {
+            owner = (pmix_rank_t)(uintptr_t)ptr;
+            have_owner = true;
+        }
+        pthread_mutex_unlock(&ds_ctx->key_index_lock);
+        kidx = NULL;
+        if (have_owner) {
+            rc = _dstore_fetch(ds_ctx, nspace, owner, key, kvs);
+            if (PMIX_SUCCESS == rc) {
+                return rc;
+            }
+            /* the data moved - fall back to searching every rank */
+        }
+    } else {
+        nprocs = 1;
+        cur_rank = rank;
+    }
+
+    rc = _esh_fetch_prepare(ds_ctx, nspace, &tbl_idx, &meta_seg, &data_seg);
+    if (PMIX_ERR_PROC_ENTRY_NOT_FOUND == rc) {
+        return rc;
+    } else if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+
+    if( NULL != key ) {
+        keyhash = PMIX_DS_KEY_HASH(ds_ctx, key);
+    }
+
+    if (PMIX_RANK_UNDEF == rank) {
+        /* held until done - index the keys of the ranks we walk */
+        pthread_mutex_lock(&ds_ctx->key_index_lock);
+        kidx = _esh_key_index_get(ds_ctx, nspace, nprocs, true);
     }
 
     while (nprocs--) {
@@ -2071,6 +2419,15 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                         "%s:%d:%s:  no data for this rank is found in the shared memory. rank %u",
                         __FILE__, __LINE__, __func__, cur_rank));
             all_ranks_found = false;
+            if (PMIX_RANK_UNDEF == rank) {
+                cur_rank++;
+            }
+            continue;
+        }
+        if (NULL != kidx && !have_owner && cur_rank < kidx->nranks &&
+            kidx->counts[cur_rank] == rinfo->count) {
+            /* all keys of this rank are indexed and ours isn't one of them */
+            cur_rank++;
             continue;
         }
         addr = _get_data_region_by_offset(ds_ctx, data_seg, rinfo->offset);
@@ -2186,6 +2543,9 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                 PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                             "%s:%d:%s: for rank %s:%u, found target key %s",
                             __FILE__, __LINE__, __func__, nspace, cur_rank, key));
+                if (NULL != kidx) {
+                    _esh_key_index_add(kidx, key, cur_rank);
+                }
                 /* target key is found, get value */
                 uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
                 size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
@@ -2209,29 +2569,33 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                             "%s:%d:%s: for rank %s:%u, skip key %s look for key %s",
                             __FILE__, __LINE__, __func__, nspace, cur_rank,
                             PMIX_DS_KNAME_PTR(ds_ctx, addr), key));
+                if (NULL != kidx) {
+                    _esh_key_index_add(kidx, PMIX_DS_KNAME_PTR(ds_ctx, addr), cur_rank);
+                }
                 /* go to next item, updating address */
                 addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
                 kval_cnt--;
             }
         }
 
+        if (NULL != kidx && cur_rank < kidx->nranks) {
+            kidx->counts[cur_rank] = rinfo->count;
+        }
         if (PMIX_RANK_UNDEF == rank) {
             cur_rank++;
         }
     }
 
 done:
+    if (PMIX_RANK_UNDEF == rank) {
+        pthread_mutex_unlock(&ds_ctx->key_index_lock);
+    }
     /* unset lock */
-    lock_rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, rd_unlock);
+    lock_rc = _ESH_LOCK(ds_ctx, tbl_idx, rd_unlock);
     if (PMIX_SUCCESS != lock_rc) {
         PMIX_ERROR_LOG(lock_rc);
     }
 
-    /* unset ds_ctx lock */
-    if (lock_is_set) {
-        pthread_mutex_unlock(&ds_ctx->lock);
-    }
-
     if( rc != PMIX_SUCCESS ){
         if ((NULL == key) && (kval_cnt > 0)) {
             if( NULL != info ) {
@@ -2260,9 +2624,6 @@ done:
     return rc;
 
 error:
-    if (lock_is_set) {
-        pthread_mutex_unlock(&ds_ctx->lock);
-    }
     PMIX_ERROR_LOG(rc);
     return rc;
 }
@@ -2329,6 +2690,360 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_c
     return rc;
 }
 
+typedef struct {
+    const pmix_proc_t *proc;
+    size_t idx;
+} dstor_multi_proc_t;
+
+static int _multi_proc_cmp(const void *a, const void *b)
+{
+    const pmix_proc_t *pa = ((const dstor_multi_proc_t*)a)->proc;
+    const pmix_proc_t *pb = ((const dstor_multi_proc_t*)b)->proc;
+    size_t ra, rb;
+    int rc;
+
+    if (0 != (rc = strncmp(pa->nspace, pb->nspace, PMIX_MAX_NSLEN))) {
+        return rc;
+    }
+    /* same order as the rank meta info in the meta segments */
+    ra = (PMIX_RANK_WILDCARD == pa->rank) ? 0 : pa->rank + 1;
+    rb = (PMIX_RANK_WILDCARD == pb->rank) ? 0 : pb->rank + 1;
+    return (ra < rb) ? -1 : (ra > rb);
+}
+
+PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch_multi(pmix_common_dstore_ctx_t *ds_ctx,
+                                                        const pmix_proc_t procs[], size_t nprocs,
+                                                        const pmix_key_t keys[], size_t nkeys,
+                                                        pmix_value_t vals[], pmix_status_t status[])
+{
+    dstor_multi_proc_t *order;
+    size_t *keyhash;
+    size_t n, k, tbl_idx = 0, kval_cnt, left, nfound = 0;
+    pmix_dstore_seg_desc_t *meta_seg = NULL, *data_seg = NULL;
+    const char *nspace = NULL;
+    rank_meta_info *rinfo;
+    pmix_value_t *pvals;
+    pmix_status_t *pstatus;
+    pmix_buffer_t buffer;
+    pmix_status_t rc, lock_rc;
+    bool locked = false;
+    uint8_t *addr;
+    int cnt;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "gds: dstore fetch multi for %lu procs %lu keys",
+                        (unsigned long)nprocs, (unsigned long)nkeys);
+
+    for (n = 0; n < nprocs * nkeys; n++) {
+        status[n] = PMIX_ERR_NOT_FOUND;
+    }
+    order = (dstor_multi_proc_t*)malloc(nprocs * sizeof(dstor_multi_proc_t));
+    keyhash = (size_t*)malloc(nkeys * sizeof(size_t));
+    if (NULL == order || NULL == keyhash) {
+        free(order);
+        free(keyhash);
+        return PMIX_ERR_NOMEM;
+    }
+    for (k = 0; k < nkeys; k++) {
+        keyhash[k] = PMIX_DS_KEY_HASH(ds_ctx, keys[k]);
+    }
+    /* visit the procs namespace by namespace in the order their
+     * data is laid out, so each namespace is locked only once */
+    for (n = 0; n < nprocs; n++) {
+        order[n].proc = &procs[n];
+        order[n].idx = n;
+    }
+    qsort(order, nprocs, sizeof(dstor_multi_proc_t), _multi_proc_cmp);
+
+    for (n = 0; n < nprocs; n++) {
+        if (NULL == nspace || 0 != strncmp(nspace, order[n].proc->nspace, PMIX_MAX_NSLEN)) {
+            if (locked) {
+                lock_rc = _ESH_LOCK(ds_ctx, tbl_idx, rd_unlock);
+                if (PMIX_SUCCESS != lock_rc) {
+                    PMIX_ERROR_LOG(lock_rc);
+                }
+                locked = false;
+            }
+            nspace = order[n].proc->nspace;
+            rc = _esh_fetch_prepare(ds_ctx, nspace, &tbl_idx, &meta_seg, &data_seg);
+            /* otherwise there is nothing for this namespace - leave
+             * its entries to the caller */
+            locked = (PMIX_SUCCESS == rc);
+        }
+        if (!locked || PMIX_RANK_UNDEF == order[n].proc->rank) {
+            continue;
+        }
+        if (NULL == (rinfo = _get_rank_meta_info(ds_ctx, order[n].proc->rank, meta_seg))) {
+            continue;
+        }
+        if (NULL == (addr = _get_data_region_by_offset(ds_ctx, data_seg, rinfo->offset))) {
+            /* This means that meta-info is broken */
+            PMIX_ERROR_LOG(PMIX_ERR_FATAL);
+            continue;
+        }
+        pvals = &vals[order[n].idx * nkeys];
+        pstatus = &status[order[n].idx * nkeys];
+        kval_cnt = rinfo->count;
+        left = nkeys;
+        /* a single pass over the data of this rank for all the keys */
+        while (0 < kval_cnt && 0 < left) {
+            if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+                addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+            } else if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
+                size_t offset;
+                memcpy(&offset, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
+                if (0 == offset) {
+                    /* no more data for this rank */
+                    break;
+                }
+                if (NULL == (addr = _get_data_region_by_offset(ds_ctx, data_seg, offset))) {
+                    PMIX_ERROR_LOG(PMIX_ERR_FATAL);
+                    break;
+                }
+            } else {
+                for (k = 0; k < nkeys; k++) {
+                    if (PMIX_SUCCESS == pstatus[k] ||
+                        !PMIX_DS_KEY_MATCH(ds_ctx, addr, keys[k], keyhash[k])) {
+                        continue;
+                    }
+                    uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+                    size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
+                    PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
+                    PMIX_LOAD_BUFFER(_client_peer(ds_ctx), &buffer, data_ptr, data_size);
+                    cnt = 1;
+                    PMIX_BFROPS_UNPACK(rc, _client_peer(ds_ctx), &buffer, &pvals[k], &cnt, PMIX_VALUE);
+                    buffer.base_ptr = NULL;
+                    buffer.bytes_used = 0;
+                    PMIX_DESTRUCT(&buffer);
+                    if (PMIX_SUCCESS != rc) {
+                        PMIX_ERROR_LOG(rc);
+                        PMIX_VALUE_DESTRUCT(&pvals[k]);
+                        PMIX_VALUE_CONSTRUCT(&pvals[k]);
+                        continue;
+                    }
+                    pstatus[k] = PMIX_SUCCESS;
+                    nfound++;
+                    left--;
+                }
+                addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+                kval_cnt--;
+            }
+        }
+    }
+    if (locked) {
+        lock_rc = _ESH_LOCK(ds_ctx, tbl_idx, rd_unlock);
+        if (PMIX_SUCCESS != lock_rc) {
+            PMIX_ERROR_LOG(lock_rc);
+        }
+    }
+    free(order);
+    free(keyhash);
+
+    return (nprocs * nkeys == nfound) ? PMIX_SUCCESS : PMIX_ERR_NOT_FOUND;
+}
+
+/* Pack an empty byte object and an empty string with the bfrops of our
+ * peer to learn what precedes the payload of such values in the store */
+static pmix_status_t _esh_view_hdr_init(pmix_common_dstore_ctx_t *ds_ctx)
+{
+    pmix_value_t probe;
+    pmix_buffer_t buffer;
+    pmix_status_t rc = PMIX_SUCCESS;
+    int i;
+
+    if (ds_ctx->view_hdr_set) {
+        return PMIX_SUCCESS;
+    }
+    if (0 != pthread_mutex_lock(&ds_ctx->lock)) {
+        return PMIX_ERROR;
+    }
+    for (i = 0; i < 2 && !ds_ctx->view_hdr_set; i++) {
+        PMIX_VALUE_CONSTRUCT(&probe);
+        if (0 == i) {
+            probe.type = PMIX_BYTE_OBJECT;
+        } else {
+            probe.type = PMIX_STRING;
+            probe.data.string = "";
+        }
+        PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
+        PMIX_BFROPS_PACK(rc, _client_peer(ds_ctx), &buffer, &probe, 1, PMIX_VALUE);
+        if (PMIX_SUCCESS == rc) {
+            /* leave the terminating NULL of the string out */
+            ds_ctx->view_hdr_len[i] = buffer.bytes_used - i;
+            if (PMIX_DS_VIEW_HDR_MAX < ds_ctx->view_hdr_len[i]) {
+                rc = PMIX_ERR_NOT_SUPPORTED;
+            } else {
+                memcpy(ds_ctx->view_hdr[i], buffer.base_ptr, ds_ctx->view_hdr_len[i]);
+            }
+        }
+        PMIX_DESTRUCT(&buffer);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    if (PMIX_SUCCESS == rc && !ds_ctx->view_hdr_set) {
+        pmix_atomic_wmb();
+        ds_ctx->view_hdr_set = true;
+    }
+    pthread_mutex_unlock(&ds_ctx->lock);
+    return rc;
+}
+
+/* Point the value at the payload of a stored byte object or string. The
+ * payload is the tail of the packed value, preceded by its size - a
+ * size_t for byte objects and an int32 including the terminating NULL
+ * for strings - stored in network byte order. Everything ahead of the
+ * size must match the packed empty value of the same type. */
+static bool _esh_value_view(pmix_common_dstore_ctx_t *ds_ctx, uint8_t *data_ptr,
+                            size_t data_size, pmix_value_t *val)
+{
+    static const size_t szlen[2] = {sizeof(uint64_t), sizeof(int32_t)};
+    uint64_t sz;
+    size_t hlen, n;
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        hlen = ds_ctx->view_hdr_len[i];
+        if (data_size < hlen || hlen < szlen[i] ||
+            0 != memcmp(data_ptr, ds_ctx->view_hdr[i], hlen - szlen[i])) {
+            continue;
+        }
+        sz = 0;
+        for (n = hlen - szlen[i]; n < hlen; n++) {
+            sz = (sz << 8) | data_ptr[n];
+        }
+        if (sz != data_size - hlen) {
+            continue;
+        }
+        if (0 == i) {
+            val->type = PMIX_BYTE_OBJECT;
+            val->data.bo.bytes = (char*)(data_ptr + hlen);
+            val->data.bo.size = sz;
+            return true;
+        }
+        if (0 < sz && '\0' == data_ptr[data_size - 1]) {
+            val->type = PMIX_STRING;
+            val->data.string = (char*)(data_ptr + hlen);
+            return true;
+        }
+    }
+    return false;
+}
+
+PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch_view(pmix_common_dstore_ctx_t *ds_ctx,
+                                                       const pmix_proc_t *proc, const char *key,
+                                                       pmix_value_t **val)
+{
+    pmix_dstore_seg_desc_t *meta_seg, *data_seg;
+    rank_meta_info *rinfo;
+    size_t tbl_idx, kval_cnt, keyhash;
+    pmix_value_t view;
+    pmix_status_t rc, lock_rc;
+    uint8_t *addr;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "gds: dstore fetch view `%s`", key == NULL ? "NULL" : key);
+
+    /* views are only handed out to the clients, and only for a single key
+     * of a specific proc */
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) ||
+        NULL == key || PMIX_RANK_UNDEF == proc->rank) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    if (PMIX_SUCCESS != (rc = _esh_view_hdr_init(ds_ctx))) {
+        return rc;
+    }
+    pmix_atomic_rmb();
+
+    rc = _esh_fetch_prepare(ds_ctx, proc->nspace, &tbl_idx, &meta_seg, &data_seg);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    rc = PMIX_ERR_NOT_FOUND;
+    keyhash = PMIX_DS_KEY_HASH(ds_ctx, key);
+    if (NULL == (rinfo = _get_rank_meta_info(ds_ctx, proc->rank, meta_seg))) {
+        rc = PMIX_ERR_PROC_ENTRY_NOT_FOUND;
+        goto done;
+    }
+    if (NULL == (addr = _get_data_region_by_offset(ds_ctx, data_seg, rinfo->offset))) {
+        rc = PMIX_ERR_FATAL;
+        PMIX_ERROR_LOG(rc);
+        goto done;
+    }
+    kval_cnt = rinfo->count;
+    while (0 < kval_cnt) {
+        if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        } else if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
+            size_t offset;
+            memcpy(&offset, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
+            if (0 == offset) {
+                break;
+            }
+            if (NULL == (addr = _get_data_region_by_offset(ds_ctx, data_seg, offset))) {
+                rc = PMIX_ERR_FATAL;
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+        } else if (PMIX_DS_KEY_MATCH(ds_ctx, addr, key, keyhash)) {
+            uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+            size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
+            PMIX_VALUE_CONSTRUCT(&view);
+            if (!_esh_value_view(ds_ctx, data_ptr, data_size, &view)) {
+                /* anything else has to be unpacked */
+                rc = PMIX_ERR_NOT_SUPPORTED;
+                break;
+            }
+            *val = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+            if (NULL == *val) {
+                rc = PMIX_ERR_NOMEM;
+                break;
+            }
+            memcpy(*val, &view, sizeof(pmix_value_t));
+            rc = pmix_gds_base_view_track(*val);
+            break;
+        } else {
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+            kval_cnt--;
+        }
+    }
+
+done:
+    lock_rc = _ESH_LOCK(ds_ctx, tbl_idx, rd_unlock);
+    if (PMIX_SUCCESS != lock_rc) {
+        PMIX_ERROR_LOG(lock_rc);
+    }
+    return rc;
+}
+
+PMIX_EXPORT pmix_status_t pmix_common_dstor_mem_usage(pmix_common_dstore_ctx_t *ds_ctx,
+                                                      const char *nspace, size_t *bytes)
+{
+    ns_map_data_t *ns_map;
+    ns_track_elem_t *trk;
+    pmix_dstore_seg_desc_t *seg;
+
+    *bytes = 0;
+    /* only the server knows which segments belong to an nspace */
+    if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) || NULL == ds_ctx->ns_track_array) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    if (NULL == (ns_map = ds_ctx->session_map_search(ds_ctx, nspace)) ||
+        0 > ns_map->track_idx ||
+        ns_map->track_idx >= (int)pmix_value_array_get_size(ds_ctx->ns_track_array)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    trk = pmix_value_array_get_item(ds_ctx->ns_track_array, ns_map->track_idx);
+    for (seg = trk->meta_seg; NULL != seg; seg = seg->next) {
+        *bytes += seg->seg_info.seg_size;
+    }
+    for (seg = trk->data_seg; NULL != seg; seg = seg->next) {
+        *bytes += seg->seg_info.seg_size;
+    }
+    return PMIX_SUCCESS;
+}
+
 PMIX_EXPORT pmix_status_t pmix_common_dstor_setup_fork(pmix_common_dstore_ctx_t *ds_ctx, const char *base_path_env,
                                            const pmix_proc_t *peer, char ***env)
 {
@@ -2446,6 +3161,7 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_del_nspace(pmix_common_dstore_ctx_t
     ns_track_elem_t *trk = NULL;
     int dstor_track_idx;
     size_t session_tbl_idx;
+    ns_fetch_cache_t *fc;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
         "%s:%d:%s delete nspace `%s`", __FILE__, __LINE__, __func__, nspace));
@@ -2454,6 +3170,13 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_del_nspace(pmix_common_dstore_ctx_t
         rc = PMIX_ERR_NOT_AVAILABLE;
         return rc;
     }
+    /* the segments of the namespace are going away */
+    if (NULL != (fc = _esh_fetch_cache_lookup(ds_ctx, nspace))) {
+        fc->gen = 0;
+    }
+    pthread_mutex_lock(&ds_ctx->key_index_lock);
+    _esh_key_index_del(ds_ctx, nspace);
+    pthread_mutex_unlock(&ds_ctx->key_index_lock);
     dstor_track_idx = ns_map_data->track_idx;
     session_tbl_idx = ns_map_data->tbl_idx;
     size = pmix_value_array_get_size(ds_ctx->ns_map_array);
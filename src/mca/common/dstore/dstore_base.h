@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2017      Mellanox Technologies, Inc.
  *                         All rights reserved.
  * $COPYRIGHT$
@@ -15,6 +15,7 @@
 #include <src/include/pmix_config.h>
 
 
+#include "src/class/pmix_hash_table.h"
 #include "src/mca/gds/gds.h"
 #include "src/mca/pshmem/pshmem.h"
 
@@ -30,12 +31,16 @@ BEGIN_C_DECLS
 #define NS_META_SEG_SIZE (1<<22)
 #define NS_DATA_SEG_SIZE (1<<22)
 
+#define PMIX_DS_VIEW_HDR_MAX 64
+
 #define PMIX_DSTORE_ESH_BASE_PATH "PMIX_DSTORE_ESH_BASE_PATH"
 #define PMIX_DSTORE_VER_BASE_PATH_FMT "PMIX_DSTORE_%d_BASE_PATH"
 
 typedef struct ns_map_data_s ns_map_data_t;
 typedef struct session_s session_t;
 typedef struct ns_map_s ns_map_t;
+typedef struct ns_fetch_cache_s ns_fetch_cache_t;
+typedef struct ns_key_index_s ns_key_index_t;
 
 typedef ns_map_data_t * (*session_map_search_fn_t)(pmix_common_dstore_ctx_t *ds_ctx,
                                                    const char *nspace);
@@ -60,6 +65,9 @@ struct pmix_common_dstore_ctx_s {
 
     size_t max_ns_num;
     size_t max_meta_elems;
+    /* expected amount of data per process used to size
+     * the segments of a namespace, 0 to use the defaults */
+    size_t data_seg_bytes_per_proc;
 
     session_map_search_fn_t session_map_search;
     pmix_peer_t *clients_peer;
@@ -73,6 +81,19 @@ struct pmix_common_dstore_ctx_s {
     int direct_mode;
     /* dstore ctx protect lock, uses for clients only */
     pthread_mutex_t lock;
+    /* clients only: namespaces already synchronized with the initial
+     * segment, walked without taking the ctx lock */
+    ns_fetch_cache_t * volatile fetch_cache;
+    /* clients only: owners of the keys seen by rank-undefined
+     * fetches, protected by key_index_lock */
+    pthread_mutex_t key_index_lock;
+    ns_key_index_t *key_index;
+    /* clients only: packed form of an empty byte object and an empty
+     * string value, used to locate the payload of stored values that
+     * are handed out as views */
+    volatile bool view_hdr_set;
+    uint8_t view_hdr[2][PMIX_DS_VIEW_HDR_MAX];
+    size_t view_hdr_len[2];
 };
 
 struct session_s {
@@ -100,6 +121,12 @@ struct ns_map_s {
  * size_t num_elems;
  * size_t full; //indicate to client that it needs to attach to the next segment
  * ns_seg_info_t ns_seg_info[max_ns_num];
+ *
+ * In the first initial segment of a session, ns_seg_info[0] is a header
+ * record if its name is "\0" ESH_SESSION_HDR_MARK. Its num_meta_seg field
+ * is then the generation of the session, incremented by the server each
+ * time a namespace or a meta/data segment is added. Sessions without the
+ * record are served by a server that doesn't maintain the counter.
  */
 
 typedef struct {
@@ -134,6 +161,31 @@ typedef struct {
     pmix_common_dstor_lock_ctx_t *lock;
 } lock_track_item_t;
 
+/* entries are only added and never freed before finalize, so
+ * that the clients can look them up without holding the ctx lock */
+struct ns_fetch_cache_s {
+    ns_fetch_cache_t *next;
+    char name[PMIX_MAX_NSLEN+1];
+    size_t tbl_idx;
+    volatile size_t *session_gen;
+    /* generation the segments of the namespace were synchronized at */
+    volatile size_t gen;
+    pmix_dstore_seg_desc_t *meta_seg;
+    pmix_dstore_seg_desc_t *data_seg;
+};
+
+/* the segments are written by the server, so the clients build
+ * their key index while walking them for rank-undefined fetches */
+struct ns_key_index_s {
+    ns_key_index_t *next;
+    char name[PMIX_MAX_NSLEN+1];
+    /* key -> owning rank, the first rank found holding a key wins */
+    pmix_hash_table_t keys;
+    /* number of keys each rank held when it was last fully indexed */
+    uint32_t nranks;
+    size_t *counts;
+};
+
 END_C_DECLS
 
 #endif
@@ -1,7 +1,7 @@
 /*
  * Copyright (c) 2018-2019 Mellanox Technologies, Inc.
  *                         All rights reserved.
- * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * Copyright (c) 2018-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2018      IBM Corporation.  All rights reserved.
  * $COPYRIGHT$
  *
@@ -73,6 +73,15 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_c
                                 const char *key,
                                 pmix_info_t info[], size_t ninfo,
                                 pmix_list_t *kvs);
+PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch_multi(pmix_common_dstore_ctx_t *ds_ctx,
+                                const pmix_proc_t procs[], size_t nprocs,
+                                const pmix_key_t keys[], size_t nkeys,
+                                pmix_value_t vals[], pmix_status_t status[]);
+PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch_view(pmix_common_dstore_ctx_t *ds_ctx,
+                                const pmix_proc_t *proc, const char *key,
+                                pmix_value_t **val);
+PMIX_EXPORT pmix_status_t pmix_common_dstor_mem_usage(pmix_common_dstore_ctx_t *ds_ctx,
+                                const char *nspace, size_t *bytes);
 PMIX_EXPORT pmix_status_t pmix_common_dstor_store_modex(pmix_common_dstore_ctx_t *ds_ctx,
                                 struct pmix_namespace_t *nspace,
                                 pmix_buffer_t *buff,
@@ -162,11 +162,10 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_lock_seg(const
 
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_dstore_segment_type type,
                         const char *base_path, const char *name, uint32_t id,
-                        uid_t uid, bool setuid)
+                        size_t size, uid_t uid, bool setuid)
 {
     pmix_status_t rc;
     char file_name[PMIX_PATH_MAX];
-    size_t size;
     pmix_dstore_seg_desc_t *new_seg = NULL;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
@@ -175,16 +174,21 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_ds
 
     switch (type) {
         case PMIX_DSTORE_INITIAL_SEGMENT:
+            /* the initial segment size must be known to the clients */
             size = _initial_segment_size;
             snprintf(file_name, PMIX_PATH_MAX, "%s/initial-pmix_shared-segment-%u",
                 base_path, id);
             break;
         case PMIX_DSTORE_NS_META_SEGMENT:
-            size = _meta_segment_size;
+            if (0 == size) {
+                size = _meta_segment_size;
+            }
             snprintf(file_name, PMIX_PATH_MAX, "%s/smseg-%s-%u", base_path, name, id);
             break;
         case PMIX_DSTORE_NS_DATA_SEGMENT:
-            size = _data_segment_size;
+            if (0 == size) {
+                size = _data_segment_size;
+            }
             snprintf(file_name, PMIX_PATH_MAX, "%s/smdataseg-%s-%d", base_path, name, id);
             break;
         default:
@@ -201,7 +205,7 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_ds
             PMIX_ERROR_LOG(rc);
             goto err_exit;
         }
-        memset(new_seg->seg_info.seg_base_addr, 0, size);
+        memset(new_seg->seg_info.seg_base_addr, 0, new_seg->seg_info.seg_size);
 
         if (setuid > 0){
             rc = PMIX_ERR_PERM;
@@ -245,13 +249,15 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_ds
             snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/initial-pmix_shared-segment-%u",
                 base_path, id);
             break;
+        /* the namespace segments may have been sized by the server
+         * for the particular namespace - take the size from the segment */
         case PMIX_DSTORE_NS_META_SEGMENT:
-            new_seg->seg_info.seg_size = _meta_segment_size;
+            new_seg->seg_info.seg_size = 0;
             snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/smseg-%s-%u",
                 base_path, name, id);
             break;
         case PMIX_DSTORE_NS_DATA_SEGMENT:
-            new_seg->seg_info.seg_size = _data_segment_size;
+            new_seg->seg_info.seg_size = 0;
             snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/smdataseg-%s-%d",
                 base_path, name, id);
             break;
@@ -282,8 +288,9 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_extend_segment(pmix_dstore
     while (NULL != tmp->next) {
         tmp = tmp->next;
     }
-    /* create another segment, the old one is full. */
-    seg = pmix_common_dstor_create_new_segment(segdesc->type, base_path, name, tmp->id + 1, uid, setuid);
+    /* create another segment of the same size, the old one is full. */
+    seg = pmix_common_dstor_create_new_segment(segdesc->type, base_path, name, tmp->id + 1,
+                                               tmp->seg_info.seg_size, uid, setuid);
     tmp->next = seg;
 
     return seg;
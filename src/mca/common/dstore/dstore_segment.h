@@ -54,7 +54,7 @@ PMIX_EXPORT void pmix_common_dstor_init_segment_info(size_t initial_segment_size
                         size_t data_segment_size);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_dstore_segment_type type,
                         const char *base_path, const char *name, uint32_t id,
-                        uid_t uid, bool setuid);
+                        size_t size, uid_t uid, bool setuid);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_dstore_segment_type type,
                         const char *base_path,
                         const char *name, uint32_t id);
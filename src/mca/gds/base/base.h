@@ -38,6 +38,8 @@
 #endif
 
 #include "src/class/pmix_list.h"
+#include "src/class/pmix_hash_table.h"
+#include "src/threads/mutex.h"
 #include "src/mca/mca.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
 
@@ -76,6 +78,9 @@ struct pmix_gds_globals_t {
   pmix_list_t actives;
   bool initialized;
   char *all_mods;
+  /* values handed out as views into module storage */
+  pmix_hash_table_t views;
+  pmix_mutex_t views_lock;
 };
 typedef struct pmix_gds_globals_t pmix_gds_globals_t;
 
@@ -112,6 +117,15 @@ PMIX_EXPORT pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nsp
                                                     pmix_gds_base_store_modex_cb_fn_t cb_fn,
                                                     void *cbdata);
 
+/* Track a value whose data points into the storage of a module
+ * rather than into memory owned by the value */
+PMIX_EXPORT pmix_status_t pmix_gds_base_view_track(pmix_value_t *val);
+
+/* If the value was tracked as a view, stop tracking it and free the
+ * value without touching the data it points to. Returns false if
+ * the value isn't a view, leaving it to the caller to release */
+PMIX_EXPORT bool pmix_gds_base_view_release(pmix_value_t *val);
+
 END_C_DECLS
 
 #endif
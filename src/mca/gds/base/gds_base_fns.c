@@ -231,3 +231,37 @@ error:
 
     return rc;
 }
+
+pmix_status_t pmix_gds_base_view_track(pmix_value_t *val)
+{
+    pmix_status_t rc;
+
+    pmix_mutex_lock(&pmix_gds_globals.views_lock);
+    rc = pmix_hash_table_set_value_uint64(&pmix_gds_globals.views,
+                                          (uint64_t)(uintptr_t)val, val);
+    pmix_mutex_unlock(&pmix_gds_globals.views_lock);
+    return rc;
+}
+
+bool pmix_gds_base_view_release(pmix_value_t *val)
+{
+    void *ptr;
+    bool found = false;
+
+    if (!pmix_gds_globals.initialized) {
+        return false;
+    }
+    pmix_mutex_lock(&pmix_gds_globals.views_lock);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&pmix_gds_globals.views,
+                                                         (uint64_t)(uintptr_t)val, &ptr)) {
+        pmix_hash_table_remove_value_uint64(&pmix_gds_globals.views,
+                                            (uint64_t)(uintptr_t)val);
+        found = true;
+    }
+    pmix_mutex_unlock(&pmix_gds_globals.views_lock);
+    if (found) {
+        /* the data belongs to the module */
+        free(val);
+    }
+    return found;
+}
@@ -32,6 +32,7 @@
 #endif
 
 #include "src/class/pmix_list.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/util/argv.h"
 
 #include "src/mca/base/base.h"
@@ -66,6 +67,8 @@ static pmix_status_t pmix_gds_close(void)
       PMIX_RELEASE(active);
     }
     PMIX_DESTRUCT(&pmix_gds_globals.actives);
+    PMIX_DESTRUCT(&pmix_gds_globals.views);
+    PMIX_DESTRUCT(&pmix_gds_globals.views_lock);
 
     if (NULL != pmix_gds_globals.all_mods) {
         free(pmix_gds_globals.all_mods);
@@ -81,6 +84,9 @@ static pmix_status_t pmix_gds_open(pmix_mca_base_open_flag_t flags)
     pmix_gds_globals.initialized = true;
     pmix_gds_globals.all_mods = NULL;
     PMIX_CONSTRUCT(&pmix_gds_globals.actives, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_gds_globals.views, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_gds_globals.views, 32);
+    PMIX_CONSTRUCT(&pmix_gds_globals.views_lock, pmix_mutex_t);
 
     /* Open up all available components */
     rc = pmix_mca_base_framework_components_open(&pmix_gds_base_framework, flags);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2016-2018 IBM Corporation.  All rights reserved.
  * Copyright (c) 2016-2019 Mellanox Technologies, Inc.
  *                         All rights reserved.
@@ -134,6 +134,24 @@ static pmix_status_t ds12_fetch(const pmix_proc_t *proc,
     return pmix_common_dstor_fetch(ds12_ctx, proc, scope, copy, key, info, ninfo, kvs);
 }
 
+static pmix_status_t ds12_fetch_multi(const pmix_proc_t procs[], size_t nprocs,
+                                      const pmix_key_t keys[], size_t nkeys,
+                                      pmix_value_t vals[], pmix_status_t status[])
+{
+    return pmix_common_dstor_fetch_multi(ds12_ctx, procs, nprocs, keys, nkeys, vals, status);
+}
+
+static pmix_status_t ds12_fetch_view(const pmix_proc_t *proc, const char *key,
+                                     pmix_value_t **val)
+{
+    return pmix_common_dstor_fetch_view(ds12_ctx, proc, key, val);
+}
+
+static pmix_status_t ds12_mem_usage(const char *nspace, size_t *bytes)
+{
+    return pmix_common_dstor_mem_usage(ds12_ctx, nspace, bytes);
+}
+
 static pmix_status_t ds12_setup_fork(const pmix_proc_t *peer, char ***env)
 {
     return pmix_common_dstor_setup_fork(ds12_ctx, PMIX_DSTORE_ESH_BASE_PATH, peer, env);
@@ -166,5 +184,8 @@ pmix_gds_base_module_t pmix_ds12_module = {
     .setup_fork = ds12_setup_fork,
     .add_nspace = ds12_add_nspace,
     .del_nspace = ds12_del_nspace,
+    .fetch_multi = ds12_fetch_multi,
+    .fetch_view = ds12_fetch_view,
+    .mem_usage = ds12_mem_usage,
 };
 
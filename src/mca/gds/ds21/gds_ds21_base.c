@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2016-2018 IBM Corporation.  All rights reserved.
  * Copyright (c) 2016-2019 Mellanox Technologies, Inc.
  *                         All rights reserved.
@@ -122,6 +122,24 @@ static pmix_status_t ds21_fetch(const pmix_proc_t *proc,
     return pmix_common_dstor_fetch(ds21_ctx, proc, scope, copy, key, info, ninfo, kvs);
 }
 
+static pmix_status_t ds21_fetch_multi(const pmix_proc_t procs[], size_t nprocs,
+                                      const pmix_key_t keys[], size_t nkeys,
+                                      pmix_value_t vals[], pmix_status_t status[])
+{
+    return pmix_common_dstor_fetch_multi(ds21_ctx, procs, nprocs, keys, nkeys, vals, status);
+}
+
+static pmix_status_t ds21_fetch_view(const pmix_proc_t *proc, const char *key,
+                                     pmix_value_t **val)
+{
+    return pmix_common_dstor_fetch_view(ds21_ctx, proc, key, val);
+}
+
+static pmix_status_t ds21_mem_usage(const char *nspace, size_t *bytes)
+{
+    return pmix_common_dstor_mem_usage(ds21_ctx, nspace, bytes);
+}
+
 static pmix_status_t ds21_setup_fork(const pmix_proc_t *peer, char ***env)
 {
     pmix_status_t rc;
@@ -172,5 +190,8 @@ pmix_gds_base_module_t pmix_ds21_module = {
     .setup_fork = ds21_setup_fork,
     .add_nspace = ds21_add_nspace,
     .del_nspace = ds21_del_nspace,
+    .fetch_multi = ds21_fetch_multi,
+    .fetch_view = ds21_fetch_view,
+    .mem_usage = ds21_mem_usage,
 };
 
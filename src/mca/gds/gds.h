@@ -2,7 +2,7 @@
 /*
  * Copyright (c) 2016-2019 Mellanox Technologies, Inc.
  *                         All rights reserved.
- * Copyright (c) 2016-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2016-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2018      IBM Corporation.  All rights reserved.
  * $COPYRIGHT$
  *
@@ -22,6 +22,7 @@
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/mca/bfrops/bfrops_types.h"
+#include "src/util/opstats.h"
 
 
 /* The client dictates the GDS module that will be used to interact
@@ -131,6 +132,45 @@ typedef pmix_status_t (*pmix_gds_base_module_cache_job_info_fn_t)(struct pmix_na
        (s) = _g->cache_job_info((struct pmix_namespace_t*)(n), (i), (ni));     \
     } while(0)
 
+/* SERVER FN: split form of cache_job_info for use when registering
+ * large jobs. prep_job_info parses the info into a private object and
+ * touches no shared state, so it can be called from any thread.
+ * publish_job_info must then be called from the progress thread to
+ * make the prepared data visible for the nspace - it returns
+ * PMIX_ERR_NOT_AVAILABLE if the data cannot be published (e.g., data
+ * for the nspace is already present), in which case the caller should
+ * fall back to cache_job_info. The caller releases the prepared object
+ * in either case. Both are optional - modules that do not provide them
+ * leave them NULL */
+typedef pmix_status_t (*pmix_gds_base_module_prep_job_info_fn_t)(const char *nspace,
+                                                                 pmix_info_t info[], size_t ninfo,
+                                                                 pmix_object_t **job);
+typedef pmix_status_t (*pmix_gds_base_module_publish_job_info_fn_t)(struct pmix_namespace_t *ns,
+                                                                    pmix_object_t *job);
+
+/* define convenience macros for preparing and publishing job info */
+#define PMIX_GDS_PREP_JOB_INFO(s, p, n, i, ni, j)                           \
+    do {                                                                    \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds;                 \
+        if (NULL != _g->prep_job_info && NULL != _g->publish_job_info) {    \
+            pmix_output_verbose(1, pmix_gds_base_output,                    \
+                                "[%s:%d] GDS PREP JOB INFO WITH %s",        \
+                                __FILE__, __LINE__, _g->name);              \
+            (s) = _g->prep_job_info((n), (i), (ni), (j));                   \
+        } else {                                                            \
+            (s) = PMIX_ERR_NOT_SUPPORTED;                                   \
+        }                                                                   \
+    } while(0)
+
+#define PMIX_GDS_PUBLISH_JOB_INFO(s, p, n, j)                               \
+    do {                                                                    \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds;                 \
+        pmix_output_verbose(1, pmix_gds_base_output,                        \
+                            "[%s:%d] GDS PUBLISH JOB INFO WITH %s",         \
+                            __FILE__, __LINE__, _g->name);                  \
+        (s) = _g->publish_job_info((struct pmix_namespace_t*)(n), (j));     \
+    } while(0)
+
 /* register job-level info - this is provided as a special function
  * to allow for optimization. Called solely by the server. We cannot
  * prepare the job-level info provided at PMIx_Register_nspace, because
@@ -218,10 +258,13 @@ typedef pmix_status_t (*pmix_gds_base_module_store_fn_t)(const pmix_proc_t *proc
 #define PMIX_GDS_STORE_KV(s, p, pc, sc, k)                  \
     do {                                                    \
         pmix_gds_base_module_t *_g = (p)->nptr->compat.gds; \
+        uint64_t _ts;                                       \
         pmix_output_verbose(1, pmix_gds_base_output,        \
                             "[%s:%d] GDS STORE KV WITH %s", \
                             __FILE__, __LINE__, _g->name);  \
+        PMIX_OPSTATS_START(_ts);                            \
         (s) = _g->store(pc, sc, k);                         \
+        PMIX_OPSTATS_STOP(PMIX_OPSTATS_GDS_STORE, _ts);     \
     } while(0)
 
 
@@ -310,17 +353,105 @@ typedef pmix_status_t (*pmix_gds_base_module_fetch_fn_t)(const pmix_proc_t *proc
                                                          pmix_info_t info[], size_t ninfo,
                                                          pmix_list_t *kvs);
 
+/**
+* fetch the values of a set of keys for a set of procs in one operation.
+* Optional - modules that cannot do better than repeated calls to fetch
+* shall leave it NULL.
+*
+* @param procs   array of procs whose info is being requested
+*
+* @param nprocs  number of elements in the procs array
+*
+* @param keys    array of keys to fetch for each proc
+*
+* @param nkeys   number of elements in the keys array
+*
+* @param vals    array of nprocs * nkeys constructed values, ordered by
+*                proc and then by key, that will be loaded with the data
+*
+* @param status  array of nprocs * nkeys elements that will be set to
+*                the status of each entry
+*
+* @return       PMIX_SUCCESS if all entries were found, or
+*               PMIX_ERR_NOT_FOUND if at least one of them wasn't
+*/
+typedef pmix_status_t (*pmix_gds_base_module_fetch_multi_fn_t)(const pmix_proc_t procs[], size_t nprocs,
+                                                               const pmix_key_t keys[], size_t nkeys,
+                                                               pmix_value_t vals[], pmix_status_t status[]);
+
+/**
+* fetch a read-only view of a byte object or string value - i.e., a
+* value whose data points directly into the storage of the module
+* instead of being copied out of it. Optional - modules that cannot
+* share their storage shall leave it NULL.
+*
+* The returned value is tracked by the gds base and must be released
+* with pmix_gds_base_view_release. Its data remains valid for as long
+* as the nspace of the proc is known to the module - modules must store
+* updated values elsewhere rather than overwrite the data in place, as
+* views are read without any lock held.
+*
+* @param proc   proc whose info is being requested
+*
+* @param key    key to fetch
+*
+* @param val    pointer to the location where the view will be returned
+*
+* @return       PMIX_SUCCESS if a view was returned, PMIX_ERR_NOT_SUPPORTED
+*               if the value exists but cannot be returned as a view, or
+*               an error if the value couldn't be found
+*/
+typedef pmix_status_t (*pmix_gds_base_module_fetch_view_fn_t)(const pmix_proc_t *proc,
+                                                              const char *key,
+                                                              pmix_value_t **val);
+
 /* define a convenience macro for fetch key-val pairs based on peer,
  * passing a pmix_cb_t containing all the required info */
 #define PMIX_GDS_FETCH_KV(s, p, c)      \
     do {                                                    \
         pmix_gds_base_module_t *_g = (p)->nptr->compat.gds; \
+        uint64_t _ts;                                       \
         pmix_output_verbose(1, pmix_gds_base_output,        \
                             "[%s:%d] GDS FETCH KV WITH %s", \
                             __FILE__, __LINE__, _g->name);  \
+        PMIX_OPSTATS_START(_ts);                            \
         (s) = _g->fetch((c)->proc, (c)->scope, (c)->copy,   \
                         (c)->key, (c)->info, (c)->ninfo,    \
                         &(c)->kvs);                         \
+        PMIX_OPSTATS_STOP(PMIX_OPSTATS_GDS_FETCH, _ts);     \
+    } while(0)
+
+
+/* define a convenience macro for fetching a set of keys for a set of
+ * procs based on peer - returns PMIX_ERR_NOT_SUPPORTED if the module
+ * doesn't support it */
+#define PMIX_GDS_FETCH_MULTI(s, p, pr, np, k, nk, v, st)            \
+    do {                                                            \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds;         \
+        pmix_output_verbose(1, pmix_gds_base_output,                \
+                            "[%s:%d] GDS FETCH MULTI WITH %s",      \
+                            __FILE__, __LINE__, _g->name);          \
+        if (NULL == _g->fetch_multi) {                              \
+            (s) = PMIX_ERR_NOT_SUPPORTED;                           \
+        } else {                                                    \
+            (s) = _g->fetch_multi(pr, np, k, nk, v, st);            \
+        }                                                           \
+    } while(0)
+
+
+/* define a convenience macro for fetching a view of a value based on
+ * peer - returns PMIX_ERR_NOT_SUPPORTED if the module doesn't support it */
+#define PMIX_GDS_FETCH_VIEW(s, p, pr, k, v)                         \
+    do {                                                            \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds;         \
+        pmix_output_verbose(1, pmix_gds_base_output,                \
+                            "[%s:%d] GDS FETCH VIEW WITH %s",       \
+                            __FILE__, __LINE__, _g->name);          \
+        if (NULL == _g->fetch_view) {                               \
+            (s) = PMIX_ERR_NOT_SUPPORTED;                           \
+        } else {                                                    \
+            (s) = _g->fetch_view(pr, k, v);                         \
+        }                                                           \
     } while(0)
 
 
@@ -409,6 +540,14 @@ typedef pmix_status_t (*pmix_gds_base_module_del_nspace_fn_t)(const char* nspace
         }                                                   \
 } while(0)
 
+/**
+ * report the approximate number of bytes held by this module for
+ * the given nspace. This is optional - modules that cannot say
+ * leave it NULL
+ */
+typedef pmix_status_t (*pmix_gds_base_module_mem_usage_fn_t)(const char *nspace,
+                                                             size_t *bytes);
+
 /**
 * structure for gds modules
 */
@@ -429,6 +568,11 @@ typedef struct {
     pmix_gds_base_module_del_nspace_fn_t            del_nspace;
     pmix_gds_base_module_assemb_kvs_req_fn_t        assemb_kvs_req;
     pmix_gds_base_module_accept_kvs_resp_fn_t       accept_kvs_resp;
+    pmix_gds_base_module_fetch_multi_fn_t           fetch_multi;
+    pmix_gds_base_module_fetch_view_fn_t            fetch_view;
+    pmix_gds_base_module_mem_usage_fn_t             mem_usage;
+    pmix_gds_base_module_prep_job_info_fn_t         prep_job_info;
+    pmix_gds_base_module_publish_job_info_fn_t      publish_job_info;
 
 } pmix_gds_base_module_t;
 
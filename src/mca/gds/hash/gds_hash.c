@@ -95,6 +95,15 @@ static pmix_status_t assemb_kvs_req(const pmix_proc_t *proc,
 
 static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf);
 
+static pmix_status_t hash_mem_usage(const char *nspace, size_t *bytes);
+
+static pmix_status_t hash_prep_job_info(const char *nspace,
+                                        pmix_info_t info[], size_t ninfo,
+                                        pmix_object_t **job);
+
+static pmix_status_t hash_publish_job_info(struct pmix_namespace_t *ns,
+                                           pmix_object_t *job);
+
 pmix_gds_base_module_t pmix_hash_module = {
     .name = "hash",
     .is_tsafe = false,
@@ -111,7 +120,10 @@ pmix_gds_base_module_t pmix_hash_module = {
     .add_nspace = nspace_add,
     .del_nspace = nspace_del,
     .assemb_kvs_req = assemb_kvs_req,
-    .accept_kvs_resp = accept_kvs_resp
+    .accept_kvs_resp = accept_kvs_resp,
+    .mem_usage = hash_mem_usage,
+    .prep_job_info = hash_prep_job_info,
+    .publish_job_info = hash_publish_job_info
 };
 
 typedef struct {
@@ -122,6 +134,7 @@ typedef struct {
     pmix_hash_table_t remote;
     pmix_hash_table_t local;
     bool gdata_added;
+    pmix_rank_t nprocs; // job size found while preparing the tracker
 } pmix_hash_trkr_t;
 
 static void htcon(pmix_hash_trkr_t *p)
@@ -135,6 +148,7 @@ static void htcon(pmix_hash_trkr_t *p)
     PMIX_CONSTRUCT(&p->local, pmix_hash_table_t);
     pmix_hash_table_init(&p->local, 256);
     p->gdata_added = false;
+    p->nprocs = 0;
 }
 static void htdes(pmix_hash_trkr_t *p)
 {
@@ -362,13 +376,12 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
     return PMIX_SUCCESS;
 }
 
-pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
-                                  pmix_info_t info[], size_t ninfo)
+/* parse the job info into the given hash table */
+static pmix_status_t parse_job_info(pmix_hash_table_t *ht,
+                                    pmix_info_t info[], size_t ninfo,
+                                    pmix_rank_t *nprocs)
 {
-    pmix_namespace_t *nptr = (pmix_namespace_t*)ns;
-    pmix_hash_trkr_t *trk, *t;
-    pmix_hash_table_t *ht;
-    pmix_kval_t *kp2, *kvptr;
+    pmix_kval_t *kp2;
     pmix_info_t *iptr;
     char **nodes=NULL, **procs=NULL;
     uint8_t *tmp;
@@ -376,39 +389,6 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     pmix_status_t rc=PMIX_SUCCESS;
     size_t n, j, size, len;
 
-    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                        "[%s:%d] gds:hash:cache_job_info for nspace %s",
-                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                        nptr->nspace);
-
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(nptr->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
-    }
-    if (NULL == trk) {
-        /* create a tracker as we will likely need it */
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        if (NULL == trk) {
-            return PMIX_ERR_NOMEM;
-        }
-        PMIX_RETAIN(nptr);
-        trk->nptr = nptr;
-        trk->ns = strdup(nptr->nspace);
-        pmix_list_append(&myhashes, &trk->super);
-    }
-
-    /* if there isn't any data, then be content with just
-     * creating the tracker */
-    if (NULL == info || 0 == ninfo) {
-        return PMIX_SUCCESS;
-    }
-
-    /* cache the job info on the internal hash table for this nspace */
-    ht = &trk->internal;
     for (n=0; n < ninfo; n++) {
         if (0 == strcmp(info[n].key, PMIX_NODE_MAP)) {
             /* store the node map itself since that is
@@ -544,38 +524,11 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
             PMIX_RELEASE(kp2);  // maintain acctg
             /* if this is the job size, then store it */
             if (0 == strncmp(info[n].key, PMIX_JOB_SIZE, PMIX_MAX_KEYLEN)) {
-                nptr->nprocs = info[n].value.data.uint32;
+                *nprocs = info[n].value.data.uint32;
             }
         }
     }
 
-    /* now add any global data that was provided */
-    if (!trk->gdata_added) {
-        PMIX_LIST_FOREACH(kvptr, &pmix_server_globals.gdata, pmix_kval_t) {
-            /* sadly, the data cannot simultaneously exist on two lists,
-             * so we must make a copy of it here */
-            kp2 = PMIX_NEW(pmix_kval_t);
-            if (NULL == kp2) {
-                rc = PMIX_ERR_NOMEM;
-                goto release;
-            }
-            kp2->key = strdup(kvptr->key);
-            PMIX_VALUE_XFER(rc, kp2->value, kvptr->value);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kp2);
-                goto release;
-            }
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kp2);
-                break;
-            }
-            PMIX_RELEASE(kp2);  // maintain acctg
-        }
-        trk->gdata_added = true;
-    }
-
   release:
     if (NULL != nodes) {
         pmix_argv_free(nodes);
@@ -586,6 +539,148 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     return rc;
 }
 
+/* add any global data that was provided */
+static pmix_status_t add_gdata(pmix_hash_trkr_t *trk)
+{
+    pmix_kval_t *kp2, *kvptr;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (trk->gdata_added) {
+        return PMIX_SUCCESS;
+    }
+    PMIX_LIST_FOREACH(kvptr, &pmix_server_globals.gdata, pmix_kval_t) {
+        /* sadly, the data cannot simultaneously exist on two lists,
+         * so we must make a copy of it here */
+        kp2 = PMIX_NEW(pmix_kval_t);
+        if (NULL == kp2) {
+            return PMIX_ERR_NOMEM;
+        }
+        kp2->key = strdup(kvptr->key);
+        PMIX_VALUE_XFER(rc, kp2->value, kvptr->value);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(kp2);
+            return rc;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_hash_store(&trk->internal, PMIX_RANK_WILDCARD, kp2))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(kp2);
+            break;
+        }
+        PMIX_RELEASE(kp2);  // maintain acctg
+    }
+    trk->gdata_added = true;
+    return rc;
+}
+
+pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
+                                  pmix_info_t info[], size_t ninfo)
+{
+    pmix_namespace_t *nptr = (pmix_namespace_t*)ns;
+    pmix_hash_trkr_t *trk, *t;
+    pmix_status_t rc;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:cache_job_info for nspace %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        nptr->nspace);
+
+    /* find the hash table for this nspace */
+    trk = NULL;
+    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
+        if (0 == strcmp(nptr->nspace, t->ns)) {
+            trk = t;
+            break;
+        }
+    }
+    if (NULL == trk) {
+        /* create a tracker as we will likely need it */
+        trk = PMIX_NEW(pmix_hash_trkr_t);
+        if (NULL == trk) {
+            return PMIX_ERR_NOMEM;
+        }
+        PMIX_RETAIN(nptr);
+        trk->nptr = nptr;
+        trk->ns = strdup(nptr->nspace);
+        pmix_list_append(&myhashes, &trk->super);
+    }
+
+    /* if there isn't any data, then be content with just
+     * creating the tracker */
+    if (NULL == info || 0 == ninfo) {
+        return PMIX_SUCCESS;
+    }
+
+    /* cache the job info on the internal hash table for this nspace */
+    if (PMIX_SUCCESS != (rc = parse_job_info(&trk->internal, info, ninfo, &nptr->nprocs))) {
+        return rc;
+    }
+
+    return add_gdata(trk);
+}
+
+/* parse the job info into a tracker of its own - nothing shared is
+ * touched, so this can run on any thread */
+static pmix_status_t hash_prep_job_info(const char *nspace,
+                                        pmix_info_t info[], size_t ninfo,
+                                        pmix_object_t **job)
+{
+    pmix_hash_trkr_t *trk;
+    pmix_status_t rc;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:prep_job_info for nspace %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        nspace);
+
+    *job = NULL;
+    trk = PMIX_NEW(pmix_hash_trkr_t);
+    if (NULL == trk) {
+        return PMIX_ERR_NOMEM;
+    }
+    trk->ns = strdup(nspace);
+    if (NULL != info && 0 < ninfo) {
+        rc = parse_job_info(&trk->internal, info, ninfo, &trk->nprocs);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(trk);
+            return rc;
+        }
+    }
+    *job = &trk->super.super;
+    return PMIX_SUCCESS;
+}
+
+/* link a prepared tracker in as the data for its nspace */
+static pmix_status_t hash_publish_job_info(struct pmix_namespace_t *ns,
+                                           pmix_object_t *job)
+{
+    pmix_namespace_t *nptr = (pmix_namespace_t*)ns;
+    pmix_hash_trkr_t *trk = (pmix_hash_trkr_t*)job, *t;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:publish_job_info for nspace %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        nptr->nspace);
+
+    /* the prepared data cannot be merged with anything
+     * already stored for this nspace */
+    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
+        if (0 == strcmp(nptr->nspace, t->ns)) {
+            return PMIX_ERR_NOT_AVAILABLE;
+        }
+    }
+    PMIX_RETAIN(nptr);
+    trk->nptr = nptr;
+    if (0 < trk->nprocs) {
+        nptr->nprocs = trk->nprocs;
+    }
+    /* the list holds its own reference */
+    PMIX_RETAIN(trk);
+    pmix_list_append(&myhashes, &trk->super);
+
+    return add_gdata(trk);
+}
+
 static pmix_status_t register_info(pmix_peer_t *peer,
                                    pmix_namespace_t *ns,
                                    pmix_buffer_t *reply)
@@ -1575,3 +1670,18 @@ static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
     }
     return rc;
 }
+
+static pmix_status_t hash_mem_usage(const char *nspace, size_t *bytes)
+{
+    pmix_hash_trkr_t *t;
+
+    *bytes = 0;
+    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
+        if (0 == strcmp(nspace, t->ns)) {
+            *bytes = t->internal.ht_data_bytes + t->remote.ht_data_bytes +
+                     t->local.ht_data_bytes;
+            return PMIX_SUCCESS;
+        }
+    }
+    return PMIX_ERR_NOT_FOUND;
+}
@@ -17,6 +17,7 @@
 #include "pmix_config.h"
 
 #include "src/mca/base/base.h"
+#include "src/runtime/pmix_rte.h"
 #include "src/mca/pcompress/base/base.h"
 
 #include "src/mca/pcompress/base/static-components.h"
@@ -24,16 +25,28 @@
 /*
  * Globals
  */
+/* these remain in place until a component is selected - clients
+ * don't open the framework until the first time they need it */
 static bool compress_block(char *instring,
                            uint8_t **outbytes,
                            size_t *nbytes)
 {
+    if (!pmix_rte_lazy_ready[PMIX_RTE_PCOMPRESS] &&
+        PMIX_SUCCESS == pmix_rte_open_lazy(PMIX_RTE_PCOMPRESS) &&
+        compress_block != pmix_compress.compress_string) {
+        return pmix_compress.compress_string(instring, outbytes, nbytes);
+    }
     return false;
 }
 
 static bool decompress_block(char **outstring,
                              uint8_t *inbytes, size_t len)
 {
+    if (!pmix_rte_lazy_ready[PMIX_RTE_PCOMPRESS] &&
+        PMIX_SUCCESS == pmix_rte_open_lazy(PMIX_RTE_PCOMPRESS) &&
+        decompress_block != pmix_compress.decompress_string) {
+        return pmix_compress.decompress_string(outstring, inbytes, len);
+    }
     return false;
 }
 
@@ -47,7 +60,11 @@ pmix_compress_base_module_t pmix_compress = {
     compress_block,
     decompress_block
 };
-pmix_compress_base_t pmix_compress_base = {0};
+/* the limit is set here as well as when the framework is registered
+ * so that short strings don't cause a client to open the framework */
+pmix_compress_base_t pmix_compress_base = {
+    .compress_limit = 4096
+};
 
 pmix_compress_base_component_t pmix_compress_base_selected_component = {{0}};
 
@@ -1,6 +1,6 @@
 /* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
 /*
- * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * Copyright (c) 2018-2019 Intel, Inc. All rights reserved.
  *
  * $COPYRIGHT$
  *
@@ -17,6 +17,7 @@
 #include "src/class/pmix_list.h"
 #include "src/util/error.h"
 #include "src/server/pmix_server_ops.h"
+#include "src/runtime/pmix_rte.h"
 
 #include "src/mca/plog/base/base.h"
 
@@ -80,6 +81,13 @@ pmix_status_t pmix_plog_base_log(const pmix_proc_t *source,
     pmix_list_t channels;
     bool all_complete = true;
 
+    /* clients don't open the framework until they first log */
+    PMIX_RTE_ENSURE(rc, PMIX_RTE_PLOG);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = PMIX_ERR_NOT_AVAILABLE;
+
     if (!pmix_plog_globals.initialized) {
         return PMIX_ERR_INIT;
     }
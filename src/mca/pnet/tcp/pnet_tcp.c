@@ -750,6 +750,7 @@ static pmix_status_t setup_local_network(pmix_namespace_t *nptr,
             /* look for my key */
             if (0 == strncmp(info[n].key, PMIX_TCP_SETUP_APP_KEY, PMIX_MAX_KEYLEN)) {
                 /* this macro NULLs and zero's the incoming bo */
+                PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
                 PMIX_LOAD_BUFFER(pmix_globals.mypeer, &bkt,
                                  info[n].value.data.bo.bytes,
                                  info[n].value.data.bo.size);
@@ -1095,6 +1096,7 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
     for (n=0; n < ninfo; n++) {
         if (0 == strncmp(info[n].key, PMIX_TCP_INVENTORY_KEY, PMIX_MAX_KEYLEN)) {
             /* this is our inventory in the form of a blob */
+            PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
             PMIX_LOAD_BUFFER(pmix_globals.mypeer, &bkt,
                              info[n].value.data.bo.bytes,
                              info[n].value.data.bo.size);
@@ -1143,6 +1145,7 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
                                &bkt, &pbo, &cnt, PMIX_BYTE_OBJECT);
             while (PMIX_SUCCESS == rc) {
                 /* load the byte object for unpacking */
+                PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
                 PMIX_LOAD_BUFFER(pmix_globals.mypeer, &pbkt, pbo.bytes, pbo.size);
                 /* unpack the name of the device */
                 cnt = 1;
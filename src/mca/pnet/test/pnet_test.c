@@ -346,6 +346,7 @@ static pmix_status_t setup_local_network(pmix_namespace_t *nptr,
                /* look for my key */
            if (0 == strncmp(info[n].key, "pmix-pnet-test-blob", PMIX_MAX_KEYLEN)) {
                    /* this macro NULLs and zero's the incoming bo */
+               PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
                PMIX_LOAD_BUFFER(pmix_globals.mypeer, &bkt,
                                 info[n].value.data.bo.bytes,
                                 info[n].value.data.bo.size);
@@ -9,7 +9,7 @@
  *                         University of Stuttgart.  All rights reserved.
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
- * Copyright (c) 2015-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -27,6 +27,7 @@
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/include/pmix_globals.h"
+#include "src/runtime/pmix_rte.h"
 
 #include "src/mca/preg/base/base.h"
 
@@ -34,6 +35,12 @@ pmix_status_t pmix_preg_base_generate_node_regex(const char *input,
                                                  char **regex)
 {
     pmix_preg_base_active_module_t *active;
+    pmix_status_t rc;
+
+    PMIX_RTE_ENSURE(rc, PMIX_RTE_PREG);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->generate_node_regex) {
@@ -50,6 +57,12 @@ pmix_status_t pmix_preg_base_generate_ppn(const char *input,
                                           char **ppn)
 {
     pmix_preg_base_active_module_t *active;
+    pmix_status_t rc;
+
+    PMIX_RTE_ENSURE(rc, PMIX_RTE_PREG);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->generate_ppn) {
@@ -66,6 +79,12 @@ pmix_status_t pmix_preg_base_parse_nodes(const char *regexp,
                                          char ***names)
 {
     pmix_preg_base_active_module_t *active;
+    pmix_status_t rc;
+
+    PMIX_RTE_ENSURE(rc, PMIX_RTE_PREG);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->parse_nodes) {
@@ -82,6 +101,12 @@ pmix_status_t pmix_preg_base_parse_procs(const char *regexp,
                                          char ***procs)
 {
     pmix_preg_base_active_module_t *active;
+    pmix_status_t rc;
+
+    PMIX_RTE_ENSURE(rc, PMIX_RTE_PREG);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->parse_procs) {
@@ -99,6 +124,12 @@ pmix_status_t pmix_preg_base_resolve_peers(const char *nodename,
                                            pmix_proc_t **procs, size_t *nprocs)
 {
     pmix_preg_base_active_module_t *active;
+    pmix_status_t rc;
+
+    PMIX_RTE_ENSURE(rc, PMIX_RTE_PREG);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->resolve_peers) {
@@ -115,6 +146,12 @@ pmix_status_t pmix_preg_base_resolve_nodes(const char *nspace,
                                            char **nodelist)
 {
     pmix_preg_base_active_module_t *active;
+    pmix_status_t rc;
+
+    PMIX_RTE_ENSURE(rc, PMIX_RTE_PREG);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->resolve_nodes) {
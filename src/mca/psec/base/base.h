@@ -11,7 +11,7 @@
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
  * Copyright (c) 2012      Los Alamos National Security, Inc.  All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -34,9 +34,12 @@
 #include <string.h>
 #endif
 
+#include "src/class/pmix_list.h"
 #include "src/class/pmix_pointer_array.h"
+#include "src/threads/mutex.h"
 #include "src/mca/mca.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
+#include "src/mca/bfrops/bfrops_types.h"
 
 #include "src/mca/psec/psec.h"
 
@@ -72,6 +75,13 @@ PMIX_CLASS_DECLARATION(pmix_psec_base_active_module_t);
 struct pmix_psec_globals_t {
   pmix_list_t actives;
   bool initialized;
+  /* cache of recently validated connection credentials */
+  pmix_list_t cache;
+  pmix_mutex_t cache_lock;
+  size_t cache_size;
+  int cache_ttl;
+  uint64_t cache_hits;
+  uint64_t cache_misses;
 };
 typedef struct pmix_psec_globals_t pmix_psec_globals_t;
 
@@ -80,6 +90,13 @@ extern pmix_psec_globals_t pmix_psec_globals;
 PMIX_EXPORT char* pmix_psec_base_get_available_modules(void);
 PMIX_EXPORT pmix_psec_module_t* pmix_psec_base_assign_module(const char *options);
 
+/* drop any cached credential validations for procs in the given nspace */
+PMIX_EXPORT void pmix_psec_base_cache_invalidate(const char *nspace);
+
+/* return the validation cache counters as a kval containing
+ * a pmix_data_array_t of pmix_info_t */
+PMIX_EXPORT pmix_kval_t* pmix_psec_base_cache_stats(void);
+
 
 END_C_DECLS
 
@@ -1,6 +1,6 @@
 /* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
 /*
- * Copyright (c) 2015-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2016      Mellanox Technologies, Inc.
  *                         All rights reserved.
  *
@@ -16,6 +16,11 @@
 #include <pmix_common.h>
 #include "src/include/pmix_globals.h"
 
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#include <time.h>
+
 #include "src/class/pmix_list.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
@@ -82,3 +87,185 @@ pmix_psec_module_t* pmix_psec_base_assign_module(const char *options)
     }
     return NULL;
 }
+
+/* a successfully validated connection credential */
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t digest;
+    pmix_byte_object_t cred;
+    uid_t uid;
+    gid_t gid;
+    pmix_nspace_t nspace;
+    pmix_psec_module_t *module;
+    time_t expires;
+} pmix_psec_cache_item_t;
+static void cicon(pmix_psec_cache_item_t *p)
+{
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->cred);
+    memset(p->nspace, 0, PMIX_MAX_NSLEN+1);
+    p->module = NULL;
+}
+static void cides(pmix_psec_cache_item_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->cred);
+}
+static PMIX_CLASS_INSTANCE(pmix_psec_cache_item_t,
+                           pmix_list_item_t,
+                           cicon, cides);
+
+/* FNV-1a - the cache is keyed on the credential itself, and
+ * the digest saves comparing the full bytes of every entry */
+static uint32_t cred_digest(const pmix_byte_object_t *cred)
+{
+    uint32_t h = 2166136261u;
+    size_t n;
+
+    for (n=0; n < cred->size; n++) {
+        h ^= (uint8_t)cred->bytes[n];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+pmix_status_t pmix_psec_base_validate_connection(struct pmix_peer_t *peer,
+                                                 const pmix_info_t directives[], size_t ndirs,
+                                                 pmix_info_t **info, size_t *ninfo,
+                                                 const pmix_byte_object_t *cred)
+{
+    pmix_peer_t *pr = (pmix_peer_t*)peer;
+    pmix_psec_module_t *mod = pr->nptr->compat.psec;
+    pmix_psec_cache_item_t *ci, *cinext;
+    pmix_status_t rc;
+    uint32_t digest;
+    uid_t uid;
+    gid_t gid;
+    time_t now;
+
+    /* only cache plain connection requests. The entry is keyed on
+     * the validated credential, and a credential is only accepted
+     * from the cache for a peer the server registered with the
+     * same nspace and uid/gid as the one it was validated for - so
+     * this works the same whatever the transport. A reused
+     * credential is accepted for at most cache_ttl seconds */
+    if (0 == pmix_psec_globals.cache_size || 0 >= pmix_psec_globals.cache_ttl ||
+        NULL != directives || 0 < ndirs || NULL != info ||
+        NULL == cred || NULL == cred->bytes || 0 == cred->size ||
+        NULL == pr->info) {
+        return mod->validate_cred(peer, directives, ndirs, info, ninfo, cred);
+    }
+    uid = pr->info->uid;
+    gid = pr->info->gid;
+
+    digest = cred_digest(cred);
+    now = time(NULL);
+    pmix_mutex_lock(&pmix_psec_globals.cache_lock);
+    PMIX_LIST_FOREACH_SAFE(ci, cinext, &pmix_psec_globals.cache, pmix_psec_cache_item_t) {
+        if (ci->expires <= now) {
+            pmix_list_remove_item(&pmix_psec_globals.cache, &ci->super);
+            PMIX_RELEASE(ci);
+            continue;
+        }
+        if (ci->digest == digest && ci->module == mod &&
+            ci->uid == uid && ci->gid == gid &&
+            ci->cred.size == cred->size &&
+            PMIX_CHECK_NSPACE(ci->nspace, pr->info->pname.nspace) &&
+            0 == memcmp(ci->cred.bytes, cred->bytes, cred->size)) {
+            /* keep the most recently used entries at the front */
+            pmix_list_remove_item(&pmix_psec_globals.cache, &ci->super);
+            pmix_list_prepend(&pmix_psec_globals.cache, &ci->super);
+            ++pmix_psec_globals.cache_hits;
+            pmix_mutex_unlock(&pmix_psec_globals.cache_lock);
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                                "psec: credential for %s:%u validated from cache",
+                                pr->info->pname.nspace, pr->info->pname.rank);
+            return PMIX_SUCCESS;
+        }
+    }
+    ++pmix_psec_globals.cache_misses;
+    pmix_mutex_unlock(&pmix_psec_globals.cache_lock);
+
+    /* don't hold the lock across what may be a call
+     * to an external agent */
+    rc = mod->validate_cred(peer, directives, ndirs, info, ninfo, cred);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    ci = PMIX_NEW(pmix_psec_cache_item_t);
+    ci->digest = digest;
+    ci->cred.bytes = (char*)malloc(cred->size);
+    if (NULL == ci->cred.bytes) {
+        PMIX_RELEASE(ci);
+        return rc;
+    }
+    memcpy(ci->cred.bytes, cred->bytes, cred->size);
+    ci->cred.size = cred->size;
+    ci->uid = uid;
+    ci->gid = gid;
+    PMIX_LOAD_NSPACE(ci->nspace, pr->info->pname.nspace);
+    ci->module = mod;
+    ci->expires = now + pmix_psec_globals.cache_ttl;
+    pmix_mutex_lock(&pmix_psec_globals.cache_lock);
+    pmix_list_prepend(&pmix_psec_globals.cache, &ci->super);
+    while (pmix_psec_globals.cache_size < pmix_list_get_size(&pmix_psec_globals.cache)) {
+        ci = (pmix_psec_cache_item_t*)pmix_list_remove_last(&pmix_psec_globals.cache);
+        PMIX_RELEASE(ci);
+    }
+    pmix_mutex_unlock(&pmix_psec_globals.cache_lock);
+    return rc;
+}
+
+void pmix_psec_base_cache_invalidate(const char *nspace)
+{
+    pmix_psec_cache_item_t *ci, *cinext;
+
+    if (!pmix_psec_globals.initialized) {
+        return;
+    }
+    pmix_mutex_lock(&pmix_psec_globals.cache_lock);
+    PMIX_LIST_FOREACH_SAFE(ci, cinext, &pmix_psec_globals.cache, pmix_psec_cache_item_t) {
+        if (PMIX_CHECK_NSPACE(ci->nspace, nspace)) {
+            pmix_list_remove_item(&pmix_psec_globals.cache, &ci->super);
+            PMIX_RELEASE(ci);
+        }
+    }
+    pmix_mutex_unlock(&pmix_psec_globals.cache_lock);
+}
+
+pmix_kval_t* pmix_psec_base_cache_stats(void)
+{
+    pmix_kval_t *kv;
+    pmix_info_t *iptr;
+    size_t nentries = 0;
+    uint64_t hits = 0, misses = 0;
+
+    if (pmix_psec_globals.initialized) {
+        pmix_mutex_lock(&pmix_psec_globals.cache_lock);
+        hits = pmix_psec_globals.cache_hits;
+        misses = pmix_psec_globals.cache_misses;
+        nentries = pmix_list_get_size(&pmix_psec_globals.cache);
+        pmix_mutex_unlock(&pmix_psec_globals.cache_lock);
+    }
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return NULL;
+    }
+    kv->key = strdup(PMIX_QUERY_PSEC_CACHE_STATS);
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return NULL;
+    }
+    kv->value->type = PMIX_DATA_ARRAY;
+    PMIX_DATA_ARRAY_CREATE(kv->value->data.darray, 3, PMIX_INFO);
+    if (NULL == kv->value->data.darray) {
+        PMIX_RELEASE(kv);
+        return NULL;
+    }
+    iptr = (pmix_info_t*)kv->value->data.darray->array;
+    PMIX_INFO_LOAD(&iptr[0], PMIX_PSEC_CACHE_HITS, &hits, PMIX_UINT64);
+    PMIX_INFO_LOAD(&iptr[1], PMIX_PSEC_CACHE_MISSES, &misses, PMIX_UINT64);
+    PMIX_INFO_LOAD(&iptr[2], PMIX_PSEC_CACHE_ENTRIES, &nentries, PMIX_SIZE);
+    return kv;
+}
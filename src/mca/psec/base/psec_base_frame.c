@@ -11,7 +11,7 @@
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
  * Copyright (c) 2012-2013 Los Alamos National Security, Inc.  All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015-2016 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -46,6 +46,30 @@
 /* Instantiate the global vars */
 pmix_psec_globals_t pmix_psec_globals = {{{0}}};
 
+static int cache_size = 256;
+static int cache_ttl = 60;
+
+static int pmix_psec_register(pmix_mca_base_register_flag_t flags)
+{
+    pmix_mca_base_var_register("pmix", "psec", "base", "cache_size",
+                               "Max number of validated connection credentials to cache "
+                               "(0 => disable the cache)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &cache_size);
+    pmix_psec_globals.cache_size = (0 < cache_size) ? cache_size : 0;
+
+    pmix_mca_base_var_register("pmix", "psec", "base", "cache_ttl",
+                               "Number of seconds a cached credential validation remains valid",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &cache_ttl);
+    pmix_psec_globals.cache_ttl = cache_ttl;
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t pmix_psec_close(void)
 {
   pmix_psec_base_active_module_t *active, *prev;
@@ -63,6 +87,8 @@ static pmix_status_t pmix_psec_close(void)
       PMIX_RELEASE(active);
     }
     PMIX_DESTRUCT(&pmix_psec_globals.actives);
+    PMIX_LIST_DESTRUCT(&pmix_psec_globals.cache);
+    PMIX_DESTRUCT(&pmix_psec_globals.cache_lock);
 
     return pmix_mca_base_framework_components_close(&pmix_psec_base_framework, NULL);
 }
@@ -72,13 +98,17 @@ static pmix_status_t pmix_psec_open(pmix_mca_base_open_flag_t flags)
     /* initialize globals */
     pmix_psec_globals.initialized = true;
     PMIX_CONSTRUCT(&pmix_psec_globals.actives, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_psec_globals.cache, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_psec_globals.cache_lock, pmix_mutex_t);
+    pmix_psec_globals.cache_hits = 0;
+    pmix_psec_globals.cache_misses = 0;
 
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&pmix_psec_base_framework, flags);
 }
 
 PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, psec, "PMIx Security Operations",
-                                NULL, pmix_psec_open, pmix_psec_close,
+                                pmix_psec_register, pmix_psec_open, pmix_psec_close,
                                 mca_psec_base_static_components, 0);
 
 PMIX_CLASS_INSTANCE(pmix_psec_base_active_module_t,
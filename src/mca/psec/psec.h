@@ -1,7 +1,7 @@
 /* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
 /*
  * Copyright (c) 2007-2008 Cisco Systems, Inc.  All rights reserved.
- * Copyright (c) 2015-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc. All rights reserved.
  *
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
@@ -126,6 +126,15 @@ PMIX_EXPORT char* pmix_psec_base_get_available_modules(void);
 /* Select a psec module for a given peer */
 PMIX_EXPORT pmix_psec_module_t* pmix_psec_base_assign_module(const char *options);
 
+/* Validate the credential presented by a connecting peer, reusing
+ * the result of a prior validation of the same credential for a
+ * peer registered with the same nspace and uid/gid if it is still
+ * cached */
+PMIX_EXPORT pmix_status_t pmix_psec_base_validate_connection(struct pmix_peer_t *peer,
+                                                             const pmix_info_t directives[], size_t ndirs,
+                                                             pmix_info_t **info, size_t *ninfo,
+                                                             const pmix_byte_object_t *cred);
+
 /* MACROS FOR EXECUTING PSEC FUNCTIONS */
 
 #define PMIX_PSEC_CREATE_CRED(r, p, d, nd, in, nin, c)                      \
@@ -145,8 +154,8 @@ PMIX_EXPORT pmix_psec_module_t* pmix_psec_base_assign_module(const char *options
         int _r;                                                                                             \
         /* if a credential is available, then check it */                                                   \
         if (NULL != (p)->nptr->compat.psec->validate_cred) {                                                \
-            _r = (p)->nptr->compat.psec->validate_cred((struct pmix_peer_t*)(p),                            \
-                                                       (d), (nd), (in), (nin), c);                          \
+            _r = pmix_psec_base_validate_connection((struct pmix_peer_t*)(p),                               \
+                                                    (d), (nd), (in), (nin), c);                             \
             if (PMIX_SUCCESS != _r) {                                                                       \
                 pmix_output_verbose(2, pmix_globals.debug_output,                                           \
                                     "validation of credential failed: %s",                                  \
@@ -2,7 +2,7 @@
  * Copyright (c) 2009      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2013      Los Alamos National Security, LLC.  All rights reserved.
  *
- * Copyright (c) 2017      Intel, Inc.  All rights reserved.
+ * Copyright (c) 2017-2019 Intel, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -50,7 +50,8 @@ PMIX_EXPORT extern pmix_psensor_base_t pmix_psensor_base;
 
 PMIX_EXPORT pmix_status_t pmix_psensor_base_start(pmix_peer_t *requestor, pmix_status_t error,
                                                   const pmix_info_t *monitor,
-                                                  const pmix_info_t directives[], size_t ndirs);
+                                                  const pmix_info_t directives[], size_t ndirs,
+                                                  pmix_list_t *results);
 
 PMIX_EXPORT pmix_status_t pmix_psensor_base_stop(pmix_peer_t *requestor,
                                                  char *id);
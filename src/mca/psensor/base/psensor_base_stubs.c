@@ -1,7 +1,7 @@
 /*
  * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2012      Los Alamos National Security, Inc. All rights reserved.
- * Copyright (c) 2014-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc.  All rights reserved.
  *
  * $COPYRIGHT$
  *
@@ -20,7 +20,8 @@
 
 pmix_status_t pmix_psensor_base_start(pmix_peer_t *requestor, pmix_status_t error,
                                       const pmix_info_t *monitor,
-                                      const pmix_info_t directives[], size_t ndirs)
+                                      const pmix_info_t directives[], size_t ndirs,
+                                      pmix_list_t *results)
 {
     pmix_psensor_active_module_t *mod;
     pmix_status_t rc;
@@ -33,7 +34,7 @@ pmix_status_t pmix_psensor_base_start(pmix_peer_t *requestor, pmix_status_t erro
     /* call the start function of all modules in priority order */
     PMIX_LIST_FOREACH(mod, &pmix_psensor_base.actives, pmix_psensor_active_module_t) {
         if (NULL != mod->module->start) {
-            rc = mod->module->start(requestor, error, monitor, directives, ndirs);
+            rc = mod->module->start(requestor, error, monitor, directives, ndirs, results);
             if (PMIX_SUCCESS != rc && PMIX_ERR_TAKE_NEXT_OPTION != rc) {
                 return rc;
             }
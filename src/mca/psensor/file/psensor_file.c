@@ -6,7 +6,7 @@
  * Copyright (c) 2011-2012 Los Alamos National Security, LLC.
  *                         All rights reserved.
  *
- * Copyright (c) 2017-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2017-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
  * $COPYRIGHT$
@@ -39,9 +39,14 @@
 #endif
 #include <sys/stat.h>
 #include <sys/types.h>
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/include/pmix_globals.h"
+#include "src/util/basename.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 #include "src/util/show_help.h"
@@ -52,7 +57,8 @@
 /* declare the API functions */
 static pmix_status_t start(pmix_peer_t *requestor, pmix_status_t error,
                            const pmix_info_t *monitor,
-                           const pmix_info_t directives[], size_t ndirs);
+                           const pmix_info_t directives[], size_t ndirs,
+                           pmix_list_t *results);
 static pmix_status_t stop(pmix_peer_t *requestor, char *id);
 
 /* instantiate the module */
@@ -61,6 +67,85 @@ pmix_psensor_base_module_t pmix_psensor_file_module = {
     .stop = stop
 };
 
+/* the inotify events that show a file being created, removed
+ * or written, or its directory going away - IN_ACCESS is added
+ * for directories holding files whose accesses are being monitored */
+#define FILE_WATCH_EVENTS   (IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | \
+                             IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF)
+
+/* a watched directory, shared by all the monitored
+ * files within it */
+typedef struct {
+    pmix_list_item_t super;
+    char *path;
+    int wd;
+    uint32_t mask;
+    pmix_hash_table_t files;
+    size_t nfiles;
+} file_dir_t;
+static void dir_con(file_dir_t *p)
+{
+    p->path = NULL;
+    p->wd = -1;
+    p->mask = 0;
+    PMIX_CONSTRUCT(&p->files, pmix_hash_table_t);
+    pmix_hash_table_init(&p->files, 32);
+    p->nfiles = 0;
+}
+static void dir_des(file_dir_t *p)
+{
+    if (NULL != p->path) {
+        free(p->path);
+    }
+#ifdef HAVE_SYS_INOTIFY_H
+    if (0 <= p->wd && 0 <= mca_psensor_file_component.inotify_fd) {
+        inotify_rm_watch(mca_psensor_file_component.inotify_fd, p->wd);
+    }
+#endif
+    PMIX_DESTRUCT(&p->files);
+}
+static PMIX_CLASS_INSTANCE(file_dir_t,
+                           pmix_list_item_t,
+                           dir_con, dir_des);
+
+/* a watched file, shared by all the trackers monitoring it.
+ * The counts of events seen for it let each tracker tell
+ * whether anything happened during its own window */
+typedef struct {
+    pmix_object_t super;
+    file_dir_t *dir;
+    char *name;
+    bool exists;
+    uint64_t nmod;
+    uint64_t nacc;
+} file_watch_t;
+static void fw_con(file_watch_t *p)
+{
+    p->dir = NULL;
+    p->name = NULL;
+    p->exists = false;
+    p->nmod = 0;
+    p->nacc = 0;
+}
+static void fw_des(file_watch_t *p)
+{
+    if (NULL != p->dir) {
+        pmix_hash_table_remove_value_ptr(&p->dir->files, p->name, strlen(p->name));
+        /* stop watching the directory once nothing in it
+         * is being monitored */
+        if (0 == --p->dir->nfiles) {
+            pmix_list_remove_item(&mca_psensor_file_component.dirs, &p->dir->super);
+            PMIX_RELEASE(p->dir);
+        }
+    }
+    if (NULL != p->name) {
+        free(p->name);
+    }
+}
+static PMIX_CLASS_INSTANCE(file_watch_t,
+                           pmix_object_t,
+                           fw_con, fw_des);
+
 /* define a tracking object */
 typedef struct {
     pmix_list_item_t super;
@@ -80,6 +165,12 @@ typedef struct {
     time_t last_mod;
     uint32_t ndrops;
     uint32_t nmisses;
+    /* the file's watch, if it is not being polled, and
+     * its event counts as of the last sample */
+    file_watch_t *watch;
+    uint64_t seen_mod;
+    uint64_t seen_acc;
+    bool pending;
     pmix_status_t error;
     pmix_data_range_t range;
     pmix_info_t *info;
@@ -93,6 +184,7 @@ static void ft_constructor(file_tracker_t *ft)
     ft->tv.tv_sec = 0;
     ft->tv.tv_usec = 0;
     ft->tick = 0;
+    ft->file = NULL;
     ft->file_size = false;
     ft->file_access = false;
     ft->file_mod = false;
@@ -101,6 +193,10 @@ static void ft_constructor(file_tracker_t *ft)
     ft->last_mod = 0;
     ft->ndrops = 0;
     ft->nmisses = 0;
+    ft->watch = NULL;
+    ft->seen_mod = 0;
+    ft->seen_acc = 0;
+    ft->pending = false;
     ft->error = PMIX_SUCCESS;
     ft->range = PMIX_RANGE_NAMESPACE;
     ft->info = NULL;
@@ -120,6 +216,9 @@ static void ft_destructor(file_tracker_t *ft)
     if (NULL != ft->file) {
         free(ft->file);
     }
+    if (NULL != ft->watch) {
+        PMIX_RELEASE(ft->watch);
+    }
     if (NULL != ft->info) {
         PMIX_INFO_FREE(ft->info, ft->ninfo);
     }
@@ -155,15 +254,278 @@ PMIX_CLASS_INSTANCE(file_caddy_t,
 
 static void file_sample(int sd, short args, void *cbdata);
 
+#ifdef HAVE_SYS_INOTIFY_H
+/* the events lost track of - assume every file changed */
+static void watch_overflow(void)
+{
+    file_dir_t *dir;
+    file_watch_t *fw;
+    void *key, *node, *ptr;
+    size_t keylen;
+    int rc;
+
+    PMIX_LIST_FOREACH(dir, &mca_psensor_file_component.dirs, file_dir_t) {
+        rc = pmix_hash_table_get_first_key_ptr(&dir->files, &key, &keylen, &ptr, &node);
+        while (PMIX_SUCCESS == rc) {
+            fw = (file_watch_t*)ptr;
+            ++fw->nmod;
+            ++fw->nacc;
+            rc = pmix_hash_table_get_next_key_ptr(&dir->files, &key, &keylen, &ptr, node, &node);
+        }
+    }
+}
+
+/* the directory has gone, taking its watch with it - count
+ * it as a change to each of its files, which are then polled
+ * until the directory can be watched again */
+static void watch_lost(file_dir_t *dir, bool removed)
+{
+    file_watch_t *fw;
+    void *key, *node, *ptr;
+    size_t keylen;
+    int rc;
+
+    if (0 > dir->wd) {
+        return;
+    }
+    PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                         "[%s:%d] lost the watch on %s - polling its files",
+                         pmix_globals.myid.nspace, pmix_globals.myid.rank, dir->path));
+    if (!removed) {
+        /* the directory was moved, so the watch is still there
+         * but no longer on the path we were given */
+        inotify_rm_watch(mca_psensor_file_component.inotify_fd, dir->wd);
+    }
+    dir->wd = -1;
+    rc = pmix_hash_table_get_first_key_ptr(&dir->files, &key, &keylen, &ptr, &node);
+    while (PMIX_SUCCESS == rc) {
+        fw = (file_watch_t*)ptr;
+        fw->exists = false;
+        ++fw->nmod;
+        rc = pmix_hash_table_get_next_key_ptr(&dir->files, &key, &keylen, &ptr, node, &node);
+    }
+}
+
+/* try to watch a directory that was lost again, returning
+ * false if it still isn't there */
+static bool watch_rearm(file_dir_t *dir)
+{
+    file_watch_t *fw;
+    struct stat buf;
+    char *file;
+    void *key, *node, *ptr;
+    size_t keylen;
+    int rc, wd;
+
+    if (0 > (wd = inotify_add_watch(mca_psensor_file_component.inotify_fd,
+                                    dir->path, dir->mask))) {
+        return false;
+    }
+    PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                         "[%s:%d] watching %s again",
+                         pmix_globals.myid.nspace, pmix_globals.myid.rank, dir->path));
+    dir->wd = wd;
+    /* anything may have happened to the files in the meantime */
+    rc = pmix_hash_table_get_first_key_ptr(&dir->files, &key, &keylen, &ptr, &node);
+    while (PMIX_SUCCESS == rc) {
+        fw = (file_watch_t*)ptr;
+        if (0 <= asprintf(&file, "%s/%s", dir->path, fw->name)) {
+            fw->exists = (0 == stat(file, &buf));
+            free(file);
+        }
+        ++fw->nmod;
+        ++fw->nacc;
+        rc = pmix_hash_table_get_next_key_ptr(&dir->files, &key, &keylen, &ptr, node, &node);
+    }
+    return true;
+}
+
+/* pick up whatever has happened to the watched files. The
+ * queue is only read when a file is sampled so that a busy
+ * file doesn't wake us on every write - the kernel folds
+ * repeated events together in the meantime */
+static void drain_watches(void)
+{
+    union {
+        struct inotify_event ev;
+        char bytes[4096];
+    } buf;
+    const struct inotify_event *ev;
+    ssize_t len;
+    char *ptr;
+    file_dir_t *dir;
+    file_watch_t *fw;
+    void *val;
+
+    if (0 > mca_psensor_file_component.inotify_fd) {
+        return;
+    }
+    while (0 < (len = read(mca_psensor_file_component.inotify_fd, &buf, sizeof(buf)))) {
+        for (ptr = buf.bytes; ptr < buf.bytes + len; ptr += sizeof(struct inotify_event) + ev->len) {
+            ev = (const struct inotify_event*)ptr;
+            if (ev->mask & IN_Q_OVERFLOW) {
+                watch_overflow();
+                continue;
+            }
+            if (ev->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                PMIX_LIST_FOREACH(dir, &mca_psensor_file_component.dirs, file_dir_t) {
+                    if (dir->wd == ev->wd) {
+                        watch_lost(dir, !(ev->mask & IN_MOVE_SELF));
+                        break;
+                    }
+                }
+                continue;
+            }
+            if (0 == ev->len) {
+                /* event on the directory itself */
+                continue;
+            }
+            fw = NULL;
+            PMIX_LIST_FOREACH(dir, &mca_psensor_file_component.dirs, file_dir_t) {
+                if (dir->wd == ev->wd) {
+                    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&dir->files, ev->name,
+                                                                      strlen(ev->name), &val)) {
+                        fw = (file_watch_t*)val;
+                    }
+                    break;
+                }
+            }
+            if (NULL == fw) {
+                /* not a file we are monitoring */
+                continue;
+            }
+            if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+                fw->exists = true;
+                ++fw->nmod;
+            }
+            if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                fw->exists = false;
+            }
+            if (ev->mask & (IN_MODIFY | IN_ATTRIB)) {
+                ++fw->nmod;
+            }
+            if (ev->mask & IN_ACCESS) {
+                ++fw->nacc;
+            }
+        }
+    }
+}
+#endif
+
+/* watch the file for changes through its directory, returning
+ * NULL if it has to be polled instead */
+static file_watch_t* watch_file(const char *file, bool access)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+    pmix_psensor_file_component_t *c = &mca_psensor_file_component;
+    char *path, *name;
+    file_dir_t *dir;
+    file_watch_t *fw = NULL;
+    struct stat buf;
+    uint32_t mask;
+    void *val;
+    int wd;
+
+    if (!c->use_inotify) {
+        return NULL;
+    }
+    if (0 > c->inotify_fd) {
+        if (0 > (c->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC))) {
+            PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                                 "[%s:%d] inotify unavailable - polling files",
+                                 pmix_globals.myid.nspace, pmix_globals.myid.rank));
+            c->use_inotify = false;
+            return NULL;
+        }
+    }
+
+    path = pmix_dirname(file);
+    name = pmix_basename(file);
+    if (NULL == path || NULL == name) {
+        goto done;
+    }
+    mask = FILE_WATCH_EVENTS | (access ? IN_ACCESS : 0);
+
+    PMIX_LIST_FOREACH(dir, &c->dirs, file_dir_t) {
+        if (0 == strcmp(dir->path, path)) {
+            break;
+        }
+    }
+    if ((file_dir_t*)pmix_list_get_end(&c->dirs) == dir || mask != (dir->mask & mask)) {
+        /* watching a directory a second time, e.g., through
+         * another path, returns the same descriptor and adds
+         * to the events being watched */
+        if (0 > (wd = inotify_add_watch(c->inotify_fd, path, mask | IN_MASK_ADD))) {
+            PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                                 "[%s:%d] cannot watch %s: %s - polling %s",
+                                 pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                                 path, strerror(errno), file));
+            goto done;
+        }
+        PMIX_LIST_FOREACH(dir, &c->dirs, file_dir_t) {
+            if (dir->wd == wd) {
+                break;
+            }
+        }
+        if ((file_dir_t*)pmix_list_get_end(&c->dirs) == dir) {
+            dir = PMIX_NEW(file_dir_t);
+            dir->path = path;
+            path = NULL;
+            dir->wd = wd;
+            pmix_list_append(&c->dirs, &dir->super);
+        }
+        dir->mask |= mask;
+    }
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&dir->files, name, strlen(name), &val)) {
+        fw = (file_watch_t*)val;
+        PMIX_RETAIN(fw);
+    } else {
+        fw = PMIX_NEW(file_watch_t);
+        fw->dir = dir;
+        fw->name = name;
+        name = NULL;
+        /* the file may not exist yet - any later creation
+         * will be seen through the directory */
+        fw->exists = (0 == stat(file, &buf));
+        pmix_hash_table_set_value_ptr(&dir->files, fw->name, strlen(fw->name), fw);
+        ++dir->nfiles;
+    }
+
+  done:
+    if (NULL != path) {
+        free(path);
+    }
+    if (NULL != name) {
+        free(name);
+    }
+    return fw;
+#else
+    return NULL;
+#endif
+}
+
 static void add_tracker(int sd, short flags, void *cbdata)
 {
     file_tracker_t *ft = (file_tracker_t*)cbdata;
 
-    PMIX_ACQUIRE_OBJECT(fd);
+    PMIX_ACQUIRE_OBJECT(ft);
 
     /* add the tracker to our list */
     pmix_list_append(&mca_psensor_file_component.trackers, &ft->super);
 
+    /* watch the file so it only needs to be looked at when
+     * something happens to it - access times are only of
+     * interest if we aren't checking the size */
+    ft->watch = watch_file(ft->file, ft->file_access && !ft->file_size);
+    if (NULL != ft->watch) {
+        /* sample the file in full at the end of the first
+         * window, as if it were being polled */
+        ft->seen_mod = ft->watch->nmod;
+        ft->seen_acc = ft->watch->nacc;
+        ft->pending = true;
+    }
+
     /* setup the timer event */
     pmix_event_evtimer_set(pmix_psensor_base.evbase, &ft->ev,
                            file_sample, ft);
@@ -176,7 +538,8 @@ static void add_tracker(int sd, short flags, void *cbdata)
  */
 static pmix_status_t start(pmix_peer_t *requestor, pmix_status_t error,
                            const pmix_info_t *monitor,
-                           const pmix_info_t directives[], size_t ndirs)
+                           const pmix_info_t directives[], size_t ndirs,
+                           pmix_list_t *results)
 {
     file_tracker_t *ft;
     size_t n;
@@ -279,19 +642,11 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(ft);
 }
 
-static void file_sample(int sd, short args, void *cbdata)
+/* stat the file and compare it with the last sample,
+ * returning false if it cannot be found */
+static bool poll_file(file_tracker_t *ft)
 {
-    file_tracker_t *ft = (file_tracker_t*)cbdata;
     struct stat buf;
-    pmix_status_t rc;
-    pmix_proc_t source;
-
-    PMIX_ACQUIRE_OBJECT(ft);
-
-    PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
-                         "[%s:%d] sampling file %s",
-                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                         ft->file));
 
     /* stat the file and get its info */
     if (0 > stat(ft->file, &buf)) {
@@ -300,9 +655,7 @@ static void file_sample(int sd, short args, void *cbdata)
                              "[%s:%d] could not stat %s",
                              pmix_globals.myid.nspace, pmix_globals.myid.rank,
                              ft->file));
-        /* re-add the timer, in case this file shows up */
-        pmix_event_evtimer_add(&ft->ev, &ft->tv);
-        return;
+        return false;
     }
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
@@ -332,6 +685,94 @@ static void file_sample(int sd, short args, void *cbdata)
             ft->last_mod = buf.st_mtime;
         }
     }
+    return true;
+}
+
+/* compare the events seen on a watched file with those at
+ * the last sample, only looking at the file itself if its
+ * size may have changed */
+static bool check_watch(file_tracker_t *ft)
+{
+    file_watch_t *fw = ft->watch;
+    bool changed;
+
+    if (!fw->exists) {
+        PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                             "[%s:%d] %s does not exist",
+                             pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                             ft->file));
+        return false;
+    }
+
+    if (ft->pending) {
+        /* first sample - get the starting point */
+        if (!poll_file(ft)) {
+            return false;
+        }
+        ft->pending = false;
+    } else if (ft->file_size) {
+        if (fw->nmod == ft->seen_mod) {
+            /* nothing has written to it */
+            ft->nmisses++;
+        } else if (!poll_file(ft)) {
+            return false;
+        }
+    } else {
+        if (ft->file_access) {
+            changed = (fw->nacc != ft->seen_acc);
+        } else {
+            changed = (fw->nmod != ft->seen_mod);
+        }
+        if (changed) {
+            ft->nmisses = 0;
+            if (ft->file_access) {
+                ft->last_access = time(NULL);
+            } else {
+                ft->last_mod = time(NULL);
+            }
+        } else {
+            ft->nmisses++;
+        }
+    }
+    ft->seen_mod = fw->nmod;
+    ft->seen_acc = fw->nacc;
+    return true;
+}
+
+static void file_sample(int sd, short args, void *cbdata)
+{
+    file_tracker_t *ft = (file_tracker_t*)cbdata;
+    pmix_status_t rc;
+    pmix_proc_t source;
+    bool found;
+
+    PMIX_ACQUIRE_OBJECT(ft);
+
+    PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                         "[%s:%d] sampling file %s",
+                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                         ft->file));
+
+    if (NULL != ft->watch) {
+#ifdef HAVE_SYS_INOTIFY_H
+        drain_watches();
+        if (0 > ft->watch->dir->wd && !watch_rearm(ft->watch->dir)) {
+            /* the directory is still gone - poll until it is back */
+            found = poll_file(ft);
+        } else {
+            found = check_watch(ft);
+        }
+#else
+        found = check_watch(ft);
+#endif
+    } else {
+        found = poll_file(ft);
+    }
+    if (!found) {
+        /* re-add the timer, in case this file shows up */
+        pmix_event_evtimer_add(&ft->ev, &ft->tv);
+        return;
+    }
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] sampled file %s misses %d",
@@ -345,6 +786,11 @@ static void file_sample(int sd, short args, void *cbdata)
         }
         /* stop monitoring this client */
         pmix_list_remove_item(&mca_psensor_file_component.trackers, &ft->super);
+        /* the watch can only be released in our event base */
+        if (NULL != ft->watch) {
+            PMIX_RELEASE(ft->watch);
+            ft->watch = NULL;
+        }
         /* generate an event */
         pmix_strncpy(source.nspace, ft->requestor->info->pname.nspace, PMIX_MAX_NSLEN);
         source.rank = ft->requestor->info->pname.rank;
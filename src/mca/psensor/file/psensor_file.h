@@ -1,7 +1,7 @@
 /*
  * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
  *
- * Copyright (c) 2017      Intel, Inc.  All rights reserved.
+ * Copyright (c) 2017-2019 Intel, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -27,6 +27,13 @@ BEGIN_C_DECLS
 typedef struct {
     pmix_psensor_base_component_t super;
     pmix_list_t trackers;
+    /* watch for changes with inotify rather than polling
+     * each file with stat */
+    bool use_inotify;
+    int inotify_fd;
+    /* directories being watched, each shared by all the
+     * monitored files within it */
+    pmix_list_t dirs;
 } pmix_psensor_file_component_t;
 
 PMIX_EXPORT extern pmix_psensor_file_component_t mca_psensor_file_component;
@@ -1,6 +1,6 @@
 /*
  * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
- * Copyright (c) 2017      Intel, Inc.  All rights reserved.
+ * Copyright (c) 2017-2019 Intel, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -11,6 +11,10 @@
 #include <src/include/pmix_config.h>
 #include <pmix_common.h>
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #include "src/class/pmix_list.h"
 
 #include "src/mca/psensor/base/base.h"
@@ -19,6 +23,7 @@
 /*
  * Local functions
  */
+static int psensor_file_register(void);
 static int psensor_file_open(void);
 static int psensor_file_close(void);
 static int psensor_file_query(pmix_mca_base_module_t **module, int *priority);
@@ -36,17 +41,35 @@ pmix_psensor_file_component_t mca_psensor_file_component = {
                                        PMIX_RELEASE_VERSION),
 
             /* Component open and close functions */
-            psensor_file_open,  /* component open  */
-            psensor_file_close, /* component close */
-            psensor_file_query  /* component query */
+            .pmix_mca_open_component = psensor_file_open,
+            .pmix_mca_close_component = psensor_file_close,
+            .pmix_mca_query_component = psensor_file_query,
+            .pmix_mca_register_component_params = psensor_file_register
         },
-    }
+    },
+    .use_inotify = true,
+    .inotify_fd = -1
 };
 
+static int psensor_file_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_psensor_file_component.super.base;
+
+    (void)pmix_mca_base_component_var_register(component, "use_inotify",
+                                               "Watch monitored files for changes with inotify, where supported, instead of polling each of them with stat",
+                                               PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                               PMIX_INFO_LVL_9,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_psensor_file_component.use_inotify);
+    return PMIX_SUCCESS;
+}
+
 
 static int psensor_file_open(void)
 {
     PMIX_CONSTRUCT(&mca_psensor_file_component.trackers, pmix_list_t);
+    PMIX_CONSTRUCT(&mca_psensor_file_component.dirs, pmix_list_t);
+    mca_psensor_file_component.inotify_fd = -1;
     return PMIX_SUCCESS;
 }
 
@@ -64,6 +87,12 @@ static int psensor_file_query(pmix_mca_base_module_t **module, int *priority)
 
 static int psensor_file_close(void)
 {
+    /* the trackers hold the directories they are watched through */
     PMIX_LIST_DESTRUCT(&mca_psensor_file_component.trackers);
+    PMIX_LIST_DESTRUCT(&mca_psensor_file_component.dirs);
+    if (0 <= mca_psensor_file_component.inotify_fd) {
+        close(mca_psensor_file_component.inotify_fd);
+        mca_psensor_file_component.inotify_fd = -1;
+    }
     return PMIX_SUCCESS;
 }
@@ -3,7 +3,7 @@
  * Copyright (c) 2011-2012 Los Alamos National Security, LLC.  All rights
  *                         reserved.
   *
- * Copyright (c) 2017-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2017-2019 Intel, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -23,6 +23,8 @@
 #endif  /* HAVE_STRING_H */
 #include <stdio.h>
 #include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include PMIX_EVENT_HEADER
 
 #include "src/util/argv.h"
@@ -31,6 +33,7 @@
 #include "src/util/show_help.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/ptl/base/base.h"
+#include "src/server/pmix_server_ops.h"
 
 #include "src/mca/psensor/base/base.h"
 #include "psensor_heartbeat.h"
@@ -38,7 +41,8 @@
 /* declare the API functions */
 static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error,
                                      const pmix_info_t *monitor,
-                                     const pmix_info_t directives[], size_t ndirs);
+                                     const pmix_info_t directives[], size_t ndirs,
+                                     pmix_list_t *results);
 static pmix_status_t heartbeat_stop(pmix_peer_t *requestor, char *id);
 
 /* instantiate the module */
@@ -52,10 +56,11 @@ typedef struct {
     pmix_list_item_t super;
     pmix_peer_t *requestor;
     char *id;
-    bool event_active;
-    pmix_event_t ev;
     pmix_event_t cdev;
     struct timeval tv;
+    uint32_t rounds;
+    int slot;
+    int64_t last;
     uint32_t nbeats;
     uint32_t ndrops;
     uint32_t nmissed;
@@ -70,9 +75,11 @@ static void ft_constructor(pmix_heartbeat_trkr_t *ft)
 {
     ft->requestor = NULL;
     ft->id = NULL;
-    ft->event_active = false;
     ft->tv.tv_sec = 0;
     ft->tv.tv_usec = 0;
+    ft->rounds = 0;
+    ft->slot = -1;
+    ft->last = 0;
     ft->nbeats = 0;
     ft->ndrops = 0;
     ft->nmissed = 0;
@@ -90,9 +97,6 @@ static void ft_destructor(pmix_heartbeat_trkr_t *ft)
     if (NULL != ft->id) {
         free(ft->id);
     }
-    if (ft->event_active) {
-        pmix_event_del(&ft->ev);
-    }
     if (NULL != ft->info) {
         PMIX_INFO_FREE(ft->info, ft->ninfo);
     }
@@ -146,31 +150,107 @@ PMIX_CLASS_INSTANCE(pmix_psensor_beat_t,
                     pmix_object_t,
                     bcon, bdes);
 
-static void check_heartbeat(int fd, short dummy, void *arg);
+static void check_heartbeats(int fd, short dummy, void *arg);
+
+/* the beat counter of a tracker in the shared page */
+static inline volatile int64_t* heartbeat_counter(int slot)
+{
+    return (volatile int64_t*)(mca_psensor_heartbeat_component.seg_base +
+                               (size_t)slot * PMIX_HEARTBEAT_SLOT_SIZE);
+}
+
+/* place the tracker in the wheel at the tick on which its
+ * current window closes */
+static void schedule_tracker(pmix_heartbeat_trkr_t *ft, uint64_t ticks)
+{
+    pmix_psensor_heartbeat_component_t *c = &mca_psensor_heartbeat_component;
+    uint64_t due = c->tick + ticks;
+
+    /* windows longer than the wheel go around it more than once */
+    ft->rounds = (uint32_t)((ticks - 1) / PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE);
+    pmix_list_append(&c->wheel[due % PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE], &ft->super);
+}
 
 static void add_tracker(int sd, short flags, void *cbdata)
 {
     pmix_heartbeat_trkr_t *ft = (pmix_heartbeat_trkr_t*)cbdata;
+    pmix_psensor_heartbeat_component_t *c = &mca_psensor_heartbeat_component;
+    struct timeval tv = {1, 0};
 
     PMIX_ACQUIRE_OBJECT(ft);
 
-    /* add the tracker to our list */
-    pmix_list_append(&mca_psensor_heartbeat_component.trackers, &ft->super);
+    /* the next tick can come at any point within the next
+     * second, so allow an extra one to ensure the first
+     * window is at least as long as requested */
+    schedule_tracker(ft, (uint64_t)ft->tv.tv_sec + 1);
+    ++c->ntrackers;
+
+    /* start the timer if it isn't already running */
+    if (!c->tick_active) {
+        pmix_event_assign(&c->tick_ev, pmix_psensor_base.evbase, -1,
+                          EV_PERSIST, check_heartbeats, NULL);
+        pmix_event_add(&c->tick_ev, &tv);
+        c->tick_active = true;
+    }
+}
 
-    /* setup the timer event */
-    pmix_event_evtimer_set(pmix_psensor_base.evbase, &ft->ev,
-                           check_heartbeat, ft);
-    pmix_event_evtimer_add(&ft->ev, &ft->tv);
-    ft->event_active = true;
+/* map the page of beat counters shared with our clients,
+ * creating it on first use */
+static pmix_status_t setup_segment(void)
+{
+    pmix_psensor_heartbeat_component_t *c = &mca_psensor_heartbeat_component;
+    size_t size;
+    void *base;
+    int fd;
+
+    if (NULL != c->seg_base) {
+        return PMIX_SUCCESS;
+    }
+    if (NULL == pmix_server_globals.tmpdir) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    size = (size_t)c->max_slots * PMIX_HEARTBEAT_SLOT_SIZE;
+    if (0 > asprintf(&c->seg_path, "%s/pmix_hbeat.%lu",
+                     pmix_server_globals.tmpdir, (unsigned long)getpid())) {
+        c->seg_path = NULL;
+        return PMIX_ERR_NOMEM;
+    }
+    if (0 > (fd = open(c->seg_path, O_CREAT | O_RDWR | O_TRUNC, 0600))) {
+        goto error;
+    }
+    if (0 != ftruncate(fd, size)) {
+        close(fd);
+        goto error;
+    }
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        goto error;
+    }
+    c->seg_base = (unsigned char*)base;
+    c->seg_size = size;
+    return PMIX_SUCCESS;
+
+  error:
+    pmix_output_verbose(2, pmix_psensor_base_framework.framework_output,
+                        "psensor:heartbeat: cannot create %s: %s",
+                        c->seg_path, strerror(errno));
+    unlink(c->seg_path);
+    free(c->seg_path);
+    c->seg_path = NULL;
+    return PMIX_ERROR;
 }
 
 static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error,
                                      const pmix_info_t *monitor,
-                                     const pmix_info_t directives[], size_t ndirs)
+                                     const pmix_info_t directives[], size_t ndirs,
+                                     pmix_list_t *results)
 {
     pmix_heartbeat_trkr_t *ft;
     size_t n;
     pmix_ptl_posted_recv_t *rcv;
+    pmix_infolist_t *iptr;
+    uint32_t slot;
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] checking heartbeat monitoring for requestor %s:%d",
@@ -205,6 +285,30 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
         return PMIX_ERR_BAD_PARAM;
     }
 
+    /* if the requestor can reach our page of counters, then give
+     * it a slot there so it can beat without messaging us. The
+     * slot is that of its connection, so it can't be handed to
+     * another client while this one is still around */
+    if (mca_psensor_heartbeat_component.use_shmem &&
+        0 <= requestor->index && requestor->index < mca_psensor_heartbeat_component.max_slots &&
+        NULL != requestor->info && geteuid() == requestor->info->uid) {
+        if (PMIX_SUCCESS == setup_segment()) {
+            ft->slot = requestor->index;
+            ft->last = *heartbeat_counter(ft->slot);
+            iptr = PMIX_NEW(pmix_infolist_t);
+            PMIX_INFO_LOAD(&iptr->info, PMIX_HEARTBEAT_SEGMENT,
+                           mca_psensor_heartbeat_component.seg_path, PMIX_STRING);
+            pmix_list_append(results, &iptr->super);
+            iptr = PMIX_NEW(pmix_infolist_t);
+            slot = ft->slot;
+            PMIX_INFO_LOAD(&iptr->info, PMIX_HEARTBEAT_SLOT, &slot, PMIX_UINT32);
+            pmix_list_append(results, &iptr->super);
+        } else {
+            /* don't keep trying */
+            mca_psensor_heartbeat_component.use_shmem = false;
+        }
+    }
+
     /* if the recv hasn't been posted, so so now */
     if (!mca_psensor_heartbeat_component.recv_active) {
         /* setup to receive heartbeats */
@@ -228,21 +332,31 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
 static void del_tracker(int sd, short flags, void *cbdata)
 {
     heartbeat_caddy_t *cd = (heartbeat_caddy_t*)cbdata;
+    pmix_psensor_heartbeat_component_t *c = &mca_psensor_heartbeat_component;
     pmix_heartbeat_trkr_t *ft, *ftnext;
+    int i;
 
     PMIX_ACQUIRE_OBJECT(cd);
 
-    /* remove the tracker from our list */
-    PMIX_LIST_FOREACH_SAFE(ft, ftnext, &mca_psensor_heartbeat_component.trackers, pmix_heartbeat_trkr_t) {
-        if (ft->requestor != cd->requestor) {
-            continue;
-        }
-        if (NULL == cd->id ||
-            (NULL != ft->id && 0 == strcmp(ft->id, cd->id))) {
-            pmix_list_remove_item(&mca_psensor_heartbeat_component.trackers, &ft->super);
-            PMIX_RELEASE(ft);
+    /* remove the tracker from the wheel */
+    for (i=0; i < PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE; i++) {
+        PMIX_LIST_FOREACH_SAFE(ft, ftnext, &c->wheel[i], pmix_heartbeat_trkr_t) {
+            if (ft->requestor != cd->requestor) {
+                continue;
+            }
+            if (NULL == cd->id ||
+                (NULL != ft->id && 0 == strcmp(ft->id, cd->id))) {
+                pmix_list_remove_item(&c->wheel[i], &ft->super);
+                --c->ntrackers;
+                PMIX_RELEASE(ft);
+            }
         }
     }
+    /* nothing left to check - let the timer go idle */
+    if (0 == c->ntrackers && c->tick_active) {
+        pmix_event_del(&c->tick_ev);
+        c->tick_active = false;
+    }
     PMIX_RELEASE(cd);
 }
 
@@ -273,24 +387,32 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(ft);  // maintain accounting
 }
 
-/* this function automatically gets periodically called
- * by the event library so we can check on the state
- * of the various procs we are monitoring
- */
-static void check_heartbeat(int fd, short dummy, void *cbdata)
+/* see if the proc behind a tracker beat during the window
+ * that just closed */
+static void check_heartbeat(pmix_heartbeat_trkr_t *ft)
 {
-    pmix_heartbeat_trkr_t *ft = (pmix_heartbeat_trkr_t*)cbdata;
     pmix_status_t rc;
     pmix_proc_t source;
-
-    PMIX_ACQUIRE_OBJECT(ft);
+    int64_t beats;
+    uint32_t nbeats = ft->nbeats;
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] sensor:check_heartbeat for proc %s:%d",
                          pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         ft->requestor->info->pname.nspace, ft->requestor->info->pname.rank));
 
-    if (0 == ft->nbeats && !ft->stopped) {
+    /* add in any beats counted in the shared page */
+    if (0 <= ft->slot) {
+        beats = *heartbeat_counter(ft->slot);
+        nbeats += (uint32_t)(beats - ft->last);
+        ft->last = beats;
+        if (0 < nbeats) {
+            /* ensure we know that the proc is alive */
+            ft->stopped = false;
+        }
+    }
+
+    if (0 == nbeats && !ft->stopped) {
         /* no heartbeat recvd in last window */
         PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                              "[%s:%d] sensor:check_heartbeat failed for proc %s:%d",
@@ -312,34 +434,66 @@ static void check_heartbeat(int fd, short dummy, void *cbdata)
     } else {
         PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                              "[%s:%d] sensor:check_heartbeat detected %d beats for proc %s:%d",
-                             pmix_globals.myid.nspace, pmix_globals.myid.rank, ft->nbeats,
+                             pmix_globals.myid.nspace, pmix_globals.myid.rank, nbeats,
                              ft->requestor->info->pname.nspace, ft->requestor->info->pname.rank));
     }
     /* reset for next period */
     ft->nbeats = 0;
+}
 
-    /* reset the timer */
-    pmix_event_evtimer_add(&ft->ev, &ft->tv);
+/* this function automatically gets called by the event
+ * library once a second so we can check on the state of
+ * the procs whose windows close on this tick */
+static void check_heartbeats(int fd, short dummy, void *cbdata)
+{
+    pmix_psensor_heartbeat_component_t *c = &mca_psensor_heartbeat_component;
+    pmix_heartbeat_trkr_t *ft, *ftnext;
+    pmix_list_t *bucket, due;
+
+    ++c->tick;
+    bucket = &c->wheel[c->tick % PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE];
+
+    /* pull out the trackers that are due before checking any
+     * of them, as they go straight back into the wheel */
+    PMIX_CONSTRUCT(&due, pmix_list_t);
+    PMIX_LIST_FOREACH_SAFE(ft, ftnext, bucket, pmix_heartbeat_trkr_t) {
+        if (0 < ft->rounds) {
+            /* not due until the wheel comes around again */
+            --ft->rounds;
+            continue;
+        }
+        pmix_list_remove_item(bucket, &ft->super);
+        pmix_list_append(&due, &ft->super);
+    }
+    while (NULL != (ft = (pmix_heartbeat_trkr_t*)pmix_list_remove_first(&due))) {
+        check_heartbeat(ft);
+        schedule_tracker(ft, (uint64_t)ft->tv.tv_sec);
+    }
+    PMIX_DESTRUCT(&due);
 }
 
 static void add_beat(int sd, short args, void *cbdata)
 {
     pmix_psensor_beat_t *b = (pmix_psensor_beat_t*)cbdata;
     pmix_heartbeat_trkr_t *ft;
+    int i;
 
     PMIX_ACQUIRE_OBJECT(b);
 
     /* find this peer in our trackers */
-    PMIX_LIST_FOREACH(ft, &mca_psensor_heartbeat_component.trackers, pmix_heartbeat_trkr_t) {
-        if (ft->requestor == b->peer) {
-            /* increment the beat count */
-            ++ft->nbeats;
-            /* ensure we know that the proc is alive */
-            ft->stopped = false;
-            break;
+    for (i=0; i < PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE; i++) {
+        PMIX_LIST_FOREACH(ft, &mca_psensor_heartbeat_component.wheel[i], pmix_heartbeat_trkr_t) {
+            if (ft->requestor == b->peer) {
+                /* increment the beat count */
+                ++ft->nbeats;
+                /* ensure we know that the proc is alive */
+                ft->stopped = false;
+                goto done;
+            }
         }
     }
 
+  done:
     PMIX_RELEASE(b);
 }
 
@@ -2,7 +2,7 @@
  * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2012      Los Alamos National Security, Inc. All rights reserved.
  *
- * Copyright (c) 2017-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2017-2019 Intel, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -26,10 +26,25 @@
 
 BEGIN_C_DECLS
 
+/* trackers are checked from a single timer that ticks once a
+ * second - the wheel holds them in slots by the tick at which
+ * they are next due, so each tick only visits those that are */
+#define PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE   64
+
 typedef struct {
     pmix_psensor_base_component_t super;
     bool recv_active;
-    pmix_list_t trackers;
+    pmix_list_t wheel[PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE];
+    size_t ntrackers;
+    uint64_t tick;
+    pmix_event_t tick_ev;
+    bool tick_active;
+    /* page of beat counters shared with our local clients */
+    bool use_shmem;
+    int max_slots;
+    char *seg_path;
+    unsigned char *seg_base;
+    size_t seg_size;
 } pmix_psensor_heartbeat_component_t;
 
 PMIX_EXPORT extern pmix_psensor_heartbeat_component_t mca_psensor_heartbeat_component;
@@ -1,7 +1,7 @@
 /*
  * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2012      Los Alamos National Security, Inc. All rights reserved.
- * Copyright (c) 2017-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2017-2019 Intel, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -12,6 +12,10 @@
 #include <src/include/pmix_config.h>
 #include <pmix_common.h>
 
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
 #include "src/mca/ptl/ptl.h"
 #include "src/mca/psensor/base/base.h"
 #include "src/mca/psensor/heartbeat/psensor_heartbeat.h"
@@ -20,6 +24,7 @@
  * Local functions
  */
 
+static int heartbeat_register(void);
 static int heartbeat_open(void);
 static int heartbeat_close(void);
 static int heartbeat_query(pmix_mca_base_module_t **module, int *priority);
@@ -37,20 +42,52 @@ pmix_psensor_heartbeat_component_t mca_psensor_heartbeat_component = {
                                        PMIX_RELEASE_VERSION),
 
             /* Component open and close functions */
-            heartbeat_open,  /* component open  */
-            heartbeat_close, /* component close */
-            heartbeat_query  /* component query */
+            .pmix_mca_open_component = heartbeat_open,
+            .pmix_mca_close_component = heartbeat_close,
+            .pmix_mca_query_component = heartbeat_query,
+            .pmix_mca_register_component_params = heartbeat_register
         }
-    }
+    },
+    .use_shmem = true,
+    .max_slots = 1024
 };
 
+static int heartbeat_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_psensor_heartbeat_component.super.base;
+
+    (void)pmix_mca_base_component_var_register(component, "use_shmem",
+                                               "Have local clients count their heartbeats in a page shared with the server instead of sending each one as a message",
+                                               PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                               PMIX_INFO_LVL_9,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_psensor_heartbeat_component.use_shmem);
+    (void)pmix_mca_base_component_var_register(component, "max_shmem_slots",
+                                               "Number of client heartbeat counters in the shared page",
+                                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                               PMIX_INFO_LVL_9,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_psensor_heartbeat_component.max_slots);
+    return PMIX_SUCCESS;
+}
+
 
 /**
   * component open/close/init function
   */
 static int heartbeat_open(void)
 {
-    PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.trackers, pmix_list_t);
+    int i;
+
+    for (i=0; i < PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE; i++) {
+        PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.wheel[i], pmix_list_t);
+    }
+    mca_psensor_heartbeat_component.ntrackers = 0;
+    mca_psensor_heartbeat_component.tick = 0;
+    mca_psensor_heartbeat_component.tick_active = false;
+    mca_psensor_heartbeat_component.seg_path = NULL;
+    mca_psensor_heartbeat_component.seg_base = NULL;
+    mca_psensor_heartbeat_component.seg_size = 0;
 
     return PMIX_SUCCESS;
 }
@@ -69,7 +106,25 @@ static int heartbeat_query(pmix_mca_base_module_t **module, int *priority)
 
 static int heartbeat_close(void)
 {
-    PMIX_LIST_DESTRUCT(&mca_psensor_heartbeat_component.trackers);
+    int i;
+
+    if (mca_psensor_heartbeat_component.tick_active) {
+        pmix_event_del(&mca_psensor_heartbeat_component.tick_ev);
+        mca_psensor_heartbeat_component.tick_active = false;
+    }
+    for (i=0; i < PMIX_PSENSOR_HEARTBEAT_WHEEL_SIZE; i++) {
+        PMIX_LIST_DESTRUCT(&mca_psensor_heartbeat_component.wheel[i]);
+    }
+    if (NULL != mca_psensor_heartbeat_component.seg_base) {
+        munmap(mca_psensor_heartbeat_component.seg_base,
+               mca_psensor_heartbeat_component.seg_size);
+        mca_psensor_heartbeat_component.seg_base = NULL;
+    }
+    if (NULL != mca_psensor_heartbeat_component.seg_path) {
+        unlink(mca_psensor_heartbeat_component.seg_path);
+        free(mca_psensor_heartbeat_component.seg_path);
+        mca_psensor_heartbeat_component.seg_path = NULL;
+    }
 
     return PMIX_SUCCESS;
 }
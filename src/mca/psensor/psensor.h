@@ -1,7 +1,7 @@
 /*
  * Copyright (c) 2009      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2012      Los Alamos National Security, Inc. All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc.  All rights reserved.
  *
  * $COPYRIGHT$
  *
@@ -36,10 +36,14 @@ BEGIN_C_DECLS
  *
  * directives - an array of pmix_info_t specifying relevant limits on values, and action
  *              to be taken when limits exceeded. Can include
- *              user-provided "id" string */
+ *              user-provided "id" string
+ *
+ * results - a list of pmix_infolist_t to which the sensor can append
+ *           information to be returned to the requestor */
 typedef pmix_status_t (*pmix_psensor_base_module_start_fn_t)(pmix_peer_t *requestor, pmix_status_t error,
                                                              const pmix_info_t *monitor,
-                                                             const pmix_info_t directives[], size_t ndirs);
+                                                             const pmix_info_t directives[], size_t ndirs,
+                                                             pmix_list_t *results);
 
 /* stop a sensor operation:
  *
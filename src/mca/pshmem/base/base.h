@@ -47,6 +47,36 @@ BEGIN_C_DECLS
  * MCA Framework
  */
 PMIX_EXPORT extern pmix_mca_base_framework_t pmix_pshmem_base_framework;
+
+/* huge page policy for segments of at least one huge page */
+typedef enum {
+    PMIX_PSHMEM_HUGEPAGES_NONE,
+    PMIX_PSHMEM_HUGEPAGES_THP,      // madvise(MADV_HUGEPAGE)
+    PMIX_PSHMEM_HUGEPAGES_HUGETLB   // explicit huge pages, if the module can
+} pmix_pshmem_hugepages_t;
+
+typedef struct {
+    pmix_pshmem_hugepages_t hugepages;
+    size_t hugepage_size;
+    bool prefault;
+} pmix_pshmem_globals_t;
+
+PMIX_EXPORT extern pmix_pshmem_globals_t pmix_pshmem_globals;
+
+/* return true if a segment of the given size should use huge pages */
+#define PMIX_PSHMEM_USE_HUGEPAGES(s)                                \
+    (PMIX_PSHMEM_HUGEPAGES_NONE != pmix_pshmem_globals.hugepages && \
+     pmix_pshmem_globals.hugepage_size <= (s))
+
+/* round the size of a segment up to a whole number of huge
+ * pages if they are going to be used for it */
+PMIX_EXPORT size_t pmix_pshmem_base_segment_size(size_t size);
+
+/* additional mmap(2) flags requested by the user */
+PMIX_EXPORT int pmix_pshmem_base_mmap_flags(void);
+
+/* apply the huge page policy to a mapped segment */
+PMIX_EXPORT void pmix_pshmem_base_advise(void *addr, size_t size);
 /**
  * PSHMEM select function
  *
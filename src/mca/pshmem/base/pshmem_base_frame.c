@@ -30,10 +30,13 @@
 #ifdef HAVE_STRING_H
 #include <string.h>
 #endif
+#include <stdio.h>
+#include <sys/mman.h>
 
 #include "src/class/pmix_list.h"
 #include "src/mca/base/base.h"
 #include "src/mca/pshmem/base/base.h"
+#include "src/util/output.h"
 
 /*
  * The following file was created by configure.  It contains extern
@@ -47,6 +50,55 @@ static bool initialized = false;
 
 /* Instantiate the global vars */
 pmix_pshmem_base_module_t pmix_pshmem = {0};
+pmix_pshmem_globals_t pmix_pshmem_globals = {
+    .hugepages = PMIX_PSHMEM_HUGEPAGES_NONE,
+    .hugepage_size = 2 * 1024 * 1024,
+    .prefault = false
+};
+
+static char *hugepages = NULL;
+
+static pmix_status_t pmix_pshmem_register(pmix_mca_base_register_flag_t flags)
+{
+    (void)pmix_mca_base_var_register("pmix", "pshmem", "base", "hugepages",
+                                     "Back shared memory segments that are at least one huge page "
+                                     "in size with huge pages [none (default) | thp (transparent "
+                                     "huge pages via madvise) | hugetlb (explicit huge pages where "
+                                     "supported by the component, thp otherwise)]",
+                                     PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                     PMIX_INFO_LVL_5,
+                                     PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                     &hugepages);
+
+    (void)pmix_mca_base_var_register("pmix", "pshmem", "base", "prefault",
+                                     "Populate the page tables of shared memory segments when they "
+                                     "are created or attached instead of faulting them in lazily",
+                                     PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                     PMIX_INFO_LVL_5,
+                                     PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                     &pmix_pshmem_globals.prefault);
+    return PMIX_SUCCESS;
+}
+
+static size_t get_hugepage_size(void)
+{
+    FILE *fp;
+    char line[256];
+    unsigned long sz;
+    size_t size = 0;
+
+    if (NULL == (fp = fopen("/proc/meminfo", "r"))) {
+        return 0;
+    }
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        if (1 == sscanf(line, "Hugepagesize: %lu kB", &sz)) {
+            size = sz * 1024;
+            break;
+        }
+    }
+    fclose(fp);
+    return size;
+}
 
 static pmix_status_t pmix_pshmem_close(void)
 {
@@ -66,10 +118,61 @@ static pmix_status_t pmix_pshmem_open(pmix_mca_base_open_flag_t flags)
     /* initialize globals */
     initialized = true;
 
+    if (NULL == hugepages || 0 == strcmp(hugepages, "none")) {
+        pmix_pshmem_globals.hugepages = PMIX_PSHMEM_HUGEPAGES_NONE;
+    } else if (0 == strcmp(hugepages, "thp")) {
+        pmix_pshmem_globals.hugepages = PMIX_PSHMEM_HUGEPAGES_THP;
+    } else if (0 == strcmp(hugepages, "hugetlb")) {
+        pmix_pshmem_globals.hugepages = PMIX_PSHMEM_HUGEPAGES_HUGETLB;
+    } else {
+        pmix_output(0, "pshmem: unknown huge page policy \"%s\" - ignored", hugepages);
+        pmix_pshmem_globals.hugepages = PMIX_PSHMEM_HUGEPAGES_NONE;
+    }
+    if (PMIX_PSHMEM_HUGEPAGES_NONE != pmix_pshmem_globals.hugepages) {
+        size_t sz = get_hugepage_size();
+        if (0 == sz) {
+            /* no huge page support in this kernel */
+            pmix_pshmem_globals.hugepages = PMIX_PSHMEM_HUGEPAGES_NONE;
+        } else {
+            pmix_pshmem_globals.hugepage_size = sz;
+        }
+    }
+
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&pmix_pshmem_base_framework, flags);
 }
 
+size_t pmix_pshmem_base_segment_size(size_t size)
+{
+    size_t hsz = pmix_pshmem_globals.hugepage_size;
+
+    if (!PMIX_PSHMEM_USE_HUGEPAGES(size)) {
+        return size;
+    }
+    return ((size + hsz - 1) / hsz) * hsz;
+}
+
+int pmix_pshmem_base_mmap_flags(void)
+{
+#ifdef MAP_POPULATE
+    if (pmix_pshmem_globals.prefault) {
+        return MAP_POPULATE;
+    }
+#endif
+    return 0;
+}
+
+void pmix_pshmem_base_advise(void *addr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    if (PMIX_PSHMEM_USE_HUGEPAGES(size)) {
+        /* this is only a hint - if THP isn't enabled for shared
+         * memory, then we simply keep using regular pages */
+        (void)madvise(addr, size, MADV_HUGEPAGE);
+    }
+#endif
+}
+
 PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, pshmem, "PMIx Shared memory",
-                                NULL, pmix_pshmem_open, pmix_pshmem_close,
+                                pmix_pshmem_register, pmix_pshmem_open, pmix_pshmem_close,
                                 mca_pshmem_base_static_components, 0);
@@ -77,7 +77,7 @@ int pmix_pshmem_base_select(void)
 
         /* If we got a module, try to initialize it */
         nmodule = (pmix_pshmem_base_module_t*) module;
-        if (NULL != nmodule->init && PMIX_SUCCESS != nmodule->init()) {
+        if (NULL != nmodule->init && PMIX_SUCCESS != nmodule->init(NULL, 0)) {
             continue;
         }
 
@@ -0,0 +1,36 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2019      Intel, Inc.  All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_pshmem_memfd_CONFIG([action-if-found], [action-if-not-found])
+# --------------------------------------------------------------------
+AC_DEFUN([MCA_pmix_pshmem_memfd_CONFIG],[
+    AC_CONFIG_FILES([src/mca/pshmem/memfd/Makefile])
+
+    PMIX_VAR_SCOPE_PUSH([pshmem_memfd_happy])
+
+    pshmem_memfd_happy=no
+    AC_CHECK_FUNC([memfd_create],
+                  [AC_CHECK_DECL([F_ADD_SEALS],
+                                 [pshmem_memfd_happy=yes],
+                                 [],
+                                 [#ifndef _GNU_SOURCE
+                                  #define _GNU_SOURCE
+                                  #endif
+                                  #include <fcntl.h>])])
+
+    AC_MSG_CHECKING([will memfd shared memory support be built])
+    AS_IF([test "$pshmem_memfd_happy" = "yes"],
+          [AC_MSG_RESULT([yes])
+           $1],
+          [AC_MSG_RESULT([no])
+           $2])
+
+    PMIX_VAR_SCOPE_POP
+])dnl
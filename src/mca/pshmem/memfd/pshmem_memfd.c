@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/* The memfd module backs each segment with an anonymous, sealed
+ * memory file instead of a file in the session directory. The
+ * server keeps the descriptor open for the lifetime of the segment
+ * and exports it to the clients through a symbolic link at the
+ * usual segment path that points to /proc/<pid>/fd/<fd>. Opening
+ * that link hands the client its own reference to the server's
+ * memfd, so the clients attach exactly as they would to a file.
+ *
+ * Nothing is ever written to the filesystem besides the link, and
+ * the memory is released by the kernel as soon as the server and
+ * the last client go away - even if they do so abnormally.
+ *
+ * If the memfd can't be exported (no procfs, or the segments have
+ * to be reachable by a different uid), the module falls back to
+ * regular file-backed segments.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <unistd.h>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+
+#include <src/include/pmix_config.h>
+#include <pmix_common.h>
+#include "src/include/pmix_globals.h"
+#include "src/util/output.h"
+
+#include <src/mca/pshmem/pshmem.h>
+#include "src/mca/pshmem/base/base.h"
+#include "pshmem_memfd.h"
+
+static int _memfd_init(pmix_info_t info[], size_t ninfo);
+static void _memfd_finalize(void);
+static int _memfd_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size);
+static int _memfd_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mode_t sm_mode);
+static int _memfd_segment_detach(pmix_pshmem_seg_t *sm_seg);
+static int _memfd_segment_unlink(pmix_pshmem_seg_t *sm_seg);
+
+pmix_pshmem_base_module_t pmix_memfd_module = {
+    "memfd",
+    _memfd_init,
+    _memfd_finalize,
+    _memfd_segment_create,
+    _memfd_segment_attach,
+    _memfd_segment_detach,
+    _memfd_segment_unlink
+};
+
+#define PMIX_PSHMEM_MEMFD_SEALS (F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)
+
+static int _memfd_init(pmix_info_t info[], size_t ninfo)
+{
+    size_t n;
+    int fd;
+    char path[PMIX_PATH_MAX];
+    struct stat st;
+
+    /* a memfd exported through procfs is only reachable by
+     * processes that can access our /proc entry - if the
+     * segments are going to be owned by another user, then
+     * we have to use regular files */
+    for (n=0; n < ninfo; n++) {
+        if (0 == strcmp(PMIX_USERID, info[n].key)) {
+            if (info[n].value.data.uint32 != geteuid()) {
+                pmix_output_verbose(2, pmix_globals.debug_output,
+                                    "pshmem:memfd: job uid %u differs from ours - using files",
+                                    info[n].value.data.uint32);
+                mca_pshmem_memfd_component.use_memfd = false;
+            }
+            break;
+        }
+    }
+    if (!mca_pshmem_memfd_component.use_memfd) {
+        return PMIX_SUCCESS;
+    }
+
+    /* check that the kernel supports it and that we can
+     * reach our own descriptors through procfs */
+    if (0 > (fd = memfd_create("pmix-probe", MFD_CLOEXEC | MFD_ALLOW_SEALING))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pshmem:memfd: memfd_create(2) unavailable - using files");
+        mca_pshmem_memfd_component.use_memfd = false;
+        return PMIX_SUCCESS;
+    }
+    snprintf(path, PMIX_PATH_MAX, "/proc/%d/fd/%d", (int)getpid(), fd);
+    if (0 != stat(path, &st)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pshmem:memfd: %s not accessible - using files", path);
+        mca_pshmem_memfd_component.use_memfd = false;
+    }
+    close(fd);
+
+    return PMIX_SUCCESS;
+}
+
+static void _memfd_finalize(void)
+{
+    ;
+}
+
+static int _file_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size)
+{
+    int fd;
+
+    if (-1 == (fd = open(file_name, O_CREAT | O_RDWR, 0600))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call open(2) fail\n");
+        return PMIX_ERROR;
+    }
+    if (0 != ftruncate(fd, size)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call ftruncate(2) fail\n");
+        close(fd);
+        unlink(file_name);
+        return PMIX_ERROR;
+    }
+    sm_seg->seg_base_addr = (unsigned char *)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                                                  MAP_SHARED | pmix_pshmem_base_mmap_flags(),
+                                                  fd, 0);
+    close(fd);
+    if (MAP_FAILED == sm_seg->seg_base_addr) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call mmap(2) fail\n");
+        unlink(file_name);
+        return PMIX_ERROR;
+    }
+    pmix_pshmem_base_advise(sm_seg->seg_base_addr, size);
+    /* we don't hold on to the descriptor */
+    sm_seg->seg_id = PMIX_SHMEM_DS_ID_INVALID;
+    return PMIX_SUCCESS;
+}
+
+static int _memfd_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size)
+{
+    int rc = PMIX_ERROR;
+    const char *name;
+    char path[PMIX_PATH_MAX];
+    unsigned int flags = MFD_CLOEXEC | MFD_ALLOW_SEALING;
+    bool hugetlb = false;
+
+    _segment_ds_reset(sm_seg);
+    size = pmix_pshmem_base_segment_size(size);
+
+    if (!mca_pshmem_memfd_component.use_memfd) {
+        if (PMIX_SUCCESS != (rc = _file_segment_create(sm_seg, file_name, size))) {
+            _segment_ds_reset(sm_seg);
+            return rc;
+        }
+        goto done;
+    }
+
+    /* the name is only used for debugging purposes - it shows
+     * up as the target of /proc/<pid>/fd/<fd> */
+    if (NULL == (name = strrchr(file_name, '/'))) {
+        name = file_name;
+    } else {
+        name++;
+    }
+#ifdef MFD_HUGETLB
+    if (PMIX_PSHMEM_HUGEPAGES_HUGETLB == pmix_pshmem_globals.hugepages &&
+        PMIX_PSHMEM_USE_HUGEPAGES(size)) {
+        sm_seg->seg_id = memfd_create(name, flags | MFD_HUGETLB);
+        if (-1 != sm_seg->seg_id) {
+            hugetlb = true;
+        } else {
+            /* no huge pages reserved or not supported - use THP */
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                    "pshmem:memfd: MFD_HUGETLB unavailable for %s\n", name);
+        }
+    }
+#endif
+  regular:
+    if (-1 == sm_seg->seg_id &&
+        -1 == (sm_seg->seg_id = memfd_create(name, flags))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call memfd_create(2) fail\n");
+        goto err;
+    }
+    if (0 != ftruncate(sm_seg->seg_id, size)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call ftruncate(2) fail\n");
+        goto err;
+    }
+    /* nobody - including a misbehaving client - may resize the
+     * segment underneath the processes that have it mapped */
+    if (0 != fcntl(sm_seg->seg_id, F_ADD_SEALS, PMIX_PSHMEM_MEMFD_SEALS)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call fcntl(F_ADD_SEALS) fail\n");
+        /* older kernels can't seal hugetlbfs files - a hugetlb
+         * segment can't be truncated to a partial page anyway */
+        if (!hugetlb) {
+            goto err;
+        }
+    }
+    if (MAP_FAILED == (sm_seg->seg_base_addr = (unsigned char *)
+                mmap(NULL, size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | pmix_pshmem_base_mmap_flags(),
+                     sm_seg->seg_id, 0))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call mmap(2) fail\n");
+        if (hugetlb) {
+            /* not enough huge pages reserved - retry with
+             * regular pages */
+            close(sm_seg->seg_id);
+            sm_seg->seg_id = PMIX_SHMEM_DS_ID_INVALID;
+            hugetlb = false;
+            goto regular;
+        }
+        goto err;
+    }
+    if (!hugetlb) {
+        pmix_pshmem_base_advise(sm_seg->seg_base_addr, size);
+    }
+    /* export the descriptor at the path the clients expect */
+    snprintf(path, PMIX_PATH_MAX, "/proc/%d/fd/%d", (int)getpid(), sm_seg->seg_id);
+    if (0 != symlink(path, file_name)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call symlink(2) fail\n");
+        munmap(sm_seg->seg_base_addr, size);
+        goto err;
+    }
+
+  done:
+    sm_seg->seg_cpid = getpid();
+    sm_seg->seg_size = size;
+    pmix_strncpy(sm_seg->seg_name, file_name, PMIX_PATH_MAX);
+    return PMIX_SUCCESS;
+
+  err:
+    if (-1 != sm_seg->seg_id) {
+        close(sm_seg->seg_id);
+    }
+    _segment_ds_reset(sm_seg);
+    return rc;
+}
+
+static int _memfd_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mode_t sm_mode)
+{
+    mode_t mode = O_RDWR;
+    int mmap_prot = PROT_READ | PROT_WRITE;
+    int fd;
+    struct stat st;
+
+    if (sm_mode == PMIX_PSHMEM_RONLY) {
+        mode = O_RDONLY;
+        mmap_prot = PROT_READ;
+    }
+
+    /* this works for both the exported memfd and a file, so
+     * we can attach regardless of what the server ended up using */
+    if (-1 == (fd = open(sm_seg->seg_name, mode))) {
+        return PMIX_ERROR;
+    }
+    /* protect ourselves against mapping beyond the end of the
+     * object - e.g., if the link was resolved in a different
+     * pid namespace than the one it was created in */
+    if (0 != fstat(fd, &st) || 0 == st.st_size ||
+        (size_t)st.st_size < sm_seg->seg_size) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "pshmem:memfd: segment %s is smaller than expected\n",
+                sm_seg->seg_name);
+        close(fd);
+        return PMIX_ERROR;
+    }
+    /* a zero size means the creator sized the segment */
+    if (0 == sm_seg->seg_size) {
+        sm_seg->seg_size = st.st_size;
+    }
+    sm_seg->seg_base_addr = (unsigned char *)mmap(NULL, sm_seg->seg_size, mmap_prot,
+                                                  MAP_SHARED | pmix_pshmem_base_mmap_flags(),
+                                                  fd, 0);
+    close(fd);
+    if (MAP_FAILED == sm_seg->seg_base_addr) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call mmap(2) fail\n");
+        return PMIX_ERROR;
+    }
+    pmix_pshmem_base_advise(sm_seg->seg_base_addr, sm_seg->seg_size);
+    sm_seg->seg_id = PMIX_SHMEM_DS_ID_INVALID;
+    sm_seg->seg_cpid = 0;
+    return PMIX_SUCCESS;
+}
+
+static int _memfd_segment_detach(pmix_pshmem_seg_t *sm_seg)
+{
+    int rc = PMIX_SUCCESS;
+
+    if (0 != munmap((void *)sm_seg->seg_base_addr, sm_seg->seg_size)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call munmap(2) fail\n");
+        rc = PMIX_ERROR;
+    }
+    if (PMIX_SHMEM_DS_ID_INVALID != sm_seg->seg_id) {
+        close(sm_seg->seg_id);
+    }
+    _segment_ds_reset(sm_seg);
+    return rc;
+}
+
+static int _memfd_segment_unlink(pmix_pshmem_seg_t *sm_seg)
+{
+    if (-1 == unlink(sm_seg->seg_name)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call unlink(2) fail\n");
+        return PMIX_ERROR;
+    }
+    /* without the link nobody can reach the memfd anymore, so
+     * drop our reference - the mapping keeps the memory alive */
+    if (PMIX_SHMEM_DS_ID_INVALID != sm_seg->seg_id) {
+        close(sm_seg->seg_id);
+    }
+    sm_seg->seg_id = PMIX_SHMEM_DS_ID_INVALID;
+    return PMIX_SUCCESS;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_PSHMEM_MEMFD_H
+#define PMIX_PSHMEM_MEMFD_H
+
+#include <src/include/pmix_config.h>
+#include <src/mca/pshmem/pshmem.h>
+
+BEGIN_C_DECLS
+
+typedef struct {
+    pmix_pshmem_base_component_t super;
+    int priority;
+    /* fall back to file-backed segments if the memfd
+     * can't be exported to the clients */
+    bool use_memfd;
+} pmix_pshmem_memfd_component_t;
+
+PMIX_EXPORT extern pmix_pshmem_memfd_component_t mca_pshmem_memfd_component;
+extern pmix_pshmem_base_module_t pmix_memfd_module;
+
+END_C_DECLS
+
+#endif /* PMIX_PSHMEM_MEMFD_H */
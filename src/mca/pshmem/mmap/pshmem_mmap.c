@@ -27,13 +27,14 @@
 
 //#include "pmix_sm.h"
 #include <src/mca/pshmem/pshmem.h>
+#include "src/mca/pshmem/base/base.h"
 #include "pshmem_mmap.h"
 
 #if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
 #    define MAP_ANONYMOUS MAP_ANON
 #endif /* MAP_ANONYMOUS and MAP_ANON */
 
-static int _mmap_init(void);
+static int _mmap_init(pmix_info_t info[], size_t ninfo);
 static void _mmap_finalize(void);
 static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size);
 static int _mmap_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mode_t sm_mode);
@@ -50,7 +51,7 @@ pmix_pshmem_base_module_t pmix_mmap_module = {
     _mmap_segment_unlink
 };
 
-static int _mmap_init(void)
+static int _mmap_init(pmix_info_t info[], size_t ninfo)
 {
     return PMIX_SUCCESS;
 }
@@ -67,6 +68,9 @@ static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name
     pid_t my_pid = getpid();
 
     _segment_ds_reset(sm_seg);
+    /* we can't get explicit huge pages for a regular file, so
+     * hugetlb falls back to THP - but keep the size aligned */
+    size = pmix_pshmem_base_segment_size(size);
     /* enough space is available, so create the segment */
     if (-1 == (sm_seg->seg_id = open(file_name, O_CREAT | O_RDWR, 0600))) {
         pmix_output_verbose(2, pmix_globals.debug_output,
@@ -111,13 +115,15 @@ static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name
   map_memory:
 #endif
     if (MAP_FAILED == (seg_addr = mmap(NULL, size,
-                                       PROT_READ | PROT_WRITE, MAP_SHARED,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | pmix_pshmem_base_mmap_flags(),
                                        sm_seg->seg_id, 0))) {
         pmix_output_verbose(2, pmix_globals.debug_output,
                 "sys call mmap(2) fail\n");
         rc = PMIX_ERROR;
         goto out;
     }
+    pmix_pshmem_base_advise(seg_addr, size);
     sm_seg->seg_cpid = my_pid;
     sm_seg->seg_size = size;
     sm_seg->seg_base_addr = (unsigned char *)seg_addr;
@@ -154,9 +160,19 @@ static int _mmap_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mo
     if (-1 == (sm_seg->seg_id = open(sm_seg->seg_name, mode))) {
         return PMIX_ERROR;
     }
+    /* a zero size means the creator sized the segment, so take
+     * whatever the file holds */
+    if (0 == sm_seg->seg_size) {
+        struct stat st;
+        if (0 != fstat(sm_seg->seg_id, &st) || 0 == st.st_size) {
+            close(sm_seg->seg_id);
+            return PMIX_ERROR;
+        }
+        sm_seg->seg_size = st.st_size;
+    }
     if (MAP_FAILED == (sm_seg->seg_base_addr = (unsigned char *)
                 mmap(NULL, sm_seg->seg_size,
-                    mmap_prot, MAP_SHARED,
+                    mmap_prot, MAP_SHARED | pmix_pshmem_base_mmap_flags(),
                     sm_seg->seg_id, 0))) {
         /* mmap failed, so close the file and return NULL - no error check
          * here because we are already in an error path...
@@ -166,6 +182,7 @@ static int _mmap_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mo
         close(sm_seg->seg_id);
         return PMIX_ERROR;
     }
+    pmix_pshmem_base_advise(sm_seg->seg_base_addr, sm_seg->seg_size);
     /* all is well */
     /* if close fails here, that's okay.  just let the user know and
      * continue.  if we got this far, open and mmap were successful...
@@ -55,8 +55,10 @@ static inline void _segment_ds_reset(pmix_pshmem_seg_t *sm_seg)
     sm_seg->seg_base_addr = (unsigned char *)MAP_FAILED;
 }
 
-/* initialize the module */
-typedef pmix_status_t (*pmix_pshmem_base_module_init_fn_t)(void);
+/* initialize the module - the info array contains the directives
+ * that were passed to the datastore, e.g., the uid that will own
+ * the segments */
+typedef pmix_status_t (*pmix_pshmem_base_module_init_fn_t)(pmix_info_t info[], size_t ninfo);
 
 /* finalize the module */
 typedef void (*pmix_pshmem_base_module_finalize_fn_t)(void);
@@ -70,7 +72,9 @@ typedef void (*pmix_pshmem_base_module_finalize_fn_t)(void);
 * @param file_name unique string identifier that must be a valid,
 *                 writable path (IN).
 *
-* @param size     size of the shared memory segment.
+* @param size     size of the shared memory segment. The module may
+*                 round it up (e.g., to a whole number of huge pages) -
+*                 the actual size is returned in sm_seg->seg_size.
 *
 * @return PMIX_SUCCESS on success.
 */
@@ -81,7 +85,8 @@ typedef int (*pmix_pshmem_base_module_segment_create_fn_t)(pmix_pshmem_seg_t *sm
 * attach to an existing shared memory segment initialized by segment_create.
 *
 * @param sm_seg  pointer to initialized pmix_pshmem_seg_t typedef'd
-*                structure (IN/OUT).
+*                structure (IN/OUT). If seg_size is zero, the size
+*                of the existing segment is used and returned in it.
 *
 * @return        base address of shared memory segment on success. returns
 *                NULL otherwise.
@@ -80,6 +80,7 @@ struct pmix_ptl_globals_t {
     pmix_list_t listeners;
     uint32_t current_tag;
     size_t max_msg_size;
+    int listen_backlog;
 };
 typedef struct pmix_ptl_globals_t pmix_ptl_globals_t;
 
@@ -112,6 +113,7 @@ PMIX_EXPORT pmix_status_t pmix_ptl_base_set_nonblocking(int sd);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_set_blocking(int sd);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_send_blocking(int sd, char *ptr, size_t size);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_recv_blocking(int sd, char *data, size_t size);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_read_bytes(int sd, char **buf, size_t *remain);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_connect(struct sockaddr_storage *addr,
                                                 pmix_socklen_t len, int *fd);
 PMIX_EXPORT void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata);
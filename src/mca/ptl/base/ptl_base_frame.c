@@ -11,7 +11,7 @@
  * Copyright (c) 2004-2005 The Regents of the University of California.
  *                         All rights reserved.
  * Copyright (c) 2012-2013 Los Alamos National Security, Inc.  All rights reserved.
- * Copyright (c) 2014-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015-2017 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -36,6 +36,12 @@
 #ifdef HAVE_SYS_STAT_H
 #include <sys/stat.h>
 #endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
 
 #include "src/mca/mca.h"
 #include "src/mca/base/base.h"
@@ -60,9 +66,12 @@ pmix_ptl_globals_t pmix_ptl_globals = {{{0}}};
 int pmix_ptl_base_output = -1;
 
 static size_t max_msg_size = PMIX_MAX_MSG_SIZE;
+static int listen_backlog = 0;
 
 static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
 {
+    long ncpus;
+
     pmix_mca_base_var_register("pmix", "ptl", "base", "max_msg_size",
                                "Max size (in Mbytes) of a client/server msg",
                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
@@ -70,6 +79,25 @@ static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_SCOPE_READONLY,
                                &max_msg_size);
     pmix_ptl_globals.max_msg_size = max_msg_size * 1024 * 1024;
+
+    pmix_mca_base_var_register("pmix", "ptl", "base", "listen_backlog",
+                               "Number of connection requests a server listener can have queued "
+                               "(0 => size it from the number of processors on the node)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &listen_backlog);
+    pmix_ptl_globals.listen_backlog = listen_backlog;
+    if (0 >= pmix_ptl_globals.listen_backlog) {
+        /* a dense job will try to connect one proc per processor
+         * all at once, and tools come on top of that - the kernel
+         * will clamp this to its own limit */
+        ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+        pmix_ptl_globals.listen_backlog = SOMAXCONN;
+        if (pmix_ptl_globals.listen_backlog < 2 * ncpus) {
+            pmix_ptl_globals.listen_backlog = 2 * ncpus;
+        }
+    }
     return PMIX_SUCCESS;
 }
 
@@ -143,9 +171,9 @@ static void sdes(pmix_ptl_send_t *p)
         PMIX_RELEASE(p->data);
     }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_send_t,
-                                pmix_list_item_t,
-                                scon, sdes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_ptl_send_t,
+                                       pmix_list_item_t,
+                                       scon, sdes);
 
 static void rcon(pmix_ptl_recv_t *p)
 {
@@ -164,9 +192,9 @@ static void rdes(pmix_ptl_recv_t *p)
         PMIX_RELEASE(p->peer);
     }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_recv_t,
-                                pmix_list_item_t,
-                                rcon, rdes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_ptl_recv_t,
+                                       pmix_list_item_t,
+                                       rcon, rdes);
 
 static void prcon(pmix_ptl_posted_recv_t *p)
 {
@@ -209,6 +237,12 @@ static void pccon(pmix_pending_connection_t *p)
     p->ptl = NULL;
     p->cred = NULL;
     p->proc_type = PMIX_PROC_UNDEF;
+    memset(&p->hdr, 0, sizeof(pmix_ptl_hdr_t));
+    p->hdr_recvd = false;
+    p->data = NULL;
+    p->rdptr = NULL;
+    p->rdbytes = 0;
+    p->timer_active = false;
 }
 static void pcdes(pmix_pending_connection_t *p)
 {
@@ -227,6 +261,9 @@ static void pcdes(pmix_pending_connection_t *p)
     if (NULL != p->cred) {
         free(p->cred);
     }
+    if (NULL != p->data) {
+        free(p->data);
+    }
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_pending_connection_t,
                                 pmix_object_t,
@@ -1,6 +1,6 @@
 /* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
 /*
- * Copyright (c) 2014-2017 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2014-2019 Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
  * Copyright (c) 2014-2015 Artem Y. Polyakov <artpol84@gmail.com>.
@@ -42,6 +42,9 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
 #include <ctype.h>
 #include <sys/stat.h>
 #include PMIX_EVENT_HEADER
@@ -179,19 +182,238 @@ void pmix_ptl_base_stop_listening(void)
     }
 }
 
+/* connections harvested in a single pass of the listener
+ * thread - handed to the progress thread in one shot */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_pending_connection_t **pending;
+    pmix_ptl_pending_cbfunc_t *cbfuncs;
+    size_t npending;
+    size_t size;
+} pmix_ptl_accept_batch_t;
+static void bcon(pmix_ptl_accept_batch_t *p)
+{
+    p->pending = NULL;
+    p->cbfuncs = NULL;
+    p->npending = 0;
+    p->size = 0;
+}
+static void bdes(pmix_ptl_accept_batch_t *p)
+{
+    size_t n;
+
+    /* anything left was never handed off */
+    for (n=0; n < p->npending; n++) {
+        CLOSE_THE_SOCKET(p->pending[n]->sd);
+        PMIX_RELEASE(p->pending[n]);
+    }
+    if (NULL != p->pending) {
+        free(p->pending);
+    }
+    if (NULL != p->cbfuncs) {
+        free(p->cbfuncs);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_ptl_accept_batch_t,
+                           pmix_object_t,
+                           bcon, bdes);
+
+static void process_batch(int sd, short args, void *cbdata)
+{
+    pmix_ptl_accept_batch_t *batch = (pmix_ptl_accept_batch_t*)cbdata;
+    size_t n;
+
+    PMIX_ACQUIRE_OBJECT(batch);
+
+    for (n=0; n < batch->npending; n++) {
+        batch->cbfuncs[n](batch->pending[n]->sd, EV_WRITE, batch->pending[n]);
+    }
+    /* the handlers own the connections now */
+    batch->npending = 0;
+    PMIX_RELEASE(batch);
+}
+
+/* accept everything that is waiting on this listener, adding
+ * it to the batch. Returns the number of connections accepted,
+ * or a negative value if the listener can no longer be used */
+static int harvest(pmix_listener_t *lt, pmix_ptl_accept_batch_t *batch)
+{
+    pmix_pending_connection_t *pnd;
+    socklen_t addrlen;
+    void *tmp;
+    int naccepted = 0;
+
+    while (1) {
+        /* a connection request has been received - so harvest it. All
+         * we want to do here is accept the connection and push the info
+         * onto the event library for subsequent processing - we don't
+         * want to actually process the connection here as it takes too
+         * long, and so the OS might start rejecting connections due
+         * to timeout */
+        pnd = PMIX_NEW(pmix_pending_connection_t);
+        pnd->protocol = lt->protocol;
+        pnd->ptl = lt->ptl;
+        addrlen = sizeof(struct sockaddr_storage);
+#if defined(HAVE_ACCEPT4) && defined(SOCK_CLOEXEC) && defined(SOCK_NONBLOCK)
+        pnd->sd = accept4(lt->socket, (struct sockaddr*)&(pnd->addr),
+                          &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+        pnd->sd = accept(lt->socket, (struct sockaddr*)&(pnd->addr), &addrlen);
+        if (0 <= pnd->sd) {
+            pmix_fd_set_cloexec(pnd->sd);
+        }
+#endif
+        if (pnd->sd < 0) {
+            PMIX_RELEASE(pnd);
+            if (EAGAIN == pmix_socket_errno ||
+                EWOULDBLOCK == pmix_socket_errno) {
+                /* nothing more waiting */
+                return naccepted;
+            }
+            if (ECONNABORTED == pmix_socket_errno ||
+                EINTR == pmix_socket_errno) {
+                /* they aborted the attempt */
+                continue;
+            }
+            if (EMFILE == pmix_socket_errno ||
+                ENOBUFS == pmix_socket_errno ||
+                ENOMEM == pmix_socket_errno) {
+                PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+            } else if (EINVAL != pmix_socket_errno) {
+                /* EINVAL is a race condition at finalize */
+                pmix_output(0, "listen_thread: accept() failed: %s (%d).",
+                            strerror(pmix_socket_errno), pmix_socket_errno);
+            }
+            return -1;
+        }
+
+        pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
+                            "listen_thread: new connection: (%d, %d)",
+                            pnd->sd, pmix_socket_errno);
+        if (batch->npending == batch->size) {
+            batch->size = (0 == batch->size) ? 16 : 2 * batch->size;
+            tmp = realloc(batch->pending, batch->size * sizeof(pmix_pending_connection_t*));
+            if (NULL == tmp) {
+                CLOSE_THE_SOCKET(pnd->sd);
+                PMIX_RELEASE(pnd);
+                return -1;
+            }
+            batch->pending = (pmix_pending_connection_t**)tmp;
+            tmp = realloc(batch->cbfuncs, batch->size * sizeof(pmix_ptl_pending_cbfunc_t));
+            if (NULL == tmp) {
+                CLOSE_THE_SOCKET(pnd->sd);
+                PMIX_RELEASE(pnd);
+                return -1;
+            }
+            batch->cbfuncs = (pmix_ptl_pending_cbfunc_t*)tmp;
+        }
+        batch->pending[batch->npending] = pnd;
+        batch->cbfuncs[batch->npending] = lt->cbfunc;
+        ++batch->npending;
+        ++naccepted;
+    }
+}
+
+/* push a batch of connections to the progress thread */
+static void post_batch(pmix_ptl_accept_batch_t **batch)
+{
+    if (0 == (*batch)->npending) {
+        return;
+    }
+    pmix_event_assign(&(*batch)->ev, pmix_globals.evbase, -1,
+                      EV_WRITE, process_batch, *batch);
+    PMIX_POST_OBJECT(*batch);
+    pmix_event_active(&(*batch)->ev, EV_WRITE, 1);
+    *batch = PMIX_NEW(pmix_ptl_accept_batch_t);
+}
+
+#if defined(HAVE_SYS_EPOLL_H)
+
 static void* listen_thread(void *obj)
 {
-    int rc, max, accepted_connections;
-    socklen_t addrlen = sizeof(struct sockaddr_storage);
-    pmix_pending_connection_t *pending_connection;
+    int rc, n, efd;
+    struct epoll_event ev, events[16];
+    pmix_listener_t *lt;
+    pmix_ptl_accept_batch_t *batch;
+
+    pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
+                        "listen_thread: active");
+
+    if (0 > (efd = epoll_create1(EPOLL_CLOEXEC))) {
+        PMIX_ERROR_LOG(PMIX_ERR_IN_ERRNO);
+        goto done;
+    }
+    PMIX_LIST_FOREACH(lt, &pmix_ptl_globals.listeners, pmix_listener_t) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = lt;
+        if (0 > epoll_ctl(efd, EPOLL_CTL_ADD, lt->socket, &ev)) {
+            PMIX_ERROR_LOG(PMIX_ERR_IN_ERRNO);
+            close(efd);
+            goto done;
+        }
+    }
+    /* add the stop_thread fd - we don't need a timeout
+     * as this will wake us when it is time to leave */
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (0 > epoll_ctl(efd, EPOLL_CTL_ADD, pmix_ptl_globals.stop_thread[0], &ev)) {
+        PMIX_ERROR_LOG(PMIX_ERR_IN_ERRNO);
+        close(efd);
+        goto done;
+    }
+
+    batch = PMIX_NEW(pmix_ptl_accept_batch_t);
+    while (pmix_ptl_globals.listen_thread_active) {
+        rc = epoll_wait(efd, events, 16, -1);
+        if (!pmix_ptl_globals.listen_thread_active) {
+            /* we've been asked to terminate */
+            PMIX_RELEASE(batch);
+            close(efd);
+            close(pmix_ptl_globals.stop_thread[0]);
+            close(pmix_ptl_globals.stop_thread[1]);
+            return NULL;
+        }
+        if (rc < 0) {
+            continue;
+        }
+        for (n=0; n < rc; n++) {
+            if (NULL == events[n].data.ptr) {
+                continue;
+            }
+            if (0 > harvest((pmix_listener_t*)events[n].data.ptr, batch)) {
+                post_batch(&batch);
+                PMIX_RELEASE(batch);
+                close(efd);
+                goto done;
+            }
+        }
+        post_batch(&batch);
+    }
+    PMIX_RELEASE(batch);
+    close(efd);
+
+ done:
+    pmix_ptl_globals.listen_thread_active = false;
+    return NULL;
+}
+
+#else
+
+static void* listen_thread(void *obj)
+{
+    int rc, max;
     struct timeval timeout;
     fd_set readfds;
     pmix_listener_t *lt;
+    pmix_ptl_accept_batch_t *batch;
 
     pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
                         "listen_thread: active");
 
-
+    batch = PMIX_NEW(pmix_ptl_accept_batch_t);
     while (pmix_ptl_globals.listen_thread_active) {
         FD_ZERO(&readfds);
         max = -1;
@@ -213,6 +435,7 @@ static void* listen_thread(void *obj)
         rc = select(max + 1, &readfds, NULL, NULL, &timeout);
         if (!pmix_ptl_globals.listen_thread_active) {
             /* we've been asked to terminate */
+            PMIX_RELEASE(batch);
             close(pmix_ptl_globals.stop_thread[0]);
             close(pmix_ptl_globals.stop_thread[1]);
             return NULL;
@@ -221,77 +444,33 @@ static void* listen_thread(void *obj)
             continue;
         }
 
-        /* Spin accepting connections until all active listen sockets
-         * do not have any incoming connections, pushing each connection
-         * onto the event queue for processing
+        /* accept everything that is waiting on the active listen
+         * sockets, pushing the connections onto the event queue
+         * for processing
          */
-        do {
-            accepted_connections = 0;
-            PMIX_LIST_FOREACH(lt, &pmix_ptl_globals.listeners, pmix_listener_t) {
-
-                /* according to the man pages, select replaces the given descriptor
-                 * set with a subset consisting of those descriptors that are ready
-                 * for the specified operation - in this case, a read. So we need to
-                 * first check to see if this file descriptor is included in the
-                 * returned subset
-                 */
-                if (0 == FD_ISSET(lt->socket, &readfds)) {
-                    /* this descriptor is not included */
-                    continue;
-                }
-
-                /* this descriptor is ready to be read, which means a connection
-                 * request has been received - so harvest it. All we want to do
-                 * here is accept the connection and push the info onto the event
-                 * library for subsequent processing - we don't want to actually
-                 * process the connection here as it takes too long, and so the
-                 * OS might start rejecting connections due to timeout.
-                 */
-                pending_connection = PMIX_NEW(pmix_pending_connection_t);
-                pending_connection->protocol = lt->protocol;
-                pending_connection->ptl = lt->ptl;
-                pmix_event_assign(&pending_connection->ev, pmix_globals.evbase, -1,
-                                  EV_WRITE, lt->cbfunc, pending_connection);
-                pending_connection->sd = accept(lt->socket,
-                                                (struct sockaddr*)&(pending_connection->addr),
-                                                &addrlen);
-                if (pending_connection->sd < 0) {
-                    PMIX_RELEASE(pending_connection);
-                    if (pmix_socket_errno != EAGAIN ||
-                        pmix_socket_errno != EWOULDBLOCK) {
-                        if (EMFILE == pmix_socket_errno ||
-                            ENOBUFS == pmix_socket_errno ||
-                            ENOMEM == pmix_socket_errno) {
-                            PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
-                        } else if (EINVAL == pmix_socket_errno ||
-                                   EINTR == pmix_socket_errno) {
-                            /* race condition at finalize */
-                            goto done;
-                        } else if (ECONNABORTED == pmix_socket_errno) {
-                            /* they aborted the attempt */
-                            continue;
-                        } else {
-                            pmix_output(0, "listen_thread: accept() failed: %s (%d).",
-                                        strerror(pmix_socket_errno), pmix_socket_errno);
-                        }
-                        goto done;
-                    }
-                    continue;
-                }
-
-                pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
-                                    "listen_thread: new connection: (%d, %d)",
-                                    pending_connection->sd, pmix_socket_errno);
-                /* post the object */
-                PMIX_POST_OBJECT(pending_connection);
-                /* activate the event */
-                pmix_event_active(&pending_connection->ev, EV_WRITE, 1);
-                accepted_connections++;
+        PMIX_LIST_FOREACH(lt, &pmix_ptl_globals.listeners, pmix_listener_t) {
+            /* according to the man pages, select replaces the given descriptor
+             * set with a subset consisting of those descriptors that are ready
+             * for the specified operation - in this case, a read. So we need to
+             * first check to see if this file descriptor is included in the
+             * returned subset
+             */
+            if (0 == FD_ISSET(lt->socket, &readfds)) {
+                /* this descriptor is not included */
+                continue;
+            }
+            if (0 > harvest(lt, batch)) {
+                post_batch(&batch);
+                goto done;
             }
-        } while (accepted_connections > 0);
+        }
+        post_batch(&batch);
     }
 
  done:
+    PMIX_RELEASE(batch);
     pmix_ptl_globals.listen_thread_active = false;
     return NULL;
 }
+
+#endif
@@ -43,6 +43,7 @@
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/util/error.h"
+#include "src/util/opstats.h"
 #include "src/util/show_help.h"
 #include "src/mca/psensor/psensor.h"
 
@@ -184,6 +185,12 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
         /* purge any notifications cached for this client */
         pmix_server_purge_events(peer, NULL);
 
+        if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+            /* drop what it published for its own lifetime,
+             * along with any lookups it left waiting */
+            pmix_server_pubsub_purge_peer(peer);
+        }
+
         if (PMIX_PROC_IS_LAUNCHER(pmix_globals.mypeer)) {
             /* only connection I can lose is to my server, so mark it */
             pmix_globals.connected = false;
@@ -327,7 +334,7 @@ static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
     }
 }
 
-static pmix_status_t read_bytes(int sd, char **buf, size_t *remain)
+pmix_status_t pmix_ptl_base_read_bytes(int sd, char **buf, size_t *remain)
 {
     pmix_status_t ret = PMIX_SUCCESS;
     int rc;
@@ -408,6 +415,8 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             // message is complete
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:base:send_handler MSG SENT");
+            PMIX_OPSTATS_BYTES(PMIX_OPSTATS_PTL_SEND, ntohl(msg->hdr.nbytes));
+            PMIX_PTL_SEND_DONE(peer, msg);
             PMIX_RELEASE(msg);
             peer->send_msg = NULL;
         } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
@@ -427,6 +436,7 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             // report the error
             pmix_event_del(&peer->send_event);
             peer->send_ev_active = false;
+            PMIX_PTL_SEND_DONE(peer, msg);
             PMIX_RELEASE(msg);
             peer->send_msg = NULL;
             pmix_ptl_base_lost_connection(peer, rc);
@@ -505,7 +515,7 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
                             "ptl:base:recv:handler read hdr on socket %d", peer->sd);
         nbytes = sizeof(pmix_ptl_hdr_t);
         ptr = (char*)&hdr;
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &ptr, &nbytes))) {
+        if (PMIX_SUCCESS == (rc = pmix_ptl_base_read_bytes(peer->sd, &ptr, &nbytes))) {
             /* completed reading the header */
             peer->recv_msg->hdr_recvd = true;
             /* convert the hdr to host format */
@@ -525,6 +535,7 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
                 peer->recv_msg->data = NULL;  // make sure
                 peer->recv_msg->rdptr = NULL;
                 peer->recv_msg->rdbytes = 0;
+                PMIX_OPSTATS_BYTES(PMIX_OPSTATS_PTL_RECV, 0);
                 /* post it for delivery */
                 PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
                 peer->recv_msg = NULL;
@@ -568,13 +579,14 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
          * wherever we left off, which could be at the
          * beginning or somewhere in the message
          */
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
+        if (PMIX_SUCCESS == (rc = pmix_ptl_base_read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
             /* we recvd all of the message */
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "%s:%d RECVD COMPLETE MESSAGE FROM SERVER OF %d BYTES FOR TAG %d ON PEER SOCKET %d",
                                 pmix_globals.myid.nspace, pmix_globals.myid.rank,
                                 (int)peer->recv_msg->hdr.nbytes,
                                 peer->recv_msg->hdr.tag, peer->sd);
+            PMIX_OPSTATS_BYTES(PMIX_OPSTATS_PTL_RECV, peer->recv_msg->hdr.nbytes);
             /* post it for delivery */
             PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
             peer->recv_msg = NULL;
@@ -662,6 +674,7 @@ void pmix_ptl_base_send(int sd, short args, void *cbdata)
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_ptl_hdr_t);
 
+    PMIX_PTL_SEND_QUEUED(queue->peer, snd);
     /* if there is no message on-deck, put this one there */
     if (NULL == (queue->peer)->send_msg) {
         (queue->peer)->send_msg = snd;
@@ -739,6 +752,7 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_ptl_hdr_t);
 
+    PMIX_PTL_SEND_QUEUED(ms->peer, snd);
     /* if there is no message on-deck, put this one there */
     if (NULL == ms->peer->send_msg) {
         ms->peer->send_msg = snd;
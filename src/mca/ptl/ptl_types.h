@@ -12,7 +12,7 @@
  *                         All rights reserved.
  * Copyright (c) 2007-2011 Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2012-2013 Los Alamos National Security, Inc. All rights reserved.
- * Copyright (c) 2014-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -136,6 +136,13 @@ typedef struct {
     char *sdptr;
     size_t sdbytes;
 } pmix_ptl_send_t;
+
+/* account for the payload of a message entering or leaving
+ * a peer's send queue - the "on-deck" send_msg is included */
+#define PMIX_PTL_SEND_QUEUED(p, s)                                  \
+    (p)->send_qbytes += (NULL == (s)->data) ? 0 : (s)->data->bytes_used
+#define PMIX_PTL_SEND_DONE(p, s)                                    \
+    (p)->send_qbytes -= (NULL == (s)->data) ? 0 : (s)->data->bytes_used
 PMIX_CLASS_DECLARATION(pmix_ptl_send_t);
 
 /* structure for recving a message */
@@ -215,6 +222,14 @@ typedef struct {
     uid_t uid;
     gid_t gid;
     pmix_proc_type_t proc_type;
+    /* non-blocking handshake state */
+    pmix_ptl_hdr_t hdr;
+    bool hdr_recvd;
+    char *data;
+    char *rdptr;
+    size_t rdbytes;
+    pmix_event_t timer;
+    bool timer_active;
 } pmix_pending_connection_t;
 PMIX_CLASS_DECLARATION(pmix_pending_connection_t);
 
@@ -240,8 +255,9 @@ PMIX_EXPORT extern int pmix_ptl_base_output;
 
 #define PMIX_ACTIVATE_POST_MSG(ms)                                      \
     do {                                                                \
-        pmix_event_assign(&((ms)->ev), pmix_globals.evbase, -1,         \
-                          EV_WRITE, pmix_ptl_base_process_msg, (ms));   \
+        pmix_event_assign_shift(&((ms)->ev), pmix_globals.evbase,       \
+                                EV_WRITE, pmix_ptl_base_process_msg,    \
+                                (ms));                                  \
         PMIX_POST_OBJECT(ms);                                           \
         pmix_event_active(&((ms)->ev), EV_WRITE, 1);                    \
     } while (0)
@@ -281,6 +297,7 @@ PMIX_EXPORT extern int pmix_ptl_base_output;
             /* always start with the header */                                              \
             snd->sdptr = (char*)&snd->hdr;                                                  \
             snd->sdbytes = sizeof(pmix_ptl_hdr_t);                                          \
+            PMIX_PTL_SEND_QUEUED(p, snd);                                                   \
             /* if there is no message on-deck, put this one there */                        \
             if (NULL == (p)->send_msg) {                                                    \
                 (p)->send_msg = snd;                                                        \
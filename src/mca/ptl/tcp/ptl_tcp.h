@@ -56,6 +56,11 @@ typedef struct {
     bool remote_connections;
     int handshake_wait_time;
     int handshake_max_retries;
+    int handshake_timeout;
+    /* pool of threads used to validate the credentials
+     * of connecting clients */
+    int validation_threads;
+    pmix_event_base_t **validation_evbases;
 } pmix_ptl_tcp_component_t;
 
 extern pmix_ptl_tcp_component_t mca_ptl_tcp_component;
@@ -54,6 +54,7 @@
 #include <ctype.h>
 
 #include "src/include/pmix_socket_errno.h"
+#include "src/runtime/pmix_progress_threads.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/fd.h"
@@ -124,11 +125,20 @@ static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env);
     .report_uri = NULL,
     .remote_connections = false,
     .handshake_wait_time = 4,
-    .handshake_max_retries = 2
+    .handshake_max_retries = 2,
+    .handshake_timeout = 10,
+    .validation_threads = 2,
+    .validation_evbases = NULL
 };
 
 static char **split_and_resolve(char **orig_str, char *name);
 static void connection_handler(int sd, short args, void *cbdata);
+static void handshake_recv(int sd, short flags, void *cbdata);
+static void handshake_timeout(int sd, short flags, void *cbdata);
+static void process_handshake(pmix_pending_connection_t *pnd);
+static void validate_client(pmix_pending_connection_t *pnd);
+static void start_validation_threads(void);
+static void stop_validation_threads(void);
 static void cnct_cbfunc(pmix_status_t status,
                         pmix_proc_t *proc, void *cbdata);
 
@@ -239,6 +249,20 @@ static int component_register(void)
                                           PMIX_MCA_BASE_VAR_SCOPE_READONLY,
                                           &mca_ptl_tcp_component.handshake_max_retries);
 
+    (void)pmix_mca_base_component_var_register(component, "handshake_timeout",
+                                          "Number of seconds a server waits for a new connection to deliver its handshake request before closing it (0 => wait forever)",
+                                          PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PMIX_INFO_LVL_4,
+                                          PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &mca_ptl_tcp_component.handshake_timeout);
+
+    (void)pmix_mca_base_component_var_register(component, "validation_threads",
+                                          "Number of threads used by a server to validate the credentials of connecting clients (0 => validate on the progress thread)",
+                                          PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                          PMIX_INFO_LVL_5,
+                                          PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                          &mca_ptl_tcp_component.validation_threads);
+
     return PMIX_SUCCESS;
 }
 
@@ -285,6 +309,7 @@ static pmix_status_t component_open(void)
 
 pmix_status_t component_close(void)
 {
+    stop_validation_threads();
     if (NULL != mca_ptl_tcp_component.system_filename) {
         unlink(mca_ptl_tcp_component.system_filename);
         free(mca_ptl_tcp_component.system_filename);
@@ -598,8 +623,8 @@ static pmix_status_t setup_listener(pmix_info_t info[], size_t ninfo,
         goto sockerror;
     }
 
-    /* setup listen backlog to maximum allowed by kernel */
-    if (listen(lt->socket, SOMAXCONN) < 0) {
+    /* setup listen backlog - the kernel caps it at its own maximum */
+    if (listen(lt->socket, pmix_ptl_globals.listen_backlog) < 0) {
         printf("%s:%d listen() failed\n", __FILE__, __LINE__);
         CLOSE_THE_SOCKET(lt->socket);
         goto sockerror;
@@ -842,6 +867,9 @@ static pmix_status_t setup_listener(pmix_info_t info[], size_t ninfo,
     *need_listener = true;
     pmix_list_append(&pmix_ptl_globals.listeners, &lt->super);
 
+    /* and somewhere to validate the connections it harvests */
+    start_validation_threads();
+
     return PMIX_SUCCESS;
 
   sockerror:
@@ -954,24 +982,7 @@ static char **split_and_resolve(char **orig_str, char *name)
 static void connection_handler(int sd, short args, void *cbdata)
 {
     pmix_pending_connection_t *pnd = (pmix_pending_connection_t*)cbdata;
-    pmix_ptl_hdr_t hdr;
-    pmix_peer_t *peer;
-    pmix_rank_t rank=0;
-    pmix_status_t rc;
-    char *msg, *mg, *version;
-    char *sec, *bfrops, *gds;
-    pmix_bfrop_buffer_type_t bftype;
-    char *nspace;
-    uint32_t len, u32;
-    size_t cnt, msglen, n;
-    pmix_namespace_t *nptr, *tmp;
-    bool found;
-    pmix_rank_info_t *info;
-    pmix_proc_t proc;
-    pmix_info_t ginfo;
-    pmix_proc_type_t proc_type;
-    pmix_byte_object_t cred;
-    pmix_buffer_t buf;
+    struct timeval tv = {0, 0};
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(pnd);
@@ -980,44 +991,130 @@ static void connection_handler(int sd, short args, void *cbdata)
                         "ptl:tcp:connection_handler: new connection: %d",
                         pnd->sd);
 
-    /* ensure the socket is in blocking mode */
-    pmix_ptl_base_set_blocking(pnd->sd);
-
-    /* ensure all is zero'd */
-    memset(&hdr, 0, sizeof(pmix_ptl_hdr_t));
+    /* the handshake is progressed by the event library so that
+     * a slow peer cannot hold up the handshakes of the others -
+     * ensure the socket is in non-blocking mode */
+    pmix_ptl_base_set_nonblocking(pnd->sd);
 
-    /* get the header */
-    if (PMIX_SUCCESS != (rc = pmix_ptl_base_recv_blocking(pnd->sd, (char*)&hdr, sizeof(pmix_ptl_hdr_t)))) {
-        CLOSE_THE_SOCKET(pnd->sd);
-        PMIX_RELEASE(pnd);
-        return;
+    /* start with the header */
+    pnd->hdr_recvd = false;
+    pnd->rdptr = (char*)&pnd->hdr;
+    pnd->rdbytes = sizeof(pmix_ptl_hdr_t);
+    pmix_event_assign(&pnd->ev, pmix_globals.evbase, pnd->sd,
+                      EV_READ|EV_PERSIST, handshake_recv, pnd);
+    pmix_event_add(&pnd->ev, NULL);
+
+    /* don't let a stalled or half-open peer hold the socket forever */
+    if (0 < mca_ptl_tcp_component.handshake_timeout) {
+        tv.tv_sec = mca_ptl_tcp_component.handshake_timeout;
+        pmix_event_evtimer_set(pmix_globals.evbase, &pnd->timer,
+                               handshake_timeout, pnd);
+        pmix_event_evtimer_add(&pnd->timer, &tv);
+        pnd->timer_active = true;
     }
+}
 
-    /* get the id, authentication and version payload (and possibly
-     * security credential) - to guard against potential attacks,
-     * we'll set an arbitrary limit per a define */
-    if (PMIX_MAX_CRED_SIZE < hdr.nbytes) {
-        CLOSE_THE_SOCKET(pnd->sd);
-        PMIX_RELEASE(pnd);
-        return;
+static void handshake_timeout(int sd, short flags, void *cbdata)
+{
+    pmix_pending_connection_t *pnd = (pmix_pending_connection_t*)cbdata;
+
+    /* acquire the object */
+    PMIX_ACQUIRE_OBJECT(pnd);
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:tcp:connection_handler handshake on socket %d timed out",
+                        pnd->sd);
+    pnd->timer_active = false;
+    pmix_event_del(&pnd->ev);
+    CLOSE_THE_SOCKET(pnd->sd);
+    PMIX_RELEASE(pnd);
+}
+
+static void handshake_recv(int sd, short flags, void *cbdata)
+{
+    pmix_pending_connection_t *pnd = (pmix_pending_connection_t*)cbdata;
+    pmix_status_t rc;
+
+    /* acquire the object */
+    PMIX_ACQUIRE_OBJECT(pnd);
+
+    if (!pnd->hdr_recvd) {
+        rc = pmix_ptl_base_read_bytes(pnd->sd, &pnd->rdptr, &pnd->rdbytes);
+        if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
+            /* wait for the rest of it to arrive */
+            return;
+        }
+        if (PMIX_SUCCESS != rc) {
+            goto abort;
+        }
+        pnd->hdr_recvd = true;
+        /* get the id, authentication and version payload (and possibly
+         * security credential) - to guard against potential attacks,
+         * we'll set an arbitrary limit per a define */
+        if (PMIX_MAX_CRED_SIZE < pnd->hdr.nbytes) {
+            goto abort;
+        }
+        if (NULL == (pnd->data = (char*)malloc(pnd->hdr.nbytes))) {
+            goto abort;
+        }
+        pnd->rdptr = pnd->data;
+        pnd->rdbytes = pnd->hdr.nbytes;
     }
-    if (NULL == (msg = (char*)malloc(hdr.nbytes))) {
-        CLOSE_THE_SOCKET(pnd->sd);
-        PMIX_RELEASE(pnd);
+
+    rc = pmix_ptl_base_read_bytes(pnd->sd, &pnd->rdptr, &pnd->rdbytes);
+    if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
         return;
     }
-    if (PMIX_SUCCESS != (rc = pmix_ptl_base_recv_blocking(pnd->sd, msg, hdr.nbytes))) {
+    if (PMIX_SUCCESS != rc) {
         /* unable to complete the recv */
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:tcp:connection_handler unable to complete recv of connect-ack with client ON SOCKET %d",
                             pnd->sd);
-        free(msg);
-        CLOSE_THE_SOCKET(pnd->sd);
-        PMIX_RELEASE(pnd);
-        return;
+        goto abort;
     }
 
-    cnt = hdr.nbytes;
+    /* we have the complete request */
+    pmix_event_del(&pnd->ev);
+    if (pnd->timer_active) {
+        pmix_event_del(&pnd->timer);
+        pnd->timer_active = false;
+    }
+    process_handshake(pnd);
+    return;
+
+  abort:
+    pmix_event_del(&pnd->ev);
+    if (pnd->timer_active) {
+        pmix_event_del(&pnd->timer);
+        pnd->timer_active = false;
+    }
+    CLOSE_THE_SOCKET(pnd->sd);
+    PMIX_RELEASE(pnd);
+}
+
+static void process_handshake(pmix_pending_connection_t *pnd)
+{
+    pmix_peer_t *peer;
+    pmix_rank_t rank=0;
+    pmix_status_t rc;
+    char *msg, *mg, *version;
+    char *sec, *bfrops, *gds;
+    pmix_bfrop_buffer_type_t bftype;
+    char *nspace;
+    uint32_t len, u32;
+    size_t cnt, msglen, n;
+    pmix_namespace_t *nptr, *tmp;
+    bool found;
+    pmix_rank_info_t *info;
+    pmix_proc_t proc;
+    pmix_info_t ginfo;
+    pmix_proc_type_t proc_type;
+    pmix_buffer_t buf;
+
+    /* take the payload */
+    msg = pnd->data;
+    pnd->data = NULL;
+    cnt = pnd->hdr.nbytes;
     mg = msg;
     /* extract the name of the sec module they used */
     PMIX_STRNLEN(msglen, mg, cnt);
@@ -1541,23 +1638,12 @@ static void connection_handler(int sd, short args, void *cbdata)
     nptr->epilog.gid = info->gid;
     info->proc_cnt++; /* increase number of processes on this rank */
     peer->sd = pnd->sd;
-    if (0 > (peer->index = pmix_pointer_array_add(&pmix_server_globals.clients, peer))) {
-        free(msg);
-        info->proc_cnt--;
-        PMIX_RELEASE(peer);
-        /* probably cannot send an error reply if we are out of memory */
-        CLOSE_THE_SOCKET(pnd->sd);
-        PMIX_RELEASE(pnd);
-        return;
-    }
-    info->peerid = peer->index;
 
     /* set the sec module to match this peer */
     peer->nptr->compat.psec = pmix_psec_base_assign_module(sec);
     if (NULL == peer->nptr->compat.psec) {
         free(msg);
         info->proc_cnt--;
-        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
         PMIX_RELEASE(peer);
         /* send an error reply to the client */
         goto error;
@@ -1568,7 +1654,6 @@ static void connection_handler(int sd, short args, void *cbdata)
     if (NULL == peer->nptr->compat.bfrops) {
         free(msg);
         info->proc_cnt--;
-        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
         PMIX_RELEASE(peer);
         /* send an error reply to the client */
         goto error;
@@ -1587,7 +1672,6 @@ static void connection_handler(int sd, short args, void *cbdata)
     if (NULL == peer->nptr->compat.gds) {
         free(msg);
         info->proc_cnt--;
-        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
         PMIX_RELEASE(peer);
         /* send an error reply to the client */
         goto error;
@@ -1607,15 +1691,49 @@ static void connection_handler(int sd, short args, void *cbdata)
     /* the choice of PTL module is obviously us */
     peer->nptr->compat.ptl = &pmix_ptl_tcp_module;
 
-    /* validate the connection */
-    cred.bytes = pnd->cred;
-    cred.size = pnd->len;
-    PMIX_PSEC_VALIDATE_CONNECTION(rc, peer, NULL, 0, NULL, NULL, &cred);
+    /* validate the connection - the peer isn't made visible
+     * to the rest of the server until this completes */
+    pnd->peer = peer;
+    validate_client(pnd);
+    return;
+
+  error:
+    /* send an error reply to the client */
+    u32 = htonl(rc);
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(int)))) {
+        PMIX_ERROR_LOG(rc);
+        CLOSE_THE_SOCKET(pnd->sd);
+    }
+    PMIX_RELEASE(pnd);
+    return;
+}
+
+/* complete the connection of a client once its
+ * credential has been checked */
+static void client_validated(int sd, short args, void *cbdata)
+{
+    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
+    pmix_pending_connection_t *pnd;
+    pmix_peer_t *peer;
+    pmix_rank_info_t *info;
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    uint32_t u32;
+
+    /* acquire the object */
+    PMIX_ACQUIRE_OBJECT(cd);
+    pnd = (pmix_pending_connection_t*)cd->cbdata;
+    rc = cd->status;
+    PMIX_RELEASE(cd);
+    /* take the peer back from the pending connection */
+    peer = (pmix_peer_t*)pnd->peer;
+    pnd->peer = NULL;
+    info = peer->info;
+
     if (PMIX_SUCCESS != rc) {
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "validation of client connection failed");
         info->proc_cnt--;
-        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
         PMIX_RELEASE(peer);
         /* send an error reply to the client */
         goto error;
@@ -1624,6 +1742,16 @@ static void connection_handler(int sd, short args, void *cbdata)
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "client connection validated");
 
+    if (0 > (peer->index = pmix_pointer_array_add(&pmix_server_globals.clients, peer))) {
+        info->proc_cnt--;
+        PMIX_RELEASE(peer);
+        /* probably cannot send an error reply if we are out of memory */
+        CLOSE_THE_SOCKET(pnd->sd);
+        PMIX_RELEASE(pnd);
+        return;
+    }
+    info->peerid = peer->index;
+
     /* tell the client all is good */
     u32 = htonl(PMIX_SUCCESS);
     if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
@@ -1635,35 +1763,33 @@ static void connection_handler(int sd, short args, void *cbdata)
         PMIX_RELEASE(pnd);
         return;
     }
-      /* send the client's array index */
+    /* send the client's array index */
     u32 = htonl(peer->index);
-      if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
-          PMIX_ERROR_LOG(rc);
-          info->proc_cnt--;
-          pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
-          PMIX_RELEASE(peer);
-          goto error;
-      }
-
-      pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                          "connect-ack from client completed");
-
-      /* let the host server know that this client has connected */
-      if (NULL != pmix_host_server.client_connected) {
-          pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
-          proc.rank = peer->info->pname.rank;
-          rc = pmix_host_server.client_connected(&proc, peer->info->server_object,
-                                                 NULL, NULL);
-          if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
-              PMIX_ERROR_LOG(rc);
-              info->proc_cnt--;
-              pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
-              PMIX_RELEASE(peer);
-              goto error;
-          }
-      }
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
+        PMIX_ERROR_LOG(rc);
+        info->proc_cnt--;
+        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
+        PMIX_RELEASE(peer);
+        goto error;
+    }
 
-    pmix_ptl_base_set_nonblocking(pnd->sd);
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "connect-ack from client completed");
+
+    /* let the host server know that this client has connected */
+    if (NULL != pmix_host_server.client_connected) {
+        pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
+        proc.rank = peer->info->pname.rank;
+        rc = pmix_host_server.client_connected(&proc, peer->info->server_object,
+                                               NULL, NULL);
+        if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
+            PMIX_ERROR_LOG(rc);
+            info->proc_cnt--;
+            pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
+            PMIX_RELEASE(peer);
+            goto error;
+        }
+    }
 
     /* start the events for this client */
     pmix_event_assign(&peer->recv_event, pmix_globals.evbase, pnd->sd,
@@ -1686,7 +1812,120 @@ static void connection_handler(int sd, short args, void *cbdata)
         CLOSE_THE_SOCKET(pnd->sd);
     }
     PMIX_RELEASE(pnd);
-    return;
+}
+
+/* check a client credential - executes in one of
+ * the validation threads, if we have them */
+static void validate_cred(int sd, short args, void *cbdata)
+{
+    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
+    pmix_pending_connection_t *pnd;
+    pmix_peer_t *peer;
+    pmix_byte_object_t cred;
+    pmix_status_t rc;
+
+    /* acquire the object */
+    PMIX_ACQUIRE_OBJECT(cd);
+    pnd = (pmix_pending_connection_t*)cd->cbdata;
+    peer = (pmix_peer_t*)pnd->peer;
+
+    /* nothing else is watching the socket while we do this, and
+     * the security module may need to run a blocking exchange */
+    pmix_ptl_base_set_blocking(pnd->sd);
+    cred.bytes = pnd->cred;
+    cred.size = pnd->len;
+    PMIX_PSEC_VALIDATE_CONNECTION(rc, peer, NULL, 0, NULL, NULL, &cred);
+    cd->status = rc;
+    pmix_ptl_base_set_nonblocking(pnd->sd);
+
+    /* return to the progress thread to complete the connection */
+    PMIX_THREADSHIFT(cd, client_validated);
+}
+
+static void validate_client(pmix_pending_connection_t *pnd)
+{
+    static int next = 0;
+    pmix_setup_caddy_t *cd;
+    pmix_event_base_t *evbase;
+
+    cd = PMIX_NEW(pmix_setup_caddy_t);
+    if (NULL == cd) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        ((pmix_peer_t*)pnd->peer)->info->proc_cnt--;
+        PMIX_RELEASE(pnd->peer);
+        CLOSE_THE_SOCKET(pnd->sd);
+        PMIX_RELEASE(pnd);
+        return;
+    }
+    cd->cbdata = pnd;
+
+    /* credential checks can be expensive (e.g., they may require a
+     * round-trip to an external daemon), so spread them across the
+     * validation threads and let the progress thread get on with
+     * the other handshakes */
+    if (NULL != mca_ptl_tcp_component.validation_evbases) {
+        evbase = mca_ptl_tcp_component.validation_evbases[next];
+        next = (next + 1) % mca_ptl_tcp_component.validation_threads;
+    } else {
+        evbase = pmix_globals.evbase;
+    }
+    pmix_event_assign(&cd->ev, evbase, -1, EV_WRITE, validate_cred, cd);
+    PMIX_POST_OBJECT(cd);
+    pmix_event_active(&cd->ev, EV_WRITE, 1);
+}
+
+static void start_validation_threads(void)
+{
+    char *name;
+    int n;
+
+    if (0 >= mca_ptl_tcp_component.validation_threads ||
+        NULL != mca_ptl_tcp_component.validation_evbases) {
+        return;
+    }
+    mca_ptl_tcp_component.validation_evbases =
+        (pmix_event_base_t**)calloc(mca_ptl_tcp_component.validation_threads,
+                                    sizeof(pmix_event_base_t*));
+    if (NULL == mca_ptl_tcp_component.validation_evbases) {
+        return;
+    }
+    for (n=0; n < mca_ptl_tcp_component.validation_threads; n++) {
+        if (0 > asprintf(&name, "PTL-TCP-VALIDATE-%d", n)) {
+            break;
+        }
+        mca_ptl_tcp_component.validation_evbases[n] = pmix_progress_thread_init(name);
+        free(name);
+        if (NULL == mca_ptl_tcp_component.validation_evbases[n]) {
+            break;
+        }
+    }
+    if (n < mca_ptl_tcp_component.validation_threads) {
+        /* use whatever we managed to start, if anything */
+        mca_ptl_tcp_component.validation_threads = n;
+        if (0 == n) {
+            free(mca_ptl_tcp_component.validation_evbases);
+            mca_ptl_tcp_component.validation_evbases = NULL;
+        }
+    }
+}
+
+static void stop_validation_threads(void)
+{
+    char *name;
+    int n;
+
+    if (NULL == mca_ptl_tcp_component.validation_evbases) {
+        return;
+    }
+    for (n=0; n < mca_ptl_tcp_component.validation_threads; n++) {
+        if (0 > asprintf(&name, "PTL-TCP-VALIDATE-%d", n)) {
+            continue;
+        }
+        pmix_progress_thread_finalize(name);
+        free(name);
+    }
+    free(mca_ptl_tcp_component.validation_evbases);
+    mca_ptl_tcp_component.validation_evbases = NULL;
 }
 
 /* process the callback with tool connection info */
@@ -1853,7 +2092,9 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     req->channels = PMIX_FWD_STDOUT_CHANNEL | PMIX_FWD_STDERR_CHANNEL | PMIX_FWD_STDDIAG_CHANNEL;
     pmix_list_append(&pmix_globals.iof_requests, &req->super);
 
-    /* validate the connection */
+    /* validate the connection - the security module
+     * may need to run a blocking exchange */
+    pmix_ptl_base_set_blocking(pnd->sd);
     cred.bytes = pnd->cred;
     cred.size = pnd->len;
     PMIX_PSEC_VALIDATE_CONNECTION(rc, peer, NULL, 0, NULL, NULL, &cred);
@@ -13,7 +13,7 @@
  * Copyright (c) 2011-2014 Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2011-2013 Los Alamos National Security, LLC.  All rights
  *                         reserved.
- * Copyright (c) 2013-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2013-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
  * $COPYRIGHT$
@@ -586,6 +586,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                 /* setup to send the data */
                 if (NULL == msg->data) {
                     /* this was a zero-byte msg - nothing more to do */
+                    PMIX_PTL_SEND_DONE(peer, msg);
                     PMIX_RELEASE(msg);
                     peer->send_msg = NULL;
                     goto next;
@@ -615,6 +616,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                 // report the error
                 pmix_event_del(&peer->send_event);
                 peer->send_ev_active = false;
+                PMIX_PTL_SEND_DONE(peer, msg);
                 PMIX_RELEASE(msg);
                 peer->send_msg = NULL;
                 pmix_ptl_base_lost_connection(peer, rc);
@@ -632,6 +634,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                 // message is complete
                 pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                     "usock:send_handler BODY SENT");
+                PMIX_PTL_SEND_DONE(peer, msg);
                 PMIX_RELEASE(msg);
                 peer->send_msg = NULL;
             } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
@@ -649,6 +652,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                             peer->sd);
                 pmix_event_del(&peer->send_event);
                 peer->send_ev_active = false;
+                PMIX_PTL_SEND_DONE(peer, msg);
                 PMIX_RELEASE(msg);
                 peer->send_msg = NULL;
                 pmix_ptl_base_lost_connection(peer, rc);
@@ -877,6 +881,7 @@ void pmix_usock_send_recv(int fd, short args, void *cbdata)
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_usock_hdr_t);
 
+    PMIX_PTL_SEND_QUEUED(ms->peer, snd);
     /* if there is no message on-deck, put this one there */
     if (NULL == ms->peer->send_msg) {
         ms->peer->send_msg = snd;
@@ -928,6 +933,7 @@ static void pmix_usock_send(int sd, short args, void *cbdata)
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_ptl_hdr_t);
 
+    PMIX_PTL_SEND_QUEUED(queue->peer, snd);
     /* if there is no message on-deck, put this one there */
     if (NULL == (queue->peer)->send_msg) {
         (queue->peer)->send_msg = snd;
@@ -282,8 +282,8 @@ static pmix_status_t setup_listener(pmix_info_t info[], size_t ninfo,
         goto sockerror;
     }
 
-    /* setup listen backlog to maximum allowed by kernel */
-    if (listen(lt->socket, SOMAXCONN) < 0) {
+    /* setup listen backlog - the kernel caps it at its own maximum */
+    if (listen(lt->socket, pmix_ptl_globals.listen_backlog) < 0) {
         printf("%s:%d listen() failed\n", __FILE__, __LINE__);
         CLOSE_THE_SOCKET(lt->socket);
         goto sockerror;
@@ -361,6 +361,9 @@ static void connection_handler(int sd, short args, void *cbdata)
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "USOCK CONNECTION FROM PEER ON SOCKET %d", pnd->sd);
 
+    /* ensure the socket is in blocking mode */
+    pmix_ptl_base_set_blocking(pnd->sd);
+
     /* ensure all is zero'd */
     memset(&hdr, 0, sizeof(pmix_usock_hdr_t));
 
@@ -29,6 +29,7 @@
 #include "src/class/pmix_object.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/common/pmix_attributes.h"
+#include "src/common/pmix_query.h"
 #include "src/util/output.h"
 #include "src/util/keyval_parse.h"
 #include "src/util/show_help.h"
@@ -68,6 +69,9 @@ void pmix_rte_finalize(void)
     /* release the attribute support trackers */
     pmix_release_registered_attrs();
 
+    /* release any cached query answers */
+    pmix_query_cache_finalize();
+
     /* close plog */
     (void)pmix_mca_base_framework_close(&pmix_plog_base_framework);
 
@@ -101,6 +105,12 @@ void pmix_rte_finalize(void)
     (void)pmix_mca_base_framework_close(&pmix_pif_base_framework);
     (void)pmix_mca_base_close();
 
+    /* frameworks opened on demand must be opened again
+     * should we be re-initialized */
+    for (i=0; i < PMIX_RTE_NUM_LAZY; i++) {
+        pmix_rte_lazy_ready[i] = false;
+    }
+
     /* finalize the show_help system */
     pmix_show_help_finalize();
 
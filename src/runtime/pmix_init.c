@@ -87,6 +87,50 @@ PMIX_EXPORT pmix_globals_t pmix_globals = {
 };
 
 
+/* frameworks a client opens on first use - in the
+ * order of pmix_rte_lazy_t */
+static struct {
+    pmix_mca_base_framework_t *framework;
+    pmix_status_t (*select)(void);
+} lazy_frameworks[PMIX_RTE_NUM_LAZY] = {
+    {&pmix_pcompress_base_framework, pmix_compress_base_select},
+    {&pmix_pif_base_framework, NULL},
+    {&pmix_preg_base_framework, pmix_preg_base_select},
+    {&pmix_plog_base_framework, pmix_plog_base_select}
+};
+PMIX_EXPORT volatile bool pmix_rte_lazy_ready[PMIX_RTE_NUM_LAZY] = {false};
+static pmix_mutex_t lazy_lock = PMIX_MUTEX_STATIC_INIT;
+
+pmix_status_t pmix_rte_open_lazy(pmix_rte_lazy_t fw)
+{
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (PMIX_RTE_NUM_LAZY <= fw) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_mutex_lock(&lazy_lock);
+    /* someone may have beaten us to it */
+    if (pmix_rte_lazy_ready[fw]) {
+        pmix_mutex_unlock(&lazy_lock);
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_mca_base_framework_open(lazy_frameworks[fw].framework, 0))) {
+        pmix_mutex_unlock(&lazy_lock);
+        return rc;
+    }
+    if (NULL != lazy_frameworks[fw].select &&
+        PMIX_SUCCESS != (rc = lazy_frameworks[fw].select())) {
+        (void)pmix_mca_base_framework_close(lazy_frameworks[fw].framework);
+        pmix_mutex_unlock(&lazy_lock);
+        return rc;
+    }
+    PMIX_POST_OBJECT(&pmix_rte_lazy_ready[fw]);
+    pmix_rte_lazy_ready[fw] = true;
+    pmix_mutex_unlock(&lazy_lock);
+    return PMIX_SUCCESS;
+}
+
 static void _notification_eviction_cbfunc(struct pmix_hotel_t *hotel,
                                           int room_num,
                                           void *occupant)
@@ -291,16 +335,6 @@ int pmix_rte_init(pmix_proc_type_t type,
         goto return_error;
     }
 
-    /* open and select the compress framework */
-    if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_pcompress_base_framework, 0)) ) {
-        error = "pmix_pcompress_base_open";
-        goto return_error;
-    }
-    if (PMIX_SUCCESS != (ret = pmix_compress_base_select()) ) {
-        error = "pmix_pcompress_base_select";
-        goto return_error;
-    }
-
     /* open the ptl and select the active plugins */
     if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_ptl_base_framework, 0)) ) {
         error = "pmix_ptl_base_open";
@@ -336,30 +370,14 @@ int pmix_rte_init(pmix_proc_type_t type,
         goto return_error;
     }
 
-    /* initialize pif framework */
-    if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_pif_base_framework, 0))) {
-        error = "pmix_pif_base_open";
-        return ret;
-    }
-
-    /* open the preg and select the active plugins */
-    if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_preg_base_framework, 0)) ) {
-        error = "pmix_preg_base_open";
-        goto return_error;
-    }
-    if (PMIX_SUCCESS != (ret = pmix_preg_base_select()) ) {
-        error = "pmix_preg_base_select";
-        goto return_error;
-    }
-
-    /* open the plog and select the active plugins */
-    if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_plog_base_framework, 0)) ) {
-        error = "pmix_plog_base_open";
-        goto return_error;
-    }
-    if (PMIX_SUCCESS != (ret = pmix_plog_base_select()) ) {
-        error = "pmix_plog_base_select";
-        goto return_error;
+    /* clients only open the remaining frameworks if they need them */
+    if (type & (PMIX_PROC_SERVER | PMIX_PROC_TOOL)) {
+        for (n=0; n < PMIX_RTE_NUM_LAZY; n++) {
+            if (PMIX_SUCCESS != (ret = pmix_rte_open_lazy(n))) {
+                error = lazy_frameworks[n].framework->framework_name;
+                goto return_error;
+            }
+        }
     }
 
     /* initialize the attribute support system */
@@ -34,6 +34,8 @@
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/runtime/pmix_rte.h"
 #include "src/util/timings.h"
+#include "src/util/opstats.h"
+#include "src/runtime/pmix_progress_threads.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
 
@@ -257,6 +259,22 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_globals.event_eviction_time);
 
+    /* how long to cache the answers to queries */
+    pmix_globals.query_cache_ttl = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "query", "cache_ttl",
+                                       "Number of seconds to cache the answers to queries that don't give "
+                                       "a PMIX_QUERY_CACHE_TTL of their own (0 only caches those that do)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_globals.query_cache_ttl);
+
+    pmix_globals.query_cache_size = 256;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "query", "cache_size",
+                                       "Maximum number of query answers to cache (0 disables the cache)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_globals.query_cache_size);
+
     /* max number of IOF messages to cache */
     pmix_server_globals.max_iof_cache = 1024 * 1024;
     (void) pmix_mca_base_var_register ("pmix", "pmix", "max", "iof_cache",
@@ -265,6 +283,62 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_server_globals.max_iof_cache);
 
+    /* how often to check the progress thread for lag */
+    pmix_server_globals.lag_interval = 1000;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "lag_interval",
+                                       "Interval in msec at which a server checks how late its progress thread runs timers "
+                                       "- only done when PMIx runs that thread itself (0 disables)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.lag_interval);
+
+    /* threads for preparing nspace registrations */
+    pmix_server_globals.reg_threads = 2;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "register_threads",
+                                       "Number of threads a server uses to parse the job info of nspace registrations "
+                                       "off its progress thread (0 parses it on the progress thread)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.reg_threads);
+
+    /* datastore for published data */
+    pmix_server_globals.pubsub_local = false;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "local_datastore",
+                                       "Keep data published by local clients in the server itself when its range "
+                                       "does not extend beyond the node, or when the host has no datastore of its own",
+                                       PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.pubsub_local);
+
+    /* progress thread stall watchdog */
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "progress", "stall_threshold",
+                                       "Report progress thread callbacks and stalls longer than this many msec (0 disables)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_progress_stall_threshold);
+
+    /* per-operation latency and message size histograms */
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "opstats", "enable",
+                                       "Record per-operation latency and message size histograms (default: true)",
+                                       PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_opstats_enabled);
+
+    /* recycling of the objects of the hot classes */
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "obj_cache", "size",
+                                       "Number of released objects of each cached class kept for reuse "
+                                       "by all threads (0 disables recycling)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_obj_cache_size);
+
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "obj_cache", "thread_size",
+                                       "Number of released objects of each cached class every thread keeps "
+                                       "to itself (0 disables the per-thread lists)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_obj_cache_thread_size);
+
     return PMIX_SUCCESS;
 }
 
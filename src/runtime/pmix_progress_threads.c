@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2017-2019 Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
@@ -16,16 +16,24 @@
 #include <unistd.h>
 #endif
 #include <string.h>
+#include <time.h>
 #include <pthread.h>
+#ifdef HAVE_DLFCN_H
+#include <dlfcn.h>
+#endif
 #include PMIX_EVENT_HEADER
 
 #include "src/class/pmix_list.h"
 #include "src/threads/threads.h"
 #include "src/util/error.h"
 #include "src/util/fd.h"
+#include "src/util/opstats.h"
+#include "src/util/output.h"
 
 #include "src/runtime/pmix_progress_threads.h"
 
+int pmix_progress_stall_threshold = 0;
+
 
 /* create a tracking object for progress threads */
 typedef struct {
@@ -46,6 +54,20 @@ typedef struct {
 
     bool engine_constructed;
     pmix_thread_t engine;
+
+    /* loop lag - a timer that should fire every tick_interval msec,
+     * how late it fired, and the thread-shifted callback currently
+     * being executed for the stall watchdog */
+    pmix_event_t tick;
+    bool tick_active;
+    int lag_interval;
+    volatile int tick_interval;
+    volatile uint64_t tick_expected;
+    volatile uint64_t lag_last;
+    volatile uint64_t lag_max;
+    volatile uint64_t dispatch_start;
+    volatile event_callback_fn dispatch_fn;
+    volatile bool stalled;
 #if PMIX_HAVE_LIBEV
     ev_async async;
     pthread_mutex_t mutex;
@@ -61,6 +83,15 @@ static void tracker_constructor(pmix_progress_tracker_t *p)
     p->ev_base = NULL;
     p->ev_active = false;
     p->engine_constructed = false;
+    p->tick_active = false;
+    p->lag_interval = 0;
+    p->tick_interval = 0;
+    p->tick_expected = 0;
+    p->lag_last = 0;
+    p->lag_max = 0;
+    p->dispatch_start = 0;
+    p->dispatch_fn = NULL;
+    p->stalled = false;
 #if PMIX_HAVE_LIBEV
     pthread_mutex_init(&p->mutex, NULL);
     PMIX_CONSTRUCT(&p->list, pmix_list_t);
@@ -70,6 +101,9 @@ static void tracker_constructor(pmix_progress_tracker_t *p)
 static void tracker_destructor(pmix_progress_tracker_t *p)
 {
     pmix_event_del(&p->block);
+    if (p->tick_active) {
+        pmix_event_del(&p->tick);
+    }
 
     if (NULL != p->name) {
         free(p->name);
@@ -91,6 +125,8 @@ static PMIX_CLASS_INSTANCE(pmix_progress_tracker_t,
                           tracker_constructor,
                           tracker_destructor);
 
+static pmix_progress_tracker_t* pmix_progress_tracker_get_by_base(pmix_event_base_t *);
+
 #if PMIX_HAVE_LIBEV
 
 typedef enum {
@@ -112,8 +148,6 @@ static PMIX_CLASS_INSTANCE(pmix_event_caddy_t,
                            pmix_list_item_t,
                            NULL, NULL);
 
-static pmix_progress_tracker_t* pmix_progress_tracker_get_by_base(struct event_base *);
-
 static void pmix_libev_ev_async_cb (EV_P_ ev_async *w, int revents)
 {
     pmix_progress_tracker_t *trk = pmix_progress_tracker_get_by_base((struct event_base *)EV_A);
@@ -218,6 +252,352 @@ static void dummy_timeout_cb(int fd, short args, void *cbdata)
     pmix_event_add(&trk->block, &long_timeout);
 }
 
+/*
+ * Loop lag and stall watchdog. A progress thread runs a timer every
+ * tick_interval msec and records how late it actually fires - the
+ * interval is the one asked for by pmix_progress_thread_lag_watch()
+ * or half the stall threshold, whichever is shorter. When
+ * pmix_progress_stall_threshold is set, a separate watchdog thread
+ * reports any progress thread whose timer is overdue by more than
+ * the threshold, naming the thread-shifted callback it is executing.
+ * Thread-shifted callbacks that run for longer than the threshold are
+ * recorded against their function.
+ */
+static pmix_mutex_t watch_lock = PMIX_MUTEX_STATIC_INIT;
+static pmix_thread_t watchdog;
+static volatile bool watchdog_active = false;
+#if PMIX_HAVE_THREAD_LOCAL
+/* the tracker of the progress thread we are running on */
+static pmix_thread_local pmix_progress_tracker_t *mytrk = NULL;
+#endif
+
+/* the real callback of a wrapped thread-shifted event. They come
+ * from a pool that is only released once the last progress thread
+ * is gone, so events deleted before they fire don't leak them */
+typedef struct pmix_shift_watch_t {
+    struct pmix_shift_watch_t *next;
+    event_callback_fn cbfn;
+    void *cbdata;
+    pmix_event_base_t *evbase;
+} pmix_shift_watch_t;
+
+#define PMIX_SHIFT_WATCH_CHUNK  64
+
+typedef struct pmix_shift_watch_chunk_t {
+    struct pmix_shift_watch_chunk_t *next;
+    pmix_shift_watch_t watch[PMIX_SHIFT_WATCH_CHUNK];
+} pmix_shift_watch_chunk_t;
+
+static pmix_mutex_t pool_lock = PMIX_MUTEX_STATIC_INIT;
+static pmix_shift_watch_t *pool_free = NULL;
+static pmix_shift_watch_chunk_t *pool_chunks = NULL;
+
+#define PMIX_PROGRESS_MAX_SLOW  32
+
+typedef struct {
+    event_callback_fn fn;
+    uint64_t count;
+    uint64_t max;
+} pmix_slow_cb_t;
+
+static pmix_slow_cb_t slow_cbs[PMIX_PROGRESS_MAX_SLOW];
+
+static inline uint64_t stall_ns(void)
+{
+    return (uint64_t)pmix_progress_stall_threshold * 1000000ULL;
+}
+
+static inline int stall_tick_msec(void)
+{
+    return (1 < pmix_progress_stall_threshold) ? pmix_progress_stall_threshold / 2 : 1;
+}
+
+/* name a callback by its symbol where the loader can find an exact
+ * match, otherwise by its offset within the containing object */
+static void fn_name(event_callback_fn fn, char *name, size_t len)
+{
+    union {
+        event_callback_fn fn;
+        void *ptr;
+    } addr;
+
+    addr.fn = fn;
+#if defined(HAVE_DLFCN_H) && defined(HAVE_DLADDR)
+    Dl_info dli;
+
+    if (0 != dladdr(addr.ptr, &dli)) {
+        if (NULL != dli.dli_sname && addr.ptr == dli.dli_saddr) {
+            snprintf(name, len, "%s", dli.dli_sname);
+            return;
+        }
+        if (NULL != dli.dli_fname) {
+            snprintf(name, len, "%s+0x%lx", dli.dli_fname,
+                     (unsigned long)((char*)addr.ptr - (char*)dli.dli_fbase));
+            return;
+        }
+    }
+#endif
+    snprintf(name, len, "%p", addr.ptr);
+}
+
+static void record_slow(pmix_progress_tracker_t *trk, event_callback_fn fn, uint64_t elapsed)
+{
+    char name[256];
+    bool report = false;
+    int n, least = 0;
+
+    pmix_mutex_lock(&watch_lock);
+    for (n=0; n < PMIX_PROGRESS_MAX_SLOW; n++) {
+        if (NULL == slow_cbs[n].fn) {
+            slow_cbs[n].fn = fn;
+        }
+        if (fn == slow_cbs[n].fn) {
+            break;
+        }
+        if (slow_cbs[n].max < slow_cbs[least].max) {
+            least = n;
+        }
+    }
+    if (PMIX_PROGRESS_MAX_SLOW == n) {
+        /* the table is full - this callback takes the place of the
+         * one with the mildest worst case, but only if it was worse
+         * than that, so a stream of new callbacks can't flood the log */
+        if (elapsed > slow_cbs[least].max) {
+            slow_cbs[least].fn = fn;
+            slow_cbs[least].count = 0;
+            slow_cbs[least].max = 0;
+            n = least;
+        }
+    }
+    if (n < PMIX_PROGRESS_MAX_SLOW) {
+        ++slow_cbs[n].count;
+        /* only report each new worst case */
+        report = (elapsed > slow_cbs[n].max);
+        if (report) {
+            slow_cbs[n].max = elapsed;
+        }
+    }
+    pmix_mutex_unlock(&watch_lock);
+    if (report) {
+        fn_name(fn, name, sizeof(name));
+        pmix_output(0, "pmix:progress: %s: callback %s ran for %.3f msec",
+                    trk->name, name, (double)elapsed / 1.0e6);
+    }
+}
+
+static pmix_shift_watch_t* watch_get(void)
+{
+    pmix_shift_watch_chunk_t *chunk;
+    pmix_shift_watch_t *w;
+    int n;
+
+    pmix_mutex_lock(&pool_lock);
+    if (NULL == pool_free) {
+        chunk = (pmix_shift_watch_chunk_t*)malloc(sizeof(pmix_shift_watch_chunk_t));
+        if (NULL == chunk) {
+            pmix_mutex_unlock(&pool_lock);
+            return NULL;
+        }
+        chunk->next = pool_chunks;
+        pool_chunks = chunk;
+        for (n=0; n < PMIX_SHIFT_WATCH_CHUNK; n++) {
+            chunk->watch[n].next = pool_free;
+            pool_free = &chunk->watch[n];
+        }
+    }
+    w = pool_free;
+    pool_free = w->next;
+    pmix_mutex_unlock(&pool_lock);
+    return w;
+}
+
+static void watch_put(pmix_shift_watch_t *w)
+{
+    pmix_mutex_lock(&pool_lock);
+    w->next = pool_free;
+    pool_free = w;
+    pmix_mutex_unlock(&pool_lock);
+}
+
+/* called once the last progress thread is gone, so no
+ * wrapped event can still be pending */
+static void watch_pool_release(void)
+{
+    pmix_shift_watch_chunk_t *chunk;
+
+    pmix_mutex_lock(&pool_lock);
+    while (NULL != (chunk = pool_chunks)) {
+        pool_chunks = chunk->next;
+        free(chunk);
+    }
+    pool_free = NULL;
+    pmix_mutex_unlock(&pool_lock);
+}
+
+static void shift_watch_cb(int sd, short args, void *cbdata)
+{
+    pmix_shift_watch_t *w = (pmix_shift_watch_t*)cbdata;
+    event_callback_fn cbfn = w->cbfn;
+    void *cbd = w->cbdata;
+    pmix_progress_tracker_t *trk;
+    uint64_t start, elapsed;
+
+#if PMIX_HAVE_THREAD_LOCAL
+    trk = mytrk;
+#else
+    pmix_mutex_lock(&watch_lock);
+    trk = pmix_progress_tracker_get_by_base(w->evbase);
+    pmix_mutex_unlock(&watch_lock);
+#endif
+    watch_put(w);
+    if (NULL == trk) {
+        cbfn(sd, args, cbd);
+        return;
+    }
+    start = pmix_opstats_now();
+    trk->dispatch_fn = cbfn;
+    trk->dispatch_start = start;
+    cbfn(sd, args, cbd);
+    trk->dispatch_start = 0;
+    elapsed = pmix_opstats_now() - start;
+    if (elapsed >= stall_ns()) {
+        record_slow(trk, cbfn, elapsed);
+    }
+}
+
+int pmix_event_assign_shift(struct event *ev, pmix_event_base_t *evbase,
+                            short arg, event_callback_fn cbfn, void *cbd)
+{
+    pmix_shift_watch_t *w;
+
+    if (0 < pmix_progress_stall_threshold && NULL != (w = watch_get())) {
+        w->cbfn = cbfn;
+        w->cbdata = cbd;
+        w->evbase = evbase;
+        return pmix_event_assign(ev, evbase, -1, arg, shift_watch_cb, w);
+    }
+    return pmix_event_assign(ev, evbase, -1, arg, cbfn, cbd);
+}
+
+static void start_tick(pmix_progress_tracker_t *trk, uint64_t now)
+{
+    struct timeval tv;
+    int msec = trk->tick_interval;
+
+    tv.tv_sec = msec / 1000;
+    tv.tv_usec = (msec % 1000) * 1000;
+    trk->tick_expected = now + (uint64_t)msec * 1000000ULL;
+    pmix_event_evtimer_add(&trk->tick, &tv);
+}
+
+static void tick_cb(int fd, short args, void *cbdata)
+{
+    pmix_progress_tracker_t *trk = (pmix_progress_tracker_t*)cbdata;
+    uint64_t now, lag;
+
+    now = pmix_opstats_now();
+    lag = (now > trk->tick_expected) ? now - trk->tick_expected : 0;
+    trk->lag_last = lag;
+    if (lag > trk->lag_max) {
+        trk->lag_max = lag;
+    }
+    if (trk->stalled) {
+        trk->stalled = false;
+        pmix_output(0, "pmix:progress: %s: resumed after %.3f msec",
+                    trk->name, (double)lag / 1.0e6);
+    }
+    if (0 < trk->tick_interval) {
+        start_tick(trk, now);
+    }
+}
+
+/* the tick runs at the shorter of the requested lag interval
+ * and half the stall threshold */
+static int tick_interval(pmix_progress_tracker_t *trk)
+{
+    int msec = trk->lag_interval;
+
+    if (0 < pmix_progress_stall_threshold &&
+        (0 >= msec || stall_tick_msec() < msec)) {
+        msec = stall_tick_msec();
+    }
+    return msec;
+}
+
+static void* watchdog_engine(pmix_object_t *obj)
+{
+    pmix_progress_tracker_t *trk;
+    struct timespec ts;
+    uint64_t now, start;
+    event_callback_fn fn;
+    char name[256];
+
+    ts.tv_sec = stall_tick_msec() / 1000;
+    ts.tv_nsec = (long)(stall_tick_msec() % 1000) * 1000000L;
+    while (watchdog_active) {
+        nanosleep(&ts, NULL);
+        now = pmix_opstats_now();
+        pmix_mutex_lock(&watch_lock);
+        PMIX_LIST_FOREACH(trk, &tracking, pmix_progress_tracker_t) {
+            if (!trk->ev_active || !trk->tick_active || trk->stalled ||
+                now < trk->tick_expected + stall_ns()) {
+                continue;
+            }
+            trk->stalled = true;
+            fn = trk->dispatch_fn;
+            start = trk->dispatch_start;
+            if (0 != start && NULL != fn && start < now) {
+                fn_name(fn, name, sizeof(name));
+                pmix_output(0, "pmix:progress: %s: stalled for %.3f msec - callback %s "
+                            "has been running for %.3f msec", trk->name,
+                            (double)(now - trk->tick_expected) / 1.0e6, name,
+                            (double)(now - start) / 1.0e6);
+            } else {
+                pmix_output(0, "pmix:progress: %s: stalled for %.3f msec outside "
+                            "any thread-shifted callback", trk->name,
+                            (double)(now - trk->tick_expected) / 1.0e6);
+            }
+        }
+        pmix_mutex_unlock(&watch_lock);
+    }
+
+    return PMIX_THREAD_CANCELLED;
+}
+
+static void start_watchdog(void)
+{
+    int rc;
+
+    if (watchdog_active || 0 >= pmix_progress_stall_threshold) {
+        return;
+    }
+    PMIX_CONSTRUCT(&watchdog, pmix_thread_t);
+    watchdog.t_run = watchdog_engine;
+    watchdog.t_arg = NULL;
+    watchdog_active = true;
+    if (PMIX_SUCCESS != (rc = pmix_thread_start(&watchdog))) {
+        PMIX_ERROR_LOG(rc);
+        watchdog_active = false;
+        PMIX_DESTRUCT(&watchdog);
+    }
+}
+
+static void stop_watchdog(void)
+{
+    if (0 < pmix_list_get_size(&tracking)) {
+        return;
+    }
+    /* the event bases are gone, and the records of any
+     * wrapped events they still held with them */
+    watch_pool_release();
+    if (!watchdog_active) {
+        return;
+    }
+    watchdog_active = false;
+    pmix_thread_join(&watchdog, NULL);
+    PMIX_DESTRUCT(&watchdog);
+}
+
 /*
  * Main for the progress thread
  */
@@ -226,6 +606,9 @@ static void* progress_engine(pmix_object_t *obj)
     pmix_thread_t *t = (pmix_thread_t*)obj;
     pmix_progress_tracker_t *trk = (pmix_progress_tracker_t*)t->t_arg;
 
+#if PMIX_HAVE_THREAD_LOCAL
+    mytrk = trk;
+#endif
     while (trk->ev_active) {
         pmix_event_loop(trk->ev_base, PMIX_EVLOOP_ONCE);
     }
@@ -249,6 +632,18 @@ static int start_progress_engine(pmix_progress_tracker_t *trk)
     assert(!trk->ev_active);
     trk->ev_active = true;
 
+    /* the engine isn't running, so the timer can be safely
+     * (re)started from here */
+    trk->tick_interval = tick_interval(trk);
+    if (0 < trk->tick_interval) {
+        if (!trk->tick_active) {
+            pmix_event_evtimer_set(trk->ev_base, &trk->tick, tick_cb, trk);
+            trk->tick_active = true;
+        }
+        trk->stalled = false;
+        start_tick(trk, pmix_opstats_now());
+    }
+
     /* fork off a thread to progress it */
     trk->engine.t_run = progress_engine;
     trk->engine.t_arg = trk;
@@ -323,7 +718,10 @@ pmix_event_base_t *pmix_progress_thread_init(const char *name)
         PMIX_RELEASE(trk);
         return NULL;
     }
+    pmix_mutex_lock(&watch_lock);
     pmix_list_append(&tracking, &trk->super);
+    pmix_mutex_unlock(&watch_lock);
+    start_watchdog();
 
     return trk->ev_base;
 }
@@ -356,7 +754,10 @@ int pmix_progress_thread_stop(const char *name)
             if (trk->ev_active) {
                 stop_progress_engine(trk);
             }
+            pmix_mutex_lock(&watch_lock);
             pmix_list_remove_item(&tracking, &trk->super);
+            pmix_mutex_unlock(&watch_lock);
+            stop_watchdog();
             PMIX_RELEASE(trk);
             return PMIX_SUCCESS;
         }
@@ -386,7 +787,10 @@ int pmix_progress_thread_finalize(const char *name)
                 return PMIX_SUCCESS;
             }
 
+            pmix_mutex_lock(&watch_lock);
             pmix_list_remove_item(&tracking, &trk->super);
+            pmix_mutex_unlock(&watch_lock);
+            stop_watchdog();
             PMIX_RELEASE(trk);
             return PMIX_SUCCESS;
         }
@@ -425,7 +829,6 @@ int pmix_progress_thread_pause(const char *name)
     return PMIX_ERR_NOT_FOUND;
 }
 
-#if PMIX_HAVE_LIBEV
 static pmix_progress_tracker_t* pmix_progress_tracker_get_by_base(pmix_event_base_t *base) {
     pmix_progress_tracker_t *trk;
 
@@ -438,7 +841,6 @@ static pmix_progress_tracker_t* pmix_progress_tracker_get_by_base(pmix_event_bas
     }
     return NULL;
 }
-#endif
 
 int pmix_progress_thread_resume(const char *name)
 {
@@ -466,3 +868,46 @@ int pmix_progress_thread_resume(const char *name)
 
     return PMIX_ERR_NOT_FOUND;
 }
+
+int pmix_progress_thread_lag_watch(pmix_event_base_t *evbase, int interval)
+{
+    pmix_progress_tracker_t *trk;
+    int prev;
+
+    pmix_mutex_lock(&watch_lock);
+    if (NULL == (trk = pmix_progress_tracker_get_by_base(evbase))) {
+        pmix_mutex_unlock(&watch_lock);
+        return PMIX_ERR_NOT_FOUND;
+    }
+    trk->lag_interval = (0 < interval) ? interval : 0;
+    prev = trk->tick_interval;
+    /* a running tick picks up the new interval when it next fires,
+     * and stops once the interval drops to zero */
+    trk->tick_interval = tick_interval(trk);
+    if (0 < trk->tick_interval && (!trk->tick_active || 0 >= prev)) {
+        if (!trk->tick_active) {
+            pmix_event_evtimer_set(trk->ev_base, &trk->tick, tick_cb, trk);
+            trk->tick_active = true;
+        }
+        start_tick(trk, pmix_opstats_now());
+    }
+    pmix_mutex_unlock(&watch_lock);
+    return PMIX_SUCCESS;
+}
+
+int pmix_progress_thread_lag(pmix_event_base_t *evbase, uint64_t *last, uint64_t *max)
+{
+    pmix_progress_tracker_t *trk;
+
+    pmix_mutex_lock(&watch_lock);
+    if (NULL == (trk = pmix_progress_tracker_get_by_base(evbase))) {
+        pmix_mutex_unlock(&watch_lock);
+        *last = 0;
+        *max = 0;
+        return PMIX_ERR_NOT_FOUND;
+    }
+    *last = trk->lag_last;
+    *max = trk->lag_max;
+    pmix_mutex_unlock(&watch_lock);
+    return PMIX_SUCCESS;
+}
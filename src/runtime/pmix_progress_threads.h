@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Cisco Systems, Inc.  All rights reserved.
  * $COPYRIGHT$
  *
@@ -18,6 +18,10 @@
 
 #include "src/include/types.h"
 
+/* msec a progress thread may go without servicing its timers before
+ * the watchdog reports it as stalled - zero disables the watchdog */
+PMIX_EXPORT extern int pmix_progress_stall_threshold;
+
 /**
  * Initialize a progress thread name; if a progress thread is not
  * already associated with that name, start a progress thread.
@@ -81,4 +85,23 @@ int pmix_progress_thread_pause(const char *name);
  */
 int pmix_progress_thread_resume(const char *name);
 
+/**
+ * Time how late the progress thread running the given event base
+ * services a timer that should fire every interval msec - zero
+ * stops it unless the stall watchdog needs it.
+ *
+ * Will return PMIX_ERR_NOT_FOUND if the event base is not run by
+ * one of our progress threads; PMIX_SUCCESS otherwise.
+ */
+int pmix_progress_thread_lag_watch(pmix_event_base_t *evbase, int interval);
+
+/**
+ * Return the nsec the timer of the progress thread running the given
+ * event base fired late at its last check, and the largest such lag.
+ *
+ * Will return PMIX_ERR_NOT_FOUND (and zero lags) if the event base is
+ * not run by one of our progress threads; PMIX_SUCCESS otherwise.
+ */
+int pmix_progress_thread_lag(pmix_event_base_t *evbase, uint64_t *last, uint64_t *max);
+
 #endif
@@ -11,7 +11,7 @@
  *                         All rights reserved.
  * Copyright (c) 2008      Sun Microsystems, Inc.  All rights reserved.
  * Copyright (c) 2010-2012 Cisco Systems, Inc.  All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -35,6 +35,7 @@
 
 #include "src/include/pmix_globals.h"
 #include "src/mca/ptl/ptl_types.h"
+#include "src/threads/threads.h"
 
 BEGIN_C_DECLS
 
@@ -69,6 +70,37 @@ PMIX_EXPORT pmix_status_t pmix_rte_init(pmix_proc_type_t type,
  */
 PMIX_EXPORT void pmix_rte_finalize(void);
 
+/**
+ * Frameworks that are not needed to connect or to exchange data.
+ * Servers and tools open them in pmix_rte_init, but clients only
+ * open them the first time they are used.
+ */
+typedef enum {
+    PMIX_RTE_PCOMPRESS,
+    PMIX_RTE_PIF,
+    PMIX_RTE_PREG,
+    PMIX_RTE_PLOG,
+    PMIX_RTE_NUM_LAZY
+} pmix_rte_lazy_t;
+
+PMIX_EXPORT extern volatile bool pmix_rte_lazy_ready[PMIX_RTE_NUM_LAZY];
+
+/**
+ * Open and select the given framework if that hasn't
+ * already been done. Safe to call from any thread.
+ */
+PMIX_EXPORT pmix_status_t pmix_rte_open_lazy(pmix_rte_lazy_t fw);
+
+#define PMIX_RTE_ENSURE(r, f)                               \
+    do {                                                    \
+        if (pmix_rte_lazy_ready[(f)]) {                     \
+            PMIX_ACQUIRE_OBJECT(&pmix_rte_lazy_ready[(f)]); \
+            (r) = PMIX_SUCCESS;                             \
+        } else {                                            \
+            (r) = pmix_rte_open_lazy(f);                    \
+        }                                                   \
+    } while(0)
+
 /**
  * Internal function.  Do not call.
  */
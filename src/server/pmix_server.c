@@ -51,9 +51,11 @@
 
 
 #include "src/common/pmix_attributes.h"
+#include "src/common/pmix_query.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/name_fns.h"
+#include "src/util/opstats.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/show_help.h"
@@ -66,6 +68,7 @@
 #include "src/mca/bfrops/base/base.h"
 #include "src/mca/gds/base/base.h"
 #include "src/mca/preg/preg.h"
+#include "src/mca/psec/base/base.h"
 #include "src/mca/psensor/base/base.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/hwloc/hwloc-internal.h"
@@ -85,6 +88,66 @@ static char *bfrops_mode = NULL;
 static char *gds_mode = NULL;
 static pid_t mypid;
 
+static pmix_mutex_t nspace_posted_lock = PMIX_MUTEX_STATIC_INIT;
+static void _nspace_op_flush(void);
+
+/* the job info of a large nspace registration can take a while to
+ * parse, so we do that on threads of its own and leave the progress
+ * thread free to service everyone else */
+static void start_register_threads(void)
+{
+    char *name;
+    int n;
+
+    if (0 >= pmix_server_globals.reg_threads ||
+        NULL != pmix_server_globals.reg_evbases) {
+        return;
+    }
+    pmix_server_globals.reg_evbases =
+        (pmix_event_base_t**)calloc(pmix_server_globals.reg_threads,
+                                    sizeof(pmix_event_base_t*));
+    if (NULL == pmix_server_globals.reg_evbases) {
+        return;
+    }
+    for (n=0; n < pmix_server_globals.reg_threads; n++) {
+        if (0 > asprintf(&name, "PMIX-SERVER-REGISTER-%d", n)) {
+            break;
+        }
+        pmix_server_globals.reg_evbases[n] = pmix_progress_thread_init(name);
+        free(name);
+        if (NULL == pmix_server_globals.reg_evbases[n]) {
+            break;
+        }
+    }
+    if (n < pmix_server_globals.reg_threads) {
+        /* use whatever we managed to start, if anything */
+        pmix_server_globals.reg_threads = n;
+        if (0 == n) {
+            free(pmix_server_globals.reg_evbases);
+            pmix_server_globals.reg_evbases = NULL;
+        }
+    }
+}
+
+static void stop_register_threads(void)
+{
+    char *name;
+    int n;
+
+    if (NULL == pmix_server_globals.reg_evbases) {
+        return;
+    }
+    for (n=0; n < pmix_server_globals.reg_threads; n++) {
+        if (0 > asprintf(&name, "PMIX-SERVER-REGISTER-%d", n)) {
+            continue;
+        }
+        pmix_progress_thread_finalize(name);
+        free(name);
+    }
+    free(pmix_server_globals.reg_evbases);
+    pmix_server_globals.reg_evbases = NULL;
+}
+
 // local functions for connection support
 pmix_status_t pmix_server_initialize(void)
 {
@@ -98,7 +161,17 @@ pmix_status_t pmix_server_initialize(void)
     PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.nspaces, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.groups, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.grpindex, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.grpindex, 256);
+    PMIX_CONSTRUCT(&pmix_server_globals.pubdata, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.pubdata, 256);
+    PMIX_CONSTRUCT(&pmix_server_globals.pubwaiters, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.pubwaiters, 256);
     PMIX_CONSTRUCT(&pmix_server_globals.iof, pmix_list_t);
+    pmix_server_globals.iof_bytes = 0;
+    pmix_server_globals.reg_evbases = NULL;
+    PMIX_CONSTRUCT(&pmix_server_globals.nspace_ops, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.nspace_posted, pmix_list_t);
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "pmix:server init called");
@@ -421,6 +494,15 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module,
         return PMIX_ERR_INIT;
     }
 
+    /* start watching the progress thread for lag - this can only
+     * be done for a progress thread of our own */
+    if (0 < pmix_server_globals.lag_interval) {
+        (void)pmix_progress_thread_lag_watch(pmix_globals.evbase,
+                                             pmix_server_globals.lag_interval);
+    }
+
+    start_register_threads();
+
     ++pmix_globals.init_cntr;
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
@@ -449,6 +531,10 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "pmix:server finalize called");
 
+    /* stop preparing registrations before the progress
+     * thread can no longer take their results */
+    stop_register_threads();
+
     if (!pmix_globals.external_evbase) {
         /* stop the progress thread, but leave the event base
          * still constructed. This will allow us to safely
@@ -459,6 +545,13 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
 
     pmix_ptl_base_stop_listening();
 
+    /* fail the nspace operations that didn't get to run */
+    _nspace_op_flush();
+
+    if (0 < pmix_server_globals.lag_interval) {
+        (void)pmix_progress_thread_lag_watch(pmix_globals.evbase, 0);
+    }
+
     for (i=0; i < pmix_server_globals.clients.size; i++) {
         if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, i))) {
             /* ensure that we do the specified cleanup - if this is an
@@ -481,6 +574,12 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
         pmix_execute_epilog(&ns->epilog);
     }
     PMIX_LIST_DESTRUCT(&pmix_server_globals.nspaces);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.nspace_ops);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.nspace_posted);
+    PMIX_DESTRUCT(&pmix_server_globals.grpindex);
+    pmix_server_pubsub_finalize();
+    PMIX_DESTRUCT(&pmix_server_globals.pubwaiters);
+    PMIX_DESTRUCT(&pmix_server_globals.pubdata);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.groups);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
 
@@ -538,6 +637,9 @@ static void _register_nspace(int sd, short args, void *cbdata)
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "pmix:server _register_nspace %s", cd->proc.nspace);
 
+    /* cached query answers may not reflect the new job */
+    pmix_query_cache_flush();
+
     /* see if we already have this nspace */
     nptr = NULL;
     PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
@@ -580,9 +682,16 @@ static void _register_nspace(int sd, short args, void *cbdata)
     /* store this data in our own GDS module - we will retrieve
      * it later so it can be passed down to the launched procs
      * once they connect to us and we know what GDS module they
-     * are using */
-    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr,
-                            cd->info, cd->ninfo);
+     * are using. If it was already parsed on a register thread,
+     * then all that remains is to publish it */
+    rc = PMIX_ERR_NOT_AVAILABLE;
+    if (NULL != cd->job) {
+        PMIX_GDS_PUBLISH_JOB_INFO(rc, pmix_globals.mypeer, nptr, cd->job);
+    }
+    if (PMIX_ERR_NOT_AVAILABLE == rc) {
+        PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr,
+                                cd->info, cd->ninfo);
+    }
 
   release:
     if (NULL != cd->opcbfunc) {
@@ -591,12 +700,184 @@ static void _register_nspace(int sd, short args, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+/* A registration may be parsed on a register thread, so the
+ * (de)registrations of an nspace are run one at a time, in the
+ * order they were requested - anything arriving while one is in
+ * progress waits on the nspace_ops list behind it */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_nspace_t nspace;
+    pmix_setup_caddy_t *cd;
+    event_callback_fn fn;       // runs the operation on the progress thread
+    bool prep;                  // parse the job info on a register thread first
+    pmix_event_base_t *evbase;  // base the event was last assigned to
+} pmix_nspace_op_t;
+static void nsopcon(pmix_nspace_op_t *p)
+{
+    memset(p->nspace, 0, sizeof(p->nspace));
+    p->cd = NULL;
+    p->fn = NULL;
+    p->prep = false;
+    p->evbase = NULL;
+}
+static void nsopdes(pmix_nspace_op_t *p)
+{
+    if (NULL != p->cd) {
+        PMIX_RELEASE(p->cd);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_nspace_op_t,
+                           pmix_list_item_t,
+                           nsopcon, nsopdes);
+
+static void _nspace_op_start(pmix_nspace_op_t *op);
+
+/* the operation completed - start the next one for its nspace */
+static void _nspace_op_done(pmix_nspace_op_t *op)
+{
+    pmix_nspace_op_t *nxt, *item;
+
+    pmix_list_remove_item(&pmix_server_globals.nspace_ops, &op->super);
+    nxt = NULL;
+    PMIX_LIST_FOREACH(item, &pmix_server_globals.nspace_ops, pmix_nspace_op_t) {
+        if (PMIX_CHECK_NSPACE(item->nspace, op->nspace)) {
+            nxt = item;
+            break;
+        }
+    }
+    PMIX_RELEASE(op);
+    if (NULL != nxt) {
+        _nspace_op_start(nxt);
+    }
+}
+
+static void _nspace_op_run(int sd, short args, void *cbdata)
+{
+    pmix_nspace_op_t *op = (pmix_nspace_op_t*)cbdata;
+    pmix_setup_caddy_t *cd = op->cd;
+
+    PMIX_ACQUIRE_OBJECT(op);
+
+    /* the operation releases the caddy */
+    op->cd = NULL;
+    op->fn(sd, args, cd);
+    _nspace_op_done(op);
+}
+
+/* runs on a register thread - parse the job info into private
+ * storage and then hand it to the progress thread to publish */
+static void _prep_nspace(int sd, short args, void *cbdata)
+{
+    pmix_nspace_op_t *op = (pmix_nspace_op_t*)cbdata;
+    pmix_setup_caddy_t *cd = op->cd;
+    pmix_status_t rc;
+
+    PMIX_ACQUIRE_OBJECT(op);
+
+    PMIX_GDS_PREP_JOB_INFO(rc, pmix_globals.mypeer, cd->proc.nspace,
+                           cd->info, cd->ninfo, &cd->job);
+    if (PMIX_SUCCESS != rc && NULL != cd->job) {
+        /* let the progress thread try again the usual way */
+        PMIX_RELEASE(cd->job);
+        cd->job = NULL;
+    }
+
+    op->evbase = pmix_globals.evbase;
+    PMIX_THREADSHIFT(op, _nspace_op_run);
+}
+
+static void _nspace_op_start(pmix_nspace_op_t *op)
+{
+    static int next = 0;
+
+    if (op->prep && NULL != pmix_server_globals.reg_evbases) {
+        op->evbase = pmix_server_globals.reg_evbases[next];
+        pmix_event_assign(&op->ev, op->evbase, -1, EV_WRITE, _prep_nspace, op);
+        next = (next + 1) % pmix_server_globals.reg_threads;
+        PMIX_POST_OBJECT(op);
+        pmix_event_active(&op->ev, EV_WRITE, 1);
+        return;
+    }
+    _nspace_op_run(-1, EV_WRITE, op);
+}
+
+static void _nspace_op_post(int sd, short args, void *cbdata)
+{
+    pmix_nspace_op_t *op = (pmix_nspace_op_t*)cbdata, *item;
+
+    PMIX_ACQUIRE_OBJECT(op);
+
+    pmix_mutex_lock(&nspace_posted_lock);
+    pmix_list_remove_item(&pmix_server_globals.nspace_posted, &op->super);
+    pmix_mutex_unlock(&nspace_posted_lock);
+
+    PMIX_LIST_FOREACH(item, &pmix_server_globals.nspace_ops, pmix_nspace_op_t) {
+        if (PMIX_CHECK_NSPACE(item->nspace, op->nspace)) {
+            /* wait for the ones ahead of us */
+            pmix_list_append(&pmix_server_globals.nspace_ops, &op->super);
+            return;
+        }
+    }
+    pmix_list_append(&pmix_server_globals.nspace_ops, &op->super);
+    _nspace_op_start(op);
+}
+
+/* queue an operation on an nspace - we have to push this into
+ * our event library to avoid potential threading issues */
+static void nspace_op(pmix_setup_caddy_t *cd, event_callback_fn fn, bool prep)
+{
+    pmix_nspace_op_t *op;
+
+    op = PMIX_NEW(pmix_nspace_op_t);
+    PMIX_LOAD_NSPACE(op->nspace, cd->proc.nspace);
+    op->cd = cd;
+    op->fn = fn;
+    op->prep = prep;
+    op->evbase = pmix_globals.evbase;
+    /* track it until the progress thread takes it up, so
+     * finalize can find it */
+    pmix_mutex_lock(&nspace_posted_lock);
+    pmix_list_append(&pmix_server_globals.nspace_posted, &op->super);
+    pmix_mutex_unlock(&nspace_posted_lock);
+    PMIX_THREADSHIFT(op, _nspace_op_post);
+}
+
+/* called at finalize once the register threads are gone and the
+ * progress thread is stopped - tell the host about the operations
+ * that will now never complete */
+static void _nspace_op_flush(void)
+{
+    pmix_nspace_op_t *op;
+    pmix_setup_caddy_t *cd;
+
+    pmix_mutex_lock(&nspace_posted_lock);
+    pmix_list_join(&pmix_server_globals.nspace_ops,
+                   pmix_list_get_end(&pmix_server_globals.nspace_ops),
+                   &pmix_server_globals.nspace_posted);
+    pmix_mutex_unlock(&nspace_posted_lock);
+    while (NULL != (op = (pmix_nspace_op_t*)pmix_list_remove_first(&pmix_server_globals.nspace_ops))) {
+        /* the event of an operation sent to a register thread went
+         * with the base of that thread */
+        if (pmix_globals.evbase == op->evbase) {
+            pmix_event_del(&op->ev);
+        }
+        cd = op->cd;
+        if (NULL != cd && NULL != cd->opcbfunc) {
+            cd->opcbfunc(PMIX_ERR_INIT, cd->cbdata);
+        }
+        PMIX_RELEASE(op);
+    }
+}
+
 /* setup the data for a job */
 PMIX_EXPORT pmix_status_t PMIx_server_register_nspace(const pmix_nspace_t nspace, int nlocalprocs,
                                                       pmix_info_t info[], size_t ninfo,
                                                       pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
     pmix_setup_caddy_t *cd;
+    bool prep;
+    size_t n;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
     if (pmix_globals.init_cntr <= 0) {
@@ -616,9 +897,16 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_nspace(const pmix_nspace_t nspace
         cd->info = info;
     }
 
-    /* we have to push this into our event library to avoid
-     * potential threading issues */
-    PMIX_THREADSHIFT(cd, _register_nspace);
+    /* if we have register threads, then parse the info on one of
+     * them - no point in that if we aren't going to store the data */
+    prep = (NULL != pmix_server_globals.reg_evbases &&
+            NULL != pmix_globals.mypeer->nptr->compat.gds->prep_job_info);
+    for (n=0; prep && n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_REGISTER_NODATA)) {
+            prep = false;
+        }
+    }
+    nspace_op(cd, _register_nspace, prep);
     return PMIX_SUCCESS;
 }
 
@@ -730,12 +1018,21 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
                         "pmix:server _deregister_nspace %s",
                         cd->proc.nspace);
 
+    /* cached query answers may still include the job */
+    pmix_query_cache_flush();
+
+    /* drop the data it published that was to go with it */
+    pmix_server_pubsub_purge_nspace(cd->proc.nspace);
+
     /* release any job-level network resources */
     pmix_pnet.deregister_nspace(cd->proc.nspace);
 
     /* let our local storage clean up */
     PMIX_GDS_DEL_NSPACE(rc, cd->proc.nspace);
 
+    /* procs from this nspace can no longer connect */
+    pmix_psec_base_cache_invalidate(cd->proc.nspace);
+
     /* remove any event registrations, IOF registrations, and
      * cached notifications targeting procs from this nspace */
     pmix_server_purge_events(NULL, &cd->proc);
@@ -784,9 +1081,8 @@ PMIX_EXPORT void PMIx_server_deregister_nspace(const pmix_nspace_t nspace,
     cd->opcbfunc = cbfunc;
     cd->cbdata = cbdata;
 
-    /* we have to push this into our event library to avoid
-     * potential threading issues */
-    PMIX_THREADSHIFT(cd, _deregister_nspace);
+    /* wait for any registration of the nspace still in progress */
+    nspace_op(cd, _deregister_nspace, false);
 }
 
 void pmix_server_execute_collective(int sd, short args, void *cbdata)
@@ -1769,6 +2065,7 @@ static void _iofdeliver(int sd, short args, void *cbdata)
         if (pmix_server_globals.max_iof_cache == pmix_list_get_size(&pmix_server_globals.iof)) {
             /* remove the oldest cached message */
             iof = (pmix_iof_cache_t*)pmix_list_remove_first(&pmix_server_globals.iof);
+            PMIX_SERVER_IOF_UNCACHED(iof);
             PMIX_RELEASE(iof);
         }
         /* add this output to our cache so it is cached until someone
@@ -1779,6 +2076,7 @@ static void _iofdeliver(int sd, short args, void *cbdata)
         iof->bo = cd->bo;
         cd->bo = NULL;  // protect the data
         pmix_list_append(&pmix_server_globals.iof, &iof->super);
+        PMIX_SERVER_IOF_CACHED(iof);
     }
 
 
@@ -2487,20 +2785,89 @@ static void get_cbfunc(pmix_status_t status, const char *data, size_t ndata, voi
     PMIX_RELEASE(cd);
 }
 
+/* return the packed job-level info of an nspace for the given peer,
+ * building it only if no peer using the same modules has needed it */
+static pmix_status_t job_payload(pmix_list_t *cache, pmix_peer_t *peer,
+                                 char *nspace, pmix_buffer_t **payload)
+{
+    pmix_job_payload_t *jp;
+    pmix_proc_t proc;
+    pmix_cb_t cb;
+    pmix_kval_t *kptr;
+    pmix_status_t rc;
+
+    PMIX_LIST_FOREACH(jp, cache, pmix_job_payload_t) {
+        if (jp->bfrops == peer->nptr->compat.bfrops &&
+            jp->type == peer->nptr->compat.type &&
+            jp->gds == peer->nptr->compat.gds &&
+            0 == strcmp(jp->nspace, nspace)) {
+            *payload = &jp->payload;
+            return PMIX_SUCCESS;
+        }
+    }
+
+    jp = PMIX_NEW(pmix_job_payload_t);
+    if (NULL == jp) {
+        return PMIX_ERR_NOMEM;
+    }
+    jp->nspace = strdup(nspace);
+    jp->bfrops = peer->nptr->compat.bfrops;
+    jp->type = peer->nptr->compat.type;
+    jp->gds = peer->nptr->compat.gds;
+
+    /* add the job-level info */
+    proc.rank = PMIX_RANK_WILDCARD;
+    pmix_strncpy(proc.nspace, nspace, PMIX_MAX_NSLEN);
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    /* this is for a local client, so give the gds the
+     * option of returning a complete copy of the data,
+     * or returning a pointer to local storage */
+    cb.proc = &proc;
+    cb.scope = PMIX_SCOPE_UNDEF;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, peer, &cb);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        PMIX_RELEASE(jp);
+        return rc;
+    }
+    /* pack the nspace name */
+    PMIX_BFROPS_PACK(rc, peer, &jp->payload, &nspace, 1, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        PMIX_RELEASE(jp);
+        return rc;
+    }
+    PMIX_LIST_FOREACH(kptr, &cb.kvs, pmix_kval_t) {
+        PMIX_BFROPS_PACK(rc, peer, &jp->payload, kptr, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&cb);
+            PMIX_RELEASE(jp);
+            return rc;
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+
+    pmix_list_append(cache, &jp->super);
+    *payload = &jp->payload;
+    return PMIX_SUCCESS;
+}
+
 static void _cnct(int sd, short args, void *cbdata)
 {
     pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
     pmix_server_trkr_t *tracker = scd->tracker;
-    pmix_buffer_t *reply, pbkt;
+    pmix_buffer_t *reply, *pbkt;
     pmix_byte_object_t bo;
     pmix_status_t rc;
     int i;
     pmix_server_caddy_t *cd;
     char **nspaces=NULL;
     bool found;
-    pmix_proc_t proc;
-    pmix_cb_t cb;
-    pmix_kval_t *kptr;
+    pmix_list_t payloads;
 
     PMIX_ACQUIRE_OBJECT(scd);
 
@@ -2536,6 +2903,7 @@ static void _cnct(int sd, short args, void *cbdata)
     }
 
     /* loop across all local procs in the tracker, sending them the reply */
+    PMIX_CONSTRUCT(&payloads, pmix_list_t);
     PMIX_LIST_FOREACH(cd, &tracker->local_cbs, pmix_server_caddy_t) {
         /* setup the reply, starting with the returned status */
         reply = PMIX_NEW(pmix_buffer_t);
@@ -2561,70 +2929,27 @@ static void _cnct(int sd, short args, void *cbdata)
                     continue;
                 }
 
-                /* this is a local request, so give the gds the option
-                 * of returning a copy of the data, or a pointer to
-                 * local storage */
-                /* add the job-level info, if necessary */
-                proc.rank = PMIX_RANK_WILDCARD;
-                pmix_strncpy(proc.nspace, nspaces[i], PMIX_MAX_NSLEN);
-                PMIX_CONSTRUCT(&cb, pmix_cb_t);
-                /* this is for a local client, so give the gds the
-                 * option of returning a complete copy of the data,
-                 * or returning a pointer to local storage */
-                cb.proc = &proc;
-                cb.scope = PMIX_SCOPE_UNDEF;
-                cb.copy = false;
-                PMIX_GDS_FETCH_KV(rc, cd->peer, &cb);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(reply);
-                    PMIX_DESTRUCT(&cb);
-                    goto cleanup;
-                }
-                PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
-                /* pack the nspace name */
-                PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &nspaces[i], 1, PMIX_STRING);
+                /* add the job-level info - this is the same for every
+                 * peer using the same modules, so it is only built once */
+                rc = job_payload(&payloads, cd->peer, nspaces[i], &pbkt);
                 if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(reply);
-                    PMIX_DESTRUCT(&pbkt);
-                    PMIX_DESTRUCT(&cb);
                     goto cleanup;
                 }
-                PMIX_LIST_FOREACH(kptr, &cb.kvs, pmix_kval_t) {
-                    PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, kptr, 1, PMIX_KVAL);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(reply);
-                        PMIX_DESTRUCT(&pbkt);
-                        PMIX_DESTRUCT(&cb);
-                        goto cleanup;
-                    }
-                }
-                PMIX_DESTRUCT(&cb);
 
                 if (PMIX_PROC_IS_V1(cd->peer) || PMIX_PROC_IS_V20(cd->peer)) {
-                    PMIX_BFROPS_PACK(rc, cd->peer, reply, &pbkt, 1, PMIX_BUFFER);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(reply);
-                        PMIX_DESTRUCT(&pbkt);
-                        PMIX_DESTRUCT(&cb);
-                        goto cleanup;
-                    }
+                    PMIX_BFROPS_PACK(rc, cd->peer, reply, pbkt, 1, PMIX_BUFFER);
                 } else {
-                    PMIX_UNLOAD_BUFFER(&pbkt, bo.bytes, bo.size);
+                    /* the pack copies the bytes, so just point at them */
+                    bo.bytes = pbkt->base_ptr;
+                    bo.size = pbkt->bytes_used;
                     PMIX_BFROPS_PACK(rc, cd->peer, reply, &bo, 1, PMIX_BYTE_OBJECT);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(reply);
-                        PMIX_DESTRUCT(&pbkt);
-                        PMIX_DESTRUCT(&cb);
-                        goto cleanup;
-                    }
                 }
-
-                PMIX_DESTRUCT(&pbkt);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_RELEASE(reply);
+                    goto cleanup;
+                }
             }
         }
         pmix_output_verbose(2, pmix_server_globals.base_output,
@@ -2637,6 +2962,7 @@ static void _cnct(int sd, short args, void *cbdata)
     }
 
   cleanup:
+    PMIX_LIST_DESTRUCT(&payloads);
     if (NULL != nspaces) {
       pmix_argv_free(nspaces);
     }
@@ -2897,6 +3223,9 @@ static void query_cbfunc(pmix_status_t status,
     }
 
     /* cache the data for any future requests */
+    if (PMIX_SUCCESS == status && NULL != qcd->cache_key) {
+        pmix_query_cache_store(qcd->cache_key, qcd->cache_ttl, info, ninfo);
+    }
 
   complete:
     // send reply
@@ -2905,8 +3234,8 @@ static void query_cbfunc(pmix_status_t status,
         PMIX_RELEASE(reply);
     }
 
-    // cleanup
-    if (NULL != qcd->queries) {
+    // cleanup - queries held in an arena go with the caddy
+    if (NULL != qcd->queries && NULL == qcd->arena) {
         PMIX_QUERY_FREE(qcd->queries, qcd->nqueries);
     }
     if (NULL != qcd->info) {
@@ -3236,7 +3565,7 @@ static void iof_cbfunc(pmix_status_t status,
  * error reply buffer will be returned so that the caller can be notified,
  * thereby preventing the process from hanging. */
 static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
-                                       pmix_buffer_t *buf)
+                                       pmix_buffer_t *buf, pmix_cmd_t *command)
 {
     pmix_status_t rc=PMIX_ERR_NOT_SUPPORTED;
     int32_t cnt;
@@ -3252,6 +3581,7 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
         PMIX_ERROR_LOG(rc);
         return rc;
     }
+    *command = cmd;
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "recvd pmix cmd %s from %s:%u",
                         pmix_command_string(cmd), peer->info->pname.nspace, peer->info->pname.rank);
@@ -3319,6 +3649,14 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
         return rc;
     }
 
+    if (PMIX_GETNB_MULTI_CMD == cmd) {
+        PMIX_GDS_CADDY(cd, peer, tag);
+        if (PMIX_SUCCESS != (rc = pmix_server_get_multi(cd, buf))) {
+            PMIX_RELEASE(cd);
+        }
+        return rc;
+    }
+
     if (PMIX_FINALIZE_CMD == cmd) {
         pmix_output_verbose(2, pmix_server_globals.base_output,
                             "recvd FINALIZE");
@@ -3544,13 +3882,21 @@ void pmix_server_message_handler(struct pmix_peer_t *pr,
     pmix_peer_t *peer = (pmix_peer_t*)pr;
     pmix_buffer_t *reply;
     pmix_status_t rc, ret;
+    pmix_cmd_t cmd = UINT8_MAX;
+    uint64_t ts;
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "SWITCHYARD for %s:%u:%d",
                         peer->info->pname.nspace,
                         peer->info->pname.rank, peer->sd);
 
-    ret = server_switchyard(peer, hdr->tag, buf);
+    /* this times our handling of the request - operations that are
+     * passed up to the host complete later and are not included */
+    PMIX_OPSTATS_START(ts);
+    ret = server_switchyard(peer, hdr->tag, buf, &cmd);
+    if (cmd < PMIX_OPSTATS_MAX_CMDS) {
+        PMIX_OPSTATS_STOP(cmd, ts);
+    }
     /* send the return, if there was an error returned */
     if (PMIX_SUCCESS != ret) {
         reply = PMIX_NEW(pmix_buffer_t);
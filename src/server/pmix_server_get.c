@@ -479,6 +479,246 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     return rc;
 }
 
+/* tracks a request for the data of several procs at once - each
+ * proc goes through the regular get path on its own, and the
+ * answers are returned together once all of them are in */
+typedef struct {
+    pmix_object_t super;
+    pmix_server_caddy_t *cd;
+    size_t nprocs;
+    pmix_status_t *status;
+    pmix_byte_object_t *data;
+    size_t npending;
+} pmix_get_multi_trk_t;
+static void gmtcon(pmix_get_multi_trk_t *p)
+{
+    p->cd = NULL;
+    p->nprocs = 0;
+    p->status = NULL;
+    p->data = NULL;
+    p->npending = 0;
+}
+static void gmtdes(pmix_get_multi_trk_t *p)
+{
+    size_t n;
+
+    if (NULL != p->cd) {
+        PMIX_RELEASE(p->cd);
+    }
+    if (NULL != p->status) {
+        free(p->status);
+    }
+    if (NULL != p->data) {
+        for (n=0; n < p->nprocs; n++) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&p->data[n]);
+        }
+        free(p->data);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_multi_trk_t,
+                           pmix_object_t,
+                           gmtcon, gmtdes);
+
+/* the caddy handed to the get path for one of the procs */
+typedef struct {
+    pmix_server_caddy_t super;
+    pmix_get_multi_trk_t *trk;
+    size_t idx;
+} pmix_get_multi_caddy_t;
+static void gmccon(pmix_get_multi_caddy_t *p)
+{
+    p->trk = NULL;
+    p->idx = 0;
+}
+static void gmcdes(pmix_get_multi_caddy_t *p)
+{
+    if (NULL != p->trk) {
+        PMIX_RELEASE(p->trk);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_multi_caddy_t,
+                           pmix_server_caddy_t,
+                           gmccon, gmcdes);
+
+static void get_multi_done(pmix_get_multi_trk_t *trk)
+{
+    pmix_buffer_t *reply;
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+    size_t n;
+
+    if (0 < --trk->npending) {
+        return;
+    }
+
+    /* the overall status, then the status and blob of each proc
+     * in the order they were requested */
+    reply = PMIX_NEW(pmix_buffer_t);
+    if (NULL == reply) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        return;
+    }
+    PMIX_BFROPS_PACK(rc, trk->cd->peer, reply, &ret, 1, PMIX_STATUS);
+    for (n=0; PMIX_SUCCESS == rc && n < trk->nprocs; n++) {
+        PMIX_BFROPS_PACK(rc, trk->cd->peer, reply, &trk->status[n], 1, PMIX_STATUS);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, trk->cd->peer, reply, &trk->data[n], 1, PMIX_BYTE_OBJECT);
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(reply);
+        return;
+    }
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "server:get_multi reply for %lu procs being sent to %s:%u",
+                        (unsigned long)trk->nprocs,
+                        trk->cd->peer->info->pname.nspace, trk->cd->peer->info->pname.rank);
+    PMIX_SERVER_QUEUE_REPLY(rc, trk->cd->peer, trk->cd->hdr.tag, reply);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(reply);
+    }
+}
+
+static void get_multi_cbfunc(pmix_status_t status, const char *data, size_t ndata,
+                             void *cbdata, pmix_release_cbfunc_t relfn, void *relcbd)
+{
+    pmix_get_multi_caddy_t *mcd = (pmix_get_multi_caddy_t*)cbdata;
+    pmix_get_multi_trk_t *trk = mcd->trk;
+
+    trk->status[mcd->idx] = status;
+    if (PMIX_SUCCESS == status && NULL != data && 0 < ndata) {
+        trk->data[mcd->idx].bytes = (char*)malloc(ndata);
+        if (NULL == trk->data[mcd->idx].bytes) {
+            trk->status[mcd->idx] = PMIX_ERR_NOMEM;
+        } else {
+            memcpy(trk->data[mcd->idx].bytes, data, ndata);
+            trk->data[mcd->idx].size = ndata;
+        }
+    }
+    if (NULL != relfn) {
+        relfn(relcbd);
+    }
+    get_multi_done(trk);
+    PMIX_RELEASE(mcd);
+}
+
+pmix_status_t pmix_server_get_multi(pmix_server_caddy_t *cd,
+                                    pmix_buffer_t *buf)
+{
+    pmix_get_multi_trk_t *trk;
+    pmix_get_multi_caddy_t *mcd;
+    pmix_proc_t *procs = NULL;
+    pmix_info_t *info = NULL;
+    size_t nprocs, ninfo = 0, n;
+    pmix_buffer_t pkt;
+    pmix_status_t rc;
+    int32_t cnt;
+    char *nsp;
+
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "recvd GET MULTI");
+
+    /* retrieve the procs */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &nprocs, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 == nprocs || INT32_MAX < nprocs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    PMIX_PROC_CREATE(procs, nprocs);
+    if (NULL == procs) {
+        return PMIX_ERR_NOMEM;
+    }
+    cnt = nprocs;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, procs, &cnt, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_PROC_FREE(procs, nprocs);
+        return rc;
+    }
+    /* retrieve any provided info structs - they apply to every proc */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &ninfo, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_PROC_FREE(procs, nprocs);
+        return rc;
+    }
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(info, ninfo);
+        if (NULL == info) {
+            PMIX_PROC_FREE(procs, nprocs);
+            return PMIX_ERR_NOMEM;
+        }
+        cnt = ninfo;
+        PMIX_BFROPS_UNPACK(rc, cd->peer, buf, info, &cnt, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_PROC_FREE(procs, nprocs);
+            PMIX_INFO_FREE(info, ninfo);
+            return rc;
+        }
+    }
+
+    trk = PMIX_NEW(pmix_get_multi_trk_t);
+    trk->status = (pmix_status_t*)calloc(nprocs, sizeof(pmix_status_t));
+    trk->data = (pmix_byte_object_t*)calloc(nprocs, sizeof(pmix_byte_object_t));
+    if (NULL == trk->status || NULL == trk->data) {
+        PMIX_RELEASE(trk);
+        PMIX_PROC_FREE(procs, nprocs);
+        PMIX_INFO_FREE(info, ninfo);
+        return PMIX_ERR_NOMEM;
+    }
+    trk->nprocs = nprocs;
+    /* the tracker now owns the request and answers it */
+    trk->cd = cd;
+
+    /* hold a count of our own so the reply can't go out while
+     * we are still issuing the requests */
+    trk->npending = 1;
+    for (n=0; n < nprocs; n++) {
+        mcd = PMIX_NEW(pmix_get_multi_caddy_t);
+        PMIX_RETAIN(cd->peer);
+        mcd->super.peer = cd->peer;
+        mcd->super.hdr = cd->hdr;
+        PMIX_RETAIN(trk);
+        mcd->trk = trk;
+        mcd->idx = n;
+        ++trk->npending;
+        /* present each proc to the get path as a request of its own */
+        PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
+        nsp = procs[n].nspace;
+        PMIX_BFROPS_PACK(rc, cd->peer, &pkt, &nsp, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, cd->peer, &pkt, &procs[n].rank, 1, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, cd->peer, &pkt, &ninfo, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc && 0 < ninfo) {
+            PMIX_BFROPS_PACK(rc, cd->peer, &pkt, info, ninfo, PMIX_INFO);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_server_get(&pkt, get_multi_cbfunc, mcd);
+        }
+        PMIX_DESTRUCT(&pkt);
+        if (PMIX_SUCCESS != rc) {
+            /* the get path didn't take the caddy */
+            trk->status[n] = rc;
+            get_multi_done(trk);
+            PMIX_RELEASE(mcd);
+        }
+    }
+    get_multi_done(trk);
+    PMIX_RELEASE(trk);
+    PMIX_PROC_FREE(procs, nprocs);
+    PMIX_INFO_FREE(info, ninfo);
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
                                           pmix_info_t info[], size_t ninfo,
                                           pmix_modex_cbfunc_t cbfunc,
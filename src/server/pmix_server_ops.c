@@ -53,11 +53,15 @@
 #include "src/class/pmix_hotel.h"
 #include "src/class/pmix_list.h"
 #include "src/common/pmix_attributes.h"
+#include "src/common/pmix_query.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/plog/plog.h"
+#include "src/mca/psec/base/base.h"
 #include "src/mca/psensor/psensor.h"
+#include "src/runtime/pmix_progress_threads.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
+#include "src/util/opstats.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 
@@ -614,6 +618,185 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
     return rc;
 }
 
+/* groups are indexed by ID so they can be found without walking
+ * the list of every known group */
+static pmix_group_t* group_lookup(const char *grpid)
+{
+    void *ptr;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_server_globals.grpindex,
+                                                      grpid, strlen(grpid), &ptr)) {
+        return NULL;
+    }
+    return (pmix_group_t*)ptr;
+}
+
+static void group_add(pmix_group_t *grp)
+{
+    pmix_list_append(&pmix_server_globals.groups, &grp->super);
+    pmix_hash_table_set_value_ptr(&pmix_server_globals.grpindex,
+                                  grp->grpid, strlen(grp->grpid), grp);
+}
+
+static void group_remove(pmix_group_t *grp)
+{
+    pmix_hash_table_remove_value_ptr(&pmix_server_globals.grpindex,
+                                     grp->grpid, strlen(grp->grpid));
+    pmix_list_remove_item(&pmix_server_globals.groups, &grp->super);
+}
+
+static pmix_group_ranks_t* group_find_ranks(pmix_group_t *grp, const char *nspace)
+{
+    pmix_group_ranks_t *gr;
+
+    PMIX_LIST_FOREACH(gr, &grp->mbrmap, pmix_group_ranks_t) {
+        if (PMIX_CHECK_NSPACE(gr->nspace, nspace)) {
+            return gr;
+        }
+    }
+    return NULL;
+}
+
+static void group_clear_members(pmix_group_t *grp)
+{
+    pmix_list_item_t *item;
+
+    while (NULL != (item = pmix_list_remove_first(&grp->mbrmap))) {
+        PMIX_RELEASE(item);
+    }
+    if (NULL != grp->members) {
+        PMIX_PROC_FREE(grp->members, grp->nmbrs);
+        grp->members = NULL;
+        grp->nmbrs = 0;
+    }
+}
+
+/* take ownership of the given procs as the group's members and
+ * record them as a bitmap of ranks for each nspace */
+static pmix_status_t group_set_members(pmix_group_t *grp,
+                                       pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_group_ranks_t *gr;
+    pmix_namespace_t *ns;
+    size_t n;
+
+    grp->members = procs;
+    grp->nmbrs = nprocs;
+
+    for (n=0; n < nprocs; n++) {
+        if (NULL == (gr = group_find_ranks(grp, procs[n].nspace))) {
+            gr = PMIX_NEW(pmix_group_ranks_t);
+            if (NULL == gr) {
+                return PMIX_ERR_NOMEM;
+            }
+            PMIX_LOAD_NSPACE(gr->nspace, procs[n].nspace);
+            PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
+                if (PMIX_CHECK_NSPACE(ns->nspace, procs[n].nspace)) {
+                    gr->size = ns->nprocs;
+                    break;
+                }
+            }
+            pmix_list_append(&grp->mbrmap, &gr->super);
+        }
+        if (PMIX_RANK_WILDCARD == procs[n].rank) {
+            gr->all = true;
+        } else if (PMIX_RANK_LOCAL_PEERS == procs[n].rank ||
+                   PMIX_RANK_LOCAL_NODE == procs[n].rank) {
+            /* these always refer to local procs */
+            continue;
+        } else if (procs[n].rank < INT_MAX) {
+            if (0 < gr->size && gr->size <= procs[n].rank) {
+                /* no such proc */
+                return PMIX_ERR_BAD_PARAM;
+            }
+            if (!pmix_bitmap_is_set_bit(&gr->ranks, procs[n].rank)) {
+                if (PMIX_SUCCESS != pmix_bitmap_set_bit(&gr->ranks, procs[n].rank)) {
+                    return PMIX_ERR_NOMEM;
+                }
+                ++gr->nranks;
+            }
+        } else {
+            /* some other special rank - count it so it can
+             * never be found to be local */
+            ++gr->nranks;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* record a group whose construction was completed elsewhere,
+ * replacing any earlier record of the same ID */
+pmix_status_t pmix_server_group_record(const char *grpid,
+                                       const pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_group_t *grp, *old;
+    pmix_proc_t *mbrs;
+    pmix_status_t rc;
+
+    grp = PMIX_NEW(pmix_group_t);
+    if (NULL == grp) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_PROC_CREATE(mbrs, nprocs);
+    if (NULL == mbrs) {
+        PMIX_RELEASE(grp);
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(mbrs, procs, nprocs * sizeof(pmix_proc_t));
+    if (PMIX_SUCCESS != (rc = group_set_members(grp, mbrs, nprocs))) {
+        PMIX_RELEASE(grp);
+        return rc;
+    }
+
+    if (NULL != (old = group_lookup(grpid))) {
+        /* construct/destruct trackers may still point at the
+         * old record, so move the new membership into it */
+        group_clear_members(old);
+        pmix_list_join(&old->mbrmap, pmix_list_get_end(&old->mbrmap), &grp->mbrmap);
+        old->members = grp->members;
+        old->nmbrs = grp->nmbrs;
+        grp->members = NULL;
+        grp->nmbrs = 0;
+        PMIX_RELEASE(grp);
+        return PMIX_SUCCESS;
+    }
+    grp->grpid = strdup(grpid);
+    group_add(grp);
+    return PMIX_SUCCESS;
+}
+
+/* are all the members of the group local clients? */
+static bool group_is_local(pmix_group_t *grp)
+{
+    pmix_group_ranks_t *gr;
+    pmix_peer_t *pr;
+    int m;
+
+    PMIX_LIST_FOREACH(gr, &grp->mbrmap, pmix_group_ranks_t) {
+        gr->nlocal = 0;
+        gr->anylocal = false;
+    }
+    for (m=0; m < pmix_server_globals.clients.size; m++) {
+        if (NULL == (pr = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, m))) {
+            continue;
+        }
+        if (NULL == (gr = group_find_ranks(grp, pr->info->pname.nspace))) {
+            continue;
+        }
+        gr->anylocal = true;
+        if (pr->info->pname.rank < INT_MAX &&
+            pmix_bitmap_is_set_bit(&gr->ranks, pr->info->pname.rank)) {
+            ++gr->nlocal;
+        }
+    }
+    PMIX_LIST_FOREACH(gr, &grp->mbrmap, pmix_group_ranks_t) {
+        if (gr->nlocal < gr->nranks || (gr->all && !gr->anylocal)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
                                 pmix_buffer_t *buf,
                                 pmix_modex_cbfunc_t modexcbfunc,
@@ -674,22 +857,26 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
      * a PMIx group */
     nmbrs = nprocs;
     PMIX_CONSTRUCT(&expand, pmix_list_t);
-    /* use groups as the outer-most loop as there will
-     * usually not be any */
-    PMIX_LIST_FOREACH(grp, &pmix_server_globals.groups, pmix_group_t) {
+    if (0 < pmix_list_get_size(&pmix_server_globals.groups)) {
         for (n=0; n < nprocs; n++) {
-            if (PMIX_CHECK_NSPACE(procs[n].nspace, grp->grpid)) {
-                /* we need to replace this proc with grp members */
-                gcd = PMIX_NEW(pmix_group_caddy_t);
-                gcd->grp = grp;
-                gcd->idx = n;
-                gcd->rank = procs[n].rank;
-                pmix_list_append(&expand, &gcd->super);
-                /* see how many need to come across */
-                if (PMIX_RANK_WILDCARD == procs[n].rank) {
-                    nmbrs += grp->nmbrs - 1; // account for replacing current proc
-                }
-                break;
+            if (NULL == (grp = group_lookup(procs[n].nspace))) {
+                continue;
+            }
+            if (PMIX_RANK_WILDCARD != procs[n].rank &&
+                grp->nmbrs <= procs[n].rank) {
+                PMIX_LIST_DESTRUCT(&expand);
+                rc = PMIX_ERR_BAD_PARAM;
+                goto cleanup;
+            }
+            /* we need to replace this proc with grp members */
+            gcd = PMIX_NEW(pmix_group_caddy_t);
+            gcd->grp = grp;
+            gcd->idx = n;
+            gcd->rank = procs[n].rank;
+            pmix_list_append(&expand, &gcd->super);
+            /* see how many need to come across */
+            if (PMIX_RANK_WILDCARD == procs[n].rank) {
+                nmbrs += grp->nmbrs - 1; // account for replacing current proc
             }
         }
     }
@@ -697,25 +884,23 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         PMIX_PROC_CREATE(newprocs, nmbrs);
         gcd = (pmix_group_caddy_t*)pmix_list_remove_first(&expand);
         n=0;
-        idx = 0;
-        while (n < nmbrs) {
-            if (idx != gcd->idx) {
+        for (idx=0; idx < nprocs; idx++) {
+            if (NULL == gcd || idx != gcd->idx) {
                 memcpy(&newprocs[n], &procs[idx], sizeof(pmix_proc_t));
                 ++n;
+                continue;
+            }
+            /* if we are bringing over just one, then simply replace */
+            if (PMIX_RANK_WILDCARD != gcd->rank) {
+                memcpy(&newprocs[n], &gcd->grp->members[gcd->rank], sizeof(pmix_proc_t));
+                ++n;
             } else {
-                /* if we are bringing over just one, then simply replace */
-                if (PMIX_RANK_WILDCARD != gcd->rank) {
-                    memcpy(&newprocs[n], &gcd->grp->members[gcd->rank], sizeof(pmix_proc_t));
-                    ++n;
-                } else {
-                    /* take them all */
-                    memcpy(&newprocs[n], gcd->grp->members, gcd->grp->nmbrs * sizeof(pmix_proc_t));
-                    n += gcd->grp->nmbrs;
-                }
-                PMIX_RELEASE(gcd);
-                gcd = (pmix_group_caddy_t*)pmix_list_remove_first(&expand);
+                /* take them all */
+                memcpy(&newprocs[n], gcd->grp->members, gcd->grp->nmbrs * sizeof(pmix_proc_t));
+                n += gcd->grp->nmbrs;
             }
-            ++idx;
+            PMIX_RELEASE(gcd);
+            gcd = (pmix_group_caddy_t*)pmix_list_remove_first(&expand);
         }
         PMIX_PROC_FREE(procs, nprocs);
         procs = newprocs;
@@ -886,7 +1071,7 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer,
     pmix_output_verbose(2, pmix_server_globals.pub_output,
                         "recvd PUBLISH");
 
-    if (NULL == pmix_host_server.publish) {
+    if (NULL == pmix_host_server.publish && !pmix_server_globals.pubsub_local) {
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
@@ -918,8 +1103,8 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer,
         goto cleanup;
     }
     /* unpack the array of info objects */
-    if (0 < cd->ninfo) {
-        cnt=cd->ninfo;
+    if (0 < ninfo) {
+        cnt=ninfo;
         PMIX_BFROPS_UNPACK(rc, peer, buf, cd->info, &cnt, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
@@ -930,6 +1115,16 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer,
     cd->info[cd->ninfo-1].value.type = PMIX_UINT32;
     cd->info[cd->ninfo-1].value.data.uint32 = uid;
 
+    /* keep it ourselves if it stays on this node */
+    rc = pmix_server_pubsub_publish(peer, uid, cd->info, cd->ninfo,
+                                    NULL != pmix_host_server.publish);
+    if (PMIX_SUCCESS == rc) {
+        opcbfunc(PMIX_SUCCESS, cd);
+        return PMIX_SUCCESS;
+    } else if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        goto cleanup;
+    }
+
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
@@ -981,7 +1176,7 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer,
     pmix_output_verbose(2, pmix_server_globals.pub_output,
                         "recvd LOOKUP");
 
-    if (NULL == pmix_host_server.lookup) {
+    if (NULL == pmix_host_server.lookup && !pmix_server_globals.pubsub_local) {
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
@@ -1044,6 +1239,16 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer,
     cd->info[cd->ninfo-1].value.type = PMIX_UINT32;
     cd->info[cd->ninfo-1].value.data.uint32 = uid;
 
+    /* see if we hold the data ourselves - if so, or if we are
+     * to wait for it to be published here, then we are done */
+    rc = pmix_server_pubsub_lookup(peer, uid, cd->keys, cd->info, cd->ninfo,
+                                   NULL != pmix_host_server.lookup, lkcbfunc, cd);
+    if (PMIX_SUCCESS == rc) {
+        return PMIX_SUCCESS;
+    } else if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        goto cleanup;
+    }
+
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
@@ -1077,7 +1282,7 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer,
     pmix_output_verbose(2, pmix_server_globals.pub_output,
                         "recvd UNPUBLISH");
 
-    if (NULL == pmix_host_server.unpublish) {
+    if (NULL == pmix_host_server.unpublish && !pmix_server_globals.pubsub_local) {
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
@@ -1140,6 +1345,16 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer,
     cd->info[cd->ninfo-1].value.type = PMIX_UINT32;
     cd->info[cd->ninfo-1].value.data.uint32 = uid;
 
+    /* remove anything we hold ourselves */
+    rc = pmix_server_pubsub_unpublish(peer, cd->keys, cd->info, cd->ninfo,
+                                      NULL != pmix_host_server.unpublish);
+    if (PMIX_SUCCESS == rc) {
+        opcbfunc(PMIX_SUCCESS, cd);
+        return PMIX_SUCCESS;
+    } else if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        goto cleanup;
+    }
+
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
@@ -1236,6 +1451,7 @@ static void spcbfunc(pmix_status_t status,
             }
             /* remove it from the list since it has now been forwarded */
             pmix_list_remove_item(&pmix_server_globals.iof, &iof->super);
+            PMIX_SERVER_IOF_UNCACHED(iof);
             PMIX_RELEASE(iof);
         }
     }
@@ -2295,6 +2511,7 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
     size_t n, p;
     pmix_list_t results;
     pmix_kval_t *kv, *kvnxt;
+    bool refresh;
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "recvd query from client");
@@ -2304,6 +2521,13 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
         return PMIX_ERR_NOMEM;
     }
     cd->cbdata = cbdata;
+    /* the queries are not needed once the request completes, so
+     * unpack them into an arena that goes with the caddy */
+    PMIX_BFROPS_USE_ARENA(peer, buf);
+    if (NULL != buf->arena) {
+        cd->arena = buf->arena;
+        PMIX_RETAIN(cd->arena);
+    }
     /* unpack the number of queries */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &cd->nqueries, &cnt, PMIX_SIZE);
@@ -2314,7 +2538,7 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
     }
     /* unpack the queries */
     if (0 < cd->nqueries) {
-        PMIX_QUERY_CREATE(cd->queries, cd->nqueries);
+        PMIX_BFROPS_ALLOC(cd->queries, buf, cd->nqueries, pmix_query_t);
         if (NULL == cd->queries) {
             rc = PMIX_ERR_NOMEM;
             PMIX_RELEASE(cd);
@@ -2329,6 +2553,19 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
         }
     }
 
+    /* answer from the cache if the host was asked the same
+     * thing recently enough */
+    cd->cache_key = pmix_query_cache_key(cd->queries, cd->nqueries, peer->info->pname.nspace,
+                                         (uint32_t)peer->info->uid, &cd->cache_ttl, &refresh);
+    if (NULL != cd->cache_key && !refresh &&
+        PMIX_SUCCESS == pmix_query_cache_fetch(cd->cache_key, &cd->info, &cd->ninfo)) {
+        /* already cached */
+        free(cd->cache_key);
+        cd->cache_key = NULL;
+        cbfunc(PMIX_SUCCESS, cd->info, cd->ninfo, cd, NULL, NULL);
+        return PMIX_SUCCESS;
+    }
+
     /* check the directives to see if they want us to refresh
      * the local cached results - if we wanted to optimize this
      * more, we would check each query and allow those that don't
@@ -2392,6 +2629,34 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
         }
         for (p=0; NULL != cd->queries[n].keys[p]; p++) {
             cb.key = cd->queries[n].keys[p];
+            if (0 == strcmp(cb.key, PMIX_QUERY_PSEC_CACHE_STATS)) {
+                /* the cache lives in the server's security framework */
+                if (NULL != (kv = pmix_psec_base_cache_stats())) {
+                    pmix_list_append(&results, &kv->super);
+                    continue;
+                }
+            }
+            if (0 == strcmp(cb.key, PMIX_QUERY_OP_STATS)) {
+                /* report our own operation histograms */
+                if (NULL != (kv = pmix_opstats_report())) {
+                    pmix_list_append(&results, &kv->super);
+                    continue;
+                }
+            }
+            if (0 == strcmp(cb.key, PMIX_QUERY_ALLOC_STATS)) {
+                /* report our own object recycling */
+                if (NULL != (kv = pmix_opstats_alloc_report())) {
+                    pmix_list_append(&results, &kv->super);
+                    continue;
+                }
+            }
+            if (0 == strcmp(cb.key, PMIX_QUERY_SERVER_STATS)) {
+                /* report our own queues */
+                if (NULL != (kv = pmix_server_stats_report())) {
+                    pmix_list_append(&results, &kv->super);
+                    continue;
+                }
+            }
             PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
             if (PMIX_SUCCESS != rc) {
                 /* needs to be passed to the host */
@@ -2940,6 +3205,10 @@ pmix_status_t pmix_server_monitor(pmix_peer_t *peer,
     pmix_status_t rc, error;
     pmix_query_caddy_t *cd;
     pmix_proc_t proc;
+    pmix_list_t results;
+    pmix_infolist_t *iptr;
+    pmix_info_t *info;
+    size_t n, ninfo;
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "recvd monitor request from client");
@@ -2988,7 +3257,23 @@ pmix_status_t pmix_server_monitor(pmix_peer_t *peer,
 
     /* see if they are requesting one of the monitoring
      * methods we internally support */
-    rc = pmix_psensor.start(peer, error, &monitor, cd->info, cd->ninfo);
+    PMIX_CONSTRUCT(&results, pmix_list_t);
+    rc = pmix_psensor.start(peer, error, &monitor, cd->info, cd->ninfo, &results);
+    if (PMIX_SUCCESS == rc && 0 < (ninfo = pmix_list_get_size(&results))) {
+        /* the sensor has something to tell the requestor */
+        PMIX_INFO_CREATE(info, ninfo);
+        n = 0;
+        PMIX_LIST_FOREACH(iptr, &results, pmix_infolist_t) {
+            PMIX_INFO_XFER(&info[n], &iptr->info);
+            ++n;
+        }
+        PMIX_LIST_DESTRUCT(&results);
+        PMIX_INFO_DESTRUCT(&monitor);
+        cbfunc(PMIX_SUCCESS, info, ninfo, cd, NULL, NULL);
+        PMIX_INFO_FREE(info, ninfo);
+        return PMIX_SUCCESS;
+    }
+    PMIX_LIST_DESTRUCT(&results);
     if (PMIX_SUCCESS == rc) {
         rc = PMIX_OPERATION_SUCCEEDED;
         goto exit;
@@ -3307,6 +3592,7 @@ pmix_status_t pmix_server_iofreg(pmix_peer_t *peer,
             }
             /* remove it from the list since it has now been forwarded */
             pmix_list_remove_item(&pmix_server_globals.iof, &iof->super);
+            PMIX_SERVER_IOF_UNCACHED(iof);
             PMIX_RELEASE(iof);
         }
     }
@@ -3521,7 +3807,7 @@ static void _grpcbfunc(int sd, short argc, void *cbdata)
     if (trk->hybrid) {
         /* we destructed the group */
         if (NULL != grp) {
-            pmix_list_remove_item(&pmix_server_globals.groups, &grp->super);
+            group_remove(grp);
             PMIX_RELEASE(grp);
         }
     } else {
@@ -3662,19 +3948,19 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
     pmix_status_t rc;
     char *grpid;
     pmix_proc_t *procs;
-    pmix_group_t *grp, *pgrp;
+    pmix_group_t *grp;
     pmix_info_t *info = NULL, *iptr;
     size_t n, ninfo, nprocs, n2;
     pmix_server_trkr_t *trk;
     struct timeval tv = {0, 0};
     bool need_cxtid = false;
-    bool match, force_local = false;
+    bool force_local = false;
     bool embed_barrier = false;
     bool barrier_directive_included = false;
     pmix_buffer_t bucket;
     pmix_byte_object_t bo;
-    pmix_list_t mbrs;
-    pmix_namelist_t *nm;
+    pmix_proc_t *mbrs;
+    size_t nmbrs;
     bool expanded = false;
 
     pmix_output_verbose(2, pmix_server_globals.connect_output,
@@ -3689,13 +3975,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
     }
 
     /* see if we already have this group */
-    grp = NULL;
-    PMIX_LIST_FOREACH(pgrp, &pmix_server_globals.groups, pmix_group_t) {
-        if (0 == strcmp(grpid, pgrp->grpid)) {
-            grp = pgrp;
-            break;
-        }
-    }
+    grp = group_lookup(grpid);
     if (NULL == grp) {
         /* create a new entry */
         grp = PMIX_NEW(pmix_group_t);
@@ -3704,7 +3984,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
             goto error;
         }
         grp->grpid = grpid;
-        pmix_list_append(&pmix_server_globals.groups, &grp->super);
+        group_add(grp);
     } else {
         free(grpid);
     }
@@ -3735,7 +4015,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
         /* see if they used a local proc or local peer
          * wildcard - if they did, then we need to expand
          * it here */
-        PMIX_CONSTRUCT(&mbrs, pmix_list_t);
+        nmbrs = 0;
         for (n=0; n < nprocs; n++) {
             if (PMIX_RANK_LOCAL_PEERS == procs[n].rank) {
                 expanded = true;
@@ -3745,44 +4025,52 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
                         continue;
                     }
                     if (PMIX_CHECK_NSPACE(procs[n].nspace, pr->info->pname.nspace)) {
-                        nm = PMIX_NEW(pmix_namelist_t);
-                        nm->pname = &pr->info->pname;
-                        pmix_list_append(&mbrs, &nm->super);
+                        ++nmbrs;
                     }
                 }
             } else if (PMIX_RANK_LOCAL_NODE == procs[n].rank) {
                 expanded = true;
                 /* add in all procs on the node */
-                for (m=0; m < pmix_server_globals.clients.size; m++) {
-                    if (NULL == (pr = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, m))) {
-                        continue;
-                    }
-                    nm = PMIX_NEW(pmix_namelist_t);
-                    nm->pname = &pr->info->pname;
-                    pmix_list_append(&mbrs, &nm->super);
-                }
+                nmbrs += pmix_pointer_array_get_size(&pmix_server_globals.clients);
             } else {
-                nm = PMIX_NEW(pmix_namelist_t);
-                /* have to duplicate the name here */
-                nm->pname = (pmix_name_t*)malloc(sizeof(pmix_name_t));
-                nm->pname->nspace = strdup(procs[n].nspace);
-                nm->pname->rank = procs[n].rank;
-                pmix_list_append(&mbrs, &nm->super);
+                ++nmbrs;
             }
         }
         if (expanded) {
-            PMIX_PROC_FREE(procs, nprocs);
-            nprocs = pmix_list_get_size(&mbrs);
-            PMIX_PROC_CREATE(procs, nprocs);
-            n=0;
-            while (NULL != (nm = (pmix_namelist_t*)pmix_list_remove_first(&mbrs))) {
-                PMIX_LOAD_PROCID(&procs[n], nm->pname->nspace, nm->pname->rank);
-                PMIX_RELEASE(nm);
+            PMIX_PROC_CREATE(mbrs, nmbrs);
+            if (NULL == mbrs) {
+                PMIX_PROC_FREE(procs, nprocs);
+                rc = PMIX_ERR_NOMEM;
+                goto error;
             }
-            PMIX_DESTRUCT(&mbrs);
+            n2 = 0;
+            for (n=0; n < nprocs; n++) {
+                if (PMIX_RANK_LOCAL_PEERS == procs[n].rank ||
+                    PMIX_RANK_LOCAL_NODE == procs[n].rank) {
+                    for (m=0; m < pmix_server_globals.clients.size && n2 < nmbrs; m++) {
+                        if (NULL == (pr = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, m))) {
+                            continue;
+                        }
+                        if (PMIX_RANK_LOCAL_NODE == procs[n].rank ||
+                            PMIX_CHECK_NSPACE(procs[n].nspace, pr->info->pname.nspace)) {
+                            PMIX_LOAD_PROCID(&mbrs[n2], pr->info->pname.nspace, pr->info->pname.rank);
+                            ++n2;
+                        }
+                    }
+                } else if (n2 < nmbrs) {
+                    memcpy(&mbrs[n2], &procs[n], sizeof(pmix_proc_t));
+                    ++n2;
+                }
+            }
+            PMIX_PROC_FREE(procs, nprocs);
+            procs = mbrs;
+            nprocs = n2;
+        }
+        if (PMIX_SUCCESS != (rc = group_set_members(grp, procs, nprocs))) {
+            /* leave it for a valid construct to fill in */
+            group_clear_members(grp);
+            goto error;
         }
-        grp->members = procs;
-        grp->nmbrs = nprocs;
     } else {
         PMIX_PROC_FREE(procs, nprocs);
     }
@@ -3850,31 +4138,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
         } else if (need_cxtid) {
             trk->local = false;
         } else {
-            trk->local = true;
-            for (n=0; n < grp->nmbrs; n++) {
-                /* if this entry references the local procs, then
-                 * we can skip it */
-                if (PMIX_RANK_LOCAL_PEERS == grp->members[n].rank ||
-                    PMIX_RANK_LOCAL_NODE == grp->members[n].rank) {
-                    continue;
-                }
-                /* see if it references a specific local proc */
-                match = false;
-                for (m=0; m < pmix_server_globals.clients.size; m++) {
-                    if (NULL == (pr = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, m))) {
-                        continue;
-                    }
-                    if (PMIX_CHECK_PROCID(&grp->members[n], &pr->info->pname)) {
-                        match = true;
-                        break;
-                    }
-                }
-                if (!match) {
-                    /* this requires a non_local operation */
-                    trk->local = false;
-                    break;
-                }
-            }
+            trk->local = group_is_local(grp);
         }
     } else {
         /* cleanup */
@@ -3993,7 +4257,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
     pmix_info_t *info = NULL;
     size_t n, ninfo;
     pmix_server_trkr_t *trk;
-    pmix_group_t *grp, *pgrp;
+    pmix_group_t *grp;
     struct timeval tv = {0, 0};
 
     pmix_output_verbose(2, pmix_server_globals.iof_output,
@@ -4012,14 +4276,8 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
         goto error;
     }
 
-    /* find this group in our list */
-    grp = NULL;
-    PMIX_LIST_FOREACH(pgrp, &pmix_server_globals.groups, pmix_group_t) {
-        if (0 == strcmp(grpid, pgrp->grpid)) {
-            grp = pgrp;
-            break;
-        }
-    }
+    /* find this group */
+    grp = group_lookup(grpid);
     free(grpid);
 
     /* if not found, then this is an error - we cannot
@@ -4132,6 +4390,122 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
     return rc;
 }
 
+static void load_size(pmix_info_t *info, const char *key, size_t val)
+{
+    PMIX_INFO_LOAD(info, key, &val, PMIX_SIZE);
+}
+
+static void load_gds(pmix_info_t *info, pmix_namespace_t *ns,
+                     pmix_gds_base_module_t *gds, size_t *n)
+{
+    pmix_info_t *iptr;
+    size_t bytes;
+
+    if (NULL == gds || NULL == gds->mem_usage ||
+        PMIX_SUCCESS != gds->mem_usage(ns->nspace, &bytes)) {
+        return;
+    }
+    PMIX_LOAD_KEY(info[*n].key, PMIX_SRVSTAT_GDS);
+    info[*n].value.type = PMIX_DATA_ARRAY;
+    PMIX_DATA_ARRAY_CREATE(info[*n].value.data.darray, 3, PMIX_INFO);
+    iptr = (pmix_info_t*)info[*n].value.data.darray->array;
+    PMIX_INFO_LOAD(&iptr[0], PMIX_NSPACE, ns->nspace, PMIX_STRING);
+    PMIX_INFO_LOAD(&iptr[1], PMIX_GDS_MODULE, gds->name, PMIX_STRING);
+    load_size(&iptr[2], PMIX_SRVSTAT_GDS_BYTES, bytes);
+    ++(*n);
+}
+
+pmix_kval_t* pmix_server_stats_report(void)
+{
+    pmix_kval_t *kv;
+    pmix_info_t *info, *iptr;
+    pmix_peer_t *peer;
+    pmix_namespace_t *ns;
+    pmix_proc_t proc;
+    size_t n, nmax, nclients, nmsgs, tmsgs, tbytes;
+    int i;
+    uint64_t lag, lagmax;
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return NULL;
+    }
+    kv->key = strdup(PMIX_QUERY_SERVER_STATS);
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return NULL;
+    }
+    /* room for the fixed values, one entry for every client
+     * and up to two storage entries for each nspace */
+    nmax = 13 + pmix_server_globals.clients.size +
+           2 * pmix_list_get_size(&pmix_server_globals.nspaces);
+    kv->value->type = PMIX_DATA_ARRAY;
+    PMIX_DATA_ARRAY_CREATE(kv->value->data.darray, nmax, PMIX_INFO);
+    if (NULL == kv->value->data.darray) {
+        PMIX_RELEASE(kv);
+        return NULL;
+    }
+    info = (pmix_info_t*)kv->value->data.darray->array;
+
+    /* every value here is kept current as the queues change, so
+     * nothing is walked except the clients and nspaces themselves */
+    n = 13;
+    nclients = 0;
+    tmsgs = 0;
+    tbytes = 0;
+    for (i=0; i < pmix_server_globals.clients.size; i++) {
+        peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, i);
+        if (NULL == peer) {
+            continue;
+        }
+        ++nclients;
+        nmsgs = pmix_list_get_size(&peer->send_queue);
+        if (NULL != peer->send_msg) {
+            ++nmsgs;
+        }
+        if (0 == nmsgs) {
+            continue;
+        }
+        tmsgs += nmsgs;
+        tbytes += peer->send_qbytes;
+        PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
+        PMIX_LOAD_KEY(info[n].key, PMIX_SRVSTAT_PEER);
+        info[n].value.type = PMIX_DATA_ARRAY;
+        PMIX_DATA_ARRAY_CREATE(info[n].value.data.darray, 3, PMIX_INFO);
+        iptr = (pmix_info_t*)info[n].value.data.darray->array;
+        PMIX_INFO_LOAD(&iptr[0], PMIX_PROCID, &proc, PMIX_PROC);
+        load_size(&iptr[1], PMIX_SRVSTAT_SEND_MSGS, nmsgs);
+        load_size(&iptr[2], PMIX_SRVSTAT_SEND_BYTES, peer->send_qbytes);
+        ++n;
+    }
+    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
+        load_gds(info, ns, pmix_globals.mygds, &n);
+        if (ns->compat.gds != pmix_globals.mygds) {
+            load_gds(info, ns, ns->compat.gds, &n);
+        }
+    }
+    kv->value->data.darray->size = n;
+
+    load_size(&info[0], PMIX_SRVSTAT_NSPACES, pmix_list_get_size(&pmix_server_globals.nspaces));
+    load_size(&info[1], PMIX_SRVSTAT_CLIENTS, nclients);
+    load_size(&info[2], PMIX_SRVSTAT_COLLECTIVES, pmix_list_get_size(&pmix_server_globals.collectives));
+    load_size(&info[3], PMIX_SRVSTAT_LOCAL_REQS, pmix_list_get_size(&pmix_server_globals.local_reqs));
+    load_size(&info[4], PMIX_SRVSTAT_REMOTE_REQS, pmix_list_get_size(&pmix_server_globals.remote_pnd));
+    load_size(&info[5], PMIX_SRVSTAT_EVENT_REGS, pmix_list_get_size(&pmix_server_globals.events));
+    load_size(&info[6], PMIX_SRVSTAT_EVENTS_CACHED,
+              pmix_globals.notifications.num_rooms - (pmix_globals.notifications.last_unoccupied_room + 1));
+    load_size(&info[7], PMIX_SRVSTAT_IOF_MSGS, pmix_list_get_size(&pmix_server_globals.iof));
+    load_size(&info[8], PMIX_SRVSTAT_IOF_BYTES, pmix_server_globals.iof_bytes);
+    load_size(&info[9], PMIX_SRVSTAT_SEND_MSGS, tmsgs);
+    load_size(&info[10], PMIX_SRVSTAT_SEND_BYTES, tbytes);
+    (void)pmix_progress_thread_lag(pmix_globals.evbase, &lag, &lagmax);
+    PMIX_INFO_LOAD(&info[11], PMIX_SRVSTAT_LOOP_LAG, &lag, PMIX_UINT64);
+    PMIX_INFO_LOAD(&info[12], PMIX_SRVSTAT_LOOP_LAG_MAX, &lagmax, PMIX_UINT64);
+
+    return kv;
+}
+
 /*****    INSTANCE SERVER LIBRARY CLASSES    *****/
 static void tcon(pmix_server_trkr_t *t)
 {
@@ -4196,9 +4570,9 @@ static void cddes(pmix_server_caddy_t *cd)
         PMIX_RELEASE(cd->peer);
     }
 }
-PMIX_CLASS_INSTANCE(pmix_server_caddy_t,
-                   pmix_list_item_t,
-                   cdcon, cddes);
+PMIX_CLASS_INSTANCE_CACHED(pmix_server_caddy_t,
+                          pmix_list_item_t,
+                          cdcon, cddes);
 
 
 static void scadcon(pmix_setup_caddy_t *p)
@@ -4217,6 +4591,7 @@ static void scadcon(pmix_setup_caddy_t *p)
     p->nlocalprocs = 0;
     p->info = NULL;
     p->ninfo = 0;
+    p->job = NULL;
     p->keys = NULL;
     p->channels = PMIX_FWD_NO_CHANNELS;
     p->bo = NULL;
@@ -4240,6 +4615,9 @@ static void scaddes(pmix_setup_caddy_t *p)
     if (NULL != p->bo) {
         PMIX_BYTE_OBJECT_FREE(p->bo, p->nbo);
     }
+    if (NULL != p->job) {
+        PMIX_RELEASE(p->job);
+    }
     PMIX_DESTRUCT_LOCK(&p->lock);
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_setup_caddy_t,
@@ -4398,11 +4776,30 @@ PMIX_CLASS_INSTANCE(pmix_inventory_rollup_t,
                     pmix_object_t,
                     ilcon, ildes);
 
+static void grrcon(pmix_group_ranks_t *p)
+{
+    memset(p->nspace, 0, sizeof(p->nspace));
+    p->all = false;
+    p->size = 0;
+    PMIX_CONSTRUCT(&p->ranks, pmix_bitmap_t);
+    p->nranks = 0;
+    p->nlocal = 0;
+    p->anylocal = false;
+}
+static void grrdes(pmix_group_ranks_t *p)
+{
+    PMIX_DESTRUCT(&p->ranks);
+}
+PMIX_CLASS_INSTANCE(pmix_group_ranks_t,
+                    pmix_list_item_t,
+                    grrcon, grrdes);
+
 static void grcon(pmix_group_t *p)
 {
     p->grpid = NULL;
     p->members = NULL;
     p->nmbrs = 0;
+    PMIX_CONSTRUCT(&p->mbrmap, pmix_list_t);
 }
 static void grdes(pmix_group_t *p)
 {
@@ -4412,6 +4809,7 @@ static void grdes(pmix_group_t *p)
     if (NULL != p->members) {
         PMIX_PROC_FREE(p->members, p->nmbrs);
     }
+    PMIX_LIST_DESTRUCT(&p->mbrmap);
 }
 PMIX_CLASS_INSTANCE(pmix_group_t,
                     pmix_list_item_t,
@@ -4421,6 +4819,25 @@ PMIX_CLASS_INSTANCE(pmix_group_caddy_t,
                     pmix_list_item_t,
                     NULL, NULL);
 
+static void jpcon(pmix_job_payload_t *p)
+{
+    p->nspace = NULL;
+    p->bfrops = NULL;
+    p->type = PMIX_BFROP_BUFFER_UNDEF;
+    p->gds = NULL;
+    PMIX_CONSTRUCT(&p->payload, pmix_buffer_t);
+}
+static void jpdes(pmix_job_payload_t *p)
+{
+    if (NULL != p->nspace) {
+        free(p->nspace);
+    }
+    PMIX_DESTRUCT(&p->payload);
+}
+PMIX_CLASS_INSTANCE(pmix_job_payload_t,
+                    pmix_list_item_t,
+                    jpcon, jpdes);
+
 static void iocon(pmix_iof_cache_t *p)
 {
     p->bo = NULL;
@@ -23,6 +23,7 @@
 #include "src/include/types.h"
 #include <pmix_common.h>
 
+#include <src/class/pmix_bitmap.h>
 #include <src/class/pmix_hotel.h>
 #include <pmix_server.h>
 #include "src/threads/threads.h"
@@ -57,6 +58,7 @@ typedef struct {
     int nlocalprocs;
     pmix_info_t *info;
     size_t ninfo;
+    pmix_object_t *job;     // job info prepared off the progress thread
     char **keys;
     pmix_app_t *apps;
     size_t napps;
@@ -143,11 +145,27 @@ typedef struct {
 } pmix_regevents_info_t;
 PMIX_CLASS_DECLARATION(pmix_regevents_info_t);
 
+/* the members of a group that come from one nspace */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    bool all;               // every rank of the nspace is a member
+    pmix_rank_t size;       // number of procs in the nspace, 0 if unknown
+    pmix_bitmap_t ranks;    // the specific ranks that are members
+    size_t nranks;          // number of specific members, including any
+                            // special ranks that cannot be in the bitmap
+    /* scratch for the local membership check */
+    size_t nlocal;
+    bool anylocal;
+} pmix_group_ranks_t;
+PMIX_CLASS_DECLARATION(pmix_group_ranks_t);
+
 typedef struct {
     pmix_list_item_t super;
     char *grpid;
     pmix_proc_t *members;
     size_t nmbrs;
+    pmix_list_t mbrmap;     // list of pmix_group_ranks_t, one per nspace
 } pmix_group_t;
 PMIX_CLASS_DECLARATION(pmix_group_t);
 
@@ -167,6 +185,19 @@ typedef struct {
 } pmix_iof_cache_t;
 PMIX_CLASS_DECLARATION(pmix_iof_cache_t);
 
+/* the job-level info of an nspace as packed for one combination of
+ * bfrops and gds modules - replies to all peers using the same
+ * modules carry identical copies of it, so it need only be built once */
+typedef struct {
+    pmix_list_item_t super;
+    char *nspace;
+    pmix_bfrops_module_t *bfrops;
+    pmix_bfrop_buffer_type_t type;
+    pmix_gds_base_module_t *gds;
+    pmix_buffer_t payload;
+} pmix_job_payload_t;
+PMIX_CLASS_DECLARATION(pmix_job_payload_t);
+
 typedef struct {
     pmix_list_t nspaces;                    // list of pmix_nspace_t for the nspaces we know about
     pmix_pointer_array_t clients;           // array of pmix_peer_t local clients
@@ -176,8 +207,18 @@ typedef struct {
     pmix_list_t gdata;                      // cache of data given to me for passing to all clients
     pmix_list_t events;                     // list of pmix_regevents_info_t registered events
     pmix_list_t groups;                     // list of pmix_group_t group memberships
+    pmix_hash_table_t grpindex;             // the same groups, keyed by group ID
     pmix_list_t iof;                        // IO to be forwarded to clients
     size_t max_iof_cache;                   // max number of IOF messages to cache
+    size_t iof_bytes;                       // bytes of output held in the IOF cache
+    int lag_interval;                       // msec between progress thread lag checks
+    int reg_threads;                        // number of threads preparing nspace registrations
+    pmix_event_base_t **reg_evbases;        // event bases of those threads
+    pmix_list_t nspace_ops;                 // list of nspace (de)registrations in progress or waiting
+    pmix_list_t nspace_posted;              // (de)registrations not yet taken up by the progress thread
+    bool pubsub_local;                      // keep node-local published data ourselves
+    pmix_hash_table_t pubdata;              // lists of published values, keyed by key
+    pmix_hash_table_t pubwaiters;           // lists of lookups waiting on a key, keyed by key
     bool tool_connections_allowed;
     char *tmpdir;                           // temporary directory for this server
     char *system_tmpdir;                    // system tmpdir
@@ -208,6 +249,12 @@ typedef struct {
 
 } pmix_server_globals_t;
 
+/* track the size of the IOF cache as entries enter and leave it */
+#define PMIX_SERVER_IOF_CACHED(i)                                   \
+    pmix_server_globals.iof_bytes += (NULL == (i)->bo) ? 0 : (i)->bo->size
+#define PMIX_SERVER_IOF_UNCACHED(i)                                 \
+    pmix_server_globals.iof_bytes -= (NULL == (i)->bo) ? 0 : (i)->bo->size
+
 #define PMIX_GDS_CADDY(c, p, t)                \
     do {                                        \
         (c) = PMIX_NEW(pmix_server_caddy_t);    \
@@ -225,8 +272,8 @@ typedef struct {
 #define PMIX_EXECUTE_COLLECTIVE(c, t, f)                        \
     do {                                                        \
         PMIX_SETUP_COLLECTIVE(c, t);                            \
-        pmix_event_assign(&((c)->ev), pmix_globals.evbase, -1,  \
-                          EV_WRITE, (f), (c));                  \
+        pmix_event_assign_shift(&((c)->ev), pmix_globals.evbase,\
+                                EV_WRITE, (f), (c));            \
         pmix_event_active(&((c)->ev), EV_WRITE, 1);             \
     } while (0)
 
@@ -253,6 +300,9 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
                               pmix_modex_cbfunc_t cbfunc,
                               void *cbdata);
 
+pmix_status_t pmix_server_get_multi(pmix_server_caddy_t *cd,
+                                    pmix_buffer_t *buf);
+
 pmix_status_t pmix_server_publish(pmix_peer_t *peer,
                                   pmix_buffer_t *buf,
                                   pmix_op_cbfunc_t cbfunc,
@@ -268,6 +318,29 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer,
                                     pmix_op_cbfunc_t cbfunc,
                                     void *cbdata);
 
+/* local datastore for published data - each returns
+ * PMIX_ERR_TAKE_NEXT_OPTION if the host is to handle the request */
+bool pmix_server_pubsub_local(pmix_data_range_t range, bool host_support);
+
+pmix_status_t pmix_server_pubsub_publish(pmix_peer_t *peer, uint32_t uid,
+                                         const pmix_info_t *info, size_t ninfo,
+                                         bool host_support);
+
+pmix_status_t pmix_server_pubsub_lookup(pmix_peer_t *peer, uint32_t uid, char **keys,
+                                        const pmix_info_t *info, size_t ninfo,
+                                        bool host_support,
+                                        pmix_lookup_cbfunc_t cbfunc, void *cbdata);
+
+pmix_status_t pmix_server_pubsub_unpublish(pmix_peer_t *peer, char **keys,
+                                           const pmix_info_t *info, size_t ninfo,
+                                           bool host_support);
+
+void pmix_server_pubsub_purge_peer(pmix_peer_t *peer);
+
+void pmix_server_pubsub_purge_nspace(const char *nspace);
+
+void pmix_server_pubsub_finalize(void);
+
 pmix_status_t pmix_server_spawn(pmix_peer_t *peer,
                                 pmix_buffer_t *buf,
                                 pmix_spawn_cbfunc_t cbfunc,
@@ -346,6 +419,9 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
 pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
                                       pmix_buffer_t *buf);
 
+pmix_status_t pmix_server_group_record(const char *grpid,
+                                       const pmix_proc_t *procs, size_t nprocs);
+
 pmix_status_t pmix_server_event_recvd_from_client(pmix_peer_t *peer,
                                                   pmix_buffer_t *buf,
                                                   pmix_op_cbfunc_t cbfunc,
@@ -361,6 +437,11 @@ void pmix_server_message_handler(struct pmix_peer_t *pr,
 void pmix_server_purge_events(pmix_peer_t *peer,
                               pmix_proc_t *proc);
 
+/* return a snapshot of the server's queue depths and storage as a
+ * pmix_kval_t keyed on PMIX_QUERY_SERVER_STATS, or NULL on error.
+ * Must be called from within the progress thread */
+PMIX_EXPORT pmix_kval_t* pmix_server_stats_report(void);
+
 PMIX_EXPORT extern pmix_server_module_t pmix_host_server;
 PMIX_EXPORT extern pmix_server_globals_t pmix_server_globals;
 
@@ -0,0 +1,689 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <src/include/pmix_stdint.h>
+
+#include <pmix_server.h>
+#include <pmix_rename.h>
+#include "src/include/pmix_globals.h"
+
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#include PMIX_EVENT_HEADER
+
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_list.h"
+#include "src/util/argv.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include "pmix_server_ops.h"
+
+/* Data published by our local clients is kept here, rather than
+ * being passed to the host, when its range doesn't extend beyond
+ * this node - or, if the host has no datastore of its own, for
+ * any range. Published values are indexed by key, each key holding
+ * a list of the values published under it by different procs.
+ * Lookups that ask to wait for data that hasn't been published yet
+ * are parked on a list held under each of the keys they are missing,
+ * so that they complete as soon as a matching publish arrives rather
+ * than by polling. Everything here executes in the progress thread */
+
+/* a published value */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t owner;
+    uint32_t uid;
+    pmix_data_range_t range;
+    pmix_persistence_t persist;
+    pmix_info_t info;
+} pmix_pubsub_data_t;
+static void pdcon(pmix_pubsub_data_t *p)
+{
+    memset(&p->owner, 0, sizeof(pmix_proc_t));
+    p->uid = 0;
+    p->range = PMIX_RANGE_SESSION;
+    p->persist = PMIX_PERSIST_SESSION;
+    PMIX_INFO_CONSTRUCT(&p->info);
+}
+static void pddes(pmix_pubsub_data_t *p)
+{
+    PMIX_INFO_DESTRUCT(&p->info);
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_data_t,
+                           pmix_list_item_t,
+                           pdcon, pddes);
+
+/* a lookup waiting for data to be published */
+typedef struct {
+    pmix_object_t super;
+    pmix_proc_t requestor;
+    uint32_t uid;
+    pmix_data_range_t range;
+    char **keys;
+    size_t nwait;
+    pmix_event_t ev;
+    bool timer_active;
+    pmix_lookup_cbfunc_t cbfunc;
+    void *cbdata;
+} pmix_pubsub_waiter_t;
+static void pwcon(pmix_pubsub_waiter_t *p)
+{
+    p->keys = NULL;
+    p->nwait = 0;
+    p->timer_active = false;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void pwdes(pmix_pubsub_waiter_t *p)
+{
+    if (p->timer_active) {
+        pmix_event_del(&p->ev);
+    }
+    if (NULL != p->keys) {
+        pmix_argv_free(p->keys);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_waiter_t,
+                           pmix_object_t,
+                           pwcon, pwdes);
+
+/* a waiter's place on the list of one of the keys it is missing */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_pubsub_waiter_t *waiter;
+} pmix_pubsub_waitref_t;
+static void wrcon(pmix_pubsub_waitref_t *p)
+{
+    p->waiter = NULL;
+}
+static void wrdes(pmix_pubsub_waitref_t *p)
+{
+    if (NULL != p->waiter) {
+        PMIX_RELEASE(p->waiter);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_waitref_t,
+                           pmix_list_item_t,
+                           wrcon, wrdes);
+
+/* return the list held under key in the given index,
+ * creating it if asked */
+static pmix_list_t* index_list(pmix_hash_table_t *ht, const char *key, bool create)
+{
+    pmix_list_t *lst;
+    void *ptr;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(ht, key, strlen(key), &ptr)) {
+        return (pmix_list_t*)ptr;
+    }
+    if (!create) {
+        return NULL;
+    }
+    lst = PMIX_NEW(pmix_list_t);
+    pmix_hash_table_set_value_ptr(ht, key, strlen(key), lst);
+    return lst;
+}
+
+/* drop the list held under key once it is empty */
+static void index_trim(pmix_hash_table_t *ht, const char *key, pmix_list_t *lst)
+{
+    if (0 == pmix_list_get_size(lst)) {
+        pmix_hash_table_remove_value_ptr(ht, key, strlen(key));
+        PMIX_RELEASE(lst);
+    }
+}
+
+static void index_release(pmix_hash_table_t *ht)
+{
+    pmix_list_t *lst;
+    void *key, *node, *ptr;
+    size_t keylen;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_ptr(ht, &key, &keylen, &ptr, &node);
+    while (PMIX_SUCCESS == rc) {
+        lst = (pmix_list_t*)ptr;
+        PMIX_LIST_RELEASE(lst);
+        rc = pmix_hash_table_get_next_key_ptr(ht, &key, &keylen, &ptr, node, &node);
+    }
+    pmix_hash_table_remove_all(ht);
+}
+
+bool pmix_server_pubsub_local(pmix_data_range_t range, bool host_support)
+{
+    if (!pmix_server_globals.pubsub_local) {
+        return false;
+    }
+    return (PMIX_RANGE_LOCAL == range || PMIX_RANGE_PROC_LOCAL == range || !host_support);
+}
+
+/* get the range and persistence given with a request */
+static void get_directives(const pmix_info_t *info, size_t ninfo,
+                           pmix_data_range_t *range, pmix_persistence_t *persist,
+                           size_t *nwait, bool *wait, int *timeout)
+{
+    size_t n;
+
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_RANGE)) {
+            *range = info[n].value.data.range;
+        } else if (NULL != persist && PMIX_CHECK_KEY(&info[n], PMIX_PERSISTENCE)) {
+            *persist = info[n].value.data.persist;
+        } else if (NULL != wait && PMIX_CHECK_KEY(&info[n], PMIX_WAIT)) {
+            *wait = true;
+            *nwait = (0 < info[n].value.data.integer) ? (size_t)info[n].value.data.integer : 0;
+        } else if (NULL != timeout && PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
+            *timeout = info[n].value.data.integer;
+        }
+    }
+}
+
+static bool is_directive(const pmix_info_t *info)
+{
+    return (PMIX_CHECK_KEY(info, PMIX_RANGE) ||
+            PMIX_CHECK_KEY(info, PMIX_PERSISTENCE) ||
+            PMIX_CHECK_KEY(info, PMIX_USERID) ||
+            PMIX_CHECK_KEY(info, PMIX_TIMEOUT));
+}
+
+/* can the given proc see the data within the range it looked in */
+static bool visible(const pmix_pubsub_data_t *pd, const pmix_proc_t *proc,
+                    uint32_t uid, pmix_data_range_t range)
+{
+    if (pd->uid != uid) {
+        return false;
+    }
+    if (PMIX_RANGE_PROC_LOCAL == pd->range || PMIX_RANGE_PROC_LOCAL == range) {
+        return PMIX_CHECK_PROCID(&pd->owner, proc);
+    }
+    if (PMIX_RANGE_NAMESPACE == pd->range || PMIX_RANGE_NAMESPACE == range) {
+        return PMIX_CHECK_NSPACE(pd->owner.nspace, proc->nspace);
+    }
+    return true;
+}
+
+static pmix_pubsub_data_t* find_data(const char *key, const pmix_proc_t *proc,
+                                     uint32_t uid, pmix_data_range_t range)
+{
+    pmix_list_t *lst;
+    pmix_pubsub_data_t *pd;
+
+    if (NULL == (lst = index_list(&pmix_server_globals.pubdata, key, false))) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH(pd, lst, pmix_pubsub_data_t) {
+        if (visible(pd, proc, uid, range)) {
+            return pd;
+        }
+    }
+    return NULL;
+}
+
+static size_t count_found(char **keys, const pmix_proc_t *proc,
+                          uint32_t uid, pmix_data_range_t range)
+{
+    size_t n, nfound = 0;
+
+    for (n=0; NULL != keys[n]; n++) {
+        if (NULL != find_data(keys[n], proc, uid, range)) {
+            ++nfound;
+        }
+    }
+    return nfound;
+}
+
+static void remove_data(const char *key, pmix_pubsub_data_t *pd)
+{
+    pmix_list_t *lst;
+
+    if (NULL != (lst = index_list(&pmix_server_globals.pubdata, key, false))) {
+        pmix_list_remove_item(lst, &pd->super);
+        PMIX_RELEASE(pd);
+        index_trim(&pmix_server_globals.pubdata, key, lst);
+    }
+}
+
+/* return whatever data can be found for the keys */
+static void answer(char **keys, const pmix_proc_t *proc, uint32_t uid,
+                   pmix_data_range_t range, pmix_status_t status,
+                   pmix_lookup_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_pdata_t *pdata = NULL;
+    pmix_pubsub_data_t *pd;
+    size_t n, ndata = 0, nkeys = pmix_argv_count(keys);
+    pmix_status_t rc;
+
+    if (0 < nkeys) {
+        PMIX_PDATA_CREATE(pdata, nkeys);
+        if (NULL == pdata) {
+            cbfunc(PMIX_ERR_NOMEM, NULL, 0, cbdata);
+            return;
+        }
+    }
+    for (n=0; n < nkeys; n++) {
+        if (NULL == (pd = find_data(keys[n], proc, uid, range))) {
+            continue;
+        }
+        PMIX_LOAD_PROCID(&pdata[ndata].proc, pd->owner.nspace, pd->owner.rank);
+        PMIX_LOAD_KEY(pdata[ndata].key, pd->info.key);
+        rc = pmix_value_xfer(&pdata[ndata].value, &pd->info.value);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            continue;
+        }
+        ++ndata;
+        if (PMIX_PERSIST_FIRST_READ == pd->persist) {
+            remove_data(keys[n], pd);
+        }
+    }
+    if (PMIX_SUCCESS == status && 0 == ndata) {
+        status = PMIX_ERR_NOT_FOUND;
+    }
+    if (PMIX_SUCCESS != status && 0 < ndata) {
+        /* return what we have */
+        status = PMIX_SUCCESS;
+    }
+    cbfunc(status, pdata, ndata, cbdata);
+    if (NULL != pdata) {
+        PMIX_PDATA_FREE(pdata, nkeys);
+    }
+}
+
+/* put the waiter on the list of each of its keys that can't be
+ * found and that it isn't already waiting on */
+static void park(pmix_pubsub_waiter_t *w)
+{
+    pmix_list_t *lst;
+    pmix_pubsub_waitref_t *ref;
+    size_t n;
+    bool parked;
+
+    for (n=0; NULL != w->keys[n]; n++) {
+        if (NULL != find_data(w->keys[n], &w->requestor, w->uid, w->range)) {
+            continue;
+        }
+        lst = index_list(&pmix_server_globals.pubwaiters, w->keys[n], true);
+        parked = false;
+        PMIX_LIST_FOREACH(ref, lst, pmix_pubsub_waitref_t) {
+            if (ref->waiter == w) {
+                parked = true;
+                break;
+            }
+        }
+        if (parked) {
+            continue;
+        }
+        ref = PMIX_NEW(pmix_pubsub_waitref_t);
+        PMIX_RETAIN(w);
+        ref->waiter = w;
+        pmix_list_append(lst, &ref->super);
+    }
+}
+
+/* take the waiter off the lists of all its keys */
+static void unpark(pmix_pubsub_waiter_t *w)
+{
+    pmix_list_t *lst;
+    pmix_pubsub_waitref_t *ref, *rnext;
+    size_t n;
+
+    if (w->timer_active) {
+        pmix_event_del(&w->ev);
+        w->timer_active = false;
+    }
+    for (n=0; NULL != w->keys[n]; n++) {
+        if (NULL == (lst = index_list(&pmix_server_globals.pubwaiters, w->keys[n], false))) {
+            continue;
+        }
+        PMIX_LIST_FOREACH_SAFE(ref, rnext, lst, pmix_pubsub_waitref_t) {
+            if (ref->waiter == w) {
+                pmix_list_remove_item(lst, &ref->super);
+                PMIX_RELEASE(ref);
+            }
+        }
+        index_trim(&pmix_server_globals.pubwaiters, w->keys[n], lst);
+    }
+}
+
+static void complete_waiter(pmix_pubsub_waiter_t *w, pmix_status_t status)
+{
+    /* hold the waiter while its references are dropped */
+    PMIX_RETAIN(w);
+    unpark(w);
+    answer(w->keys, &w->requestor, w->uid, w->range, status, w->cbfunc, w->cbdata);
+    PMIX_RELEASE(w);
+}
+
+static void wait_timeout(int sd, short args, void *cbdata)
+{
+    pmix_pubsub_waiter_t *w = (pmix_pubsub_waiter_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(w);
+    w->timer_active = false;
+    pmix_output_verbose(2, pmix_server_globals.pub_output,
+                        "pmix:server pubsub lookup by %s:%u timed out",
+                        w->requestor.nspace, w->requestor.rank);
+    complete_waiter(w, PMIX_ERR_TIMEOUT);
+}
+
+/* see if the publication of key satisfies any of the
+ * lookups waiting for it */
+static void wake_waiters(const char *key)
+{
+    pmix_list_t *lst, ready;
+    pmix_pubsub_waitref_t *ref, *rnext;
+    pmix_pubsub_waiter_t *w;
+
+    if (NULL == (lst = index_list(&pmix_server_globals.pubwaiters, key, false))) {
+        return;
+    }
+    /* collect those that are done before completing any, as
+     * completion takes them off the lists */
+    PMIX_CONSTRUCT(&ready, pmix_list_t);
+    PMIX_LIST_FOREACH_SAFE(ref, rnext, lst, pmix_pubsub_waitref_t) {
+        if (count_found(ref->waiter->keys, &ref->waiter->requestor, ref->waiter->uid,
+                        ref->waiter->range) >= ref->waiter->nwait) {
+            pmix_list_remove_item(lst, &ref->super);
+            pmix_list_append(&ready, &ref->super);
+        }
+    }
+    index_trim(&pmix_server_globals.pubwaiters, key, lst);
+    while (NULL != (ref = (pmix_pubsub_waitref_t*)pmix_list_remove_first(&ready))) {
+        w = ref->waiter;
+        /* those completed ahead of it may have taken data that is
+         * only to be read once - if so, it has to keep waiting */
+        if (count_found(w->keys, &w->requestor, w->uid, w->range) >= w->nwait) {
+            complete_waiter(w, PMIX_SUCCESS);
+        } else {
+            park(w);
+        }
+        PMIX_RELEASE(ref);
+    }
+    PMIX_DESTRUCT(&ready);
+}
+
+/* data published by the given proc */
+static bool match_proc(const pmix_pubsub_data_t *pd, const pmix_proc_t *proc)
+{
+    return PMIX_CHECK_PROCID(&pd->owner, proc);
+}
+
+/* data that was to persist only as long as the given proc */
+static bool match_proc_persist(const pmix_pubsub_data_t *pd, const pmix_proc_t *proc)
+{
+    return (PMIX_PERSIST_PROC == pd->persist && PMIX_CHECK_PROCID(&pd->owner, proc));
+}
+
+/* data that was to persist only as long as the given nspace */
+static bool match_nspace_persist(const pmix_pubsub_data_t *pd, const pmix_proc_t *proc)
+{
+    return ((PMIX_PERSIST_PROC == pd->persist || PMIX_PERSIST_APP == pd->persist) &&
+            PMIX_CHECK_NSPACE(pd->owner.nspace, proc->nspace));
+}
+
+/* remove all the data that matches, whatever its key */
+static void purge(bool (*match)(const pmix_pubsub_data_t*, const pmix_proc_t*),
+                  const pmix_proc_t *proc)
+{
+    pmix_pubsub_data_t *pd, *pdnext;
+    pmix_list_t *lst;
+    void *key, *node, *ptr;
+    size_t keylen, n;
+    char **empty = NULL, *tmp;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_ptr(&pmix_server_globals.pubdata, &key, &keylen, &ptr, &node);
+    while (PMIX_SUCCESS == rc) {
+        lst = (pmix_list_t*)ptr;
+        PMIX_LIST_FOREACH_SAFE(pd, pdnext, lst, pmix_pubsub_data_t) {
+            if (match(pd, proc)) {
+                pmix_list_remove_item(lst, &pd->super);
+                PMIX_RELEASE(pd);
+            }
+        }
+        if (0 == pmix_list_get_size(lst)) {
+            /* can't take it out of the table while walking it */
+            tmp = strndup((char*)key, keylen);
+            pmix_argv_append_nosize(&empty, tmp);
+            free(tmp);
+        }
+        rc = pmix_hash_table_get_next_key_ptr(&pmix_server_globals.pubdata, &key, &keylen,
+                                              &ptr, node, &node);
+    }
+    for (n=0; NULL != empty && NULL != empty[n]; n++) {
+        if (NULL != (lst = index_list(&pmix_server_globals.pubdata, empty[n], false))) {
+            index_trim(&pmix_server_globals.pubdata, empty[n], lst);
+        }
+    }
+    if (NULL != empty) {
+        pmix_argv_free(empty);
+    }
+}
+
+pmix_status_t pmix_server_pubsub_publish(pmix_peer_t *peer, uint32_t uid,
+                                         const pmix_info_t *info, size_t ninfo,
+                                         bool host_support)
+{
+    pmix_data_range_t range = PMIX_RANGE_SESSION;
+    pmix_persistence_t persist = PMIX_PERSIST_SESSION;
+    pmix_pubsub_data_t *pd, *pdnext;
+    pmix_list_t *lst;
+    pmix_proc_t proc;
+    size_t n;
+
+    get_directives(info, ninfo, &range, &persist, NULL, NULL, NULL);
+    if (!pmix_server_pubsub_local(range, host_support)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
+
+    for (n=0; n < ninfo; n++) {
+        if (is_directive(&info[n])) {
+            continue;
+        }
+        lst = index_list(&pmix_server_globals.pubdata, info[n].key, true);
+        /* a republished value replaces the one before it */
+        PMIX_LIST_FOREACH_SAFE(pd, pdnext, lst, pmix_pubsub_data_t) {
+            if (PMIX_CHECK_PROCID(&pd->owner, &proc) && pd->range == range) {
+                pmix_list_remove_item(lst, &pd->super);
+                PMIX_RELEASE(pd);
+            }
+        }
+        pd = PMIX_NEW(pmix_pubsub_data_t);
+        PMIX_LOAD_PROCID(&pd->owner, proc.nspace, proc.rank);
+        pd->uid = uid;
+        pd->range = range;
+        pd->persist = persist;
+        PMIX_INFO_XFER(&pd->info, (pmix_info_t*)&info[n]);
+        pmix_list_append(lst, &pd->super);
+        pmix_output_verbose(2, pmix_server_globals.pub_output,
+                            "pmix:server pubsub %s:%u published %s",
+                            proc.nspace, proc.rank, info[n].key);
+    }
+    /* now that everything is in place, release anyone
+     * that was waiting for it */
+    for (n=0; n < ninfo; n++) {
+        if (!is_directive(&info[n])) {
+            wake_waiters(info[n].key);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_server_pubsub_lookup(pmix_peer_t *peer, uint32_t uid, char **keys,
+                                        const pmix_info_t *info, size_t ninfo,
+                                        bool host_support,
+                                        pmix_lookup_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_data_range_t range = PMIX_RANGE_SESSION;
+    pmix_pubsub_waiter_t *w;
+    pmix_proc_t proc;
+    size_t nkeys, nwait = 0, nfound;
+    bool wait = false;
+    int timeout = 0;
+    struct timeval tv = {0, 0};
+
+    if (!pmix_server_globals.pubsub_local || NULL == keys) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    get_directives(info, ninfo, &range, NULL, &nwait, &wait, &timeout);
+    PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
+    nkeys = pmix_argv_count(keys);
+    if (0 == nwait || nkeys < nwait) {
+        nwait = nkeys;
+    }
+    nfound = count_found(keys, &proc, uid, range);
+
+    if (!pmix_server_pubsub_local(range, host_support)) {
+        /* we may have it anyway - otherwise, let the host
+         * look further afield */
+        if (nfound < nkeys) {
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+        answer(keys, &proc, uid, range, PMIX_SUCCESS, cbfunc, cbdata);
+        return PMIX_SUCCESS;
+    }
+
+    if (!wait || nfound >= nwait) {
+        answer(keys, &proc, uid, range, PMIX_SUCCESS, cbfunc, cbdata);
+        return PMIX_SUCCESS;
+    }
+
+    /* park the request under each of the keys it is missing */
+    w = PMIX_NEW(pmix_pubsub_waiter_t);
+    if (NULL == w) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_LOAD_PROCID(&w->requestor, proc.nspace, proc.rank);
+    w->uid = uid;
+    w->range = range;
+    w->keys = pmix_argv_copy(keys);
+    w->nwait = nwait;
+    w->cbfunc = cbfunc;
+    w->cbdata = cbdata;
+    park(w);
+    if (0 < timeout) {
+        tv.tv_sec = timeout;
+        pmix_event_evtimer_set(pmix_globals.evbase, &w->ev,
+                               wait_timeout, w);
+        pmix_event_evtimer_add(&w->ev, &tv);
+        w->timer_active = true;
+    }
+    pmix_output_verbose(2, pmix_server_globals.pub_output,
+                        "pmix:server pubsub lookup by %s:%u waiting for %lu of %lu keys",
+                        proc.nspace, proc.rank, (unsigned long)(nwait - nfound),
+                        (unsigned long)nkeys);
+    /* the lists hold the waiter now */
+    PMIX_RELEASE(w);
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_server_pubsub_unpublish(pmix_peer_t *peer, char **keys,
+                                           const pmix_info_t *info, size_t ninfo,
+                                           bool host_support)
+{
+    pmix_data_range_t range = PMIX_RANGE_SESSION;
+    pmix_pubsub_data_t *pd, *pdnext;
+    pmix_list_t *lst;
+    pmix_proc_t proc;
+    size_t n;
+
+    if (!pmix_server_globals.pubsub_local) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    get_directives(info, ninfo, &range, NULL, NULL, NULL, NULL);
+    PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
+
+    if (NULL != keys) {
+        for (n=0; NULL != keys[n]; n++) {
+            if (NULL == (lst = index_list(&pmix_server_globals.pubdata, keys[n], false))) {
+                continue;
+            }
+            PMIX_LIST_FOREACH_SAFE(pd, pdnext, lst, pmix_pubsub_data_t) {
+                if (match_proc(pd, &proc)) {
+                    pmix_list_remove_item(lst, &pd->super);
+                    PMIX_RELEASE(pd);
+                }
+            }
+            index_trim(&pmix_server_globals.pubdata, keys[n], lst);
+        }
+    } else {
+        /* remove everything this proc published */
+        purge(match_proc, &proc);
+    }
+
+    /* anything the host holds for us must go too */
+    if (!pmix_server_pubsub_local(range, host_support)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* return a waiter parked by the given proc */
+static pmix_pubsub_waiter_t* find_waiter(const pmix_proc_t *proc)
+{
+    pmix_list_t *lst;
+    pmix_pubsub_waitref_t *ref;
+    void *key, *node, *ptr;
+    size_t keylen;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_ptr(&pmix_server_globals.pubwaiters, &key, &keylen, &ptr, &node);
+    while (PMIX_SUCCESS == rc) {
+        lst = (pmix_list_t*)ptr;
+        PMIX_LIST_FOREACH(ref, lst, pmix_pubsub_waitref_t) {
+            if (PMIX_CHECK_PROCID(&ref->waiter->requestor, proc)) {
+                return ref->waiter;
+            }
+        }
+        rc = pmix_hash_table_get_next_key_ptr(&pmix_server_globals.pubwaiters, &key, &keylen,
+                                              &ptr, node, &node);
+    }
+    return NULL;
+}
+
+void pmix_server_pubsub_purge_peer(pmix_peer_t *peer)
+{
+    pmix_proc_t proc;
+    pmix_pubsub_waiter_t *w;
+
+    if (!pmix_server_globals.pubsub_local || NULL == peer->info) {
+        return;
+    }
+    PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
+    purge(match_proc_persist, &proc);
+
+    /* nobody is left to hear the answer to its lookups - the
+     * callbacks hold the peer, so we can still let them clean up */
+    while (NULL != (w = find_waiter(&proc))) {
+        complete_waiter(w, PMIX_ERR_LOST_CONNECTION_TO_CLIENT);
+    }
+}
+
+void pmix_server_pubsub_purge_nspace(const char *nspace)
+{
+    pmix_proc_t proc;
+
+    if (!pmix_server_globals.pubsub_local) {
+        return;
+    }
+    PMIX_LOAD_PROCID(&proc, nspace, PMIX_RANK_WILDCARD);
+    purge(match_nspace_persist, &proc);
+}
+
+void pmix_server_pubsub_finalize(void)
+{
+    index_release(&pmix_server_globals.pubwaiters);
+    index_release(&pmix_server_globals.pubdata);
+}
@@ -15,7 +15,7 @@
  * Copyright (c) 2007-2016 Los Alamos National Security, LLC.  All rights
  *                         reserved.
  * Copyright (c) 2010      Oracle and/or its affiliates.  All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -84,6 +84,9 @@ typedef struct {
 
 static pmix_proc_t myproc;
 
+static void print_opstats(pmix_info_t *info);
+static void print_srvstats(pmix_info_t *info);
+
 /******************
  * Local Functions
  ******************/
@@ -111,6 +114,8 @@ typedef struct {
     bool help;
     bool parseable;
     bool nodes;
+    bool stats;
+    bool server_stats;
     char *nspace;
     pid_t pid;
 } pmix_ps_globals_t;
@@ -148,6 +153,18 @@ pmix_cmd_line_init_t cmd_line_opts[] = {
       &pmix_ps_globals.nodes, PMIX_CMD_LINE_TYPE_BOOL,
       "Display Node Information" },
 
+    { NULL,
+      '\0', NULL, "stats",
+      0,
+      &pmix_ps_globals.stats, PMIX_CMD_LINE_TYPE_BOOL,
+      "Display the server's per-operation latency and message size histograms" },
+
+    { NULL,
+      '\0', NULL, "server-stats",
+      0,
+      &pmix_ps_globals.server_stats, PMIX_CMD_LINE_TYPE_BOOL,
+      "Display the depth of the server's queues, progress thread lag and storage use" },
+
     /* End of list */
     { NULL,
       '\0', NULL, NULL,
@@ -334,6 +351,33 @@ main(int argc, char *argv[])
     PMIX_WAIT_THREAD(&mylock.lock);
     PMIX_DESTRUCT_LOCK(&mylock.lock);
 
+    /* if we were asked for the operation or queue statistics, then get them */
+    if (pmix_ps_globals.stats || pmix_ps_globals.server_stats) {
+        nq = 1;
+        PMIX_QUERY_CREATE(query, nq);
+        PMIX_ARGV_APPEND(rc, query[0].keys, pmix_ps_globals.stats ?
+                         PMIX_QUERY_OP_STATS : PMIX_QUERY_SERVER_STATS);
+        PMIX_CONSTRUCT_LOCK(&myquery_data.lock.lock);
+        myquery_data.info = NULL;
+        myquery_data.ninfo = 0;
+        if (PMIX_SUCCESS != (rc = PMIx_Query_info_nb(query, nq, cbfunc, (void*)&myquery_data))) {
+            fprintf(stderr, "PMIx_Query_info failed: %d\n", rc);
+            goto done;
+        }
+        PMIX_WAIT_THREAD(&myquery_data.lock.lock);
+        PMIX_DESTRUCT_LOCK(&myquery_data.lock.lock);
+        if (1 != myquery_data.ninfo ||
+            PMIX_DATA_ARRAY != myquery_data.info[0].value.type) {
+            fprintf(stderr, "PMIx Query returned an incorrect number of results: %lu\n", myquery_data.ninfo);
+        } else if (pmix_ps_globals.stats) {
+            print_opstats(&myquery_data.info[0]);
+        } else {
+            print_srvstats(&myquery_data.info[0]);
+        }
+        PMIX_INFO_FREE(myquery_data.info, myquery_data.ninfo);
+        goto done;
+    }
+
     /* if we were given a specific nspace to ask about, then do so */
 
     /* if we were asked to provide the status of the nodes, then do that */
@@ -375,6 +419,164 @@ main(int argc, char *argv[])
     return rc;
 }
 
+/* estimate a percentile as the upper bound of the
+ * histogram bucket that holds it */
+static uint64_t hist_percentile(uint64_t *hist, size_t nbkts,
+                                uint64_t count, int pct)
+{
+    uint64_t target, seen = 0;
+    size_t b;
+
+    target = (count * pct + 99) / 100;
+    for (b=0; b < nbkts; b++) {
+        seen += hist[b];
+        if (seen >= target) {
+            return (0 == b) ? 0 : ((uint64_t)1 << b) - 1;
+        }
+    }
+    return 0;
+}
+
+static void print_opstats(pmix_info_t *info)
+{
+    pmix_info_t *ops, *stats;
+    pmix_data_array_t *hist = NULL;
+    uint64_t count, total, max, p50, p99;
+    size_t n, m, nops, nstats;
+    bool bytes;
+
+    ops = (pmix_info_t*)info->value.data.darray->array;
+    nops = info->value.data.darray->size;
+    if (!pmix_ps_globals.parseable) {
+        fprintf(stdout, "%-32s %10s %12s %12s %12s %12s\n",
+                "OPERATION", "COUNT", "MEAN", "P50<=", "P99<=", "MAX");
+        fprintf(stdout, "%-32s %10s %12s %12s %12s %12s\n",
+                "", "", "(usec|B)", "(usec|B)", "(usec|B)", "(usec|B)");
+    }
+    for (n=0; n < nops; n++) {
+        if (PMIX_DATA_ARRAY != ops[n].value.type) {
+            continue;
+        }
+        stats = (pmix_info_t*)ops[n].value.data.darray->array;
+        nstats = ops[n].value.data.darray->size;
+        count = total = max = 0;
+        hist = NULL;
+        for (m=0; m < nstats; m++) {
+            if (PMIX_CHECK_KEY(&stats[m], PMIX_OPSTAT_COUNT)) {
+                count = stats[m].value.data.uint64;
+            } else if (PMIX_CHECK_KEY(&stats[m], PMIX_OPSTAT_TOTAL)) {
+                total = stats[m].value.data.uint64;
+            } else if (PMIX_CHECK_KEY(&stats[m], PMIX_OPSTAT_MAX)) {
+                max = stats[m].value.data.uint64;
+            } else if (PMIX_CHECK_KEY(&stats[m], PMIX_OPSTAT_HIST)) {
+                hist = stats[m].value.data.darray;
+            }
+        }
+        if (0 == count) {
+            continue;
+        }
+        if (pmix_ps_globals.parseable) {
+            fprintf(stdout, "%s:%lu:%lu:%lu:", ops[n].key, (unsigned long)count,
+                    (unsigned long)total, (unsigned long)max);
+            for (m=0; NULL != hist && m < hist->size; m++) {
+                fprintf(stdout, "%s%lu", (0 == m) ? "" : ",",
+                        (unsigned long)((uint64_t*)hist->array)[m]);
+            }
+            fprintf(stdout, "\n");
+            continue;
+        }
+        p50 = p99 = 0;
+        if (NULL != hist) {
+            p50 = hist_percentile((uint64_t*)hist->array, hist->size, count, 50);
+            p99 = hist_percentile((uint64_t*)hist->array, hist->size, count, 99);
+        }
+        /* the ptl counters are in bytes, everything else in nsec */
+        bytes = (0 == strncmp(ops[n].key, "ptl:", 4));
+        if (bytes) {
+            fprintf(stdout, "%-32s %10lu %12.0f %12lu %12lu %12lu\n", ops[n].key,
+                    (unsigned long)count, (double)total / count,
+                    (unsigned long)p50, (unsigned long)p99, (unsigned long)max);
+        } else {
+            fprintf(stdout, "%-32s %10lu %12.3f %12.3f %12.3f %12.3f\n", ops[n].key,
+                    (unsigned long)count, (double)total / count / 1000.0,
+                    p50 / 1000.0, p99 / 1000.0, max / 1000.0);
+        }
+    }
+}
+
+static void print_srvstats(pmix_info_t *info)
+{
+    pmix_info_t *stats, *iptr;
+    size_t n, m, nstats, niptr, msgs, bytes;
+    pmix_proc_t *proc;
+    char *nspace, *module;
+
+    stats = (pmix_info_t*)info->value.data.darray->array;
+    nstats = info->value.data.darray->size;
+    /* the scalar values come first */
+    for (n=0; n < nstats; n++) {
+        if (PMIX_SIZE == stats[n].value.type) {
+            if (pmix_ps_globals.parseable) {
+                fprintf(stdout, "%s:%lu\n", stats[n].key,
+                        (unsigned long)stats[n].value.data.size);
+            } else {
+                fprintf(stdout, "%-24s %12lu\n", stats[n].key,
+                        (unsigned long)stats[n].value.data.size);
+            }
+        } else if (PMIX_UINT64 == stats[n].value.type) {
+            if (pmix_ps_globals.parseable) {
+                fprintf(stdout, "%s:%lu\n", stats[n].key,
+                        (unsigned long)stats[n].value.data.uint64);
+            } else {
+                fprintf(stdout, "%-24s %12.3f usec\n", stats[n].key,
+                        stats[n].value.data.uint64 / 1000.0);
+            }
+        }
+    }
+    /* followed by the per-client send queues and per-nspace storage */
+    for (n=0; n < nstats; n++) {
+        if (PMIX_DATA_ARRAY != stats[n].value.type) {
+            continue;
+        }
+        iptr = (pmix_info_t*)stats[n].value.data.darray->array;
+        niptr = stats[n].value.data.darray->size;
+        proc = NULL;
+        nspace = module = NULL;
+        msgs = bytes = 0;
+        for (m=0; m < niptr; m++) {
+            if (PMIX_CHECK_KEY(&iptr[m], PMIX_PROCID)) {
+                proc = iptr[m].value.data.proc;
+            } else if (PMIX_CHECK_KEY(&iptr[m], PMIX_NSPACE)) {
+                nspace = iptr[m].value.data.string;
+            } else if (PMIX_CHECK_KEY(&iptr[m], PMIX_GDS_MODULE)) {
+                module = iptr[m].value.data.string;
+            } else if (PMIX_CHECK_KEY(&iptr[m], PMIX_SRVSTAT_SEND_MSGS)) {
+                msgs = iptr[m].value.data.size;
+            } else if (PMIX_CHECK_KEY(&iptr[m], PMIX_SRVSTAT_SEND_BYTES) ||
+                       PMIX_CHECK_KEY(&iptr[m], PMIX_SRVSTAT_GDS_BYTES)) {
+                bytes = iptr[m].value.data.size;
+            }
+        }
+        if (PMIX_CHECK_KEY(&stats[n], PMIX_SRVSTAT_PEER) && NULL != proc) {
+            if (pmix_ps_globals.parseable) {
+                fprintf(stdout, "%s:%s:%u:%lu:%lu\n", stats[n].key, proc->nspace,
+                        proc->rank, (unsigned long)msgs, (unsigned long)bytes);
+            } else {
+                fprintf(stdout, "send queue %s:%u %lu msgs %lu bytes\n", proc->nspace,
+                        proc->rank, (unsigned long)msgs, (unsigned long)bytes);
+            }
+        } else if (PMIX_CHECK_KEY(&stats[n], PMIX_SRVSTAT_GDS) && NULL != nspace) {
+            if (pmix_ps_globals.parseable) {
+                fprintf(stdout, "%s:%s:%s:%lu\n", stats[n].key, nspace,
+                        (NULL == module) ? "" : module, (unsigned long)bytes);
+            } else {
+                fprintf(stdout, "storage %s (%s) %lu bytes\n", nspace,
+                        (NULL == module) ? "unknown" : module, (unsigned long)bytes);
+            }
+        }
+    }
+}
+
 #if 0
 static int pretty_print(pmix_ps_mpirun_info_t *hnpinfo) {
     char *header;
@@ -6,7 +6,7 @@
  *                         reserved.
  * Copyright (c) 2011-2014 Los Alamos National Security, LLC.  All rights
  *                         reserved.
- * Copyright (c) 2014-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2015-2018 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * Copyright (c) 2016      Mellanox Technologies, Inc.
@@ -65,6 +65,61 @@ static pmix_kval_t* lookup_keyval(pmix_list_t *data,
 static pmix_proc_data_t* lookup_proc(pmix_hash_table_t *jtable,
                                      uint64_t id, bool create);
 
+/* The key index of a table maps each stored key to the proc_data of
+ * the first rank that stored it, so fetches for PMIX_RANK_UNDEF -
+ * which PMI-1 and PMI-2 use for every get - don't search every rank */
+static pmix_status_t index_add(pmix_hash_table_t *table,
+                               pmix_proc_data_t *proc_data, const char *key)
+{
+    void *ptr;
+
+    if (NULL == table->ht_key_index) {
+        table->ht_key_index = PMIX_NEW(pmix_hash_table_t);
+        if (NULL == table->ht_key_index) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        pmix_hash_table_init(table->ht_key_index, 256);
+    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(table->ht_key_index, key,
+                                                      strlen(key), &ptr)) {
+        return PMIX_SUCCESS;
+    }
+    return pmix_hash_table_set_value_ptr(table->ht_key_index, key,
+                                         strlen(key), proc_data);
+}
+
+/* a key was removed from proc_data - if the index points at it,
+ * move the entry to another rank holding the key or drop it */
+static void index_remove(pmix_hash_table_t *table,
+                         pmix_proc_data_t *proc_data, const char *key)
+{
+    pmix_proc_data_t *pd, *holder = NULL;
+    void *ptr;
+    uint64_t id;
+    char *node;
+    int rc;
+
+    if (NULL == table->ht_key_index ||
+        PMIX_SUCCESS != pmix_hash_table_get_value_ptr(table->ht_key_index, key,
+                                                      strlen(key), &ptr) ||
+        ptr != (void*)proc_data) {
+        return;
+    }
+    rc = pmix_hash_table_get_first_key_uint64(table, &id, (void**)&pd, (void**)&node);
+    while (PMIX_SUCCESS == rc) {
+        if (NULL != pd && NULL != lookup_keyval(&pd->data, key)) {
+            holder = pd;
+            break;
+        }
+        rc = pmix_hash_table_get_next_key_uint64(table, &id, (void**)&pd, node, (void**)&node);
+    }
+    if (NULL == holder) {
+        pmix_hash_table_remove_value_ptr(table->ht_key_index, key, strlen(key));
+    } else {
+        pmix_hash_table_set_value_ptr(table->ht_key_index, key, strlen(key), holder);
+    }
+}
+
 pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                               pmix_rank_t rank, pmix_kval_t *kin)
 {
@@ -94,12 +149,14 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
         /* yes we do - so remove the current value
          * and replace it */
         pmix_list_remove_item(&proc_data->data, &hv->super);
+        table->ht_data_bytes -= pmix_hash_kval_size(hv);
         PMIX_RELEASE(hv);
     }
     PMIX_RETAIN(kin);
     pmix_list_append(&proc_data->data, &kin->super);
+    table->ht_data_bytes += pmix_hash_kval_size(kin);
 
-    return PMIX_SUCCESS;
+    return index_add(table, proc_data, kin->key);
 }
 
 pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
@@ -125,6 +182,23 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
      * - specified rank can return following statuses
      *     PMIX_ERR_PROC_ENTRY_NOT_FOUND | PMIX_ERR_NOT_FOUND | PMIX_SUCCESS
      * special logic is basing on these statuses on a client and a server */
+    if (PMIX_RANK_UNDEF == rank && NULL != key) {
+        /* every stored key is in the index */
+        if (NULL == table->ht_key_index ||
+            PMIX_SUCCESS != pmix_hash_table_get_value_ptr(table->ht_key_index, key, strlen(key),
+                                                          (void**)&proc_data) ||
+            NULL == (hv = lookup_keyval(&proc_data->data, key))) {
+            pmix_output_verbose(10, pmix_globals.debug_output,
+                                "HASH:FETCH data for key %s not found", key);
+            return PMIX_ERR_PROC_ENTRY_NOT_FOUND;
+        }
+        PMIX_BFROPS_COPY(rc, pmix_globals.mypeer,
+                         (void**)kvs, hv->value, PMIX_VALUE);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        return rc;
+    }
     if (PMIX_RANK_UNDEF == rank) {
         rc = pmix_hash_table_get_first_key_uint64(table, &id,
                 (void**)&proc_data, (void**)&node);
@@ -283,16 +357,27 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     /* if the rank is wildcard, we want to apply this to
      * all rank entries */
     if (PMIX_RANK_WILDCARD == rank) {
+        if (NULL != table->ht_key_index) {
+            if (NULL == key) {
+                pmix_hash_table_remove_all(table->ht_key_index);
+            } else {
+                pmix_hash_table_remove_value_ptr(table->ht_key_index, key, strlen(key));
+            }
+        }
         rc = pmix_hash_table_get_first_key_uint64(table, &id,
                 (void**)&proc_data, (void**)&node);
         while (PMIX_SUCCESS == rc) {
             if (NULL != proc_data) {
                 if (NULL == key) {
+                    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
+                        table->ht_data_bytes -= pmix_hash_kval_size(kv);
+                    }
                     PMIX_RELEASE(proc_data);
                 } else {
                     PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
                         if (0 == strcmp(key, kv->key)) {
                             pmix_list_remove_item(&proc_data->data, &kv->super);
+                            table->ht_data_bytes -= pmix_hash_kval_size(kv);
                             PMIX_RELEASE(kv);
                             break;
                         }
@@ -314,6 +399,8 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     /* if key is NULL, remove all data for this proc */
     if (NULL == key) {
         while (NULL != (kv = (pmix_kval_t*)pmix_list_remove_first(&proc_data->data))) {
+            table->ht_data_bytes -= pmix_hash_kval_size(kv);
+            index_remove(table, proc_data, kv->key);
             PMIX_RELEASE(kv);
         }
         /* remove the proc_data object itself from the jtable */
@@ -327,6 +414,8 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
         if (0 == strcmp(key, kv->key)) {
             pmix_list_remove_item(&proc_data->data, &kv->super);
+            table->ht_data_bytes -= pmix_hash_kval_size(kv);
+            index_remove(table, proc_data, kv->key);
             PMIX_RELEASE(kv);
             break;
         }
@@ -335,6 +424,50 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     return PMIX_SUCCESS;
 }
 
+size_t pmix_hash_kval_size(pmix_kval_t *kv)
+{
+    size_t sz;
+    pmix_value_t *val;
+
+    sz = sizeof(pmix_kval_t);
+    if (NULL != kv->key) {
+        sz += strlen(kv->key) + 1;
+    }
+    if (NULL == (val = kv->value)) {
+        return sz;
+    }
+    sz += sizeof(pmix_value_t);
+    switch (val->type) {
+        case PMIX_STRING:
+            if (NULL != val->data.string) {
+                sz += strlen(val->data.string) + 1;
+            }
+            break;
+        case PMIX_BYTE_OBJECT:
+        case PMIX_COMPRESSED_STRING:
+            sz += val->data.bo.size;
+            break;
+        case PMIX_PROC:
+            sz += sizeof(pmix_proc_t);
+            break;
+        case PMIX_DATA_ARRAY:
+            if (NULL != val->data.darray) {
+                sz += sizeof(pmix_data_array_t);
+                if (PMIX_INFO == val->data.darray->type) {
+                    sz += val->data.darray->size * sizeof(pmix_info_t);
+                } else if (PMIX_PROC == val->data.darray->type) {
+                    sz += val->data.darray->size * sizeof(pmix_proc_t);
+                } else {
+                    sz += val->data.darray->size * sizeof(pmix_value_t);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    return sz;
+}
+
 /**
  * Find data for a given key in a given pmix_list_t.
  */
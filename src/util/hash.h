@@ -1,7 +1,7 @@
 /*
  * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2012      Los Alamos National Security, Inc. All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -40,6 +40,10 @@ PMIX_EXPORT pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t
 PMIX_EXPORT pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
                                                  pmix_rank_t *rank, pmix_value_t **kvs, void **last);
 
+/* return the approximate number of bytes held by a key-value -
+ * nested data beyond the first level is not included */
+PMIX_EXPORT size_t pmix_hash_kval_size(pmix_kval_t *kv);
+
 /* remove the specified key-value from the given hash_table.
  * A NULL key will result in removal of all data for the
  * given rank. A rank of PMIX_RANK_WILDCARD indicates that
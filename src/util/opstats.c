@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/include/prefetch.h"
+#include "src/threads/threads.h"
+#include "src/threads/thread_usage.h"
+#include "src/util/opstats.h"
+
+bool pmix_opstats_enabled = true;
+
+typedef struct {
+    uint64_t count;
+    uint64_t total;
+    uint64_t max;
+    uint64_t buckets[PMIX_OPSTATS_NBUCKETS];
+} pmix_opstats_counter_t;
+
+/* one per recording thread - when the thread exits, its counts
+ * are folded into the retired block and its own block is freed */
+typedef struct pmix_opstats_block_t {
+    struct pmix_opstats_block_t *next;
+    pmix_opstats_counter_t ops[PMIX_OPSTATS_MAX];
+} pmix_opstats_block_t;
+
+static pmix_mutex_t blocks_lock = PMIX_MUTEX_STATIC_INIT;
+static pmix_opstats_block_t *blocks = NULL;
+/* the counts of the threads that have exited - also the
+ * shared block when there is no thread-local storage */
+static pmix_opstats_block_t retired;
+#if PMIX_HAVE_THREAD_LOCAL
+static pmix_thread_local pmix_opstats_block_t *myblock = NULL;
+static pthread_once_t block_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t block_key;
+static bool block_key_set = false;
+#endif
+
+static void add_counters(pmix_opstats_counter_t *dst, const pmix_opstats_counter_t *src)
+{
+    int b;
+
+    dst->count += src->count;
+    dst->total += src->total;
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+    for (b=0; b < PMIX_OPSTATS_NBUCKETS; b++) {
+        dst->buckets[b] += src->buckets[b];
+    }
+}
+
+#if PMIX_HAVE_THREAD_LOCAL
+/* called when a recording thread exits */
+static void release_block(void *arg)
+{
+    pmix_opstats_block_t *blk = (pmix_opstats_block_t*)arg, **prev;
+    int n;
+
+    /* destructors of other keys may still record */
+    myblock = NULL;
+    pmix_mutex_lock(&blocks_lock);
+    for (prev = &blocks; NULL != *prev; prev = &(*prev)->next) {
+        if (blk == *prev) {
+            *prev = blk->next;
+            break;
+        }
+    }
+    for (n=0; n < PMIX_OPSTATS_MAX; n++) {
+        add_counters(&retired.ops[n], &blk->ops[n]);
+    }
+    pmix_mutex_unlock(&blocks_lock);
+    free(blk);
+}
+
+static void create_block_key(void)
+{
+    block_key_set = (0 == pthread_key_create(&block_key, release_block));
+}
+
+static pmix_opstats_block_t* get_block(void)
+{
+    pmix_opstats_block_t *blk;
+
+    pthread_once(&block_key_once, create_block_key);
+    if (!block_key_set) {
+        return NULL;
+    }
+    blk = (pmix_opstats_block_t*)calloc(1, sizeof(pmix_opstats_block_t));
+    if (NULL == blk) {
+        return NULL;
+    }
+    if (0 != pthread_setspecific(block_key, blk)) {
+        free(blk);
+        return NULL;
+    }
+    pmix_mutex_lock(&blocks_lock);
+    blk->next = blocks;
+    blocks = blk;
+    pmix_mutex_unlock(&blocks_lock);
+    return blk;
+}
+#endif
+
+static inline int get_bucket(uint64_t value)
+{
+    int b;
+
+    if (0 == value) {
+        return 0;
+    }
+#if defined(__GNUC__)
+    b = 64 - __builtin_clzll(value);
+#else
+    for (b=0; 0 != value; b++) {
+        value >>= 1;
+    }
+#endif
+    return (b < PMIX_OPSTATS_NBUCKETS) ? b : PMIX_OPSTATS_NBUCKETS - 1;
+}
+
+static inline void add_value(pmix_opstats_counter_t *c, uint64_t value)
+{
+    c->count++;
+    c->total += value;
+    if (value > c->max) {
+        c->max = value;
+    }
+    c->buckets[get_bucket(value)]++;
+}
+
+void pmix_opstats_record(int op, uint64_t value)
+{
+    if (op < 0 || PMIX_OPSTATS_MAX <= op) {
+        return;
+    }
+#if PMIX_HAVE_THREAD_LOCAL
+    if (PMIX_UNLIKELY(NULL == myblock)) {
+        if (NULL == (myblock = get_block())) {
+            return;
+        }
+    }
+    add_value(&myblock->ops[op], value);
+#else
+    /* no thread-local storage - share a single block */
+    pmix_mutex_lock(&blocks_lock);
+    add_value(&retired.ops[op], value);
+    pmix_mutex_unlock(&blocks_lock);
+#endif
+}
+
+static void op_name(int op, char *name, size_t len)
+{
+    switch (op) {
+        case PMIX_OPSTATS_CLIENT_GET:
+            strncpy(name, "client:PMIx_Get", len);
+            break;
+        case PMIX_OPSTATS_CLIENT_PUT:
+            strncpy(name, "client:PMIx_Put", len);
+            break;
+        case PMIX_OPSTATS_CLIENT_COMMIT:
+            strncpy(name, "client:PMIx_Commit", len);
+            break;
+        case PMIX_OPSTATS_CLIENT_FENCE:
+            strncpy(name, "client:PMIx_Fence", len);
+            break;
+        case PMIX_OPSTATS_CLIENT_CONNECT:
+            strncpy(name, "client:PMIx_Connect", len);
+            break;
+        case PMIX_OPSTATS_GDS_FETCH:
+            strncpy(name, "gds:fetch", len);
+            break;
+        case PMIX_OPSTATS_GDS_STORE:
+            strncpy(name, "gds:store", len);
+            break;
+        case PMIX_OPSTATS_PTL_SEND:
+            strncpy(name, "ptl:send_bytes", len);
+            break;
+        case PMIX_OPSTATS_PTL_RECV:
+            strncpy(name, "ptl:recv_bytes", len);
+            break;
+        default:
+            snprintf(name, len, "server:%s", pmix_command_string((pmix_cmd_t)op));
+            break;
+    }
+    name[len-1] = '\0';
+}
+
+pmix_kval_t* pmix_opstats_report(void)
+{
+    pmix_opstats_counter_t *sum;
+    pmix_opstats_block_t *blk;
+    pmix_kval_t *kv;
+    pmix_info_t *iptr, *stats;
+    pmix_data_array_t *darray;
+    uint64_t *hist;
+    char name[PMIX_MAX_KEYLEN+1];
+    size_t n, nops, nbkts;
+
+    sum = (pmix_opstats_counter_t*)calloc(PMIX_OPSTATS_MAX, sizeof(pmix_opstats_counter_t));
+    if (NULL == sum) {
+        return NULL;
+    }
+    /* the owning threads may be updating their blocks while we
+     * read them - the result is a snapshot, not an atomic one */
+    pmix_mutex_lock(&blocks_lock);
+    for (n=0; n < PMIX_OPSTATS_MAX; n++) {
+        sum[n] = retired.ops[n];
+    }
+    for (blk = blocks; NULL != blk; blk = blk->next) {
+        for (n=0; n < PMIX_OPSTATS_MAX; n++) {
+            add_counters(&sum[n], &blk->ops[n]);
+        }
+    }
+    pmix_mutex_unlock(&blocks_lock);
+
+    nops = 0;
+    for (n=0; n < PMIX_OPSTATS_MAX; n++) {
+        if (0 < sum[n].count) {
+            ++nops;
+        }
+    }
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        free(sum);
+        return NULL;
+    }
+    kv->key = strdup(PMIX_QUERY_OP_STATS);
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        free(sum);
+        return NULL;
+    }
+    kv->value->type = PMIX_DATA_ARRAY;
+    PMIX_DATA_ARRAY_CREATE(kv->value->data.darray, nops, PMIX_INFO);
+    if (NULL == kv->value->data.darray) {
+        PMIX_RELEASE(kv);
+        free(sum);
+        return NULL;
+    }
+    iptr = (pmix_info_t*)kv->value->data.darray->array;
+    for (n=0; n < PMIX_OPSTATS_MAX; n++) {
+        if (0 == sum[n].count) {
+            continue;
+        }
+        op_name(n, name, sizeof(name));
+        PMIX_LOAD_KEY(iptr->key, name);
+        iptr->value.type = PMIX_DATA_ARRAY;
+        PMIX_DATA_ARRAY_CREATE(iptr->value.data.darray, 4, PMIX_INFO);
+        stats = (pmix_info_t*)iptr->value.data.darray->array;
+        PMIX_INFO_LOAD(&stats[0], PMIX_OPSTAT_COUNT, &sum[n].count, PMIX_UINT64);
+        PMIX_INFO_LOAD(&stats[1], PMIX_OPSTAT_TOTAL, &sum[n].total, PMIX_UINT64);
+        PMIX_INFO_LOAD(&stats[2], PMIX_OPSTAT_MAX, &sum[n].max, PMIX_UINT64);
+        /* trim the histogram at the highest occupied bucket */
+        for (nbkts = PMIX_OPSTATS_NBUCKETS; 0 < nbkts && 0 == sum[n].buckets[nbkts-1]; nbkts--);
+        PMIX_DATA_ARRAY_CREATE(darray, nbkts, PMIX_UINT64);
+        hist = (uint64_t*)darray->array;
+        memcpy(hist, sum[n].buckets, nbkts * sizeof(uint64_t));
+        PMIX_LOAD_KEY(stats[3].key, PMIX_OPSTAT_HIST);
+        stats[3].value.type = PMIX_DATA_ARRAY;
+        stats[3].value.data.darray = darray;
+        ++iptr;
+    }
+    free(sum);
+    return kv;
+}
+
+pmix_kval_t* pmix_opstats_alloc_report(void)
+{
+    pmix_obj_cache_stats_t st;
+    pmix_kval_t *kv;
+    pmix_info_t *iptr, *stats;
+    size_t n, ncls;
+
+    for (ncls=0; PMIX_SUCCESS == pmix_obj_cache_stats(ncls, &st); ncls++);
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return NULL;
+    }
+    kv->key = strdup(PMIX_QUERY_ALLOC_STATS);
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return NULL;
+    }
+    kv->value->type = PMIX_DATA_ARRAY;
+    PMIX_DATA_ARRAY_CREATE(kv->value->data.darray, ncls, PMIX_INFO);
+    if (NULL == kv->value->data.darray) {
+        PMIX_RELEASE(kv);
+        return NULL;
+    }
+    iptr = (pmix_info_t*)kv->value->data.darray->array;
+    /* classes are only ever added, so we can't run past the end */
+    for (n=0; n < ncls && PMIX_SUCCESS == pmix_obj_cache_stats(n, &st); n++) {
+        PMIX_LOAD_KEY(iptr[n].key, st.name);
+        iptr[n].value.type = PMIX_DATA_ARRAY;
+        PMIX_DATA_ARRAY_CREATE(iptr[n].value.data.darray, 5, PMIX_INFO);
+        stats = (pmix_info_t*)iptr[n].value.data.darray->array;
+        PMIX_INFO_LOAD(&stats[0], PMIX_ALLOCSTAT_NEW, &st.news, PMIX_UINT64);
+        PMIX_INFO_LOAD(&stats[1], PMIX_ALLOCSTAT_MALLOC, &st.mallocs, PMIX_UINT64);
+        PMIX_INFO_LOAD(&stats[2], PMIX_ALLOCSTAT_FREE, &st.frees, PMIX_UINT64);
+        PMIX_INFO_LOAD(&stats[3], PMIX_ALLOCSTAT_CACHED, &st.cached, PMIX_SIZE);
+        PMIX_INFO_LOAD(&stats[4], PMIX_ALLOCSTAT_PEAK, &st.peak, PMIX_SIZE);
+    }
+    return kv;
+}
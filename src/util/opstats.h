@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Always-available operation statistics. Each instrumented operation
+ * keeps a count, a total, a maximum and a log2-bucketed histogram of
+ * its values - nanoseconds for timed operations and bytes for the
+ * message counters. Every thread records into its own block of
+ * counters, so recording takes no locks and no atomics; readers sum
+ * the blocks of all threads. Recording can be switched off at runtime
+ * with the pmix_opstats_enable MCA param.
+ */
+
+#ifndef PMIX_UTIL_OPSTATS_H
+#define PMIX_UTIL_OPSTATS_H
+
+#include <src/include/pmix_config.h>
+
+#include <stdint.h>
+#include <time.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include <pmix_common.h>
+#include "src/mca/bfrops/bfrops_types.h"
+
+BEGIN_C_DECLS
+
+/* server commands are recorded at their pmix_cmd_t value */
+#define PMIX_OPSTATS_MAX_CMDS   32
+
+typedef enum {
+    PMIX_OPSTATS_CLIENT_GET = PMIX_OPSTATS_MAX_CMDS,
+    PMIX_OPSTATS_CLIENT_PUT,
+    PMIX_OPSTATS_CLIENT_COMMIT,
+    PMIX_OPSTATS_CLIENT_FENCE,
+    PMIX_OPSTATS_CLIENT_CONNECT,
+    PMIX_OPSTATS_GDS_FETCH,
+    PMIX_OPSTATS_GDS_STORE,
+    PMIX_OPSTATS_PTL_SEND,
+    PMIX_OPSTATS_PTL_RECV,
+    PMIX_OPSTATS_MAX
+} pmix_opstats_op_t;
+
+/* bucket 0 holds zero, bucket i holds [2^(i-1), 2^i) and the
+ * last bucket holds everything larger */
+#define PMIX_OPSTATS_NBUCKETS   40
+
+PMIX_EXPORT extern bool pmix_opstats_enabled;
+
+static inline uint64_t pmix_opstats_now(void)
+{
+#if PMIX_HAVE_CLOCK_GETTIME
+    struct timespec tp;
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (uint64_t)tp.tv_sec * 1000000000ULL + (uint64_t)tp.tv_nsec;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000000ULL + (uint64_t)tv.tv_usec * 1000ULL;
+#endif
+}
+
+/* add a value to the calling thread's counters for an operation */
+PMIX_EXPORT void pmix_opstats_record(int op, uint64_t value);
+
+/* return the summed statistics of all threads as a pmix_kval_t
+ * keyed on PMIX_QUERY_OP_STATS, or NULL on error */
+PMIX_EXPORT pmix_kval_t* pmix_opstats_report(void);
+
+/* return the allocation counters of the cached object classes as a
+ * pmix_kval_t keyed on PMIX_QUERY_ALLOC_STATS, or NULL on error */
+PMIX_EXPORT pmix_kval_t* pmix_opstats_alloc_report(void);
+
+/* start a timer - t must be a uint64_t */
+#define PMIX_OPSTATS_START(t)                                       \
+    (t) = pmix_opstats_enabled ? pmix_opstats_now() : 0
+
+/* stop a timer and record the elapsed time against op */
+#define PMIX_OPSTATS_STOP(op, t)                                    \
+    do {                                                            \
+        if (0 != (t)) {                                             \
+            pmix_opstats_record((op), pmix_opstats_now() - (t));    \
+        }                                                           \
+    } while(0)
+
+/* record a byte count against op */
+#define PMIX_OPSTATS_BYTES(op, n)                                   \
+    do {                                                            \
+        if (pmix_opstats_enabled) {                                 \
+            pmix_opstats_record((op), (uint64_t)(n));               \
+        }                                                           \
+    } while(0)
+
+END_C_DECLS
+
+#endif
@@ -0,0 +1,808 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Intra-node performance suite. In its default mode this sweeps the
+ * requested configurations, running each of them under the pmix_test
+ * server with this same binary as the client. Every client times its
+ * PMIx operations and the samples from all of them are reduced to
+ * percentiles, e.g.:
+ *
+ *     ./pmix_perf -n 2,8 -c 10,100 -s 64,4096 -g hash,ds12,ds21 -o base.json
+ *     ./pmix_perf -n 2,8 -c 10,100 -s 64,4096 -g hash,ds12,ds21 -o new.json
+ *     ./pmix_perf --compare base.json new.json
+ *
+ * The compare mode exits with a non-zero status if the median of any
+ * operation got slower by more than the threshold.
+ *
+ * Each client also reports how many objects of the recycled classes
+ * it created and how many of those had to be malloc'd. Running with
+ * PMIX_MCA_pmix_obj_cache_size=0 gives the numbers without recycling.
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <dirent.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+static inline double get_ts(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1E-9 * ts.tv_nsec;
+}
+
+/* the measured operations */
+enum {
+    OP_INIT,
+    OP_PUT,
+    OP_COMMIT,
+    OP_FENCE,
+    OP_GET_LOCAL,
+    OP_GET_REMOTE,
+    OP_FINALIZE,
+    OP_RSS,
+    OP_PSS,
+    OP_OBJ_NEW,
+    OP_OBJ_MALLOC,
+    OP_MAX
+};
+
+static const char *op_names[OP_MAX] = {
+    "init", "put", "commit", "fence", "get_local", "get_remote",
+    "finalize", "rss", "pss", "obj_new", "obj_malloc"
+};
+
+static const char *op_units[OP_MAX] = {
+    "usec", "usec", "usec", "usec", "usec", "usec",
+    "usec", "kB", "kB", "count", "count"
+};
+
+typedef struct {
+    double *vals;
+    size_t n;
+    size_t size;
+} samples_t;
+
+static void add_sample(samples_t *s, double val)
+{
+    if (s->n == s->size) {
+        s->size = (0 == s->size) ? 64 : 2 * s->size;
+        s->vals = (double*)realloc(s->vals, s->size * sizeof(double));
+    }
+    s->vals[s->n++] = val;
+}
+
+/****    CLIENT    ****/
+
+static int get_mem_usage(double *pss, double *rss)
+{
+    FILE *smaps;
+    char line[256];
+    double val;
+
+    *pss = 0.0;
+    *rss = 0.0;
+    if (NULL == (smaps = fopen("/proc/self/smaps", "r"))) {
+        return -1;
+    }
+    while (NULL != fgets(line, sizeof(line), smaps)) {
+        if (1 == sscanf(line, "Pss: %lf", &val)) {
+            *pss += val;
+        } else if (1 == sscanf(line, "Rss: %lf", &val)) {
+            *rss += val;
+        }
+    }
+    fclose(smaps);
+    return 0;
+}
+
+typedef struct {
+    volatile bool active;
+    double news;
+    double mallocs;
+} obj_counts_t;
+
+static void obj_counts_cb(pmix_status_t status, pmix_info_t *info, size_t ninfo,
+                          void *cbdata, pmix_release_cbfunc_t release_fn,
+                          void *release_cbdata)
+{
+    obj_counts_t *cnt = (obj_counts_t*)cbdata;
+    pmix_info_t *cls, *st;
+    size_t n, m;
+
+    if (PMIX_SUCCESS == status && 0 < ninfo && PMIX_DATA_ARRAY == info[0].value.type) {
+        cls = (pmix_info_t*)info[0].value.data.darray->array;
+        for (n=0; n < info[0].value.data.darray->size; n++) {
+            st = (pmix_info_t*)cls[n].value.data.darray->array;
+            for (m=0; m < cls[n].value.data.darray->size; m++) {
+                if (PMIX_CHECK_KEY(&st[m], PMIX_ALLOCSTAT_NEW)) {
+                    cnt->news += st[m].value.data.uint64;
+                } else if (PMIX_CHECK_KEY(&st[m], PMIX_ALLOCSTAT_MALLOC)) {
+                    cnt->mallocs += st[m].value.data.uint64;
+                }
+            }
+        }
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    cnt->active = false;
+}
+
+/* sum the object counters of our own recycled classes */
+static void get_obj_counts(double *news, double *mallocs)
+{
+    pmix_query_t *query;
+    obj_counts_t cnt;
+    pmix_status_t rc;
+    bool local = true;
+
+    memset(&cnt, 0, sizeof(cnt));
+    cnt.active = true;
+    PMIX_QUERY_CREATE(query, 1);
+    PMIX_ARGV_APPEND(rc, query[0].keys, PMIX_QUERY_ALLOC_STATS);
+    PMIX_INFO_CREATE(query[0].qualifiers, 1);
+    query[0].nqual = 1;
+    PMIX_INFO_LOAD(&query[0].qualifiers[0], PMIX_QUERY_LOCAL_ONLY, &local, PMIX_BOOL);
+    if (PMIX_SUCCESS == (rc = PMIx_Query_info_nb(query, 1, obj_counts_cb, &cnt))) {
+        while (cnt.active) {
+            usleep(10);
+        }
+    }
+    PMIX_QUERY_FREE(query, 1);
+    *news = cnt.news;
+    *mallocs = cnt.mallocs;
+}
+
+static int run_client(const char *outdir, int nkeys, int ksize, int nreps, bool dmodex)
+{
+    pmix_proc_t myproc, proc;
+    pmix_value_t val, *vp;
+    pmix_info_t info;
+    pmix_status_t rc;
+    samples_t samples[OP_MAX];
+    pmix_key_t key;
+    char path[PATH_MAX], *tok, *save;
+    bool *local, collect = !dmodex;
+    uint32_t nprocs;
+    double start, pss, rss, news, mallocs;
+    int n, k, rep;
+    FILE *fp;
+
+    memset(samples, 0, sizeof(samples));
+
+    start = get_ts();
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    add_sample(&samples[OP_INIT], 1.0e6 * (get_ts() - start));
+
+    /* find out who is local to us */
+    PMIX_PROC_CONSTRUCT(&proc);
+    PMIX_LOAD_NSPACE(proc.nspace, myproc.nspace);
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &vp))) {
+        fprintf(stderr, "Rank %d: cannot get the job size: %s\n", myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    nprocs = vp->data.uint32;
+    PMIX_VALUE_RELEASE(vp);
+    local = (bool*)calloc(nprocs, sizeof(bool));
+    if (PMIX_SUCCESS == PMIx_Get(&proc, PMIX_LOCAL_PEERS, NULL, 0, &vp)) {
+        for (tok = strtok_r(vp->data.string, ",", &save); NULL != tok;
+             tok = strtok_r(NULL, ",", &save)) {
+            n = strtol(tok, NULL, 10);
+            if (0 <= n && (uint32_t)n < nprocs) {
+                local[n] = true;
+            }
+        }
+        PMIX_VALUE_RELEASE(vp);
+    }
+
+    val.type = PMIX_BYTE_OBJECT;
+    val.data.bo.size = ksize;
+    val.data.bo.bytes = (char*)malloc(ksize);
+    memset(val.data.bo.bytes, myproc.rank & 0xff, ksize);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &collect, PMIX_BOOL);
+
+    for (rep=0; rep < nreps; rep++) {
+        for (k=0; k < nkeys; k++) {
+            snprintf(key, sizeof(key), "perf-key-%d", k);
+            start = get_ts();
+            rc = PMIx_Put(PMIX_GLOBAL, key, &val);
+            add_sample(&samples[OP_PUT], 1.0e6 * (get_ts() - start));
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stderr, "Rank %d: put failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+                goto done;
+            }
+        }
+        start = get_ts();
+        rc = PMIx_Commit();
+        add_sample(&samples[OP_COMMIT], 1.0e6 * (get_ts() - start));
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Rank %d: commit failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+        start = get_ts();
+        rc = PMIx_Fence(NULL, 0, &info, 1);
+        add_sample(&samples[OP_FENCE], 1.0e6 * (get_ts() - start));
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Rank %d: fence failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+        for (n=0; (uint32_t)n < nprocs; n++) {
+            if ((pmix_rank_t)n == myproc.rank) {
+                continue;
+            }
+            proc.rank = n;
+            for (k=0; k < nkeys; k++) {
+                snprintf(key, sizeof(key), "perf-key-%d", k);
+                start = get_ts();
+                rc = PMIx_Get(&proc, key, NULL, 0, &vp);
+                add_sample(&samples[local[n] ? OP_GET_LOCAL : OP_GET_REMOTE],
+                           1.0e6 * (get_ts() - start));
+                if (PMIX_SUCCESS != rc) {
+                    fprintf(stderr, "Rank %d: get of %s from %d failed: %s\n",
+                            myproc.rank, key, n, PMIx_Error_string(rc));
+                    goto done;
+                }
+                PMIX_VALUE_RELEASE(vp);
+            }
+        }
+    }
+    free(val.data.bo.bytes);
+    free(local);
+
+    if (0 == get_mem_usage(&pss, &rss)) {
+        add_sample(&samples[OP_RSS], rss);
+        add_sample(&samples[OP_PSS], pss);
+    }
+    get_obj_counts(&news, &mallocs);
+    if (0 < news) {
+        add_sample(&samples[OP_OBJ_NEW], news);
+        add_sample(&samples[OP_OBJ_MALLOC], mallocs);
+    }
+
+    /* nobody leaves while someone may still be reading their data */
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+        fprintf(stderr, "Rank %d: fence failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+
+  done:
+    start = get_ts();
+    PMIx_Finalize(NULL, 0);
+    add_sample(&samples[OP_FINALIZE], 1.0e6 * (get_ts() - start));
+    if (PMIX_SUCCESS != rc) {
+        return 1;
+    }
+
+    snprintf(path, sizeof(path), "%s/rank.%d", outdir, myproc.rank);
+    if (NULL == (fp = fopen(path, "w"))) {
+        return 1;
+    }
+    for (n=0; n < OP_MAX; n++) {
+        for (k=0; (size_t)k < samples[n].n; k++) {
+            fprintf(fp, "%d %.3f\n", n, samples[n].vals[k]);
+        }
+        free(samples[n].vals);
+    }
+    fclose(fp);
+    return 0;
+}
+
+/****    DRIVER    ****/
+
+/* longest string field read back from a results file */
+#define PERF_FIELD_LEN  64
+
+typedef struct {
+    int procs;
+    int keys;
+    int key_size;
+    char gds[PERF_FIELD_LEN];
+    char ptl[PERF_FIELD_LEN];
+    int dmodex;
+    char op[PERF_FIELD_LEN];
+    char unit[PERF_FIELD_LEN];
+    size_t samples;
+    double mean;
+    double min;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+} record_t;
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/* nearest-rank percentile of sorted samples */
+static double percentile(samples_t *s, double q)
+{
+    double pos = q * (double)s->n;
+    size_t idx = (size_t)pos;
+
+    if ((double)idx < pos) {
+        ++idx;
+    }
+
+    return s->vals[(0 < idx) ? idx - 1 : 0];
+}
+
+static void print_record(FILE *fp, const char *format, record_t *r, bool first)
+{
+    if (0 == strcmp(format, "csv")) {
+        fprintf(fp, "%d,%d,%d,%s,%s,%d,%s,%s,%lu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                r->procs, r->keys, r->key_size, r->gds, r->ptl, r->dmodex, r->op, r->unit,
+                (unsigned long)r->samples, r->mean, r->min, r->p50, r->p90, r->p99, r->max);
+        return;
+    }
+    fprintf(fp, "%s  {\"procs\": %d, \"keys\": %d, \"key_size\": %d, \"gds\": \"%s\", "
+            "\"ptl\": \"%s\", \"dmodex\": %d, \"op\": \"%s\", \"unit\": \"%s\", "
+            "\"samples\": %lu, \"mean\": %.3f, \"min\": %.3f, \"p50\": %.3f, "
+            "\"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}",
+            first ? "" : ",\n", r->procs, r->keys, r->key_size, r->gds, r->ptl, r->dmodex,
+            r->op, r->unit, (unsigned long)r->samples, r->mean, r->min, r->p50, r->p90,
+            r->p99, r->max);
+}
+
+static char** split(const char *list)
+{
+    char **out = NULL, *copy = strdup(list), *tok, *save;
+    int n = 0;
+
+    for (tok = strtok_r(copy, ",", &save); NULL != tok; tok = strtok_r(NULL, ",", &save)) {
+        out = (char**)realloc(out, (n + 2) * sizeof(char*));
+        out[n++] = strdup(tok);
+        out[n] = NULL;
+    }
+    free(copy);
+    return out;
+}
+
+static void free_list(char **list)
+{
+    int n;
+
+    for (n=0; NULL != list && NULL != list[n]; n++) {
+        free(list[n]);
+    }
+    free(list);
+}
+
+/* run a single configuration under pmix_test and collect the
+ * samples written by each client */
+static int run_config(const char *launcher, const char *self, int procs, int keys,
+                      int ksize, const char *gds, const char *ptl, int nreps,
+                      bool dmodex, int timeout, samples_t *samples)
+{
+    char dir[] = "/tmp/pmix_perf-XXXXXX";
+    char path[PATH_MAX], np[16], tout[16], *cargs, *argv[12], *env;
+    struct dirent *ent;
+    DIR *dp;
+    FILE *fp;
+    double val;
+    int n, op, status, nranks = 0;
+    pid_t pid;
+
+    if (NULL == mkdtemp(dir)) {
+        return -1;
+    }
+    snprintf(np, sizeof(np), "%d", procs);
+    snprintf(tout, sizeof(tout), "%d", timeout);
+    if (0 > asprintf(&cargs, "--perf-client %s %d %d %d %d", dir, keys, ksize, nreps, dmodex)) {
+        return -1;
+    }
+    n = 0;
+    argv[n++] = (char*)launcher;
+    argv[n++] = "-n";
+    argv[n++] = np;
+    argv[n++] = "-t";
+    argv[n++] = tout;
+    argv[n++] = "-e";
+    argv[n++] = (char*)self;
+    argv[n++] = "--client-args";
+    argv[n++] = cargs;
+    argv[n] = NULL;
+
+    /* don't let the child inherit unwritten results */
+    fflush(NULL);
+    pid = fork();
+    if (pid < 0) {
+        free(cargs);
+        return -1;
+    }
+    if (0 == pid) {
+        /* the clients inherit this environment */
+        if (0 == strcmp(gds, "hash")) {
+            setenv("PMIX_MCA_gds", "hash", 1);
+        } else if (0 < asprintf(&env, "%s,hash", gds)) {
+            setenv("PMIX_MCA_gds", env, 1);
+        }
+        if (0 != strcmp(ptl, "default")) {
+            setenv("PMIX_MCA_ptl", ptl, 1);
+        }
+        if (NULL == freopen("/dev/null", "w", stdout)) {
+            _exit(1);
+        }
+        execv(launcher, argv);
+        _exit(127);
+    }
+    free(cargs);
+    waitpid(pid, &status, 0);
+
+    /* pick up whatever the clients left for us */
+    if (NULL != (dp = opendir(dir))) {
+        while (NULL != (ent = readdir(dp))) {
+            if (0 != strncmp(ent->d_name, "rank.", 5)) {
+                continue;
+            }
+            snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+            if (NULL != (fp = fopen(path, "r"))) {
+                while (2 == fscanf(fp, "%d %lf", &op, &val)) {
+                    if (0 <= op && op < OP_MAX) {
+                        add_sample(&samples[op], val);
+                    }
+                }
+                fclose(fp);
+                ++nranks;
+            }
+            unlink(path);
+        }
+        closedir(dp);
+    }
+    rmdir(dir);
+
+    if (!WIFEXITED(status) || 0 != WEXITSTATUS(status) || nranks != procs) {
+        return -1;
+    }
+    return 0;
+}
+
+/* pull a field out of one line of our own json output */
+static bool json_field(const char *line, const char *name, char *out, size_t len)
+{
+    char pattern[64];
+    const char *p, *end;
+
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", name);
+    if (NULL == (p = strstr(line, pattern))) {
+        return false;
+    }
+    p += strlen(pattern);
+    if ('"' == *p) {
+        ++p;
+        end = strchr(p, '"');
+    } else {
+        end = p + strcspn(p, ",}");
+    }
+    if (NULL == end || (size_t)(end - p) >= len) {
+        return false;
+    }
+    memcpy(out, p, end - p);
+    out[end - p] = '\0';
+    return true;
+}
+
+static int load_results(const char *file, record_t **records)
+{
+    FILE *fp;
+    char line[1024], buf[PERF_FIELD_LEN], *fields[15], *save;
+    record_t r;
+    int n, nrecs = 0;
+
+    if (NULL == (fp = fopen(file, "r"))) {
+        fprintf(stderr, "Cannot open %s: %s\n", file, strerror(errno));
+        return -1;
+    }
+    *records = NULL;
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        memset(&r, 0, sizeof(r));
+        if (NULL != strchr(line, '{')) {
+#define GETF(name) (json_field(line, name, buf, sizeof(buf)) ? buf : "0")
+            r.procs = strtol(GETF("procs"), NULL, 10);
+            r.keys = strtol(GETF("keys"), NULL, 10);
+            r.key_size = strtol(GETF("key_size"), NULL, 10);
+            snprintf(r.gds, sizeof(r.gds), "%s", GETF("gds"));
+            snprintf(r.ptl, sizeof(r.ptl), "%s", GETF("ptl"));
+            r.dmodex = strtol(GETF("dmodex"), NULL, 10);
+            snprintf(r.op, sizeof(r.op), "%s", GETF("op"));
+            snprintf(r.unit, sizeof(r.unit), "%s", GETF("unit"));
+            r.samples = strtoul(GETF("samples"), NULL, 10);
+            r.mean = strtod(GETF("mean"), NULL);
+            r.min = strtod(GETF("min"), NULL);
+            r.p50 = strtod(GETF("p50"), NULL);
+            r.p90 = strtod(GETF("p90"), NULL);
+            r.p99 = strtod(GETF("p99"), NULL);
+            r.max = strtod(GETF("max"), NULL);
+#undef GETF
+        } else if (0 != isdigit((unsigned char)line[0])) {
+            /* csv - the header line is skipped */
+            fields[0] = strtok_r(line, ",\n", &save);
+            for (n=1; n < 15 && NULL != fields[n-1]; n++) {
+                fields[n] = strtok_r(NULL, ",\n", &save);
+            }
+            if (n < 15 || NULL == fields[14]) {
+                continue;
+            }
+            r.procs = strtol(fields[0], NULL, 10);
+            r.keys = strtol(fields[1], NULL, 10);
+            r.key_size = strtol(fields[2], NULL, 10);
+            snprintf(r.gds, sizeof(r.gds), "%s", fields[3]);
+            snprintf(r.ptl, sizeof(r.ptl), "%s", fields[4]);
+            r.dmodex = strtol(fields[5], NULL, 10);
+            snprintf(r.op, sizeof(r.op), "%s", fields[6]);
+            snprintf(r.unit, sizeof(r.unit), "%s", fields[7]);
+            r.samples = strtoul(fields[8], NULL, 10);
+            r.mean = strtod(fields[9], NULL);
+            r.min = strtod(fields[10], NULL);
+            r.p50 = strtod(fields[11], NULL);
+            r.p90 = strtod(fields[12], NULL);
+            r.p99 = strtod(fields[13], NULL);
+            r.max = strtod(fields[14], NULL);
+        } else {
+            continue;
+        }
+        *records = (record_t*)realloc(*records, (nrecs + 1) * sizeof(record_t));
+        (*records)[nrecs++] = r;
+    }
+    fclose(fp);
+    return nrecs;
+}
+
+static double delta(double base, double now)
+{
+    return (0 < base) ? 100.0 * (now - base) / base : 0;
+}
+
+static int compare(const char *basefile, const char *newfile, double threshold)
+{
+    record_t *base, *cur, *b, *r;
+    int nbase, ncur, n, m, nregress = 0, nmatched = 0;
+    char cfg[2 * PERF_FIELD_LEN + 64];
+
+    if (0 > (nbase = load_results(basefile, &base)) ||
+        0 > (ncur = load_results(newfile, &cur))) {
+        return 2;
+    }
+    fprintf(stdout, "%-40s %-10s %12s %12s %8s %12s %12s %8s\n", "configuration", "op",
+            "base p50", "new p50", "delta", "base p99", "new p99", "delta");
+    for (n=0; n < ncur; n++) {
+        r = &cur[n];
+        b = NULL;
+        for (m=0; m < nbase; m++) {
+            if (base[m].procs == r->procs && base[m].keys == r->keys &&
+                base[m].key_size == r->key_size && base[m].dmodex == r->dmodex &&
+                0 == strcmp(base[m].gds, r->gds) && 0 == strcmp(base[m].ptl, r->ptl) &&
+                0 == strcmp(base[m].op, r->op)) {
+                b = &base[m];
+                break;
+            }
+        }
+        if (NULL == b) {
+            continue;
+        }
+        ++nmatched;
+        snprintf(cfg, sizeof(cfg), "n=%d c=%d s=%d %s/%s%s", r->procs, r->keys, r->key_size,
+                 r->gds, r->ptl, r->dmodex ? " dmodex" : "");
+        fprintf(stdout, "%-40s %-10s %12.3f %12.3f %7.1f%% %12.3f %12.3f %7.1f%%%s\n",
+                cfg, r->op, b->p50, r->p50, delta(b->p50, r->p50),
+                b->p99, r->p99, delta(b->p99, r->p99),
+                (delta(b->p50, r->p50) > threshold) ? "  REGRESSION" : "");
+        if (delta(b->p50, r->p50) > threshold) {
+            ++nregress;
+        }
+    }
+    fprintf(stdout, "%d of %d results matched, %d regressed by more than %.1f%%\n",
+            nmatched, ncur, nregress, threshold);
+    free(base);
+    free(cur);
+    return (0 < nregress) ? 1 : 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [options]\n", prog);
+    fprintf(stderr, "       %s --compare <base> <new> [--threshold <pct>]\n", prog);
+    fprintf(stderr, "    -n <list>   Numbers of local procs (default: 2,4)\n");
+    fprintf(stderr, "    -c <list>   Numbers of keys each proc puts (default: 10)\n");
+    fprintf(stderr, "    -s <list>   Key sizes in bytes (default: 100)\n");
+    fprintf(stderr, "    -g <list>   gds components (default: hash,ds12,ds21)\n");
+    fprintf(stderr, "    -p <list>   ptl components, or \"default\" (default: default)\n");
+    fprintf(stderr, "    -r <n>      Put/commit/fence/get rounds per run (default: 3)\n");
+    fprintf(stderr, "    -d          Don't collect data in the fence - use direct modex\n");
+    fprintf(stderr, "    -f <fmt>    Output format: json or csv (default: json)\n");
+    fprintf(stderr, "    -o <file>   Write the results to file (default: stdout)\n");
+    fprintf(stderr, "    -t <sec>    Timeout for each run (default: 120)\n");
+    fprintf(stderr, "    -x <path>   Path to the pmix_test server (default: next to us)\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    char *nlist = "2,4", *clist = "10", *slist = "100", *glist = "hash,ds12,ds21";
+    char *plist = "default", *format = "json", *outfile = NULL, *launcher = NULL;
+    char **procs, **keys, **sizes, **gds, **ptls, *self, *dir, path[PATH_MAX];
+    int nreps = 3, timeout = 120, n, ip, ig, in, ic, is, op, ret = 0;
+    double threshold = 10.0, sum;
+    bool dmodex = false, first = true;
+    samples_t samples[OP_MAX];
+    record_t r;
+    FILE *out = stdout;
+    size_t k;
+
+    /* launched by pmix_test - the standard test args come first */
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp(argv[n], "--perf-client")) {
+            if (n + 5 >= argc) {
+                return 1;
+            }
+            return run_client(argv[n+1], strtol(argv[n+2], NULL, 10),
+                              strtol(argv[n+3], NULL, 10), strtol(argv[n+4], NULL, 10),
+                              0 != strtol(argv[n+5], NULL, 10));
+        }
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp(argv[n], "--compare")) {
+            if (n + 2 >= argc) {
+                usage(argv[0]);
+            }
+            if (n + 4 < argc && 0 == strcmp(argv[n+3], "--threshold")) {
+                threshold = strtod(argv[n+4], NULL);
+            }
+            return compare(argv[n+1], argv[n+2], threshold);
+        } else if (0 == strcmp(argv[n], "-d")) {
+            dmodex = true;
+        } else if (n + 1 >= argc) {
+            usage(argv[0]);
+        } else if (0 == strcmp(argv[n], "-n")) {
+            nlist = argv[++n];
+        } else if (0 == strcmp(argv[n], "-c")) {
+            clist = argv[++n];
+        } else if (0 == strcmp(argv[n], "-s")) {
+            slist = argv[++n];
+        } else if (0 == strcmp(argv[n], "-g")) {
+            glist = argv[++n];
+        } else if (0 == strcmp(argv[n], "-p")) {
+            plist = argv[++n];
+        } else if (0 == strcmp(argv[n], "-r")) {
+            nreps = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-f")) {
+            format = argv[++n];
+        } else if (0 == strcmp(argv[n], "-o")) {
+            outfile = argv[++n];
+        } else if (0 == strcmp(argv[n], "-t")) {
+            timeout = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-x")) {
+            launcher = argv[++n];
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (nreps < 1 || (0 != strcmp(format, "json") && 0 != strcmp(format, "csv"))) {
+        usage(argv[0]);
+    }
+
+    if (NULL == (self = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (NULL == launcher) {
+        /* we may be running out of the libtool .libs directory */
+        dir = strdup(self);
+        *strrchr(dir, '/') = '\0';
+        snprintf(path, sizeof(path), "%s/pmix_test", dir);
+        if (0 != access(path, X_OK)) {
+            snprintf(path, sizeof(path), "%s/../pmix_test", dir);
+        }
+        free(dir);
+        launcher = path;
+    }
+    if (0 != access(launcher, X_OK)) {
+        fprintf(stderr, "Cannot find the pmix_test server at %s\n", launcher);
+        exit(1);
+    }
+    if (NULL != outfile && NULL == (out = fopen(outfile, "w"))) {
+        fprintf(stderr, "Cannot open %s: %s\n", outfile, strerror(errno));
+        exit(1);
+    }
+
+    procs = split(nlist);
+    keys = split(clist);
+    sizes = split(slist);
+    gds = split(glist);
+    ptls = split(plist);
+    if (0 == strcmp(format, "csv")) {
+        fprintf(out, "procs,keys,key_size,gds,ptl,dmodex,op,unit,samples,mean,min,p50,p90,p99,max\n");
+    } else {
+        fprintf(out, "[\n");
+    }
+
+    for (ip=0; NULL != ptls && NULL != ptls[ip]; ip++) {
+        for (ig=0; NULL != gds && NULL != gds[ig]; ig++) {
+            for (in=0; NULL != procs && NULL != procs[in]; in++) {
+                for (ic=0; NULL != keys && NULL != keys[ic]; ic++) {
+                    for (is=0; NULL != sizes && NULL != sizes[is]; is++) {
+                        memset(&r, 0, sizeof(r));
+                        r.procs = strtol(procs[in], NULL, 10);
+                        r.keys = strtol(keys[ic], NULL, 10);
+                        r.key_size = strtol(sizes[is], NULL, 10);
+                        snprintf(r.gds, sizeof(r.gds), "%s", gds[ig]);
+                        snprintf(r.ptl, sizeof(r.ptl), "%s", ptls[ip]);
+                        r.dmodex = dmodex;
+                        fprintf(stderr, "n=%d c=%d s=%d gds=%s ptl=%s: ", r.procs, r.keys,
+                                r.key_size, r.gds, r.ptl);
+                        memset(samples, 0, sizeof(samples));
+                        if (0 != run_config(launcher, self, r.procs, r.keys, r.key_size,
+                                            r.gds, r.ptl, nreps, dmodex, timeout, samples)) {
+                            fprintf(stderr, "FAILED\n");
+                            ret = 1;
+                        } else {
+                            fprintf(stderr, "done\n");
+                        }
+                        for (op=0; op < OP_MAX; op++) {
+                            if (0 == samples[op].n) {
+                                continue;
+                            }
+                            qsort(samples[op].vals, samples[op].n, sizeof(double), cmp_double);
+                            for (sum=0, k=0; k < samples[op].n; k++) {
+                                sum += samples[op].vals[k];
+                            }
+                            snprintf(r.op, sizeof(r.op), "%s", op_names[op]);
+                            snprintf(r.unit, sizeof(r.unit), "%s", op_units[op]);
+                            r.samples = samples[op].n;
+                            r.mean = sum / samples[op].n;
+                            r.min = samples[op].vals[0];
+                            r.p50 = percentile(&samples[op], 0.50);
+                            r.p90 = percentile(&samples[op], 0.90);
+                            r.p99 = percentile(&samples[op], 0.99);
+                            r.max = samples[op].vals[samples[op].n - 1];
+                            print_record(out, format, &r, first);
+                            first = false;
+                            free(samples[op].vals);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (0 != strcmp(format, "csv")) {
+        fprintf(out, "\n]\n");
+    }
+    if (stdout != out) {
+        fclose(out);
+    }
+    free_list(procs);
+    free_list(keys);
+    free_list(sizes);
+    free_list(gds);
+    free_list(ptls);
+    free(self);
+    return ret;
+}
@@ -136,6 +136,10 @@ int main(int argc, char **argv)
     pmix_info_t info, *iptr;
     size_t ninfo;
     pmix_status_t code;
+    pmix_proc_t *mprocs;
+    pmix_key_t mkeys[2];
+    pmix_value_t *mvals = NULL;
+    pmix_status_t *mstatus;
 
     if (1 < argc) {
         if (0 == strcmp("-abort", argv[1])) {
@@ -237,6 +241,32 @@ int main(int argc, char **argv)
             goto done;
         }
 
+        if (0 == cnt) {
+            value.type = PMIX_UINT32;
+            value.data.uint32 = myproc.rank;
+            if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_LOCAL, "simpclient-multi-a", &value))) {
+                pmix_output(0, "Client ns %s rank %d: PMIx_Put multi failed: %s",
+                            myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+                goto done;
+            }
+            value.data.uint32 = myproc.rank + 100;
+            if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_LOCAL, "simpclient-multi-b", &value))) {
+                pmix_output(0, "Client ns %s rank %d: PMIx_Put multi failed: %s",
+                            myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+                goto done;
+            }
+            (void)asprintf(&tmp, "%s-%d-view", myproc.nspace, myproc.rank);
+            value.type = PMIX_BYTE_OBJECT;
+            value.data.bo.bytes = tmp;
+            value.data.bo.size = strlen(tmp);
+            if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_LOCAL, "simpclient-view", &value))) {
+                pmix_output(0, "Client ns %s rank %d: PMIx_Put view failed: %s",
+                            myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+                goto done;
+            }
+            free(tmp);
+        }
+
         if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
             pmix_output(0, "Client ns %s rank %d cnt %d: PMIx_Commit failed: %s",
                         myproc.nspace, myproc.rank, cnt, PMIx_Error_string(rc));
@@ -302,6 +332,59 @@ int main(int argc, char **argv)
         }
     }
 
+    /* get a couple of keys from every proc in one call */
+    PMIX_PROC_CREATE(mprocs, nprocs);
+    mstatus = (pmix_status_t*)malloc(2 * nprocs * sizeof(pmix_status_t));
+    for (n=0; n < nprocs; n++) {
+        PMIX_PROC_LOAD(&mprocs[n], myproc.nspace, n);
+    }
+    PMIX_LOAD_KEY(mkeys[0], "simpclient-multi-a");
+    PMIX_LOAD_KEY(mkeys[1], "simpclient-multi-b");
+    if (PMIX_SUCCESS != (rc = PMIx_Get_multi(mprocs, nprocs, mkeys, 2, NULL, 0, &mvals, mstatus))) {
+        pmix_output(0, "Client ns %s rank %d: PMIx_Get_multi failed: %s",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+    } else {
+        for (n=0; n < nprocs; n++) {
+            if (PMIX_UINT32 != mvals[2*n].type || n != mvals[2*n].data.uint32 ||
+                PMIX_UINT32 != mvals[2*n+1].type || n + 100 != mvals[2*n+1].data.uint32) {
+                pmix_output(0, "Client ns %s rank %d: PMIx_Get_multi returned wrong data for rank %d",
+                            myproc.nspace, myproc.rank, n);
+                break;
+            }
+        }
+        if (n == nprocs) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get_multi returned correct",
+                        myproc.nspace, myproc.rank);
+        }
+    }
+    PMIX_VALUE_FREE(mvals, 2 * nprocs);
+    PMIX_PROC_FREE(mprocs, nprocs);
+    free(mstatus);
+
+    /* get the byte objects of the other procs without copying them */
+    PMIX_INFO_LOAD(&info, PMIX_GET_POINTER_VALUES, NULL, PMIX_BOOL);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    for (n=0; n < nprocs; n++) {
+        proc.rank = n;
+        if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, "simpclient-view", &info, 1, &val))) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get view from %d failed: %s",
+                        myproc.nspace, myproc.rank, n, PMIx_Error_string(rc));
+            continue;
+        }
+        (void)asprintf(&tmp, "%s-%d-view", myproc.nspace, n);
+        if (PMIX_BYTE_OBJECT != val->type || strlen(tmp) != val->data.bo.size ||
+            0 != memcmp(tmp, val->data.bo.bytes, val->data.bo.size)) {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get view from %d returned wrong data",
+                        myproc.nspace, myproc.rank, n);
+        } else {
+            pmix_output(0, "Client ns %s rank %d: PMIx_Get view from %d returned correct",
+                        myproc.nspace, myproc.rank, n);
+        }
+        free(tmp);
+        PMIx_Value_release_view(val);
+    }
+    PMIX_INFO_DESTRUCT(&info);
+
     /* now get the data blob for myself */
     pmix_output(0, "Client ns %s rank %d testing internal modex blob",
                 myproc.nspace, myproc.rank);
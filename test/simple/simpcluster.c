@@ -0,0 +1,1181 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Simulate a cluster of virtual nodes on a single machine. Each node
+ * is a separate process running its own PMIx server and a set of
+ * local clients. The servers are joined into a tree by socketpairs,
+ * and a loopback "host RM" in each of them implements the fence,
+ * direct modex, event and group upcalls across that tree. Clients
+ * time each phase and the per-phase results across all ranks are
+ * reported at the end, e.g.:
+ *
+ *     ./simpcluster -n 256 -p 2 -f 8
+ *     ./simpcluster -n 1024 -p 1 -f 2 -l 50 -s 1024
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "src/util/argv.h"
+
+#include "simptest_common.h"
+
+#define SIMPCLUSTER_NSPACE  "simpcluster"
+#define SIMPCLUSTER_KEY     "simpcluster.data"
+#define SIMPCLUSTER_TS      "simpcluster.ts"
+#define SIMPCLUSTER_GROUP   "simpcluster.grp"
+#define SIMPCLUSTER_EVENT   (PMIX_EXTERNAL_ERR_BASE - 1)
+
+/* phases timed by every client */
+enum {
+    PH_INIT,
+    PH_BARRIER,
+    PH_DMODEX,
+    PH_FENCE,
+    PH_GET,
+    PH_EVENT,
+    PH_GRP_CONSTRUCT,
+    PH_GRP_DESTRUCT,
+    PH_FINALIZE,
+    PH_MAX
+};
+
+static const char *phase_names[PH_MAX] = {
+    "PMIx_Init",
+    "fence (barrier)",
+    "get (direct modex)",
+    "fence (collect data)",
+    "get (collected)",
+    "event delivery",
+    "group construct",
+    "group destruct",
+    "PMIx_Finalize"
+};
+
+/* written by each client and each node to the result pipe - the
+ * rank is negative for node records, which use the first entry for
+ * the server setup time */
+typedef struct {
+    int rank;
+    double t[PH_MAX];
+    unsigned long msgs;
+    unsigned long bytes;
+} result_t;
+
+/* the params shared by all processes */
+static int nnodes = 8;
+static int ppn = 2;
+static int fanout = 4;
+static int latency = 0;
+static int niters = 5;
+static size_t dsize = 64;
+
+/****    CLIENT    ****/
+
+static volatile int nevents = 0;
+static volatile double evlatency = 0;
+
+static void evhandler(size_t evhdlr_registration_id,
+                      pmix_status_t status,
+                      const pmix_proc_t *source,
+                      pmix_info_t info[], size_t ninfo,
+                      pmix_info_t results[], size_t nresults,
+                      pmix_event_notification_cbfunc_fn_t cbfunc,
+                      void *cbdata)
+{
+    size_t n;
+
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], SIMPCLUSTER_TS)) {
+            evlatency += simptest_ts() - info[n].value.data.dval;
+            break;
+        }
+    }
+    ++nevents;
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static volatile bool evregistered = false;
+
+static void evregcbfunc(pmix_status_t status, size_t refid, void *cbdata)
+{
+    evregistered = true;
+}
+
+static int run_client(int resfd)
+{
+    pmix_proc_t myproc, proc, *procs;
+    pmix_info_t info, *results;
+    pmix_value_t val, *vp;
+    pmix_status_t rc, code = SIMPCLUSTER_EVENT;
+    result_t res;
+    struct timespec ts = {0, 10000};
+    double start, now;
+    size_t nresults, ndmdx;
+    int n, k, node;
+    bool flag = true;
+
+    memset(&res, 0, sizeof(res));
+    for (n=0; n < PH_MAX; n++) {
+        res.t[n] = -1.0;
+    }
+
+    start = simptest_ts();
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    res.t[PH_INIT] = simptest_ts() - start;
+    res.rank = myproc.rank;
+    node = myproc.rank / ppn;
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+
+    val.type = PMIX_BYTE_OBJECT;
+    val.data.bo.size = dsize;
+    val.data.bo.bytes = (char*)malloc(dsize);
+    memset(val.data.bo.bytes, myproc.rank & 0xff, dsize);
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, SIMPCLUSTER_KEY, &val)) ||
+        PMIX_SUCCESS != (rc = PMIx_Commit())) {
+        fprintf(stderr, "Rank %d: put failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    free(val.data.bo.bytes);
+
+    /* line everyone up so the skew in starting the
+     * procs isn't charged to the first phase */
+    if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+        fprintf(stderr, "Rank %d: barrier failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+
+    /* barrier - no data is exchanged */
+    start = simptest_ts();
+    for (k=0; k < niters; k++) {
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+            fprintf(stderr, "Rank %d: barrier failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+    }
+    res.t[PH_BARRIER] = (simptest_ts() - start) / niters;
+
+    /* fetch the data from a peer on each of the following nodes - the
+     * first get of each peer has to go to the remote server */
+    ndmdx = (niters < nnodes - 1) ? niters : nnodes - 1;
+    if (0 < ndmdx) {
+        start = simptest_ts();
+        for (k=0; k < (int)ndmdx; k++) {
+            proc.rank = ((node + k + 1) % nnodes) * ppn + myproc.rank % ppn;
+            if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, SIMPCLUSTER_KEY, NULL, 0, &vp))) {
+                fprintf(stderr, "Rank %d: get from %d failed: %s\n",
+                        myproc.rank, proc.rank, PMIx_Error_string(rc));
+                goto done;
+            }
+            PMIX_VALUE_RELEASE(vp);
+        }
+        res.t[PH_DMODEX] = (simptest_ts() - start) / ndmdx;
+    }
+
+    /* fence with the data collected to everyone */
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &flag, PMIX_BOOL);
+    start = simptest_ts();
+    for (k=0; k < niters; k++) {
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, &info, 1))) {
+            fprintf(stderr, "Rank %d: fence failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+    }
+    res.t[PH_FENCE] = (simptest_ts() - start) / niters;
+    PMIX_INFO_DESTRUCT(&info);
+
+    /* the data from the most distant node is now local */
+    proc.rank = ((node + nnodes / 2) % nnodes) * ppn + myproc.rank % ppn;
+    start = simptest_ts();
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, SIMPCLUSTER_KEY, NULL, 0, &vp))) {
+        fprintf(stderr, "Rank %d: get from %d failed: %s\n",
+                myproc.rank, proc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    res.t[PH_GET] = simptest_ts() - start;
+    PMIX_VALUE_RELEASE(vp);
+
+    /* rank 0 generates an event that everyone else is waiting for,
+     * stamped so the receivers can compute the delivery time */
+    PMIx_Register_event_handler(&code, 1, NULL, 0, evhandler, evregcbfunc, NULL);
+    simptest_wait_for(&evregistered);
+    for (k=0; k < niters; k++) {
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+            fprintf(stderr, "Rank %d: barrier failed: %s\n", myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+        if (0 == myproc.rank) {
+            now = simptest_ts();
+            PMIX_INFO_LOAD(&info, SIMPCLUSTER_TS, &now, PMIX_DOUBLE);
+            rc = PMIx_Notify_event(code, &myproc, PMIX_RANGE_SESSION, &info, 1, NULL, NULL);
+            PMIX_INFO_DESTRUCT(&info);
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stderr, "Rank 0: notify failed: %s\n", PMIx_Error_string(rc));
+                goto done;
+            }
+        } else {
+            while (nevents <= k) {
+                nanosleep(&ts, NULL);
+            }
+        }
+    }
+    if (0 != myproc.rank) {
+        res.t[PH_EVENT] = evlatency / niters;
+    }
+
+    /* build a group of everyone and tear it down again */
+    PMIX_PROC_CREATE(procs, 1);
+    (void)strncpy(procs[0].nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    procs[0].rank = PMIX_RANK_WILDCARD;
+    res.t[PH_GRP_CONSTRUCT] = 0;
+    res.t[PH_GRP_DESTRUCT] = 0;
+    for (k=0; k < niters; k++) {
+        results = NULL;
+        nresults = 0;
+        start = simptest_ts();
+        rc = PMIx_Group_construct(SIMPCLUSTER_GROUP, procs, 1, NULL, 0, &results, &nresults);
+        now = simptest_ts();
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Rank %d: group construct failed: %s\n",
+                    myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+        res.t[PH_GRP_CONSTRUCT] += now - start;
+        if (NULL != results) {
+            PMIX_INFO_FREE(results, nresults);
+        }
+        start = simptest_ts();
+        rc = PMIx_Group_destruct(SIMPCLUSTER_GROUP, NULL, 0);
+        now = simptest_ts();
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Rank %d: group destruct failed: %s\n",
+                    myproc.rank, PMIx_Error_string(rc));
+            goto done;
+        }
+        res.t[PH_GRP_DESTRUCT] += now - start;
+    }
+    res.t[PH_GRP_CONSTRUCT] /= niters;
+    res.t[PH_GRP_DESTRUCT] /= niters;
+    PMIX_PROC_FREE(procs, 1);
+
+  done:
+    start = simptest_ts();
+    PMIx_Finalize(NULL, 0);
+    res.t[PH_FINALIZE] = simptest_ts() - start;
+    /* records are smaller than PIPE_BUF, so they can't interleave */
+    if (sizeof(res) != write(resfd, &res, sizeof(res))) {
+        return 1;
+    }
+    close(resfd);
+    return (PMIX_SUCCESS == rc) ? 0 : 1;
+}
+
+/****    HOST RM    ****/
+
+/* messages passed between the servers */
+enum {
+    MSG_COLL_UP,
+    MSG_COLL_DOWN,
+    MSG_DMDX_REQ,
+    MSG_DMDX_RESP,
+    MSG_EVENT
+};
+
+typedef struct {
+    uint32_t type;
+    uint32_t origin;    // node that started the operation
+    uint32_t target;    // node it is routed to
+    uint32_t id;        // dmodex request id
+    int64_t aux;        // rank, status, event code or context id
+    uint64_t len;       // bytes of payload that follow
+} msg_hdr_t;
+
+enum {
+    COLL_FENCE,
+    COLL_GROUP
+};
+
+static int mynode;
+static int parent_fd = -1;
+static int *child_fds = NULL;
+static int nchildren = 0;
+static int wakeup[2];
+static pmix_mutex_t rm_lock = PMIX_MUTEX_STATIC_INIT;
+static unsigned long nmsgs = 0;
+static unsigned long nbytes = 0;
+
+/* the collective in progress - they are executed one at a time
+ * as every proc participates in each of them */
+static struct {
+    bool local;
+    int nin;
+    char *data;
+    size_t ndata;
+    int kind;
+    pmix_modex_cbfunc_t modexcbfunc;
+    pmix_info_cbfunc_t infocbfunc;
+    void *cbdata;
+} coll = {0};
+
+/* outstanding dmodex requests, indexed by id - a slot is
+ * free for reuse once its cbfunc is NULL */
+typedef struct {
+    pmix_modex_cbfunc_t cbfunc;
+    void *cbdata;
+} dmdx_req_t;
+static dmdx_req_t *dmdx_reqs = NULL;
+static uint32_t ndmdx_reqs = 0;
+
+/* messages that arrived but are held back until the latency of
+ * their hop has passed - only touched by the rm thread */
+typedef struct delayed_msg {
+    struct delayed_msg *next;
+    int fd;
+    msg_hdr_t hdr;
+    char *data;
+    double due;
+} delayed_msg_t;
+static delayed_msg_t *delayed_head = NULL;
+static delayed_msg_t *delayed_tail = NULL;
+
+static int parent_of(int node)
+{
+    return (node - 1) / fanout;
+}
+
+/* the link a message for the given node leaves on */
+static int route(int target)
+{
+    int n, t = target;
+
+    while (t > mynode) {
+        if (parent_of(t) == mynode) {
+            n = t - mynode * fanout - 1;
+            return child_fds[n];
+        }
+        t = parent_of(t);
+    }
+    return parent_fd;
+}
+
+static int write_all(int fd, const void *buf, size_t len)
+{
+    const char *ptr = (const char*)buf;
+    ssize_t rc;
+
+    while (0 < len) {
+        rc = write(fd, ptr, len);
+        if (rc < 0) {
+            if (EINTR == errno || EAGAIN == errno) {
+                continue;
+            }
+            return -1;
+        }
+        ptr += rc;
+        len -= rc;
+    }
+    return 0;
+}
+
+static int read_all(int fd, void *buf, size_t len)
+{
+    char *ptr = (char*)buf;
+    ssize_t rc;
+
+    while (0 < len) {
+        rc = read(fd, ptr, len);
+        if (rc <= 0) {
+            if (rc < 0 && (EINTR == errno || EAGAIN == errno)) {
+                continue;
+            }
+            return -1;
+        }
+        ptr += rc;
+        len -= rc;
+    }
+    return 0;
+}
+
+/* must be called with the rm_lock held - the artificial
+ * latency of the hop is charged by the receiver */
+static void send_msg(int fd, msg_hdr_t *hdr, const void *data)
+{
+    if (0 != write_all(fd, hdr, sizeof(*hdr)) ||
+        (0 < hdr->len && 0 != write_all(fd, data, hdr->len))) {
+        fprintf(stderr, "Node %d: lost a link\n", mynode);
+        return;
+    }
+    ++nmsgs;
+    nbytes += sizeof(*hdr) + hdr->len;
+}
+
+static void release_data(void *cbdata)
+{
+    free(cbdata);
+}
+
+static void release_info(void *cbdata)
+{
+    pmix_info_t *info = (pmix_info_t*)cbdata;
+
+    PMIX_INFO_FREE(info, 1);
+}
+
+/* pass the result of the collective to our children and then
+ * release our local procs - must be called with the rm_lock held */
+static void coll_complete(char *data, size_t ndata, int64_t ctxid)
+{
+    msg_hdr_t hdr;
+    pmix_byte_object_t bo;
+    pmix_info_t *info;
+    char *copy = NULL;
+    int n;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.type = MSG_COLL_DOWN;
+    hdr.origin = mynode;
+    hdr.aux = ctxid;
+    hdr.len = ndata;
+    for (n=0; n < nchildren; n++) {
+        send_msg(child_fds[n], &hdr, data);
+    }
+
+    if (0 < ndata) {
+        copy = (char*)malloc(ndata);
+        memcpy(copy, data, ndata);
+    }
+    if (COLL_FENCE == coll.kind) {
+        coll.modexcbfunc(PMIX_SUCCESS, copy, ndata, coll.cbdata, release_data, copy);
+    } else if (NULL == copy) {
+        coll.infocbfunc(PMIX_SUCCESS, NULL, 0, coll.cbdata, NULL, NULL);
+    } else {
+        /* return the collected endpoint data */
+        PMIX_INFO_CREATE(info, 1);
+        bo.bytes = copy;
+        bo.size = ndata;
+        PMIX_INFO_LOAD(&info[0], PMIX_GROUP_ENDPT_DATA, &bo, PMIX_BYTE_OBJECT);
+        free(copy);
+        coll.infocbfunc(PMIX_SUCCESS, info, 1, coll.cbdata, release_info, info);
+    }
+
+    if (NULL != coll.data) {
+        free(coll.data);
+    }
+    memset(&coll, 0, sizeof(coll));
+}
+
+/* add a contribution to the collective, passing it up the tree once
+ * we have heard from our local procs and all our children - must be
+ * called with the rm_lock held */
+static void coll_contribute(const char *data, size_t ndata)
+{
+    msg_hdr_t hdr;
+
+    if (0 < ndata) {
+        coll.data = (char*)realloc(coll.data, coll.ndata + ndata);
+        memcpy(coll.data + coll.ndata, data, ndata);
+        coll.ndata += ndata;
+    }
+    if (!coll.local || coll.nin < nchildren) {
+        return;
+    }
+    if (0 == mynode) {
+        /* everyone is in - the root assigns the context id */
+        coll_complete(coll.data, coll.ndata, 1);
+        return;
+    }
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.type = MSG_COLL_UP;
+    hdr.origin = mynode;
+    hdr.len = coll.ndata;
+    send_msg(parent_fd, &hdr, coll.data);
+}
+
+static pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
+                                const pmix_info_t info[], size_t ninfo,
+                                char *data, size_t ndata,
+                                pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_mutex_lock(&rm_lock);
+    coll.local = true;
+    coll.kind = COLL_FENCE;
+    coll.modexcbfunc = cbfunc;
+    coll.cbdata = cbdata;
+    coll_contribute(data, ndata);
+    pmix_mutex_unlock(&rm_lock);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t group_fn(pmix_group_operation_t op, char grp[],
+                              const pmix_proc_t procs[], size_t nprocs,
+                              const pmix_info_t directives[], size_t ndirs,
+                              pmix_info_cbfunc_t cbfunc, void *cbdata)
+{
+    char *data = NULL;
+    size_t n, ndata = 0;
+
+    for (n=0; n < ndirs; n++) {
+        if (PMIX_CHECK_KEY(&directives[n], PMIX_GROUP_ENDPT_DATA)) {
+            data = directives[n].value.data.bo.bytes;
+            ndata = directives[n].value.data.bo.size;
+            break;
+        }
+    }
+
+    pmix_mutex_lock(&rm_lock);
+    coll.local = true;
+    coll.kind = COLL_GROUP;
+    coll.infocbfunc = cbfunc;
+    coll.cbdata = cbdata;
+    coll_contribute(data, ndata);
+    pmix_mutex_unlock(&rm_lock);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t dmodex_fn(const pmix_proc_t *proc,
+                               const pmix_info_t info[], size_t ninfo,
+                               pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    msg_hdr_t hdr;
+    uint32_t id;
+
+    pmix_mutex_lock(&rm_lock);
+    /* reuse the slot of a completed request if there is one */
+    for (id=0; id < ndmdx_reqs && NULL != dmdx_reqs[id].cbfunc; id++);
+    if (id == ndmdx_reqs) {
+        dmdx_reqs = (dmdx_req_t*)realloc(dmdx_reqs, (ndmdx_reqs + 1) * sizeof(dmdx_req_t));
+        ++ndmdx_reqs;
+    }
+    dmdx_reqs[id].cbfunc = cbfunc;
+    dmdx_reqs[id].cbdata = cbdata;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.type = MSG_DMDX_REQ;
+    hdr.origin = mynode;
+    hdr.target = proc->rank / ppn;
+    hdr.id = id;
+    hdr.aux = proc->rank;
+    send_msg(route(hdr.target), &hdr, NULL);
+    pmix_mutex_unlock(&rm_lock);
+    return PMIX_SUCCESS;
+}
+
+/* executes in the PMIx server's progress thread */
+static void dmdx_cbfunc(pmix_status_t status, char *data, size_t ndata, void *cbdata)
+{
+    msg_hdr_t *hdr = (msg_hdr_t*)cbdata;
+
+    pmix_mutex_lock(&rm_lock);
+    hdr->type = MSG_DMDX_RESP;
+    hdr->target = hdr->origin;
+    hdr->origin = mynode;
+    hdr->aux = status;
+    hdr->len = (PMIX_SUCCESS == status) ? ndata : 0;
+    send_msg(route(hdr->target), hdr, data);
+    pmix_mutex_unlock(&rm_lock);
+    free(hdr);
+}
+
+/* pass the event to every link other than the one it came in on -
+ * must be called with the rm_lock held */
+static void flood(int from, msg_hdr_t *hdr, const void *data)
+{
+    int n;
+
+    if (0 <= parent_fd && from != parent_fd) {
+        send_msg(parent_fd, hdr, data);
+    }
+    for (n=0; n < nchildren; n++) {
+        if (from != child_fds[n]) {
+            send_msg(child_fds[n], hdr, data);
+        }
+    }
+}
+
+static pmix_status_t notify_event(pmix_status_t code,
+                                  const pmix_proc_t *source,
+                                  pmix_data_range_t range,
+                                  pmix_info_t info[], size_t ninfo,
+                                  pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    msg_hdr_t hdr;
+    double ts = 0;
+    size_t n;
+
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], SIMPCLUSTER_TS)) {
+            ts = info[n].value.data.dval;
+            break;
+        }
+    }
+    pmix_mutex_lock(&rm_lock);
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.type = MSG_EVENT;
+    hdr.origin = mynode;
+    hdr.id = source->rank;
+    hdr.aux = code;
+    hdr.len = sizeof(ts);
+    flood(-1, &hdr, &ts);
+    pmix_mutex_unlock(&rm_lock);
+    return PMIX_OPERATION_SUCCEEDED;
+}
+
+static void notify_cbfunc(pmix_status_t status, void *cbdata)
+{
+    pmix_info_t *info = (pmix_info_t*)cbdata;
+
+    PMIX_INFO_FREE(info, 1);
+}
+
+static void handle_msg(int fd, msg_hdr_t *hdr, char *data)
+{
+    pmix_proc_t proc;
+    pmix_info_t *info;
+    msg_hdr_t *reply;
+    pmix_status_t rc;
+    double ts;
+
+    pmix_mutex_lock(&rm_lock);
+    switch (hdr->type) {
+    case MSG_COLL_UP:
+        ++coll.nin;
+        coll_contribute(data, hdr->len);
+        break;
+    case MSG_COLL_DOWN:
+        coll_complete(data, hdr->len, hdr->aux);
+        break;
+    case MSG_DMDX_REQ:
+        if (hdr->target != (uint32_t)mynode) {
+            send_msg(route(hdr->target), hdr, NULL);
+            break;
+        }
+        PMIX_PROC_CONSTRUCT(&proc);
+        (void)strncpy(proc.nspace, SIMPCLUSTER_NSPACE, PMIX_MAX_NSLEN);
+        proc.rank = hdr->aux;
+        reply = (msg_hdr_t*)malloc(sizeof(msg_hdr_t));
+        memcpy(reply, hdr, sizeof(msg_hdr_t));
+        /* the callback takes the lock */
+        pmix_mutex_unlock(&rm_lock);
+        if (PMIX_SUCCESS != (rc = PMIx_server_dmodex_request(&proc, dmdx_cbfunc, reply))) {
+            dmdx_cbfunc(rc, NULL, 0, reply);
+        }
+        return;
+    case MSG_DMDX_RESP:
+        if (hdr->target != (uint32_t)mynode) {
+            send_msg(route(hdr->target), hdr, data);
+            break;
+        }
+        if (hdr->id < ndmdx_reqs && NULL != dmdx_reqs[hdr->id].cbfunc) {
+            /* the cbfunc takes ownership of a copy */
+            char *copy = NULL;
+            dmdx_req_t req = dmdx_reqs[hdr->id];
+            if (0 < hdr->len) {
+                copy = (char*)malloc(hdr->len);
+                memcpy(copy, data, hdr->len);
+            }
+            dmdx_reqs[hdr->id].cbfunc = NULL;
+            req.cbfunc(hdr->aux, copy, hdr->len, req.cbdata, release_data, copy);
+        }
+        break;
+    case MSG_EVENT:
+        flood(fd, hdr, data);
+        PMIX_PROC_CONSTRUCT(&proc);
+        (void)strncpy(proc.nspace, SIMPCLUSTER_NSPACE, PMIX_MAX_NSLEN);
+        proc.rank = hdr->id;
+        memcpy(&ts, data, sizeof(ts));
+        PMIX_INFO_CREATE(info, 1);
+        PMIX_INFO_LOAD(&info[0], SIMPCLUSTER_TS, &ts, PMIX_DOUBLE);
+        pmix_mutex_unlock(&rm_lock);
+        if (PMIX_SUCCESS != PMIx_Notify_event(hdr->aux, &proc, PMIX_RANGE_LOCAL,
+                                              info, 1, notify_cbfunc, info)) {
+            PMIX_INFO_FREE(info, 1);
+        }
+        return;
+    default:
+        fprintf(stderr, "Node %d: unknown message %u\n", mynode, hdr->type);
+        break;
+    }
+    pmix_mutex_unlock(&rm_lock);
+}
+
+/* hand over the delayed messages whose time has come, and return
+ * the number of usec until the next one is due (-1 if none) */
+static long deliver_delayed(void)
+{
+    delayed_msg_t *msg;
+    double now;
+
+    while (NULL != (msg = delayed_head)) {
+        now = simptest_ts();
+        if (now < msg->due) {
+            return (long)((msg->due - now) * 1000000.0) + 1;
+        }
+        delayed_head = msg->next;
+        if (NULL == delayed_head) {
+            delayed_tail = NULL;
+        }
+        handle_msg(msg->fd, &msg->hdr, msg->data);
+        free(msg->data);
+        free(msg);
+    }
+    return -1;
+}
+
+/* service the links to the other servers */
+static void* rm_thread(void *arg)
+{
+    struct pollfd *fds;
+    delayed_msg_t *msg;
+    msg_hdr_t hdr;
+    char *data;
+    long wait;
+    int n, nfds = 0;
+
+    fds = (struct pollfd*)calloc(nchildren + 2, sizeof(struct pollfd));
+    fds[nfds].fd = wakeup[0];
+    fds[nfds++].events = POLLIN;
+    if (0 <= parent_fd) {
+        fds[nfds].fd = parent_fd;
+        fds[nfds++].events = POLLIN;
+    }
+    for (n=0; n < nchildren; n++) {
+        fds[nfds].fd = child_fds[n];
+        fds[nfds++].events = POLLIN;
+    }
+
+    while (1) {
+        /* every hop takes the same time, so messages come due in
+         * the order they arrived */
+        wait = deliver_delayed();
+        if (0 <= wait && wait < 1000) {
+            /* too short for the poll timeout */
+            usleep(wait);
+            continue;
+        }
+        if (poll(fds, nfds, (0 <= wait) ? (int)(wait / 1000) : -1) < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            break;
+        }
+        if (0 != fds[0].revents) {
+            break;
+        }
+        for (n=1; n < nfds; n++) {
+            if (0 == fds[n].revents) {
+                continue;
+            }
+            if (0 != read_all(fds[n].fd, &hdr, sizeof(hdr))) {
+                /* the peer has gone away */
+                fds[n].fd = -1;
+                continue;
+            }
+            data = NULL;
+            if (0 < hdr.len) {
+                data = (char*)malloc(hdr.len);
+                if (0 != read_all(fds[n].fd, data, hdr.len)) {
+                    free(data);
+                    fds[n].fd = -1;
+                    continue;
+                }
+            }
+            if (0 < latency) {
+                msg = (delayed_msg_t*)malloc(sizeof(delayed_msg_t));
+                msg->next = NULL;
+                msg->fd = fds[n].fd;
+                msg->hdr = hdr;
+                msg->data = data;
+                msg->due = simptest_ts() + latency / 1000000.0;
+                if (NULL == delayed_tail) {
+                    delayed_head = msg;
+                } else {
+                    delayed_tail->next = msg;
+                }
+                delayed_tail = msg;
+                continue;
+            }
+            handle_msg(fds[n].fd, &hdr, data);
+            free(data);
+        }
+    }
+    while (NULL != (msg = delayed_head)) {
+        delayed_head = msg->next;
+        free(msg->data);
+        free(msg);
+    }
+    delayed_tail = NULL;
+    free(fds);
+    return NULL;
+}
+
+static pmix_server_module_t mymodule = {
+    .fence_nb = fencenb_fn,
+    .direct_modex = dmodex_fn,
+    .notify_event = notify_event,
+    .group = group_fn
+};
+
+static char* make_list(int first, int count, char sep)
+{
+    char **list = NULL, *tmp;
+    int n;
+
+    for (n=first; n < first + count; n++) {
+        if (0 > asprintf(&tmp, "%d", n)) {
+            return NULL;
+        }
+        pmix_argv_append_nosize(&list, tmp);
+        free(tmp);
+    }
+    tmp = pmix_argv_join(list, sep);
+    pmix_argv_free(list);
+    return tmp;
+}
+
+/* executes in each forked node process */
+static int run_node(char *executable, const char *tmpdir, int resfd)
+{
+    pmix_info_t *info;
+    pmix_status_t rc;
+    pthread_t thread;
+    result_t res;
+    char **env, **argv = NULL, **nodes = NULL, **ppns = NULL, *tmp, *regex, *dir;
+    char hostname[PMIX_MAXHOSTNAMELEN];
+    uint32_t nprocs = nnodes * ppn, nlocal = ppn, nodeid = mynode;
+    volatile bool regdone = false;
+    double start;
+    int n;
+    pid_t pid;
+
+    start = simptest_ts();
+    snprintf(hostname, sizeof(hostname), "vnode%d", mynode);
+    if (0 > asprintf(&dir, "%s/%s", tmpdir, hostname) || 0 != mkdir(dir, 0700)) {
+        return 1;
+    }
+    PMIX_INFO_CREATE(info, 3);
+    PMIX_INFO_LOAD(&info[0], PMIX_SERVER_TMPDIR, dir, PMIX_STRING);
+    PMIX_INFO_LOAD(&info[1], PMIX_HOSTNAME, hostname, PMIX_STRING);
+    PMIX_INFO_LOAD(&info[2], PMIX_NODEID, &nodeid, PMIX_UINT32);
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, info, 3))) {
+        fprintf(stderr, "Node %d: init failed: %s\n", mynode, PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIX_INFO_FREE(info, 3);
+
+    /* our clients have no use for the links */
+    if (0 <= parent_fd) {
+        (void)fcntl(parent_fd, F_SETFD, FD_CLOEXEC);
+    }
+    for (n=0; n < nchildren; n++) {
+        (void)fcntl(child_fds[n], F_SETFD, FD_CLOEXEC);
+    }
+    if (0 != pipe(wakeup) ||
+        0 != pthread_create(&thread, NULL, rm_thread, NULL)) {
+        PMIx_server_finalize();
+        return 1;
+    }
+    (void)fcntl(wakeup[0], F_SETFD, FD_CLOEXEC);
+    (void)fcntl(wakeup[1], F_SETFD, FD_CLOEXEC);
+
+    /* describe the whole job */
+    for (n=0; n < nnodes; n++) {
+        if (0 > asprintf(&tmp, "vnode%d", n)) {
+            return 1;
+        }
+        pmix_argv_append_nosize(&nodes, tmp);
+        free(tmp);
+        tmp = make_list(n * ppn, ppn, ',');
+        pmix_argv_append_nosize(&ppns, tmp);
+        free(tmp);
+    }
+    PMIX_INFO_CREATE(info, 6);
+    PMIX_INFO_LOAD(&info[0], PMIX_UNIV_SIZE, &nprocs, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[1], PMIX_JOB_SIZE, &nprocs, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[2], PMIX_LOCAL_SIZE, &nlocal, PMIX_UINT32);
+    tmp = make_list(mynode * ppn, ppn, ',');
+    PMIX_INFO_LOAD(&info[3], PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
+    free(tmp);
+    tmp = pmix_argv_join(nodes, ',');
+    PMIx_generate_regex(tmp, &regex);
+    PMIX_INFO_LOAD(&info[4], PMIX_NODE_MAP, regex, PMIX_STRING);
+    free(regex);
+    free(tmp);
+    tmp = pmix_argv_join(ppns, ';');
+    PMIx_generate_ppn(tmp, &regex);
+    PMIX_INFO_LOAD(&info[5], PMIX_PROC_MAP, regex, PMIX_STRING);
+    free(regex);
+    free(tmp);
+    pmix_argv_free(nodes);
+    pmix_argv_free(ppns);
+    if (PMIX_SUCCESS != (rc = PMIx_server_register_nspace(SIMPCLUSTER_NSPACE, ppn, info, 6,
+                                                          simptest_opcbfunc, (void*)&regdone))) {
+        fprintf(stderr, "Node %d: register nspace failed: %s\n", mynode, PMIx_Error_string(rc));
+        goto done;
+    }
+    simptest_wait_for(&regdone);
+    PMIX_INFO_FREE(info, 6);
+
+    memset(&res, 0, sizeof(res));
+    res.rank = -1 - mynode;
+    res.t[0] = simptest_ts() - start;
+
+    /* start the local clients */
+    pmix_argv_append_nosize(&argv, executable);
+    pmix_argv_append_nosize(&argv, "--client");
+    if (0 > asprintf(&tmp, "%d,%d,%d,%d,%lu", resfd, nnodes, ppn, niters, (unsigned long)dsize)) {
+        goto done;
+    }
+    pmix_argv_append_nosize(&argv, tmp);
+    free(tmp);
+    for (n=0; n < ppn; n++) {
+        if (0 != simptest_setup_client(SIMPCLUSTER_NSPACE, mynode * ppn + n, &env)) {
+            rc = PMIX_ERROR;
+            goto done;
+        }
+        pid = fork();
+        if (pid < 0) {
+            fprintf(stderr, "Node %d: fork failed\n", mynode);
+            goto done;
+        }
+        if (0 == pid) {
+            execve(executable, argv, env);
+            _exit(1);
+        }
+        pmix_argv_free(env);
+    }
+    pmix_argv_free(argv);
+
+    /* the final fence guarantees nobody still needs us to relay
+     * their messages by the time our clients have exited */
+    while (0 < waitpid(-1, NULL, 0));
+
+  done:
+    close(wakeup[1]);
+    pthread_join(thread, NULL);
+    res.msgs = nmsgs;
+    res.bytes = nbytes;
+    PMIx_server_deregister_nspace(SIMPCLUSTER_NSPACE, NULL, NULL);
+    PMIx_server_finalize();
+    rmdir(dir);
+    free(dir);
+    if (sizeof(res) != write(resfd, &res, sizeof(res))) {
+        return 1;
+    }
+    return (PMIX_SUCCESS == rc) ? 0 : 1;
+}
+
+/****    COORDINATOR    ****/
+
+static void usage(char *prog)
+{
+    fprintf(stderr, "usage: %s [options]\n", prog);
+    fprintf(stderr, "    -n N    Number of virtual nodes (default: 8)\n");
+    fprintf(stderr, "    -p N    Procs per node (default: 2)\n");
+    fprintf(stderr, "    -f N    Fan-out of the server tree, 0 for flat (default: 4)\n");
+    fprintf(stderr, "    -l N    Latency of each hop between servers in usec (default: 0)\n");
+    fprintf(stderr, "    -i N    Iterations of each operation (default: 5)\n");
+    fprintf(stderr, "    -s N    Bytes each proc contributes to the modex (default: 64)\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    char *executable, tmpdir[] = "/tmp/simpcluster-XXXXXX";
+    int (*links)[2], res[2], n, k, resfd, nrecs = 0, nprocs, depth, ret = 0;
+    double start, setup, tmin[PH_MAX], tmax[PH_MAX], tsum[PH_MAX], smin = 1.0e9, smax = 0, ssum = 0;
+    unsigned long msgs = 0, bytes = 0, rootmsgs = 0;
+    int tcnt[PH_MAX];
+    unsigned long sz;
+    result_t rec;
+    struct rlimit rl;
+    pid_t pid;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (5 != sscanf(argv[2], "%d,%d,%d,%d,%lu", &resfd, &nnodes, &ppn, &niters, &sz)) {
+            return 1;
+        }
+        dsize = sz;
+        return run_client(resfd);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (NULL == argv[n+1]) {
+            usage(argv[0]);
+        }
+        if (0 == strcmp("-n", argv[n])) {
+            nnodes = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-p", argv[n])) {
+            ppn = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-f", argv[n])) {
+            fanout = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-l", argv[n])) {
+            latency = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-i", argv[n])) {
+            niters = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-s", argv[n])) {
+            dsize = strtoul(argv[++n], NULL, 10);
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (nnodes < 1 || ppn < 1 || niters < 1 || dsize < 1) {
+        usage(argv[0]);
+    }
+    /* a flat tree has everyone reporting to the root */
+    if (fanout < 1 || nnodes - 1 < fanout) {
+        fanout = (1 < nnodes) ? nnodes - 1 : 1;
+    }
+    nprocs = nnodes * ppn;
+    for (depth=0, n=nnodes-1; 0 < n; n = parent_of(n)) {
+        ++depth;
+    }
+
+    /* we hold both ends of every link until the nodes are started */
+    if (0 == getrlimit(RLIMIT_NOFILE, &rl)) {
+        rl.rlim_cur = rl.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &rl);
+    }
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (NULL == mkdtemp(tmpdir)) {
+        fprintf(stderr, "Cannot create tmpdir\n");
+        exit(1);
+    }
+    /* link n joins node n to its parent */
+    links = calloc(nnodes, sizeof(*links));
+    for (n=1; n < nnodes; n++) {
+        if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, links[n])) {
+            fprintf(stderr, "Cannot create link for node %d\n", n);
+            exit(1);
+        }
+    }
+    if (0 != pipe(res)) {
+        exit(1);
+    }
+
+    fprintf(stdout, "%d nodes x %d procs, fan-out %d (depth %d), %d usec/hop, %lu bytes/proc\n",
+            nnodes, ppn, fanout, depth, latency, (unsigned long)dsize);
+    start = simptest_ts();
+    for (n=0; n < nnodes; n++) {
+        pid = fork();
+        if (pid < 0) {
+            fprintf(stderr, "Fork failed\n");
+            ret = 1;
+            break;
+        }
+        if (0 != pid) {
+            continue;
+        }
+        /* keep only our own links */
+        close(res[0]);
+        mynode = n;
+        child_fds = (int*)calloc(fanout, sizeof(int));
+        for (k=1; k < nnodes; k++) {
+            if (k == n) {
+                parent_fd = links[k][1];
+                close(links[k][0]);
+            } else if (parent_of(k) == n) {
+                child_fds[nchildren++] = links[k][0];
+                close(links[k][1]);
+            } else {
+                close(links[k][0]);
+                close(links[k][1]);
+            }
+        }
+        _exit(run_node(executable, tmpdir, res[1]));
+    }
+    for (n=1; n < nnodes; n++) {
+        close(links[n][0]);
+        close(links[n][1]);
+    }
+    free(links);
+    close(res[1]);
+
+    for (n=0; n < PH_MAX; n++) {
+        tmin[n] = 1.0e9;
+        tmax[n] = 0;
+        tsum[n] = 0;
+        tcnt[n] = 0;
+    }
+    while (sizeof(rec) == read(res[0], &rec, sizeof(rec))) {
+        ++nrecs;
+        if (rec.rank < 0) {
+            setup = rec.t[0];
+            ssum += setup;
+            smin = (setup < smin) ? setup : smin;
+            smax = (setup > smax) ? setup : smax;
+            msgs += rec.msgs;
+            bytes += rec.bytes;
+            if (-1 == rec.rank) {
+                rootmsgs = rec.msgs;
+            }
+            continue;
+        }
+        for (n=0; n < PH_MAX; n++) {
+            if (rec.t[n] < 0) {
+                continue;
+            }
+            ++tcnt[n];
+            tsum[n] += rec.t[n];
+            tmin[n] = (rec.t[n] < tmin[n]) ? rec.t[n] : tmin[n];
+            tmax[n] = (rec.t[n] > tmax[n]) ? rec.t[n] : tmax[n];
+        }
+    }
+    close(res[0]);
+    while (0 < waitpid(-1, &n, 0)) {
+        if (!WIFEXITED(n) || 0 != WEXITSTATUS(n)) {
+            ret = 1;
+        }
+    }
+    if (nrecs != nnodes + nprocs) {
+        fprintf(stderr, "Only %d of %d nodes and procs reported\n", nrecs, nnodes + nprocs);
+        ret = 1;
+    }
+
+    fprintf(stdout, "%-22s %8s %12s %12s %12s\n", "phase (sec per op)", "procs", "avg", "min", "max");
+    fprintf(stdout, "%-22s %8d %12.6f %12.6f %12.6f\n", "server setup",
+            nnodes, ssum / nnodes, smin, smax);
+    for (n=0; n < PH_MAX; n++) {
+        if (0 == tcnt[n]) {
+            continue;
+        }
+        fprintf(stdout, "%-22s %8d %12.6f %12.6f %12.6f\n", phase_names[n],
+                tcnt[n], tsum[n] / tcnt[n], tmin[n], tmax[n]);
+    }
+    fprintf(stdout, "total: %10.6f sec  %lu messages  %lu bytes between servers  (%lu sent by the root)\n",
+            simptest_ts() - start, msgs, bytes, rootmsgs);
+
+    rmdir(tmpdir);
+    free(executable);
+    return ret;
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure how long it takes for a set of local clients to complete
+ * their connection handshake with the server. The clients are
+ * started and held at a barrier so that the cost of fork/exec is
+ * excluded - the clock starts when they are all released and stops
+ * when the server has accepted the last of them, e.g.:
+ *
+ *     ./simpconnect -n 64,256,1024
+ *     PMIX_MCA_ptl_tcp_validation_threads=0 ./simpconnect -n 1024
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "src/util/argv.h"
+#include "src/util/pmix_environ.h"
+
+#include "simptest_common.h"
+
+static volatile int nconnected = 0;
+static volatile int nfinalized = 0;
+static volatile double last_connect = 0;
+
+static pmix_status_t connected(const pmix_proc_t *proc, void *server_object,
+                               pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    /* executes in the server's progress thread */
+    last_connect = simptest_ts();
+    ++nconnected;
+    return PMIX_OPERATION_SUCCEEDED;
+}
+
+static pmix_status_t finalized(const pmix_proc_t *proc, void *server_object,
+                               pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    ++nfinalized;
+    return PMIX_OPERATION_SUCCEEDED;
+}
+
+static pmix_server_module_t mymodule = {
+    .client_connected = connected,
+    .client_finalized = finalized
+};
+
+/* executes in the forked child: wait for the release
+ * and then connect to the server */
+static int run_client(int rdyfd, int gofd, int resfd)
+{
+    pmix_proc_t myproc;
+    pmix_status_t rc;
+    double start, init;
+    char c = 0;
+
+    if (sizeof(c) != write(rdyfd, &c, sizeof(c))) {
+        return 1;
+    }
+    close(rdyfd);
+    /* blocks until the server closes its end */
+    (void)read(gofd, &c, sizeof(c));
+    close(gofd);
+
+    start = simptest_ts();
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    init = simptest_ts() - start;
+    if (sizeof(init) != write(resfd, &init, sizeof(init))) {
+        PMIx_Finalize(NULL, 0);
+        return 1;
+    }
+    close(resfd);
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
+
+static int run_test(char *executable, int nprocs, int iter)
+{
+    pmix_status_t rc;
+    char nspace[PMIX_MAX_NSLEN+1], **env, **argv = NULL, *tmp;
+    int n, rdy[2], go[2], res[2];
+    double start, init, imin = 1.0e9, imax = 0, isum = 0;
+    struct timespec ts = {0, 100000};
+    char c;
+    pid_t pid;
+
+    snprintf(nspace, PMIX_MAX_NSLEN, "simpconnect-%d", iter);
+    if (PMIX_SUCCESS != (rc = simptest_register_nspace(nspace, nprocs))) {
+        fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+
+    if (0 != pipe(rdy) || 0 != pipe(go) || 0 != pipe(res)) {
+        return 1;
+    }
+    nconnected = 0;
+    nfinalized = 0;
+    for (n=0; n < nprocs; n++) {
+        if (0 != simptest_setup_client(nspace, n, &env)) {
+            return 1;
+        }
+        /* measure the TCP handshake */
+        pmix_setenv("PMIX_MCA_ptl", "tcp", true, &env);
+        argv = NULL;
+        pmix_argv_append_nosize(&argv, executable);
+        pmix_argv_append_nosize(&argv, "--client");
+        if (0 > asprintf(&tmp, "%d,%d,%d", rdy[1], go[0], res[1])) {
+            return 1;
+        }
+        pmix_argv_append_nosize(&argv, tmp);
+        free(tmp);
+        pid = fork();
+        if (pid < 0) {
+            fprintf(stderr, "Fork failed\n");
+            return 1;
+        }
+        if (0 == pid) {
+            close(rdy[0]);
+            close(go[1]);
+            close(res[0]);
+            execve(executable, argv, env);
+            _exit(1);
+        }
+        pmix_argv_free(argv);
+        pmix_argv_free(env);
+    }
+    close(rdy[1]);
+    close(go[0]);
+    close(res[1]);
+
+    /* wait for everyone to get to the barrier */
+    for (n=0; n < nprocs; n++) {
+        if (sizeof(c) != read(rdy[0], &c, sizeof(c))) {
+            fprintf(stderr, "Client failed to start\n");
+            return 1;
+        }
+    }
+    close(rdy[0]);
+
+    /* release them */
+    start = simptest_ts();
+    close(go[1]);
+    for (n=0; n < nprocs; n++) {
+        if (sizeof(init) != read(res[0], &init, sizeof(init))) {
+            fprintf(stderr, "Client failed to connect\n");
+            return 1;
+        }
+        isum += init;
+        imin = (init < imin) ? init : imin;
+        imax = (init > imax) ? init : imax;
+    }
+    close(res[0]);
+    while (nconnected < nprocs) {
+        nanosleep(&ts, NULL);
+    }
+    while (nfinalized < nprocs) {
+        nanosleep(&ts, NULL);
+    }
+    while (0 < wait(NULL));
+
+    fprintf(stdout, "%5d clients: all connected in %10.6f sec (%10.1f conn/sec)\n",
+            nprocs, last_connect - start, (double)nprocs / (last_connect - start));
+    fprintf(stdout, "               PMIx_Init %10.6f sec avg  %10.6f min  %10.6f max\n",
+            isum / nprocs, imin, imax);
+
+    PMIx_server_deregister_nspace(nspace, NULL, NULL);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    char **sizes = NULL, *executable;
+    int n, rdyfd, gofd, resfd, ret = 0;
+    struct rlimit rl;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (3 != sscanf(argv[2], "%d,%d,%d", &rdyfd, &gofd, &resfd)) {
+            return 1;
+        }
+        return run_client(rdyfd, gofd, resfd);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            sizes = pmix_argv_split(argv[++n], ',');
+        } else {
+            fprintf(stderr, "usage: %s [-n nclients[,nclients...]]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (NULL == sizes) {
+        sizes = pmix_argv_split("64,256,1024", ',');
+    }
+
+    /* every client holds a socket open */
+    if (0 == getrlimit(RLIMIT_NOFILE, &rl)) {
+        rl.rlim_cur = rl.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+
+    for (n=0; NULL != sizes[n]; n++) {
+        if (0 != (ret = run_test(executable, strtol(sizes[n], NULL, 10), n))) {
+            break;
+        }
+    }
+
+    pmix_argv_free(sizes);
+    free(executable);
+    PMIx_server_finalize();
+    return ret;
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of file monitoring. A set of local clients each
+ * create a number of files and ask the server to watch them for
+ * growth, then append to half of their files once a second for a
+ * while. The server should report each file that was left alone as
+ * stalled, and reports the CPU time it used and the context switches
+ * it made. Compare watching the files with inotify against polling
+ * them with, e.g.:
+ *
+ *     ./simpfile -n 8 -f 64 -t 6
+ *     PMIX_MCA_psensor_file_use_inotify=0 ./simpfile -n 8 -f 64 -t 6
+ *
+ * and run either under "strace -c -f" to count the system calls.
+ * With -r, each client keeps its files in a directory of its own
+ * and removes and recreates it early on, to check that monitoring
+ * recovers once the directory is back.
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "src/util/os_dirpath.h"
+
+#include "simptest_common.h"
+
+static pmix_server_module_t mymodule = {0};
+static volatile bool regdone = false;
+static volatile int nalerts = 0;
+
+static void alert_handler(size_t evhdlr_registration_id,
+                          pmix_status_t status,
+                          const pmix_proc_t *source,
+                          pmix_info_t info[], size_t ninfo,
+                          pmix_info_t results[], size_t nresults,
+                          pmix_event_notification_cbfunc_fn_t cbfunc,
+                          void *cbdata)
+{
+    ++nalerts;
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static void regcbfunc(pmix_status_t status, size_t ref, void *cbdata)
+{
+    regdone = true;
+}
+
+/* create the files, empty */
+static int create_files(const char *dir, pmix_rank_t rank, int nfiles)
+{
+    char *file;
+    FILE *fp;
+    int n;
+
+    for (n=0; n < nfiles; n++) {
+        if (0 > asprintf(&file, "%s/%d.%d", dir, rank, n)) {
+            return 1;
+        }
+        if (NULL == (fp = fopen(file, "w"))) {
+            fprintf(stderr, "Cannot create %s\n", file);
+            free(file);
+            return 1;
+        }
+        fclose(fp);
+        free(file);
+    }
+    return 0;
+}
+
+/* remove the directory holding the files and put it back */
+static int recreate_files(const char *dir, pmix_rank_t rank, int nfiles)
+{
+    char *file;
+    int n;
+
+    for (n=0; n < nfiles; n++) {
+        if (0 > asprintf(&file, "%s/%d.%d", dir, rank, n)) {
+            return 1;
+        }
+        unlink(file);
+        free(file);
+    }
+    if (0 != rmdir(dir) || 0 != mkdir(dir, 0700)) {
+        fprintf(stderr, "Cannot recreate %s\n", dir);
+        return 1;
+    }
+    return create_files(dir, rank, nfiles);
+}
+
+/* executes in the exec'd child */
+static int run_client(const char *topdir, int nfiles, int secs, int interval, bool recreate)
+{
+    pmix_proc_t myproc;
+    pmix_info_t monitor, directives[5];
+    pmix_status_t rc;
+    struct timespec ts;
+    double start, end;
+    uint32_t period = 1, drops = 3;
+    bool size = true;
+    char *file, *dir = NULL;
+    FILE *fp;
+    int n, ret = 0;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIX_INFO_LOAD(&directives[1], PMIX_MONITOR_FILE_SIZE, &size, PMIX_BOOL);
+    PMIX_INFO_LOAD(&directives[2], PMIX_MONITOR_FILE_CHECK_TIME, &period, PMIX_UINT32);
+    PMIX_INFO_LOAD(&directives[3], PMIX_MONITOR_FILE_DROPS, &drops, PMIX_UINT32);
+    PMIX_INFO_LOAD(&directives[4], PMIX_RANGE, NULL, PMIX_DATA_RANGE);
+    directives[4].value.data.range = PMIX_RANGE_NAMESPACE;
+    if (recreate) {
+        if (0 > asprintf(&dir, "%s/%d", topdir, myproc.rank) || 0 != mkdir(dir, 0700)) {
+            ret = 1;
+            goto done;
+        }
+    } else {
+        dir = strdup(topdir);
+    }
+    if (0 != create_files(dir, myproc.rank, nfiles)) {
+        ret = 1;
+        goto done;
+    }
+    for (n=0; n < nfiles; n++) {
+        if (0 > asprintf(&file, "%s/%d.%d", dir, myproc.rank, n)) {
+            ret = 1;
+            goto done;
+        }
+        PMIX_INFO_LOAD(&monitor, PMIX_MONITOR_FILE, file, PMIX_STRING);
+        PMIX_INFO_LOAD(&directives[0], PMIX_MONITOR_ID, file, PMIX_STRING);
+        free(file);
+        rc = PMIx_Process_monitor(&monitor, PMIX_MONITOR_FILE_ALERT, directives, 5);
+        PMIX_INFO_DESTRUCT(&monitor);
+        PMIX_INFO_DESTRUCT(&directives[0]);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client ns %s rank %d: monitor request failed: %s\n",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+            ret = 1;
+            goto done;
+        }
+    }
+
+    /* keep the even numbered files growing */
+    ts.tv_sec = interval / 1000;
+    ts.tv_nsec = (interval % 1000) * 1000000;
+    start = simptest_ts();
+    end = start + secs;
+    while (simptest_ts() < end) {
+        /* take the directory away before any file can have been
+         * idle long enough to be reported */
+        if (recreate && start + 1.5 < simptest_ts()) {
+            recreate = false;
+            if (0 != recreate_files(dir, myproc.rank, nfiles)) {
+                ret = 1;
+                goto done;
+            }
+        }
+        for (n=0; n < nfiles; n += 2) {
+            if (0 > asprintf(&file, "%s/%d.%d", dir, myproc.rank, n)) {
+                ret = 1;
+                goto done;
+            }
+            if (NULL != (fp = fopen(file, "a"))) {
+                fputc('x', fp);
+                fclose(fp);
+            }
+            free(file);
+        }
+        nanosleep(&ts, NULL);
+    }
+
+  done:
+    for (n=1; n < 5; n++) {
+        PMIX_INFO_DESTRUCT(&directives[n]);
+    }
+    if (NULL != dir) {
+        free(dir);
+    }
+    PMIx_Finalize(NULL, 0);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc, code = PMIX_MONITOR_FILE_ALERT;
+    char *executable, *tmp, *params;
+    char nspace[PMIX_MAX_NSLEN+1] = "simpfile";
+    char dir[] = "/tmp/simpfile.XXXXXX";
+    int n, nprocs = 4, nfiles = 16, secs = 6, interval = 250, recreate = 0, ret = 0;
+    int expected;
+    struct rusage ru;
+    pid_t pid;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (NULL == (tmp = strchr(argv[2], ',')) ||
+            4 != sscanf(tmp + 1, "%d,%d,%d,%d", &nfiles, &secs, &interval, &recreate)) {
+            return 1;
+        }
+        *tmp = '\0';
+        return run_client(argv[2], nfiles, secs, interval, 0 != recreate);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-f", argv[n]) && NULL != argv[n+1]) {
+            nfiles = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-t", argv[n]) && NULL != argv[n+1]) {
+            secs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-i", argv[n]) && NULL != argv[n+1]) {
+            interval = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-r", argv[n])) {
+            recreate = 1;
+        } else {
+            fprintf(stderr, "usage: %s [-n procs] [-f files-per-proc] [-t seconds] [-i msec-between-writes] [-r]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (nprocs < 1) {
+        nprocs = 1;
+    }
+    if (nfiles < 2) {
+        nfiles = 2;
+    }
+    /* the idle files need a few windows to be reported */
+    if (secs < 6) {
+        secs = 6;
+    }
+    if (recreate && secs < 8) {
+        /* they start again once recreated */
+        secs = 8;
+    }
+    if (interval < 1 || 500 < interval) {
+        interval = 250;
+    }
+
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (NULL == mkdtemp(dir)) {
+        fprintf(stderr, "Cannot create %s\n", dir);
+        exit(1);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+    regdone = false;
+    PMIx_Register_event_handler(&code, 1, NULL, 0, alert_handler, regcbfunc, NULL);
+    simptest_wait_for(&regdone);
+
+    if (PMIX_SUCCESS != (rc = simptest_register_nspace(nspace, nprocs))) {
+        fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+        ret = 1;
+        goto done;
+    }
+
+    if (0 > asprintf(&params, "%s,%d,%d,%d,%d", dir, nfiles, secs, interval, recreate)) {
+        ret = 1;
+        goto done;
+    }
+    for (n=0; n < nprocs; n++) {
+        if (0 != simptest_start_client(executable, nspace, n, params, &pid)) {
+            ret = 1;
+            break;
+        }
+    }
+    free(params);
+    if (0 != simptest_wait_clients()) {
+        ret = 1;
+    }
+
+    getrusage(RUSAGE_SELF, &ru);
+    fprintf(stdout, "Server CPU time: %10.6f sec user  %10.6f sec sys\n",
+            ru.ru_utime.tv_sec + 1.0e-6 * ru.ru_utime.tv_usec,
+            ru.ru_stime.tv_sec + 1.0e-6 * ru.ru_stime.tv_usec);
+    fprintf(stdout, "Server context switches: %ld voluntary  %ld involuntary\n",
+            ru.ru_nvcsw, ru.ru_nivcsw);
+    fprintf(stdout, "File alerts: %d\n", nalerts);
+    /* only the files that were left alone should have been reported */
+    expected = nprocs * (nfiles / 2);
+    if (nalerts != expected) {
+        fprintf(stderr, "Expected %d alerts\n", expected);
+        ret = 1;
+    }
+
+  done:
+    PMIx_server_deregister_nspace(nspace, NULL, NULL);
+    pmix_os_dirpath_destroy(dir, true, NULL);
+    free(executable);
+    PMIx_server_finalize();
+    return ret;
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of constructing and destructing many groups. A
+ * set of local clients is started and together they construct a
+ * large number of groups of varying size - each group contains a
+ * varying number of the local procs plus, for most groups, a varying
+ * number of procs from a job that lives elsewhere. All the groups
+ * stay in existence until every one of them has been constructed,
+ * and are then destructed. Rank 0 reports the average time per
+ * operation, e.g.:
+ *
+ *     ./simpgroup -n 4 -g 10000 -r 256
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "simptest_common.h"
+
+#define SIMPGROUP_REMOTE_NSPACE "simpgroup-remote"
+
+/* the remote members are not known to this server, so the group
+ * operations are passed up to the host - complete them at once */
+static pmix_status_t group_fn(pmix_group_operation_t op, char grp[],
+                              const pmix_proc_t procs[], size_t nprocs,
+                              const pmix_info_t directives[], size_t ndirs,
+                              pmix_info_cbfunc_t cbfunc, void *cbdata)
+{
+    return PMIX_OPERATION_SUCCEEDED;
+}
+
+static pmix_server_module_t mymodule = {
+    .group = group_fn
+};
+
+/* group g contains local ranks 0..(g % nlocal) plus a number of
+ * remote procs that cycles through 0..nremote */
+static size_t group_members(int g, int nlocal, int nremote,
+                            const char *nspace, pmix_proc_t *procs)
+{
+    size_t n = 0;
+    int r, nl, nr;
+
+    nl = (g % nlocal) + 1;
+    nr = (0 < nremote) ? (int)(((long)g * 37) % (nremote + 1)) : 0;
+    for (r=0; r < nl; r++) {
+        PMIX_LOAD_PROCID(&procs[n], nspace, r);
+        ++n;
+    }
+    for (r=0; r < nr; r++) {
+        PMIX_LOAD_PROCID(&procs[n], SIMPGROUP_REMOTE_NSPACE, r);
+        ++n;
+    }
+    return n;
+}
+
+/* executes in the exec'd child */
+static int run_client(int nlocal, int ngroups, int nremote)
+{
+    pmix_proc_t myproc, *procs;
+    pmix_info_t info, *results;
+    pmix_status_t rc;
+    char grpid[64];
+    size_t nprocs, nresults;
+    int g, nops = 0, ret = 0;
+    double start, cons, dest;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIX_PROC_CREATE(procs, nlocal + nremote);
+    PMIX_INFO_LOAD(&info, PMIX_EMBED_BARRIER, NULL, PMIX_BOOL);
+    info.value.data.flag = false;
+
+    /* construct every group we belong to */
+    start = simptest_ts();
+    for (g=0; g < ngroups; g++) {
+        if ((int)myproc.rank > (g % nlocal)) {
+            continue;
+        }
+        nprocs = group_members(g, nlocal, nremote, myproc.nspace, procs);
+        (void)snprintf(grpid, sizeof(grpid), "simpgroup-%d", g);
+        results = NULL;
+        nresults = 0;
+        rc = PMIx_Group_construct(grpid, procs, nprocs, &info, 1, &results, &nresults);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client ns %s rank %d: construct of %s failed: %s\n",
+                    myproc.nspace, myproc.rank, grpid, PMIx_Error_string(rc));
+            ret = 1;
+            goto done;
+        }
+        if (NULL != results) {
+            PMIX_INFO_FREE(results, nresults);
+        }
+        ++nops;
+    }
+    cons = simptest_ts() - start;
+
+    /* and destruct them all again */
+    start = simptest_ts();
+    for (g=0; g < ngroups; g++) {
+        if ((int)myproc.rank > (g % nlocal)) {
+            continue;
+        }
+        (void)snprintf(grpid, sizeof(grpid), "simpgroup-%d", g);
+        rc = PMIx_Group_destruct(grpid, NULL, 0);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client ns %s rank %d: destruct of %s failed: %s\n",
+                    myproc.nspace, myproc.rank, grpid, PMIx_Error_string(rc));
+            ret = 1;
+            goto done;
+        }
+    }
+    dest = simptest_ts() - start;
+
+    if (0 == myproc.rank) {
+        fprintf(stdout, "Constructed %d groups: %10.6f sec total  %10.6f sec/op\n",
+                nops, cons, cons / nops);
+        fprintf(stdout, "Destructed %d groups:  %10.6f sec total  %10.6f sec/op\n",
+                nops, dest, dest / nops);
+    }
+
+  done:
+    PMIX_INFO_DESTRUCT(&info);
+    PMIX_PROC_FREE(procs, nlocal + nremote);
+    PMIx_Finalize(NULL, 0);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    char *executable, *params;
+    char nspace[PMIX_MAX_NSLEN+1] = "simpgroup";
+    int n, nprocs = 4, ngroups = 10000, nremote = 256, ret = 0;
+    pid_t pid;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (3 != sscanf(argv[2], "%d,%d,%d", &nprocs, &ngroups, &nremote)) {
+            return 1;
+        }
+        return run_client(nprocs, ngroups, nremote);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-g", argv[n]) && NULL != argv[n+1]) {
+            ngroups = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-r", argv[n]) && NULL != argv[n+1]) {
+            nremote = strtol(argv[++n], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n local-procs] [-g groups] [-r max-remote-members]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (nprocs < 1) {
+        nprocs = 1;
+    }
+    if (ngroups < 1) {
+        ngroups = 1;
+    }
+    if (nremote < 0) {
+        nremote = 0;
+    }
+
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+
+    if (PMIX_SUCCESS != (rc = simptest_register_nspace(nspace, nprocs))) {
+        fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+        ret = 1;
+        goto done;
+    }
+
+    if (0 > asprintf(&params, "%d,%d,%d", nprocs, ngroups, nremote)) {
+        ret = 1;
+        goto done;
+    }
+    for (n=0; n < nprocs; n++) {
+        if (0 != simptest_start_client(executable, nspace, n, params, &pid)) {
+            ret = 1;
+            break;
+        }
+    }
+    free(params);
+    if (0 != simptest_wait_clients()) {
+        ret = 1;
+    }
+
+  done:
+    PMIx_server_deregister_nspace(nspace, NULL, NULL);
+    free(executable);
+    PMIx_server_finalize();
+    return ret;
+}
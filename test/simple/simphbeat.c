@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of heartbeat monitoring. A set of local clients
+ * each ask the server to monitor them with heartbeats and then beat
+ * at a fixed interval for a while. The last client stops beating
+ * part way through so that the server should report it as stalled.
+ * Rank 0 reports the time spent in each PMIx_Heartbeat call and the
+ * server reports the CPU time it used and the alerts it raised.
+ * Compare counting beats in shared memory with sending them with,
+ * e.g.:
+ *
+ *     ./simphbeat -n 8 -t 5 -i 100
+ *     PMIX_MCA_psensor_heartbeat_use_shmem=0 ./simphbeat -n 8 -t 5 -i 100
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "simptest_common.h"
+
+static pmix_server_module_t mymodule = {0};
+static volatile bool regdone = false;
+static volatile int nalerts = 0;
+static volatile pmix_rank_t alerted = PMIX_RANK_UNDEF;
+
+static void alert_handler(size_t evhdlr_registration_id,
+                          pmix_status_t status,
+                          const pmix_proc_t *source,
+                          pmix_info_t info[], size_t ninfo,
+                          pmix_info_t results[], size_t nresults,
+                          pmix_event_notification_cbfunc_fn_t cbfunc,
+                          void *cbdata)
+{
+    ++nalerts;
+    alerted = source->rank;
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static void regcbfunc(pmix_status_t status, size_t ref, void *cbdata)
+{
+    regdone = true;
+}
+
+/* executes in the exec'd child */
+static int run_client(int nprocs, int secs, int interval)
+{
+    pmix_proc_t myproc;
+    pmix_info_t monitor, directives[2];
+    pmix_status_t rc;
+    struct timespec ts;
+    double start, end, t, tsum = 0;
+    long nbeats = 0;
+    uint32_t period = 1;
+    bool stall;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIX_INFO_LOAD(&monitor, PMIX_MONITOR_HEARTBEAT, NULL, PMIX_POINTER);
+    PMIX_INFO_LOAD(&directives[0], PMIX_MONITOR_ID, "simphbeat", PMIX_STRING);
+    PMIX_INFO_LOAD(&directives[1], PMIX_MONITOR_HEARTBEAT_TIME, &period, PMIX_UINT32);
+    rc = PMIx_Process_monitor(&monitor, PMIX_MONITOR_HEARTBEAT_ALERT, directives, 2);
+    PMIX_INFO_DESTRUCT(&monitor);
+    PMIX_INFO_DESTRUCT(&directives[0]);
+    PMIX_INFO_DESTRUCT(&directives[1]);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "Client ns %s rank %d: monitor request failed: %s\n",
+                myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+        PMIx_Finalize(NULL, 0);
+        return 1;
+    }
+
+    /* the last proc stops beating half way through */
+    stall = (1 < nprocs && (int)myproc.rank == nprocs - 1);
+    ts.tv_sec = interval / 1000000;
+    ts.tv_nsec = (interval % 1000000) * 1000;
+    start = simptest_ts();
+    end = start + (stall ? secs / 2.0 : secs);
+    while (simptest_ts() < end) {
+        t = simptest_ts();
+        PMIx_Heartbeat();
+        tsum += simptest_ts() - t;
+        ++nbeats;
+        nanosleep(&ts, NULL);
+    }
+    if (stall) {
+        /* stay connected until we are sure to have been noticed */
+        sleep(secs - secs / 2 + 2);
+    }
+
+    if (0 == myproc.rank) {
+        fprintf(stdout, "Sent %ld heartbeats: %10.6f usec/beat\n",
+                nbeats, (0 < nbeats) ? 1.0e6 * tsum / nbeats : 0.0);
+    }
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc, code = PMIX_MONITOR_HEARTBEAT_ALERT;
+    char *executable, *params;
+    char nspace[PMIX_MAX_NSLEN+1] = "simphbeat";
+    int n, nprocs = 4, secs = 4, interval = 1000, ret = 0;
+    struct rusage ru;
+    pid_t pid;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (3 != sscanf(argv[2], "%d,%d,%d", &nprocs, &secs, &interval)) {
+            return 1;
+        }
+        return run_client(nprocs, secs, interval);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-t", argv[n]) && NULL != argv[n+1]) {
+            secs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-i", argv[n]) && NULL != argv[n+1]) {
+            interval = strtol(argv[++n], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n procs] [-t seconds] [-i usec-between-beats]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (nprocs < 1) {
+        nprocs = 1;
+    }
+    if (secs < 4) {
+        secs = 4;
+    }
+    if (interval < 1) {
+        interval = 1;
+    }
+
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+    regdone = false;
+    PMIx_Register_event_handler(&code, 1, NULL, 0, alert_handler, regcbfunc, NULL);
+    simptest_wait_for(&regdone);
+
+    if (PMIX_SUCCESS != (rc = simptest_register_nspace(nspace, nprocs))) {
+        fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+        ret = 1;
+        goto done;
+    }
+
+    if (0 > asprintf(&params, "%d,%d,%d", nprocs, secs, interval)) {
+        ret = 1;
+        goto done;
+    }
+    for (n=0; n < nprocs; n++) {
+        if (0 != simptest_start_client(executable, nspace, n, params, &pid)) {
+            ret = 1;
+            break;
+        }
+    }
+    free(params);
+    if (0 != simptest_wait_clients()) {
+        ret = 1;
+    }
+
+    getrusage(RUSAGE_SELF, &ru);
+    fprintf(stdout, "Server CPU time: %10.6f sec user  %10.6f sec sys\n",
+            ru.ru_utime.tv_sec + 1.0e-6 * ru.ru_utime.tv_usec,
+            ru.ru_stime.tv_sec + 1.0e-6 * ru.ru_stime.tv_usec);
+    fprintf(stdout, "Heartbeat alerts: %d\n", nalerts);
+    /* only the proc that stopped beating should have been reported */
+    if (1 < nprocs && (1 != nalerts || alerted != (pmix_rank_t)(nprocs - 1))) {
+        fprintf(stderr, "Expected a single alert for rank %d\n", nprocs - 1);
+        ret = 1;
+    }
+
+  done:
+    PMIx_server_deregister_nspace(nspace, NULL, NULL);
+    free(executable);
+    PMIx_server_finalize();
+    return ret;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of PMIx_Init in a freshly exec'd client. Each
+ * client is started in turn and reports the wall time spent in
+ * PMIx_Init. One additional client is then run under ptrace (where
+ * supported) to count the system calls it makes during PMIx_Init.
+ * Compare directory scanning against the install-time component
+ * manifest with, e.g.:
+ *
+ *     ./simpinit -i 20
+ *     PMIX_MCA_mca_base_component_use_manifest=0 ./simpinit -i 20
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sys/ptrace.h>
+#endif
+
+#include "simptest_common.h"
+
+static pmix_server_module_t mymodule = {0};
+
+/* executes in the exec'd child */
+static int run_client(int resfd, int trace)
+{
+    pmix_proc_t myproc;
+    pmix_status_t rc;
+    double start, init;
+
+#ifdef __linux__
+    if (trace && 0 != ptrace(PTRACE_TRACEME, 0, NULL, NULL)) {
+        trace = 0;
+    }
+#else
+    trace = 0;
+#endif
+    /* the stops bracket the region the server counts */
+    if (trace) {
+        raise(SIGSTOP);
+    }
+    start = simptest_ts();
+    rc = PMIx_Init(&myproc, NULL, 0);
+    init = simptest_ts() - start;
+    if (trace) {
+        raise(SIGSTOP);
+    }
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    if (sizeof(init) != write(resfd, &init, sizeof(init))) {
+        PMIx_Finalize(NULL, 0);
+        return 1;
+    }
+    close(resfd);
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
+
+/* count the syscalls made by every thread of the child between
+ * its two SIGSTOPs, returning -1 if it could not be traced */
+static long count_syscalls(pid_t pid)
+{
+    long nsys = -1;
+#ifdef __linux__
+    int status, sig, nstops = 0;
+    bool counting = false;
+    pid_t tid;
+
+    while (0 < (tid = waitpid(-1, &status, __WALL))) {
+        if (WIFEXITED(status) || WIFSIGNALED(status)) {
+            if (tid == pid) {
+                break;
+            }
+            continue;
+        }
+        if (!WIFSTOPPED(status)) {
+            continue;
+        }
+        sig = WSTOPSIG(status);
+        if (tid == pid && SIGSTOP == sig && nstops < 2) {
+            if (0 == nstops++) {
+                ptrace(PTRACE_SETOPTIONS, pid, NULL,
+                       (void*)(long)(PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE));
+                counting = true;
+                nsys = 0;
+            } else {
+                counting = false;
+            }
+            sig = 0;
+        } else if ((SIGTRAP | 0x80) == sig) {
+            /* each syscall stops once on entry and once on exit */
+            if (counting) {
+                ++nsys;
+            }
+            sig = 0;
+        } else if (SIGTRAP == sig && 0 != (status >> 16)) {
+            /* clone event */
+            sig = 0;
+        } else if (SIGSTOP == sig && tid != pid) {
+            /* initial stop of a new thread */
+            sig = 0;
+        }
+        ptrace(counting ? PTRACE_SYSCALL : PTRACE_CONT, tid, NULL, (void*)(long)sig);
+    }
+    if (0 < nsys) {
+        nsys /= 2;
+    }
+#else
+    waitpid(pid, NULL, 0);
+#endif
+    return nsys;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    char *executable, *params;
+    char nspace[PMIX_MAX_NSLEN+1] = "simpinit";
+    int n, res[2], resfd, trace, niters = 10, nprocs, ret = 0;
+    double init, imin = 1.0e9, imax = 0, isum = 0;
+    long nsys;
+    pid_t pid;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (2 != sscanf(argv[2], "%d,%d", &resfd, &trace)) {
+            return 1;
+        }
+        return run_client(resfd, trace);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-i", argv[n]) && NULL != argv[n+1]) {
+            niters = strtol(argv[++n], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-i iterations]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (niters < 1) {
+        niters = 1;
+    }
+    /* the extra proc is the traced one */
+    nprocs = niters + 1;
+
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+
+    if (PMIX_SUCCESS != (rc = simptest_register_nspace(nspace, nprocs))) {
+        fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+        ret = 1;
+        goto done;
+    }
+
+    /* time PMIx_Init in each client, one at a time */
+    for (n=0; n < nprocs; n++) {
+        trace = (n == niters);
+        if (0 != pipe(res)) {
+            ret = 1;
+            goto done;
+        }
+        if (0 > asprintf(&params, "%d,%d", res[1], trace)) {
+            ret = 1;
+            goto done;
+        }
+        if (0 != simptest_start_client(executable, nspace, n, params, &pid)) {
+            free(params);
+            ret = 1;
+            goto done;
+        }
+        free(params);
+        close(res[1]);
+        nsys = trace ? count_syscalls(pid) : 0;
+        if (sizeof(init) != read(res[0], &init, sizeof(init))) {
+            fprintf(stderr, "Client failed to initialize\n");
+            close(res[0]);
+            ret = 1;
+            goto done;
+        }
+        close(res[0]);
+        while (0 < waitpid(-1, NULL, 0));
+        if (trace) {
+            break;
+        }
+        isum += init;
+        imin = (init < imin) ? init : imin;
+        imax = (init > imax) ? init : imax;
+    }
+
+    fprintf(stdout, "PMIx_Init over %d clients: %10.6f sec avg  %10.6f min  %10.6f max\n",
+            niters, isum / niters, imin, imax);
+    if (0 > nsys) {
+        fprintf(stdout, "PMIx_Init syscalls: unavailable (cannot trace the client)\n");
+    } else {
+        fprintf(stdout, "PMIx_Init syscalls: %ld\n", nsys);
+    }
+
+  done:
+    PMIx_server_deregister_nspace(nspace, NULL, NULL);
+    free(executable);
+    PMIx_server_finalize();
+    return ret;
+}
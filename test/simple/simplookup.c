@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure how quickly a waiting lookup sees published data when the
+ * server keeps it in its own datastore - the host here provides no
+ * publish/lookup support at all. Rank 1 publishes a series of keys
+ * at a fixed interval, each carrying the time it was published, and
+ * rank 0 looks each one up as it goes, either asking the server to
+ * wait for it or by polling. Rank 0 reports the time between each
+ * publish and the lookup that returned it, and checks that data is
+ * only visible within its range and is gone once unpublished. E.g.:
+ *
+ *     ./simplookup -i 1000 -d 2000
+ *     ./simplookup -i 1000 -d 2000 -p
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "simptest_common.h"
+
+static pmix_server_module_t mymodule = {0};
+
+static pmix_status_t publish(const char *key, pmix_value_t *val, pmix_data_range_t range)
+{
+    pmix_info_t info[2];
+    pmix_status_t rc;
+
+    PMIX_INFO_CONSTRUCT(&info[0]);
+    PMIX_LOAD_KEY(info[0].key, key);
+    pmix_value_xfer(&info[0].value, val);
+    PMIX_INFO_LOAD(&info[1], PMIX_RANGE, &range, PMIX_DATA_RANGE);
+    rc = PMIx_Publish(info, 2);
+    PMIX_INFO_DESTRUCT(&info[0]);
+    PMIX_INFO_DESTRUCT(&info[1]);
+    return rc;
+}
+
+/* look the key up, waiting up to timeout secs for it to be
+ * published if wait is set */
+static pmix_status_t lookup(const char *key, bool wait, int timeout, pmix_pdata_t *pdata)
+{
+    pmix_info_t info[2];
+    pmix_status_t rc;
+    int all = 0;
+    size_t ninfo = 0;
+
+    PMIX_PDATA_CONSTRUCT(pdata);
+    PMIX_LOAD_KEY(pdata->key, key);
+    if (wait) {
+        PMIX_INFO_LOAD(&info[0], PMIX_WAIT, &all, PMIX_INT);
+        PMIX_INFO_LOAD(&info[1], PMIX_TIMEOUT, &timeout, PMIX_INT);
+        ninfo = 2;
+    }
+    rc = PMIx_Lookup(pdata, 1, (0 < ninfo) ? info : NULL, ninfo);
+    if (wait) {
+        PMIX_INFO_DESTRUCT(&info[0]);
+        PMIX_INFO_DESTRUCT(&info[1]);
+    }
+    return rc;
+}
+
+static int run_publisher(pmix_proc_t *myproc, int iters, int interval)
+{
+    pmix_value_t val;
+    pmix_pdata_t pdata;
+    char key[PMIX_MAX_KEYLEN+1], *keys[2] = {"simplookup.ns", NULL};
+    struct timespec ts;
+    int n;
+
+    /* something only we can see, then something our nspace can */
+    val.type = PMIX_INT;
+    val.data.integer = myproc->rank;
+    if (PMIX_SUCCESS != publish("simplookup.private", &val, PMIX_RANGE_PROC_LOCAL) ||
+        PMIX_SUCCESS != publish("simplookup.ns", &val, PMIX_RANGE_NAMESPACE)) {
+        fprintf(stderr, "Rank %d: publish failed\n", myproc->rank);
+        return 1;
+    }
+
+    ts.tv_sec = interval / 1000000;
+    ts.tv_nsec = (interval % 1000000) * 1000;
+    for (n=0; n < iters; n++) {
+        nanosleep(&ts, NULL);
+        snprintf(key, sizeof(key), "simplookup.%d", n);
+        val.type = PMIX_DOUBLE;
+        val.data.dval = simptest_ts();
+        if (PMIX_SUCCESS != publish(key, &val, PMIX_RANGE_LOCAL)) {
+            fprintf(stderr, "Rank %d: publish of %s failed\n", myproc->rank, key);
+            return 1;
+        }
+    }
+
+    /* once the reader is done, withdraw the nspace data */
+    if (PMIX_SUCCESS != lookup("simplookup.done", true, 60, &pdata)) {
+        fprintf(stderr, "Rank %d: reader never finished\n", myproc->rank);
+        return 1;
+    }
+    PMIX_PDATA_DESTRUCT(&pdata);
+    if (PMIX_SUCCESS != PMIx_Unpublish(keys, NULL, 0)) {
+        fprintf(stderr, "Rank %d: unpublish failed\n", myproc->rank);
+        return 1;
+    }
+    val.type = PMIX_INT;
+    val.data.integer = 1;
+    if (PMIX_SUCCESS != publish("simplookup.gone", &val, PMIX_RANGE_LOCAL)) {
+        return 1;
+    }
+    return 0;
+}
+
+static int run_reader(pmix_proc_t *myproc, int iters, bool poll)
+{
+    pmix_value_t val;
+    pmix_pdata_t pdata;
+    pmix_status_t rc;
+    char key[PMIX_MAX_KEYLEN+1];
+    struct timespec ts = {0, 1000000};
+    double t, tsum = 0, tmax = 0;
+    int n, ret = 0;
+
+    /* once the nspace data is there, so is the private data */
+    if (PMIX_SUCCESS != (rc = lookup("simplookup.ns", true, 60, &pdata))) {
+        fprintf(stderr, "Lookup of nspace data failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIX_PDATA_DESTRUCT(&pdata);
+    if (PMIX_ERR_NOT_FOUND != (rc = lookup("simplookup.private", false, 0, &pdata))) {
+        fprintf(stderr, "Lookup of private data returned %s\n", PMIx_Error_string(rc));
+        ret = 1;
+    }
+    PMIX_PDATA_DESTRUCT(&pdata);
+
+    for (n=0; n < iters; n++) {
+        snprintf(key, sizeof(key), "simplookup.%d", n);
+        if (poll) {
+            while (PMIX_ERR_NOT_FOUND == (rc = lookup(key, false, 0, &pdata))) {
+                PMIX_PDATA_DESTRUCT(&pdata);
+                nanosleep(&ts, NULL);
+            }
+        } else {
+            rc = lookup(key, true, 60, &pdata);
+        }
+        t = simptest_ts();
+        if (PMIX_SUCCESS != rc || PMIX_DOUBLE != pdata.value.type) {
+            fprintf(stderr, "Lookup of %s failed: %s\n", key, PMIx_Error_string(rc));
+            PMIX_PDATA_DESTRUCT(&pdata);
+            return 1;
+        }
+        t -= pdata.value.data.dval;
+        tsum += t;
+        if (tmax < t) {
+            tmax = t;
+        }
+        PMIX_PDATA_DESTRUCT(&pdata);
+    }
+    fprintf(stdout, "Looked up %d keys by %s: %10.3f usec mean %10.3f usec max from publish\n",
+            iters, poll ? "polling" : "waiting", 1.0e6 * tsum / iters, 1.0e6 * tmax);
+
+    /* let the publisher withdraw its nspace data */
+    val.type = PMIX_INT;
+    val.data.integer = 1;
+    if (PMIX_SUCCESS != publish("simplookup.done", &val, PMIX_RANGE_LOCAL)) {
+        return 1;
+    }
+    if (PMIX_SUCCESS != (rc = lookup("simplookup.gone", true, 60, &pdata))) {
+        fprintf(stderr, "Lookup of final data failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIX_PDATA_DESTRUCT(&pdata);
+    if (PMIX_ERR_NOT_FOUND != (rc = lookup("simplookup.ns", false, 0, &pdata))) {
+        fprintf(stderr, "Lookup of unpublished data returned %s\n", PMIx_Error_string(rc));
+        ret = 1;
+    }
+    PMIX_PDATA_DESTRUCT(&pdata);
+
+    /* a wait for something that never comes must time out */
+    t = simptest_ts();
+    if (PMIX_ERR_TIMEOUT != (rc = lookup("simplookup.never", true, 1, &pdata))) {
+        fprintf(stderr, "Lookup of missing data returned %s\n", PMIx_Error_string(rc));
+        ret = 1;
+    }
+    PMIX_PDATA_DESTRUCT(&pdata);
+    if (simptest_ts() - t < 0.9) {
+        fprintf(stderr, "Lookup of missing data did not wait\n");
+        ret = 1;
+    }
+    return ret;
+}
+
+/* executes in the exec'd child */
+static int run_client(int iters, int interval, bool poll)
+{
+    pmix_proc_t myproc;
+    pmix_status_t rc;
+    int ret;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    if (0 == myproc.rank) {
+        ret = run_reader(&myproc, iters, poll);
+    } else {
+        ret = run_publisher(&myproc, iters, interval);
+    }
+    PMIx_Finalize(NULL, 0);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    char *executable, *params;
+    char nspace[PMIX_MAX_NSLEN+1] = "simplookup";
+    int n, nprocs = 2, iters = 1000, interval = 1000, poll = 0, ret = 0;
+    pid_t pid;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (3 != sscanf(argv[2], "%d,%d,%d", &iters, &interval, &poll)) {
+            return 1;
+        }
+        return run_client(iters, interval, 0 != poll);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-i", argv[n]) && NULL != argv[n+1]) {
+            iters = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-d", argv[n]) && NULL != argv[n+1]) {
+            interval = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-p", argv[n])) {
+            poll = 1;
+        } else {
+            fprintf(stderr, "usage: %s [-i iterations] [-d usec-between-publishes] [-p]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (iters < 1) {
+        iters = 1;
+    }
+    if (interval < 0) {
+        interval = 0;
+    }
+
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    /* the host has no datastore, so the server must keep the data */
+    setenv("PMIX_MCA_pmix_server_local_datastore", "1", 0);
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+
+    if (PMIX_SUCCESS != (rc = simptest_register_nspace(nspace, nprocs))) {
+        fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+        ret = 1;
+        goto done;
+    }
+
+    if (0 > asprintf(&params, "%d,%d,%d", iters, interval, poll)) {
+        ret = 1;
+        goto done;
+    }
+    for (n=0; n < nprocs; n++) {
+        if (0 != simptest_start_client(executable, nspace, n, params, &pid)) {
+            ret = 1;
+            break;
+        }
+    }
+    free(params);
+    if (0 != simptest_wait_clients()) {
+        ret = 1;
+    }
+
+  done:
+    PMIx_server_deregister_nspace(nspace, NULL, NULL);
+    free(executable);
+    PMIx_server_finalize();
+    return ret;
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the query cache. A set of local clients each repeatedly
+ * ask for the proc table of their job, which the host answers after
+ * a short delay to stand in for a trip to the resource manager. The
+ * queries carry a PMIX_QUERY_CACHE_TTL so that repeats are answered
+ * from the server's cache until it expires - the proc table changes
+ * as nspaces come and go, so the clients don't cache it themselves. Rank 0 reports the time taken by
+ * each query and the server reports how many reached the host, then
+ * registers another nspace and checks that this drops the cache.
+ * The host answers with a list of the registered namespaces so the
+ * staleness of an answer can be seen.
+ * Compare against going to the host every time with, e.g.:
+ *
+ *     ./simpqcache -n 8 -q 1000 -T 10
+ *     ./simpqcache -n 8 -q 1000 -T 0
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "src/util/argv.h"
+
+#include "simptest_common.h"
+
+static pmix_status_t query_fn(pmix_proc_t *proct,
+                              pmix_query_t *queries, size_t nqueries,
+                              pmix_info_cbfunc_t cbfunc,
+                              void *cbdata);
+
+static pmix_server_module_t mymodule = {
+    .query = query_fn
+};
+static volatile int nhost = 0;
+static char *namespaces = NULL;
+
+static void relfn(void *cbdata)
+{
+    pmix_info_t *info = (pmix_info_t*)cbdata;
+
+    PMIX_INFO_FREE(info, 1);
+}
+
+static pmix_status_t query_fn(pmix_proc_t *proct,
+                              pmix_query_t *queries, size_t nqueries,
+                              pmix_info_cbfunc_t cbfunc,
+                              void *cbdata)
+{
+    struct timespec ts = {0, 200000};
+    pmix_info_t *info;
+
+    ++nhost;
+    /* the time taken to ask the resource manager */
+    nanosleep(&ts, NULL);
+    PMIX_INFO_CREATE(info, 1);
+    PMIX_INFO_LOAD(&info[0], PMIX_QUERY_PROC_TABLE, namespaces, PMIX_STRING);
+    cbfunc(PMIX_SUCCESS, info, 1, cbdata, relfn, info);
+    return PMIX_SUCCESS;
+}
+
+typedef struct {
+    volatile bool done;
+    pmix_status_t status;
+    char *answer;
+} query_result_t;
+
+static void infocbfunc(pmix_status_t status, pmix_info_t *info, size_t ninfo,
+                       void *cbdata, pmix_release_cbfunc_t release_fn,
+                       void *release_cbdata)
+{
+    query_result_t *res = (query_result_t*)cbdata;
+
+    res->status = status;
+    if (PMIX_SUCCESS == status && 1 == ninfo && PMIX_STRING == info[0].value.type) {
+        res->answer = strdup(info[0].value.data.string);
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    res->done = true;
+}
+
+/* ask for the proc table of a job */
+static pmix_status_t query_table(const char *nspace, uint32_t ttl, char **answer)
+{
+    pmix_query_t query;
+    query_result_t res = {false, PMIX_SUCCESS, NULL};
+    pmix_status_t rc;
+
+    PMIX_QUERY_CONSTRUCT(&query);
+    pmix_argv_append_nosize(&query.keys, PMIX_QUERY_PROC_TABLE);
+    PMIX_QUERY_QUALIFIERS_CREATE(&query, 2);
+    PMIX_INFO_LOAD(&query.qualifiers[0], PMIX_NSPACE, nspace, PMIX_STRING);
+    PMIX_INFO_LOAD(&query.qualifiers[1], PMIX_QUERY_CACHE_TTL, &ttl, PMIX_UINT32);
+    rc = PMIx_Query_info_nb(&query, 1, infocbfunc, &res);
+    if (PMIX_SUCCESS == rc) {
+        simptest_wait_for(&res.done);
+        rc = res.status;
+    }
+    PMIX_QUERY_DESTRUCT(&query);
+    if (PMIX_SUCCESS == rc && NULL == res.answer) {
+        rc = PMIX_ERR_NOT_FOUND;
+    }
+    *answer = res.answer;
+    return rc;
+}
+
+/* executes in the exec'd child */
+static int run_client(int nqueries, uint32_t ttl)
+{
+    pmix_proc_t myproc;
+    pmix_status_t rc;
+    double t, tsum = 0, tfirst = 0;
+    char *answer;
+    int n, ret = 0;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "Client init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    for (n=0; n < nqueries; n++) {
+        t = simptest_ts();
+        rc = query_table(myproc.nspace, ttl, &answer);
+        t = simptest_ts() - t;
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client ns %s rank %d: query failed: %s\n",
+                    myproc.nspace, myproc.rank, PMIx_Error_string(rc));
+            ret = 1;
+            break;
+        }
+        if (0 != strcmp(answer, myproc.nspace)) {
+            fprintf(stderr, "Client ns %s rank %d: unexpected answer %s\n",
+                    myproc.nspace, myproc.rank, answer);
+            ret = 1;
+        }
+        free(answer);
+        if (0 == n) {
+            tfirst = t;
+        } else {
+            tsum += t;
+        }
+    }
+    if (0 == myproc.rank && 1 < nqueries && 0 == ret) {
+        fprintf(stdout, "First query: %10.6f usec  later queries: %10.6f usec/query\n",
+                1.0e6 * tfirst, 1.0e6 * tsum / (nqueries - 1));
+    }
+    PMIx_Finalize(NULL, 0);
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    char *executable, *params, *answer;
+    char nspace[PMIX_MAX_NSLEN+1] = "simpqcache";
+    int n, nprocs = 4, nqueries = 100, ttl = 10, ret = 0;
+    int before;
+    pid_t pid;
+
+    if (3 == argc && 0 == strcmp("--client", argv[1])) {
+        if (2 != sscanf(argv[2], "%d,%d", &nqueries, &ttl)) {
+            return 1;
+        }
+        return run_client(nqueries, (uint32_t)ttl);
+    }
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-q", argv[n]) && NULL != argv[n+1]) {
+            nqueries = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-T", argv[n]) && NULL != argv[n+1]) {
+            ttl = strtol(argv[++n], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n procs] [-q queries-per-proc] [-T cache-ttl-secs]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (nprocs < 1) {
+        nprocs = 1;
+    }
+    if (nqueries < 1) {
+        nqueries = 1;
+    }
+    if (ttl < 0) {
+        ttl = 0;
+    }
+
+    if (NULL == (executable = realpath(argv[0], NULL))) {
+        fprintf(stderr, "Cannot locate executable\n");
+        exit(1);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+    namespaces = strdup(nspace);
+    if (PMIX_SUCCESS != (rc = simptest_register_nspace(nspace, nprocs))) {
+        fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+        ret = 1;
+        goto done;
+    }
+
+    if (0 > asprintf(&params, "%d,%d", nqueries, ttl)) {
+        ret = 1;
+        goto done;
+    }
+    for (n=0; n < nprocs; n++) {
+        if (0 != simptest_start_client(executable, nspace, n, params, &pid)) {
+            ret = 1;
+            break;
+        }
+    }
+    free(params);
+    if (0 != simptest_wait_clients()) {
+        ret = 1;
+    }
+
+    fprintf(stdout, "Queries reaching the host: %d of %d\n", nhost, nprocs * nqueries);
+    if (0 == ttl) {
+        if (nhost != nprocs * nqueries) {
+            fprintf(stderr, "Uncached queries should all reach the host\n");
+            ret = 1;
+        }
+        goto done;
+    }
+    /* each client may miss once before the cache is filled,
+     * and the server may also have to refill it - but the
+     * run is too short for it to expire more than once */
+    if (nhost > 2 * nprocs + 2) {
+        fprintf(stderr, "Too many queries reached the host\n");
+        ret = 1;
+    }
+
+    /* a repeat should now be cached here too */
+    before = nhost;
+    if (PMIX_SUCCESS != (rc = query_table(nspace, ttl, &answer))) {
+        fprintf(stderr, "Server query failed: %s\n", PMIx_Error_string(rc));
+        ret = 1;
+        goto done;
+    }
+    free(answer);
+    if (PMIX_SUCCESS != (rc = query_table(nspace, ttl, &answer))) {
+        ret = 1;
+        goto done;
+    }
+    free(answer);
+    if (nhost > before + 1) {
+        fprintf(stderr, "Repeated server query was not cached\n");
+        ret = 1;
+    }
+
+    /* a new nspace must drop the cached answer */
+    free(namespaces);
+    if (0 > asprintf(&namespaces, "%s,%s.2", nspace, nspace)) {
+        ret = 1;
+        goto done;
+    }
+    if (0 > asprintf(&params, "%s.2", nspace) ||
+        PMIX_SUCCESS != simptest_register_nspace(params, 1)) {
+        ret = 1;
+        goto done;
+    }
+    before = nhost;
+    if (PMIX_SUCCESS != (rc = query_table(nspace, ttl, &answer))) {
+        ret = 1;
+        goto done;
+    }
+    if (nhost != before + 1 || 0 != strcmp(answer, namespaces)) {
+        fprintf(stderr, "Registering an nspace did not invalidate the cache\n");
+        ret = 1;
+    }
+    free(answer);
+    PMIx_server_deregister_nspace(params, NULL, NULL);
+    free(params);
+
+  done:
+    PMIx_server_deregister_nspace(nspace, NULL, NULL);
+    free(executable);
+    PMIx_server_finalize();
+    if (NULL != namespaces) {
+        free(namespaces);
+    }
+    return ret;
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of registering large nspaces with a server. A
+ * set of synthetic jobs - node and proc maps plus, optionally, the
+ * per-proc data a host RM would provide - is registered at once and
+ * the time until each registration completes is reported. While
+ * the registrations are in progress, the server's progress thread
+ * is repeatedly pinged with a query that has to be answered there,
+ * so the reported ping latency shows how responsive the server
+ * stays. Compare parsing on the progress thread with, e.g.:
+ *
+ *     ./simpreg -n 100000 -N 1000 -j 4 -d
+ *     PMIX_MCA_pmix_server_register_threads=0 ./simpreg -n 100000 -N 1000 -j 4 -d
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <pmix.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#include "src/util/argv.h"
+
+#include "simptest_common.h"
+
+static pmix_server_module_t mymodule = {0};
+
+typedef struct {
+    char nspace[PMIX_MAX_NSLEN+1];
+    pmix_info_t *info;
+    size_t ninfo;
+    volatile bool done;
+    pmix_status_t status;
+    double end;
+} job_t;
+
+static void regcbfunc(pmix_status_t status, void *cbdata)
+{
+    job_t *job = (job_t*)cbdata;
+
+    job->status = status;
+    job->end = simptest_ts();
+    job->done = true;
+}
+
+/* completion order of the operations on the same nspace */
+static volatile int opseq = 0;
+
+static void seqcbfunc(pmix_status_t status, void *cbdata)
+{
+    volatile int *order = (volatile int*)cbdata;
+
+    *order = ++opseq;
+}
+
+static volatile bool pingdone = false;
+
+static void pingcbfunc(pmix_status_t status,
+                       pmix_info_t *info, size_t ninfo,
+                       void *cbdata,
+                       pmix_release_cbfunc_t release_fn,
+                       void *release_cbdata)
+{
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    pingdone = true;
+}
+
+/* build the job info a host RM would pass for a job of nprocs
+ * procs spread evenly across nnodes nodes */
+static void build_job(job_t *job, int nprocs, int nnodes, bool pdata)
+{
+    char **nodes = NULL, **ppn = NULL, **peers, *tmp, *regex;
+    int n, r, first, last;
+    size_t m;
+    uint32_t u32;
+    uint16_t u16;
+    pmix_info_t *iptr;
+    pmix_data_array_t *darray;
+
+    for (n=0; n < nnodes; n++) {
+        if (0 > asprintf(&tmp, "node%05d", n)) {
+            exit(1);
+        }
+        pmix_argv_append_nosize(&nodes, tmp);
+        free(tmp);
+        first = (int)(((long)n * nprocs) / nnodes);
+        last = (int)(((long)(n+1) * nprocs) / nnodes);
+        peers = NULL;
+        for (r=first; r < last; r++) {
+            if (0 > asprintf(&tmp, "%d", r)) {
+                exit(1);
+            }
+            pmix_argv_append_nosize(&peers, tmp);
+            free(tmp);
+        }
+        tmp = pmix_argv_join(peers, ',');
+        pmix_argv_append_nosize(&ppn, tmp);
+        free(tmp);
+        pmix_argv_free(peers);
+    }
+
+    job->ninfo = 4 + (pdata ? nprocs : 0);
+    PMIX_INFO_CREATE(job->info, job->ninfo);
+    u32 = nprocs;
+    PMIX_INFO_LOAD(&job->info[0], PMIX_UNIV_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&job->info[1], PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    tmp = pmix_argv_join(nodes, ',');
+    PMIx_generate_regex(tmp, &regex);
+    free(tmp);
+    PMIX_INFO_LOAD(&job->info[2], PMIX_NODE_MAP, regex, PMIX_STRING);
+    free(regex);
+    tmp = pmix_argv_join(ppn, ';');
+    PMIx_generate_ppn(tmp, &regex);
+    free(tmp);
+    PMIX_INFO_LOAD(&job->info[3], PMIX_PROC_MAP, regex, PMIX_STRING);
+    free(regex);
+    pmix_argv_free(nodes);
+    pmix_argv_free(ppn);
+
+    if (!pdata) {
+        return;
+    }
+    m = 4;
+    for (n=0; n < nnodes; n++) {
+        first = (int)(((long)n * nprocs) / nnodes);
+        last = (int)(((long)(n+1) * nprocs) / nnodes);
+        for (r=first; r < last; r++) {
+            PMIX_DATA_ARRAY_CREATE(darray, 5, PMIX_INFO);
+            iptr = (pmix_info_t*)darray->array;
+            u32 = r;
+            PMIX_INFO_LOAD(&iptr[0], PMIX_RANK, &u32, PMIX_PROC_RANK);
+            u32 = 0;
+            PMIX_INFO_LOAD(&iptr[1], PMIX_APPNUM, &u32, PMIX_UINT32);
+            u16 = r - first;
+            PMIX_INFO_LOAD(&iptr[2], PMIX_LOCAL_RANK, &u16, PMIX_UINT16);
+            PMIX_INFO_LOAD(&iptr[3], PMIX_NODE_RANK, &u16, PMIX_UINT16);
+            u32 = n;
+            PMIX_INFO_LOAD(&iptr[4], PMIX_NODEID, &u32, PMIX_UINT32);
+            PMIX_INFO_LOAD(&job->info[m], PMIX_PROC_DATA, darray, PMIX_DATA_ARRAY);
+            PMIX_DATA_ARRAY_FREE(darray);
+            ++m;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_query_t query;
+    job_t *jobs;
+    int n, nprocs = 100000, nnodes = 1000, njobs = 4, ndone, npings = 0;
+    bool pdata = false;
+    double start, t, reg, rmax = 0, pmax = 0, psum = 0;
+    pmix_nspace_t order;
+    volatile int regseq = 0, deregseq = 0;
+    struct timespec ts = {0, 10000};
+    int ret = 0;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-N", argv[n]) && NULL != argv[n+1]) {
+            nnodes = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-j", argv[n]) && NULL != argv[n+1]) {
+            njobs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-d", argv[n])) {
+            pdata = true;
+        } else {
+            fprintf(stderr, "usage: %s [-n procs-per-job] [-N nodes] [-j jobs] [-d]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (nnodes < 1) {
+        nnodes = 1;
+    }
+    if (nprocs < nnodes) {
+        nprocs = nnodes;
+    }
+    if (njobs < 1) {
+        njobs = 1;
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+
+    jobs = (job_t*)calloc(njobs, sizeof(job_t));
+    for (n=0; n < njobs; n++) {
+        (void)snprintf(jobs[n].nspace, PMIX_MAX_NSLEN, "simpreg-%d", n);
+        build_job(&jobs[n], nprocs, nnodes, pdata);
+    }
+
+    PMIX_QUERY_CONSTRUCT(&query);
+    PMIX_ARGV_APPEND(rc, query.keys, PMIX_QUERY_SERVER_STATS);
+
+    /* register all the jobs at once */
+    start = simptest_ts();
+    for (n=0; n < njobs; n++) {
+        rc = PMIx_server_register_nspace(jobs[n].nspace, 0, jobs[n].info, jobs[n].ninfo,
+                                         regcbfunc, &jobs[n]);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Register nspace failed: %s\n", PMIx_Error_string(rc));
+            jobs[n].status = rc;
+            jobs[n].end = simptest_ts();
+            jobs[n].done = true;
+        }
+    }
+
+    /* ping the progress thread until they are all done */
+    do {
+        pingdone = false;
+        t = simptest_ts();
+        if (PMIX_SUCCESS != (rc = PMIx_Query_info_nb(&query, 1, pingcbfunc, NULL))) {
+            fprintf(stderr, "Query failed: %s\n", PMIx_Error_string(rc));
+            ret = 1;
+            break;
+        }
+        simptest_wait_for(&pingdone);
+        t = simptest_ts() - t;
+        ++npings;
+        psum += t;
+        pmax = (t > pmax) ? t : pmax;
+        for (ndone=0, n=0; n < njobs; n++) {
+            if (jobs[n].done) {
+                ++ndone;
+            }
+        }
+    } while (ndone < njobs);
+    for (n=0; n < njobs; n++) {
+        simptest_wait_for(&jobs[n].done);
+    }
+
+    for (n=0; n < njobs; n++) {
+        reg = jobs[n].end - start;
+        rmax = (reg > rmax) ? reg : rmax;
+        if (PMIX_SUCCESS != jobs[n].status) {
+            fprintf(stderr, "Register of %s failed: %s\n", jobs[n].nspace,
+                    PMIx_Error_string(jobs[n].status));
+            ret = 1;
+        }
+    }
+    fprintf(stdout, "Registered %d jobs of %d procs on %d nodes%s in %10.6f sec\n",
+            njobs, nprocs, nnodes, pdata ? " with proc data" : "", rmax);
+    fprintf(stdout, "Progress thread ping over %d pings: %10.6f sec avg  %10.6f max\n",
+            npings, (0 < npings) ? psum / npings : 0.0, pmax);
+
+    /* a deregistration right behind the registration of the same
+     * nspace must not overtake it */
+    PMIX_LOAD_NSPACE(order, "simpreg-order");
+    rc = PMIx_server_register_nspace(order, 0, jobs[0].info, jobs[0].ninfo,
+                                     seqcbfunc, (void*)&regseq);
+    if (PMIX_SUCCESS == rc) {
+        PMIx_server_deregister_nspace(order, seqcbfunc, (void*)&deregseq);
+        while (0 == regseq || 0 == deregseq) {
+            nanosleep(&ts, NULL);
+        }
+        if (deregseq < regseq) {
+            fprintf(stderr, "Deregister of simpreg-order completed before its register\n");
+            ret = 1;
+        }
+    }
+
+    for (n=0; n < njobs; n++) {
+        jobs[n].done = false;
+        PMIx_server_deregister_nspace(jobs[n].nspace, regcbfunc, &jobs[n]);
+    }
+    for (n=0; n < njobs; n++) {
+        simptest_wait_for(&jobs[n].done);
+        PMIX_INFO_FREE(jobs[n].info, jobs[n].ninfo);
+    }
+    free(jobs);
+    PMIX_QUERY_DESTRUCT(&query);
+    PMIx_server_finalize();
+    return ret;
+}
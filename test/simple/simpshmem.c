@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measure the cost of creating shared memory segments on the server
+ * and of attaching to them from a set of local processes using the
+ * active pshmem component. Compare the backends by selecting them
+ * explicitly, e.g.:
+ *
+ *     PMIX_MCA_pshmem=mmap  ./simpshmem -n 64 -s 32 -z 4194304
+ *     PMIX_MCA_pshmem=memfd ./simpshmem -n 64 -s 32 -z 4194304
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "src/mca/base/base.h"
+#include "src/mca/pshmem/base/base.h"
+
+#include "simptest_common.h"
+
+static pmix_server_module_t mymodule = {0};
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_pshmem_seg_t *segs, seg;
+    int nprocs = 16, nsegs = 16, n, i, pfd[2];
+    size_t size = 1 << 22, off, pgsize = sysconf(_SC_PAGESIZE);
+    char tmpdir[] = "/tmp/simpshmem-XXXXXX";
+    char path[PMIX_PATH_MAX];
+    double start, create, attach, amin = 1.0e9, amax = 0, asum = 0, cleanup;
+    volatile unsigned char sum = 0;
+    pid_t pid;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp("-n", argv[n]) && NULL != argv[n+1]) {
+            nprocs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-s", argv[n]) && NULL != argv[n+1]) {
+            nsegs = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-z", argv[n]) && NULL != argv[n+1]) {
+            size = strtoul(argv[++n], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n nprocs] [-s nsegments] [-z segment size]\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    if (NULL == mkdtemp(tmpdir)) {
+        fprintf(stderr, "Cannot create tmpdir\n");
+        exit(1);
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "Init failed with error %d\n", rc);
+        exit(rc);
+    }
+    if (PMIX_SUCCESS != (rc = pmix_mca_base_framework_open(&pmix_pshmem_base_framework, 0)) ||
+        PMIX_SUCCESS != (rc = pmix_pshmem_base_select()) ||
+        PMIX_SUCCESS != (rc = pmix_pshmem.init(NULL, 0))) {
+        fprintf(stderr, "pshmem setup failed with error %d\n", rc);
+        goto done;
+    }
+    segs = (pmix_pshmem_seg_t*)calloc(nsegs, sizeof(pmix_pshmem_seg_t));
+
+    /* server side: create and initialize the segments */
+    start = simptest_ts();
+    for (n=0; n < nsegs; n++) {
+        snprintf(path, PMIX_PATH_MAX, "%s/seg-%d", tmpdir, n);
+        if (PMIX_SUCCESS != (rc = pmix_pshmem.segment_create(&segs[n], path, size))) {
+            fprintf(stderr, "segment_create failed with error %d\n", rc);
+            goto done;
+        }
+        memset(segs[n].seg_base_addr, n, size);
+    }
+    create = simptest_ts() - start;
+
+    /* client side: attach to all segments and touch every page */
+    if (0 != pipe(pfd)) {
+        goto done;
+    }
+    for (i=0; i < nprocs; i++) {
+        if (0 == (pid = fork())) {
+            close(pfd[0]);
+            start = simptest_ts();
+            for (n=0; n < nsegs; n++) {
+                memset(&seg, 0, sizeof(seg));
+                pmix_strncpy(seg.seg_name, segs[n].seg_name, PMIX_PATH_MAX);
+                seg.seg_size = size;
+                if (PMIX_SUCCESS != pmix_pshmem.segment_attach(&seg, PMIX_PSHMEM_RONLY)) {
+                    _exit(1);
+                }
+                for (off=0; off < size; off += pgsize) {
+                    sum += seg.seg_base_addr[off];
+                }
+                pmix_pshmem.segment_detach(&seg);
+            }
+            attach = simptest_ts() - start;
+            if (sizeof(attach) != write(pfd[1], &attach, sizeof(attach))) {
+                _exit(1);
+            }
+            _exit(0);
+        }
+    }
+    close(pfd[1]);
+    for (i=0; i < nprocs; i++) {
+        if (sizeof(attach) != read(pfd[0], &attach, sizeof(attach))) {
+            fprintf(stderr, "Child failed to attach\n");
+            rc = PMIX_ERROR;
+            break;
+        }
+        asum += attach;
+        amin = (attach < amin) ? attach : amin;
+        amax = (attach > amax) ? attach : amax;
+    }
+    close(pfd[0]);
+    while (0 < wait(NULL));
+
+    start = simptest_ts();
+    for (n=0; n < nsegs; n++) {
+        pmix_pshmem.segment_unlink(&segs[n]);
+        pmix_pshmem.segment_detach(&segs[n]);
+    }
+    cleanup = simptest_ts() - start;
+    free(segs);
+
+    if (PMIX_SUCCESS == rc) {
+        fprintf(stdout, "pshmem %s: %d segments of %lu bytes, %d procs\n",
+                pmix_pshmem.name, nsegs, (unsigned long)size, nprocs);
+        fprintf(stdout, "    create:  %10.6f sec\n", create);
+        fprintf(stdout, "    attach:  %10.6f sec avg  %10.6f min  %10.6f max\n",
+                asum / nprocs, amin, amax);
+        fprintf(stdout, "    cleanup: %10.6f sec\n", cleanup);
+    }
+
+  done:
+    rmdir(tmpdir);
+    PMIx_server_finalize();
+    return rc;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+#include <src/include/types.h>
+#include <src/include/pmix_globals.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "src/util/argv.h"
+#include "src/util/pmix_environ.h"
+
+#include "simptest_common.h"
+
+double simptest_ts(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1.0e-6 * (double)tv.tv_usec;
+}
+
+void simptest_wait_for(volatile bool *flag)
+{
+    struct timespec ts = {0, 100000};
+
+    while (!*flag) {
+        nanosleep(&ts, NULL);
+    }
+}
+
+void simptest_opcbfunc(pmix_status_t status, void *cbdata)
+{
+    volatile bool *done = (volatile bool*)cbdata;
+
+    *done = true;
+}
+
+pmix_status_t simptest_register_nspace(const char *nspace, int nprocs)
+{
+    pmix_info_t *info;
+    pmix_status_t rc;
+    char **peers = NULL, *tmp, *regex;
+    char hostname[PMIX_MAXHOSTNAMELEN];
+    volatile bool done = false;
+    int n;
+
+    for (n=0; n < nprocs; n++) {
+        if (0 > asprintf(&tmp, "%d", n)) {
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_argv_append_nosize(&peers, tmp);
+        free(tmp);
+    }
+    tmp = pmix_argv_join(peers, ',');
+    pmix_argv_free(peers);
+    gethostname(hostname, sizeof(hostname));
+    PMIX_INFO_CREATE(info, 6);
+    PMIX_INFO_LOAD(&info[0], PMIX_UNIV_SIZE, &nprocs, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[1], PMIX_JOB_SIZE, &nprocs, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[2], PMIX_LOCAL_SIZE, &nprocs, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[3], PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
+    PMIx_generate_regex(hostname, &regex);
+    PMIX_INFO_LOAD(&info[4], PMIX_NODE_MAP, regex, PMIX_STRING);
+    free(regex);
+    PMIx_generate_ppn(tmp, &regex);
+    PMIX_INFO_LOAD(&info[5], PMIX_PROC_MAP, regex, PMIX_STRING);
+    free(regex);
+    free(tmp);
+    rc = PMIx_server_register_nspace(nspace, nprocs, info, 6,
+                                     simptest_opcbfunc, (void*)&done);
+    if (PMIX_SUCCESS == rc) {
+        simptest_wait_for(&done);
+    }
+    PMIX_INFO_FREE(info, 6);
+    return rc;
+}
+
+int simptest_setup_client(const char *nspace, int rank, char ***env)
+{
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    volatile bool done = false;
+
+    PMIX_LOAD_PROCID(&proc, nspace, rank);
+    if (PMIX_SUCCESS != (rc = PMIx_server_register_client(&proc, geteuid(), getegid(),
+                                                          NULL, simptest_opcbfunc,
+                                                          (void*)&done))) {
+        fprintf(stderr, "Register client failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    simptest_wait_for(&done);
+    *env = pmix_argv_copy(environ);
+    if (PMIX_SUCCESS != (rc = PMIx_server_setup_fork(&proc, env))) {
+        fprintf(stderr, "Setup fork failed: %s\n", PMIx_Error_string(rc));
+        pmix_argv_free(*env);
+        *env = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+int simptest_start_client(char *executable, const char *nspace, int rank,
+                          char *params, pid_t *pid)
+{
+    char **env, **argv = NULL;
+
+    if (0 != simptest_setup_client(nspace, rank, &env)) {
+        return 1;
+    }
+    pmix_argv_append_nosize(&argv, executable);
+    pmix_argv_append_nosize(&argv, "--client");
+    pmix_argv_append_nosize(&argv, params);
+    *pid = fork();
+    if (*pid < 0) {
+        fprintf(stderr, "Fork failed\n");
+        pmix_argv_free(argv);
+        pmix_argv_free(env);
+        return 1;
+    }
+    if (0 == *pid) {
+        execve(executable, argv, env);
+        _exit(1);
+    }
+    pmix_argv_free(argv);
+    pmix_argv_free(env);
+    return 0;
+}
+
+int simptest_wait_clients(void)
+{
+    int status, ret = 0;
+
+    while (0 < waitpid(-1, &status, 0)) {
+        if (!WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+            ret = 1;
+        }
+    }
+    return ret;
+}
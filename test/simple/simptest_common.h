@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2019      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Helpers shared by the simple tests.
+ */
+
+#ifndef SIMPTEST_COMMON_H
+#define SIMPTEST_COMMON_H
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+/* wall clock time in seconds */
+double simptest_ts(void);
+
+/* poll until the flag gets set by a callback */
+void simptest_wait_for(volatile bool *flag);
+
+/* op callback that sets the volatile bool pointed to by cbdata */
+void simptest_opcbfunc(pmix_status_t status, void *cbdata);
+
+/* register an nspace of nprocs procs, all of them on this node,
+ * and wait for the registration to complete */
+pmix_status_t simptest_register_nspace(const char *nspace, int nprocs);
+
+/* register a client and return a copy of our environment with
+ * whatever it needs to connect back to us added */
+int simptest_setup_client(const char *nspace, int rank, char ***env);
+
+/* register a client and fork/exec it as "executable --client params" */
+int simptest_start_client(char *executable, const char *nspace, int rank,
+                          char *params, pid_t *pid);
+
+/* reap all children - returns nonzero if any of them failed */
+int simptest_wait_clients(void);
+
+#endif
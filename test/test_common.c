@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2013-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Artem Y. Polyakov <artpol84@gmail.com>.
  *                         All rights reserved.
  * Copyright (c) 2015-2018 Mellanox Technologies, Inc.
@@ -81,6 +81,7 @@ void parse_cmd(int argc, char **argv, test_params *params)
             fprintf(stderr, "\t--test-replace N:k0,k1,...,k(N-1)   test key replace for N keys, k0,k1,k(N-1) - key indexes to replace  \n");
             fprintf(stderr, "\t--test-internal N  test store internal key, N - number of internal keys\n");
             fprintf(stderr, "\t--gds <external gds name>           set GDS module \"--gds hash|ds12\", default is hash\n");
+            fprintf(stderr, "\t--client-args \"<args>\"  pass additional arguments to each client\n");
             exit(0);
         } else if (0 == strcmp(argv[i], "--exec") || 0 == strcmp(argv[i], "-e")) {
             i++;
@@ -199,6 +200,11 @@ void parse_cmd(int argc, char **argv, test_params *params)
         } else if(0 == strcmp(argv[i], "--gds") ) {
             i++;
             params->gds_mode = strdup(argv[i]);
+        } else if (0 == strcmp(argv[i], "--client-args")) {
+            i++;
+            if (NULL != argv[i]) {
+                params->client_args = strdup(argv[i]);
+            }
         }
 
         else {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018 Intel, Inc. All rights reserved.
+ * Copyright (c) 2013-2019 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Artem Y. Polyakov <artpol84@gmail.com>.
  *                         All rights reserved.
  * Copyright (c) 2015      Research Organization for Information Science
@@ -129,6 +129,7 @@ typedef struct {
     char *key_replace;
     int test_internal;
     char *gds_mode;
+    char *client_args;
     int nservers;
     uint32_t lsize;
 } test_params;
@@ -162,6 +163,7 @@ typedef struct {
     params.key_replace = NULL;        \
     params.test_internal = 0;         \
     params.gds_mode = NULL;           \
+    params.client_args = NULL;        \
     params.nservers = 1;              \
     params.lsize = 0;                 \
 } while (0)
@@ -188,6 +190,9 @@ typedef struct {
     if (NULL != params.ns_dist) {     \
         free(params.ns_dist);         \
     }                                 \
+    if (NULL != params.client_args) { \
+        free(params.client_args);     \
+    }                                 \
 } while (0)
 
 void parse_cmd(int argc, char **argv, test_params *params);
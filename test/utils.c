@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2015-2019 Intel, Inc.  All rights reserved.
  * Copyright (c) 2015-2018 Mellanox Technologies, Inc.
  *                         All rights reserved.
  * Copyright (c) 2016      Research Organization for Information Science
@@ -93,4 +93,12 @@ void set_client_argv(test_params *params, char ***argv)
         pmix_argv_append_nosize(argv, "--gds");
         pmix_argv_append_nosize(argv, params->gds_mode);
     }
+    if (NULL != params->client_args) {
+        char **args = pmix_argv_split(params->client_args, ' ');
+        int n;
+        for (n=0; NULL != args && NULL != args[n]; n++) {
+            pmix_argv_append_nosize(argv, args[n]);
+        }
+        pmix_argv_free(args);
+    }
 }